@@ -1,6 +1,14 @@
 ﻿#ifndef __MATH_CORE_H__
 #define __MATH_CORE_H__
 
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 BEGIN_NAMESPACE
 /*!
  * c++20 类型限定
@@ -8,6 +16,47 @@ BEGIN_NAMESPACE
 template <typename T>
 concept validtype = std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
 
+/*!
+ * c++20 浮点类型限定
+ */
+template <typename T>
+concept floattype = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/*!
+ * 错误检查策略
+ * Checked     : 运行时检查除零与越界，出错时返回 NaN（默认行为）
+ * DebugAssert : 仅在 Debug 下断言，Release 下无分支
+ * Unchecked   : 不做任何检查
+ */
+enum class CheckPolicy
+{
+	Checked,
+	DebugAssert,
+	Unchecked
+};
+
+/**
+ * @brief 按检查策略校验条件
+ * @param condition 期望成立的条件
+ * @return 仅当策略为 Checked 且条件不成立时返回 false，其余情况恒为 true
+ */
+template <CheckPolicy P>
+inline bool checkCondition(const bool condition)
+{
+	if constexpr (CheckPolicy::Checked == P)
+	{
+		return condition;
+	}
+	else
+	{
+		if constexpr (CheckPolicy::DebugAssert == P)
+		{
+			assert(condition);
+		}
+		return true;
+	}
+}
+
 /*!
  * 坐标轴枚举
  */
@@ -27,6 +76,188 @@ enum class AxisPlane
 	YOZ,
 	XOZ
 };
+
+/**
+ * @brief 64 位整数混合（splitmix64 末段），用于散列
+ */
+inline uint64_t hashMix(uint64_t h)
+{
+	h ^= h >> 30;
+	h *= 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111ebull;
+	h ^= h >> 31;
+	return h;
+}
+
+/**
+ * @brief 标量的散列位模式，与 operator== 一致：+0 与 -0 得到相同结果
+ */
+template <validtype T>
+inline uint64_t hashBits(const T val)
+{
+	if constexpr (std::is_same_v<T, int>)
+	{
+		return static_cast<uint32_t>(val);
+	}
+	else if constexpr (std::is_same_v<T, float>)
+	{
+		return T(0) == val ? 0 : std::bit_cast<uint32_t>(val);
+	}
+	else
+	{
+		return T(0) == val ? 0 : std::bit_cast<uint64_t>(val);
+	}
+}
+
+/**
+ * @brief 将分量依次混入散列值
+ */
+template <validtype T, typename... Rest>
+inline size_t hashValues(const T first, const Rest... rest)
+{
+	uint64_t h = hashMix(hashBits(first));
+	((h = hashMix(h ^ hashBits(rest))), ...);
+	return static_cast<size_t>(h);
+}
+
+/*!
+ * 长度、距离、归一化与点积的计算精度
+ * Native      : 按分量类型计算并返回分量类型，float 全程单精度（默认）
+ * Promoted    : 提升为 double 计算并返回 double
+ * Compensated : 返回分量类型，乘积与求和带误差补偿（float 的乘积在 double 中精确累加，double 用 FMA + TwoSum）
+ * 整数分量在各策略下都先按整数/double 精确求和并返回 double
+ */
+enum class PrecisionPolicy
+{
+	Native,
+	Promoted,
+	Compensated
+};
+
+/*!
+ * 精度策略对应的结果类型
+ */
+template <validtype T, PrecisionPolicy R>
+using PrecisionType = std::conditional_t<std::is_integral_v<T> || PrecisionPolicy::Promoted == R, double, T>;
+
+/**
+ * @brief Dot2 补偿点积：乘积误差由 FMA 精确给出，求和误差由 TwoSum 给出，最后一并加回
+ * 结果约等于按 2 倍精度计算后舍入到 T
+ */
+template <floattype T>
+inline T compensatedDot(const T* a, const T* b, const size_t count)
+{
+	T sum(0), error(0);
+	for (size_t i(0); i < count; ++i)
+	{
+		const T product = a[i] * b[i];
+		const T productError = std::fma(a[i], b[i], -product);
+		const T total = sum + product;
+		const T bv = total - sum;
+		error += productError + ((sum - (total - bv)) + (product - bv));
+		sum = total;
+	}
+	return sum + error;
+}
+
+/**
+ * @brief 按精度策略计算点积
+ */
+template <PrecisionPolicy R, validtype T, size_t N>
+inline PrecisionType<T, R> dotProduct(const std::array<T, N>& a, const std::array<T, N>& b)
+{
+	if constexpr (std::is_integral_v<T>)
+	{
+		int64_t sum(0);
+		for (size_t i(0); i < N; ++i)
+		{
+			sum += static_cast<int64_t>(a[i]) * b[i];
+		}
+		return static_cast<double>(sum);
+	}
+	else if constexpr (PrecisionPolicy::Promoted == R
+		|| (PrecisionPolicy::Compensated == R && std::is_same_v<T, float>))
+	{
+		double sum(0.0);
+		for (size_t i(0); i < N; ++i)
+		{
+			sum += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+		}
+		return static_cast<PrecisionType<T, R>>(sum);
+	}
+	else if constexpr (PrecisionPolicy::Compensated == R)
+	{
+		return compensatedDot(a.data(), b.data(), N);
+	}
+	else
+	{
+		T sum(0);
+		for (size_t i(0); i < N; ++i)
+		{
+			sum += a[i] * b[i];
+		}
+		return sum;
+	}
+}
+
+/**
+ * @brief 按精度策略计算欧氏长度
+ */
+template <PrecisionPolicy R, validtype T, size_t N>
+inline PrecisionType<T, R> euclideanLength(const std::array<T, N>& a)
+{
+	return std::sqrt(dotProduct<R>(a, a));
+}
+
+/**
+ * @brief 按精度策略计算欧氏距离，Promoted 与整数分量先在 double 中求差
+ */
+template <PrecisionPolicy R, validtype T, size_t N>
+inline PrecisionType<T, R> euclideanDistance(const std::array<T, N>& a, const std::array<T, N>& b)
+{
+	if constexpr (std::is_same_v<PrecisionType<T, R>, double> && !std::is_same_v<T, double>)
+	{
+		std::array<double, N> d;
+		for (size_t i(0); i < N; ++i)
+		{
+			d[i] = static_cast<double>(b[i]) - static_cast<double>(a[i]);
+		}
+		return euclideanLength<PrecisionPolicy::Native>(d);
+	}
+	else
+	{
+		std::array<T, N> d;
+		for (size_t i(0); i < N; ++i)
+		{
+			d[i] = b[i] - a[i];
+		}
+		return euclideanLength<R>(d);
+	}
+}
+
+/**
+ * @brief 按精度策略归一化，零长度（或 NaN）返回零
+ */
+template <PrecisionPolicy R, validtype T, size_t N>
+inline std::array<T, N> normalizedArray(const std::array<T, N>& a)
+{
+	using Result = PrecisionType<T, R>;
+	const Result len = euclideanLength<R>(a);
+	std::array<T, N> result;
+	if (!(len > Result(0)))
+	{
+		result.fill(T(0));
+		return result;
+	}
+
+	const Result inv = Result(1) / len;
+	for (size_t i(0); i < N; ++i)
+	{
+		result[i] = static_cast<T>(static_cast<Result>(a[i]) * inv);
+	}
+	return result;
+}
 END_NAMESPACE
 
 #endif
\ No newline at end of file
@@ -1,9 +1,12 @@
 ﻿#ifndef __MATH_HEADER_H__
 #define __MATH_HEADER_H__
 
+#include "vector/TVector.hpp"
 #include "vector/TVector2.hpp"
 #include "vector/TVector3.hpp"
 #include "vector/TVector4.hpp"
+#include "vector/TUnitVector2.hpp"
+#include "vector/TUnitVector3.hpp"
 
 BEGIN_NAMESPACE
 
@@ -17,6 +20,33 @@ using Vector3d = TVector3<double>;
 using Vector4i = TVector4<int>;
 using Vector4f = TVector4<float>;
 using Vector4d = TVector4<double>;
+using Vector8f = TVector<8, float>;
+using Vector8d = TVector<8, double>;
+using Vector16f = TVector<16, float>;
+using Vector16d = TVector<16, double>;
+using UnitVector2f = TUnitVector2<float>;
+using UnitVector2d = TUnitVector2<double>;
+using UnitVector3f = TUnitVector3<float>;
+using UnitVector3d = TUnitVector3<double>;
+
+// 热路径类型定义：Debug 下断言，Release 下除法与下标访问无分支
+using Vector2iFast = TVector2<int, CheckPolicy::DebugAssert>;
+using Vector2fFast = TVector2<float, CheckPolicy::DebugAssert>;
+using Vector2dFast = TVector2<double, CheckPolicy::DebugAssert>;
+using Vector3iFast = TVector3<int, CheckPolicy::DebugAssert>;
+using Vector3fFast = TVector3<float, CheckPolicy::DebugAssert>;
+using Vector3dFast = TVector3<double, CheckPolicy::DebugAssert>;
+using Vector4iFast = TVector4<int, CheckPolicy::DebugAssert>;
+using Vector4fFast = TVector4<float, CheckPolicy::DebugAssert>;
+using Vector4dFast = TVector4<double, CheckPolicy::DebugAssert>;
+using Vector8fFast = TVector<8, float, CheckPolicy::DebugAssert>;
+using Vector8dFast = TVector<8, double, CheckPolicy::DebugAssert>;
+using Vector16fFast = TVector<16, float, CheckPolicy::DebugAssert>;
+using Vector16dFast = TVector<16, double, CheckPolicy::DebugAssert>;
+using UnitVector2fFast = TUnitVector2<float, CheckPolicy::DebugAssert>;
+using UnitVector2dFast = TUnitVector2<double, CheckPolicy::DebugAssert>;
+using UnitVector3fFast = TUnitVector3<float, CheckPolicy::DebugAssert>;
+using UnitVector3dFast = TUnitVector3<double, CheckPolicy::DebugAssert>;
 
 // 全局变量
 template<> const Vector2i Vector2i::zeroVector(0, 0);
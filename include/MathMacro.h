@@ -2,11 +2,20 @@
 #define __MATH_MACRO_H__
 
 // dll import export
+#if defined(_WIN32)
 #ifdef MATH_UTILS_DLL
 #define MATH_API __declspec(dllexport)
 #else
 #define MATH_API __declspec(dllimport)
 #endif
+#else
+#define MATH_API __attribute__((visibility("default")))
+#endif
+
+// simd
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SIMD_SSE2
+#endif
 
 // namespace
 #define BEGIN_NAMESPACE namespace math \
@@ -2,6 +2,10 @@
 #define __MATH_TOOL_H__
 
 #include "MathMacro.h"
+#include "MathCore.h"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
 
 BEGIN_NAMESPACE
 
@@ -23,13 +27,130 @@ public:
 	static double radianToDegree(const double radian);
 
 	/**
-	 * @brief 取小数部分
+	 * @brief 取小数部分 v - floor(v)，结果在 [0, 1) 内（绝对值极小的负数返回 1 之下最大的 float），
+	 *        超出 int 范围的整数值返回 0，NaN 原样返回
 	 * @param v 浮点数
 	 * @return 小数部分
 	 */
 	static float fraction(float v);
+
+	/**
+	 * @brief 批量向下取整，整数值、超出 int 范围的值与 NaN 原样返回
+	 * @param in 输入
+	 * @param out 输出，可与 in 相同
+	 * @param count 元素数
+	 */
+	static void floor(const float* in, float* out, const size_t count);
+
+	/**
+	 * @brief 批量取小数部分，语义同 fraction(float)
+	 * @param in 输入
+	 * @param out 输出，可与 in 相同
+	 * @param count 元素数
+	 */
+	static void fraction(const float* in, float* out, const size_t count);
+
+	/**
+	 * @brief 数组点积
+	 * @tparam R 精度策略：Native 按 T 用 4 路累加器求和，Promoted 在 double 中累加，
+	 *           Compensated 对 float 在 double 中累加后返回 float，对 double 用 Dot2 补偿
+	 * @param a 输入
+	 * @param b 输入
+	 * @param count 元素数
+	 * @return 点积
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native, floattype T>
+	static PrecisionType<T, R> dot(const T* a, const T* b, const size_t count);
+
+	/**
+	 * @brief 数组求和，精度策略同 dot，double 的 Compensated 用 Neumaier 补偿求和
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native, floattype T>
+	static PrecisionType<T, R> sum(const T* a, const size_t count);
+
+	/**
+	 * @brief 数组欧氏范数 sqrt(dot(a, a))
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native, floattype T>
+	static PrecisionType<T, R> norm(const T* a, const size_t count);
 };
 
+// 头文件内联，跨 DLL 调用时也能内联展开
+inline float MathTool::fraction(float v)
+{
+	// 绝对值极小的负数 v - floor(v) 舍入为 1，取 1 之下最大的 float 以保持 [0, 1)
+	const float f = v - std::floor(v);
+	return f >= 1.f ? 0x1.fffffep-1f : f;
+}
+
+template <PrecisionPolicy R, floattype T>
+PrecisionType<T, R> MathTool::dot(const T* a, const T* b, const size_t count)
+{
+	if constexpr (PrecisionPolicy::Compensated == R && std::is_same_v<T, double>)
+	{
+		return compensatedDot(a, b, count);
+	}
+	else
+	{
+		// 4 路独立累加器，便于流水线与向量化，结果与输入顺序一一对应
+		using Accumulator = std::conditional_t<PrecisionPolicy::Native == R, T, double>;
+		Accumulator partial[4] = {};
+		size_t i(0);
+		for (; i + 4 <= count; i += 4)
+		{
+			for (size_t k(0); k < 4; ++k)
+			{
+				partial[k] += static_cast<Accumulator>(a[i + k]) * static_cast<Accumulator>(b[i + k]);
+			}
+		}
+		for (; i < count; ++i)
+		{
+			partial[0] += static_cast<Accumulator>(a[i]) * static_cast<Accumulator>(b[i]);
+		}
+		return static_cast<PrecisionType<T, R>>((partial[0] + partial[1]) + (partial[2] + partial[3]));
+	}
+}
+
+template <PrecisionPolicy R, floattype T>
+PrecisionType<T, R> MathTool::sum(const T* a, const size_t count)
+{
+	if constexpr (PrecisionPolicy::Compensated == R && std::is_same_v<T, double>)
+	{
+		double total(0.0), error(0.0);
+		for (size_t i(0); i < count; ++i)
+		{
+			const double next = total + a[i];
+			error += std::abs(total) >= std::abs(a[i]) ? (total - next) + a[i] : (a[i] - next) + total;
+			total = next;
+		}
+		return total + error;
+	}
+	else
+	{
+		using Accumulator = std::conditional_t<PrecisionPolicy::Native == R, T, double>;
+		Accumulator partial[4] = {};
+		size_t i(0);
+		for (; i + 4 <= count; i += 4)
+		{
+			for (size_t k(0); k < 4; ++k)
+			{
+				partial[k] += static_cast<Accumulator>(a[i + k]);
+			}
+		}
+		for (; i < count; ++i)
+		{
+			partial[0] += static_cast<Accumulator>(a[i]);
+		}
+		return static_cast<PrecisionType<T, R>>((partial[0] + partial[1]) + (partial[2] + partial[3]));
+	}
+}
+
+template <PrecisionPolicy R, floattype T>
+PrecisionType<T, R> MathTool::norm(const T* a, const size_t count)
+{
+	return std::sqrt(dot<R>(a, a, count));
+}
+
 END_NAMESPACE
 
 #endif
\ No newline at end of file
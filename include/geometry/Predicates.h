@@ -0,0 +1,380 @@
+#ifndef __PREDICATES_H__
+#define __PREDICATES_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 自适应精度几何谓词（Shewchuk）
+ * 先用双精度计算并与误差上界比较，符号可确定时直接返回；
+ * 只有近退化输入才进入精确的浮点展开（expansion）运算，返回值符号总是正确的
+ */
+class MATH_API Predicates
+{
+public:
+	/**
+	 * @brief 二维方向测试
+	 * @return a、b、c 逆时针时为正，顺时针为负，共线为 0；绝对值约为三角形面积的两倍
+	 */
+	static double orient2d(const double* pa, const double* pb, const double* pc);
+
+	/**
+	 * @brief 三维方向测试
+	 * @return 从 d 看去 a、b、c 为顺时针（d 在平面下方）时为正，共面为 0
+	 */
+	static double orient3d(const double* pa, const double* pb, const double* pc, const double* pd);
+
+	/**
+	 * @brief 内切圆测试，a、b、c 需逆时针
+	 * @return d 在圆内为正，圆外为负，共圆为 0
+	 */
+	static double incircle(const double* pa, const double* pb, const double* pc, const double* pd);
+
+	/**
+	 * @brief 内切球测试，a、b、c、d 需满足 orient3d > 0
+	 * @return e 在球内为正，球外为负，共球为 0
+	 */
+	static double insphere(const double* pa, const double* pb, const double* pc, const double* pd, const double* pe);
+
+	/**
+	 * @brief 精确计算，仅在快速路径无法确定符号时调用
+	 */
+	static double orient2dExact(const double* pa, const double* pb, const double* pc);
+	static double orient3dExact(const double* pa, const double* pb, const double* pc, const double* pd);
+	static double incircleExact(const double* pa, const double* pb, const double* pc, const double* pd);
+	static double insphereExact(const double* pa, const double* pb, const double* pc, const double* pd, const double* pe);
+
+	template <validtype T, CheckPolicy P>
+	static double orient2d(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c);
+
+	template <validtype T, CheckPolicy P>
+	static double orient3d(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+		const TVector3<T, P>& d);
+
+	template <validtype T, CheckPolicy P>
+	static double incircle(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c,
+		const TVector2<T, P>& d);
+
+	template <validtype T, CheckPolicy P>
+	static double insphere(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+		const TVector3<T, P>& d, const TVector3<T, P>& e);
+
+	/**
+	 * @brief 批量二维方向测试：所有点相对同一条有向直线 ab
+	 * 第一遍只做快速过滤，记录无法确定的下标，第二遍再精确计算
+	 * @param out 输出 orient2d(a, b, points[i])
+	 */
+	template <validtype T, CheckPolicy P>
+	static void orient2d(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>* points,
+		const size_t count, double* out);
+
+	/**
+	 * @brief 批量三维方向测试：所有点相对同一平面 abc
+	 * @param out 输出 orient3d(a, b, c, points[i])
+	 */
+	template <validtype T, CheckPolicy P>
+	static void orient3d(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+		const TVector3<T, P>* points, const size_t count, double* out);
+
+	/**
+	 * @brief 批量内切圆测试：所有点相对同一外接圆 abc
+	 * @param out 输出 incircle(a, b, c, points[i])
+	 */
+	template <validtype T, CheckPolicy P>
+	static void incircle(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c,
+		const TVector2<T, P>* points, const size_t count, double* out);
+
+	/**
+	 * @brief 批量内切球测试：所有点相对同一外接球 abcd
+	 * @param out 输出 insphere(a, b, c, d, points[i])
+	 */
+	template <validtype T, CheckPolicy P>
+	static void insphere(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+		const TVector3<T, P>& d, const TVector3<T, P>* points, const size_t count, double* out);
+
+private:
+	static constexpr double s_epsilon = 1.1102230246251565e-16;
+	static constexpr double s_orient2dBound = (3.0 + 16.0 * s_epsilon) * s_epsilon;
+	static constexpr double s_orient3dBound = (7.0 + 56.0 * s_epsilon) * s_epsilon;
+	static constexpr double s_incircleBound = (10.0 + 96.0 * s_epsilon) * s_epsilon;
+	static constexpr double s_insphereBound = (16.0 + 224.0 * s_epsilon) * s_epsilon;
+
+	// 快速路径：返回近似值，并给出误差上界
+	static double orient2dFast(const double* pa, const double* pb, const double* pc, double& bound);
+	static double orient3dFast(const double* pa, const double* pb, const double* pc, const double* pd, double& bound);
+	static double incircleFast(const double* pa, const double* pb, const double* pc, const double* pd, double& bound);
+	static double insphereFast(const double* pa, const double* pb, const double* pc, const double* pd,
+		const double* pe, double& bound);
+
+	template <typename Fast, typename Exact>
+	static void batch(const size_t count, double* out, Fast fast, Exact exact);
+};
+
+inline double Predicates::orient2dFast(const double* pa, const double* pb, const double* pc, double& bound)
+{
+	const double left = (pa[0] - pc[0]) * (pb[1] - pc[1]);
+	const double right = (pa[1] - pc[1]) * (pb[0] - pc[0]);
+	bound = s_orient2dBound * (std::abs(left) + std::abs(right));
+	return left - right;
+}
+
+inline double Predicates::orient3dFast(const double* pa, const double* pb, const double* pc, const double* pd,
+	double& bound)
+{
+	const double adx = pa[0] - pd[0], ady = pa[1] - pd[1], adz = pa[2] - pd[2];
+	const double bdx = pb[0] - pd[0], bdy = pb[1] - pd[1], bdz = pb[2] - pd[2];
+	const double cdx = pc[0] - pd[0], cdy = pc[1] - pd[1], cdz = pc[2] - pd[2];
+
+	const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+	const double cdxady = cdx * ady, adxcdy = adx * cdy;
+	const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+	const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+		+ (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+		+ (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+	bound = s_orient3dBound * permanent;
+	return adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+}
+
+inline double Predicates::incircleFast(const double* pa, const double* pb, const double* pc, const double* pd,
+	double& bound)
+{
+	const double adx = pa[0] - pd[0], ady = pa[1] - pd[1];
+	const double bdx = pb[0] - pd[0], bdy = pb[1] - pd[1];
+	const double cdx = pc[0] - pd[0], cdy = pc[1] - pd[1];
+
+	const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy, alift = adx * adx + ady * ady;
+	const double cdxady = cdx * ady, adxcdy = adx * cdy, blift = bdx * bdx + bdy * bdy;
+	const double adxbdy = adx * bdy, bdxady = bdx * ady, clift = cdx * cdx + cdy * cdy;
+
+	const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+		+ (std::abs(cdxady) + std::abs(adxcdy)) * blift
+		+ (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+	bound = s_incircleBound * permanent;
+	return alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+}
+
+inline double Predicates::insphereFast(const double* pa, const double* pb, const double* pc, const double* pd,
+	const double* pe, double& bound)
+{
+	const double aex = pa[0] - pe[0], aey = pa[1] - pe[1], aez = pa[2] - pe[2];
+	const double bex = pb[0] - pe[0], bey = pb[1] - pe[1], bez = pb[2] - pe[2];
+	const double cex = pc[0] - pe[0], cey = pc[1] - pe[1], cez = pc[2] - pe[2];
+	const double dex = pd[0] - pe[0], dey = pd[1] - pe[1], dez = pd[2] - pe[2];
+
+	const double aexbey = aex * bey, bexaey = bex * aey;
+	const double bexcey = bex * cey, cexbey = cex * bey;
+	const double cexdey = cex * dey, dexcey = dex * cey;
+	const double dexaey = dex * aey, aexdey = aex * dey;
+	const double aexcey = aex * cey, cexaey = cex * aey;
+	const double bexdey = bex * dey, dexbey = dex * bey;
+
+	const double ab = aexbey - bexaey, bc = bexcey - cexbey, cd = cexdey - dexcey;
+	const double da = dexaey - aexdey, ac = aexcey - cexaey, bd = bexdey - dexbey;
+
+	const double abc = aez * bc - bez * ac + cez * ab;
+	const double bcd = bez * cd - cez * bd + dez * bc;
+	const double cda = cez * da + dez * ac + aez * cd;
+	const double dab = dez * ab + aez * bd + bez * da;
+
+	const double alift = aex * aex + aey * aey + aez * aez;
+	const double blift = bex * bex + bey * bey + bez * bez;
+	const double clift = cex * cex + cey * cey + cez * cez;
+	const double dlift = dex * dex + dey * dey + dez * dez;
+
+	const double aezp = std::abs(aez), bezp = std::abs(bez), cezp = std::abs(cez), dezp = std::abs(dez);
+	const double abp = std::abs(aexbey) + std::abs(bexaey), bcp = std::abs(bexcey) + std::abs(cexbey);
+	const double cdp = std::abs(cexdey) + std::abs(dexcey), dap = std::abs(dexaey) + std::abs(aexdey);
+	const double acp = std::abs(aexcey) + std::abs(cexaey), bdp = std::abs(bexdey) + std::abs(dexbey);
+
+	const double permanent = (cdp * bezp + bdp * cezp + bcp * dezp) * alift
+		+ (dap * cezp + acp * dezp + cdp * aezp) * blift
+		+ (abp * dezp + bdp * aezp + dap * bezp) * clift
+		+ (bcp * aezp + acp * bezp + abp * cezp) * dlift;
+	bound = s_insphereBound * permanent;
+	return (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+}
+
+inline double Predicates::orient2d(const double* pa, const double* pb, const double* pc)
+{
+	double bound;
+	const double det = orient2dFast(pa, pb, pc, bound);
+	return (det > bound || -det > bound) ? det : orient2dExact(pa, pb, pc);
+}
+
+inline double Predicates::orient3d(const double* pa, const double* pb, const double* pc, const double* pd)
+{
+	double bound;
+	const double det = orient3dFast(pa, pb, pc, pd, bound);
+	return (det > bound || -det > bound) ? det : orient3dExact(pa, pb, pc, pd);
+}
+
+inline double Predicates::incircle(const double* pa, const double* pb, const double* pc, const double* pd)
+{
+	double bound;
+	const double det = incircleFast(pa, pb, pc, pd, bound);
+	return (det > bound || -det > bound) ? det : incircleExact(pa, pb, pc, pd);
+}
+
+inline double Predicates::insphere(const double* pa, const double* pb, const double* pc, const double* pd,
+	const double* pe)
+{
+	double bound;
+	const double det = insphereFast(pa, pb, pc, pd, pe, bound);
+	return (det > bound || -det > bound) ? det : insphereExact(pa, pb, pc, pd, pe);
+}
+
+template <validtype T, CheckPolicy P>
+double Predicates::orient2d(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c)
+{
+	const double pa[] = { double(a.x()), double(a.y()) };
+	const double pb[] = { double(b.x()), double(b.y()) };
+	const double pc[] = { double(c.x()), double(c.y()) };
+	return orient2d(pa, pb, pc);
+}
+
+template <validtype T, CheckPolicy P>
+double Predicates::orient3d(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+	const TVector3<T, P>& d)
+{
+	const double pa[] = { double(a.x()), double(a.y()), double(a.z()) };
+	const double pb[] = { double(b.x()), double(b.y()), double(b.z()) };
+	const double pc[] = { double(c.x()), double(c.y()), double(c.z()) };
+	const double pd[] = { double(d.x()), double(d.y()), double(d.z()) };
+	return orient3d(pa, pb, pc, pd);
+}
+
+template <validtype T, CheckPolicy P>
+double Predicates::incircle(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c,
+	const TVector2<T, P>& d)
+{
+	const double pa[] = { double(a.x()), double(a.y()) };
+	const double pb[] = { double(b.x()), double(b.y()) };
+	const double pc[] = { double(c.x()), double(c.y()) };
+	const double pd[] = { double(d.x()), double(d.y()) };
+	return incircle(pa, pb, pc, pd);
+}
+
+template <validtype T, CheckPolicy P>
+double Predicates::insphere(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+	const TVector3<T, P>& d, const TVector3<T, P>& e)
+{
+	const double pa[] = { double(a.x()), double(a.y()), double(a.z()) };
+	const double pb[] = { double(b.x()), double(b.y()), double(b.z()) };
+	const double pc[] = { double(c.x()), double(c.y()), double(c.z()) };
+	const double pd[] = { double(d.x()), double(d.y()), double(d.z()) };
+	const double pe[] = { double(e.x()), double(e.y()), double(e.z()) };
+	return insphere(pa, pb, pc, pd, pe);
+}
+
+template <typename Fast, typename Exact>
+void Predicates::batch(const size_t count, double* out, Fast fast, Exact exact)
+{
+	std::vector<size_t> uncertain;
+	for (size_t i(0); i < count; ++i)
+	{
+		double bound;
+		const double det = fast(i, bound);
+		out[i] = det;
+		if (!(det > bound || -det > bound))
+		{
+			uncertain.push_back(i);
+		}
+	}
+
+	for (const size_t i : uncertain)
+	{
+		out[i] = exact(i);
+	}
+}
+
+template <validtype T, CheckPolicy P>
+void Predicates::orient2d(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>* points,
+	const size_t count, double* out)
+{
+	const double pa[] = { double(a.x()), double(a.y()) };
+	const double pb[] = { double(b.x()), double(b.y()) };
+	batch(count, out,
+		[&](size_t i, double& bound)
+		{
+			const double pc[] = { double(points[i].x()), double(points[i].y()) };
+			return orient2dFast(pa, pb, pc, bound);
+		},
+		[&](size_t i)
+		{
+			const double pc[] = { double(points[i].x()), double(points[i].y()) };
+			return orient2dExact(pa, pb, pc);
+		});
+}
+
+template <validtype T, CheckPolicy P>
+void Predicates::orient3d(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+	const TVector3<T, P>* points, const size_t count, double* out)
+{
+	const double pa[] = { double(a.x()), double(a.y()), double(a.z()) };
+	const double pb[] = { double(b.x()), double(b.y()), double(b.z()) };
+	const double pc[] = { double(c.x()), double(c.y()), double(c.z()) };
+	batch(count, out,
+		[&](size_t i, double& bound)
+		{
+			const double pd[] = { double(points[i].x()), double(points[i].y()), double(points[i].z()) };
+			return orient3dFast(pa, pb, pc, pd, bound);
+		},
+		[&](size_t i)
+		{
+			const double pd[] = { double(points[i].x()), double(points[i].y()), double(points[i].z()) };
+			return orient3dExact(pa, pb, pc, pd);
+		});
+}
+
+template <validtype T, CheckPolicy P>
+void Predicates::incircle(const TVector2<T, P>& a, const TVector2<T, P>& b, const TVector2<T, P>& c,
+	const TVector2<T, P>* points, const size_t count, double* out)
+{
+	const double pa[] = { double(a.x()), double(a.y()) };
+	const double pb[] = { double(b.x()), double(b.y()) };
+	const double pc[] = { double(c.x()), double(c.y()) };
+	batch(count, out,
+		[&](size_t i, double& bound)
+		{
+			const double pd[] = { double(points[i].x()), double(points[i].y()) };
+			return incircleFast(pa, pb, pc, pd, bound);
+		},
+		[&](size_t i)
+		{
+			const double pd[] = { double(points[i].x()), double(points[i].y()) };
+			return incircleExact(pa, pb, pc, pd);
+		});
+}
+
+template <validtype T, CheckPolicy P>
+void Predicates::insphere(const TVector3<T, P>& a, const TVector3<T, P>& b, const TVector3<T, P>& c,
+	const TVector3<T, P>& d, const TVector3<T, P>* points, const size_t count, double* out)
+{
+	const double pa[] = { double(a.x()), double(a.y()), double(a.z()) };
+	const double pb[] = { double(b.x()), double(b.y()), double(b.z()) };
+	const double pc[] = { double(c.x()), double(c.y()), double(c.z()) };
+	const double pd[] = { double(d.x()), double(d.y()), double(d.z()) };
+	batch(count, out,
+		[&](size_t i, double& bound)
+		{
+			const double pe[] = { double(points[i].x()), double(points[i].y()), double(points[i].z()) };
+			return insphereFast(pa, pb, pc, pd, pe, bound);
+		},
+		[&](size_t i)
+		{
+			const double pe[] = { double(points[i].x()), double(points[i].y()), double(points[i].z()) };
+			return insphereExact(pa, pb, pc, pd, pe);
+		});
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,1105 @@
+#ifndef __TCONVEX_HULL_HPP__
+#define __TCONVEX_HULL_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "geometry/Predicates.h"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 凸包
+ * 拓扑判断均以 Predicates 的自适应精度谓词为准，结果拓扑正确；共线/共面点不输出。
+ * 预剔除只丢弃可靠位于内部的点，近似判断不可靠时一律保留
+ */
+template <validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TConvexHull
+{
+public:
+	using Vector2 = TVector2<T, P>;
+	using Vector3 = TVector3<T, P>;
+
+	/**
+	 * @brief 二维凸包
+	 * 先并行求 16 个方向的极值点构成多边形（Akl-Toussaint），各分块并行剔除严格位于其内部的点并求局部凸包，
+	 * 最后合并。剔除时先用 SIMD 比较多边形的内接矩形，矩形外的点再比较内切圆，最后才逐边判断
+	 * @param points 点
+	 * @param count 点数
+	 * @param hull 输出凸包顶点下标，逆时针，从最左下点开始
+	 */
+	static void hull2d(const Vector2* points, const size_t count, std::vector<uint32_t>& hull);
+
+	/**
+	 * @brief 三维凸包（quickhull）
+	 * 点数较多时先求 26 个方向的极值点的凸包，并行剔除位于其内部的点（先比较内切球，再逐面判断），
+	 * 再以该多面体为起点加入剩余点
+	 * @param points 点
+	 * @param count 点数
+	 * @param triangles 输出三角形顶点下标，每 3 个一组，从外侧看为逆时针
+	 * @return 点集全部共面、点数不足或面邻接关系不一致时返回 false
+	 */
+	static bool hull3d(const Vector3* points, const size_t count, std::vector<uint32_t>& triangles);
+
+private:
+	static constexpr size_t s_grain = 1 << 16;
+
+	// 近似直线/平面值的误差上界系数（约 45 个机器精度）
+	static constexpr double s_planeError = 1e-14;
+
+	// 从外侧看 v[0], v[1], v[2] 逆时针；normal 为 (v1 - v0) x (v2 - v0) 的近似值。
+	// 对坐标范围内的任意点 q，normal * q - offset 与精确平面值之差不超过 error
+	struct Face
+	{
+		uint32_t v[3];
+		double origin[3];
+		double normal[3];
+		double bound[3];
+		double offset;
+		double error;
+		std::vector<uint32_t> outside;
+		bool alive;
+	};
+
+	static void load(const Vector2& p, double* out);
+	static void load(const Vector3& p, double* out);
+
+	// 对每个分块求局部结果，再按分块顺序归并，结果与线程数无关
+	template <typename Local, typename Func, typename Merge>
+	static Local reduce(const size_t count, const Local& init, Func func, Merge merge);
+
+	// 每个方向上投影最大的点，并列取下标最小者
+	template <size_t N>
+	struct Extremes
+	{
+		std::array<double, N> value;
+		std::array<size_t, N> index;
+
+		Extremes();
+		void update(const size_t dir, const double v, const size_t i);
+		void merge(const Extremes& other);
+	};
+
+	// key(i, out) 写出第 i 个点在 N 个方向上的投影
+	template <size_t N, typename Key>
+	static std::array<size_t, N> extremes(const size_t count, Key key);
+
+	// 16 个方向（第 k 个为 22.5 * k 度）上的极值点
+	static std::array<size_t, 16> extremes2d(const Vector2* points, const size_t count);
+
+	// 对 [begin, end) 中不在 box（xmin, ymin, xmax, ymax，开区间）内的点调用 func
+	template <typename Func>
+	static void outsideBox(const Vector2* points, const size_t begin, const size_t end, const double* box, Func func);
+
+	// 单调链求 candidates（会被排序）的凸包，逆时针，从最左下点开始
+	static void monotoneChain(const Vector2* points, std::vector<uint32_t>& candidates, std::vector<uint32_t>& hull);
+
+	// scale 为各坐标绝对值的上界
+	static Face makeFace(const Vector3* points, const double* scale, const uint32_t a, const uint32_t b, const uint32_t c);
+
+	// 近似平面值，> 0 表示在外侧，仅用于比较远近
+	static double distance(const Face& face, const double* q);
+
+	// 可靠的外侧判断
+	static bool outside(const Vector3* points, const Face& face, const double* q);
+
+	static void assign(const Vector3* points, const std::vector<uint32_t>& candidates, std::vector<Face>& faces,
+		const std::vector<uint32_t>& targets);
+
+	// 由 input 构造初始四面体，点集共面时返回 false
+	static bool simplex(const Vector3* points, const double* scale, const std::vector<uint32_t>& input,
+		std::vector<Face>& faces);
+
+	// 以 faces 中存活的闭合凸多面体为起点（面上已有的外侧点保留），逐个加入外侧点直到没有外侧点；
+	// 某条有向边找不到反向边（多面体不闭合）时返回 false
+	static bool expand(const Vector3* points, const double* scale, const std::vector<uint32_t>& candidates,
+		std::vector<Face>& faces);
+};
+
+template <validtype T, CheckPolicy P>
+void TConvexHull<T, P>::load(const Vector2& p, double* out)
+{
+	out[0] = static_cast<double>(p.x());
+	out[1] = static_cast<double>(p.y());
+}
+
+template <validtype T, CheckPolicy P>
+void TConvexHull<T, P>::load(const Vector3& p, double* out)
+{
+	out[0] = static_cast<double>(p.x());
+	out[1] = static_cast<double>(p.y());
+	out[2] = static_cast<double>(p.z());
+}
+
+template <validtype T, CheckPolicy P>
+template <typename Local, typename Func, typename Merge>
+Local TConvexHull<T, P>::reduce(const size_t count, const Local& init, Func func, Merge merge)
+{
+	const size_t chunks = (count + s_grain - 1) / s_grain;
+	std::vector<Local> partial(chunks, init);
+	ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		Local local = init;
+		for (size_t i(begin); i < end; ++i)
+		{
+			func(local, i);
+		}
+		partial[begin / s_grain] = local;
+	});
+
+	Local result = init;
+	for (const Local& local : partial)
+	{
+		merge(result, local);
+	}
+	return result;
+}
+
+template <validtype T, CheckPolicy P>
+template <size_t N>
+TConvexHull<T, P>::Extremes<N>::Extremes()
+{
+	value.fill(-std::numeric_limits<double>::infinity());
+	index.fill(0);
+}
+
+template <validtype T, CheckPolicy P>
+template <size_t N>
+void TConvexHull<T, P>::Extremes<N>::update(const size_t dir, const double v, const size_t i)
+{
+	// 按下标递增调用，严格大于才替换即可保证并列取最小下标
+	if (v > value[dir])
+	{
+		value[dir] = v;
+		index[dir] = i;
+	}
+}
+
+template <validtype T, CheckPolicy P>
+template <size_t N>
+void TConvexHull<T, P>::Extremes<N>::merge(const Extremes& other)
+{
+	for (size_t d(0); d < N; ++d)
+	{
+		if (other.value[d] > value[d] || (other.value[d] == value[d] && other.index[d] < index[d]))
+		{
+			value[d] = other.value[d];
+			index[d] = other.index[d];
+		}
+	}
+}
+
+template <validtype T, CheckPolicy P>
+template <size_t N, typename Key>
+std::array<size_t, N> TConvexHull<T, P>::extremes(const size_t count, Key key)
+{
+	const Extremes<N> result = reduce(count, Extremes<N>(),
+		[&key](Extremes<N>& local, size_t i)
+		{
+			double value[N];
+			key(i, value);
+			for (size_t d(0); d < N; ++d)
+			{
+				local.update(d, value[d], i);
+			}
+		},
+		[](Extremes<N>& accumulated, const Extremes<N>& local)
+		{
+			accumulated.merge(local);
+		});
+	return result.index;
+}
+
+template <validtype T, CheckPolicy P>
+std::array<size_t, 16> TConvexHull<T, P>::extremes2d(const Vector2* points, const size_t count)
+{
+	// 前 8 个方向的反方向即后 8 个方向；极值点只影响剔除率，投影无需精确
+	static constexpr double s_cos[8] = { 1.0, 0.92387953251128674, 0.70710678118654752, 0.38268343236508977,
+		0.0, -0.38268343236508977, -0.70710678118654752, -0.92387953251128674 };
+	static constexpr double s_sin[8] = { 0.0, 0.38268343236508977, 0.70710678118654752, 0.92387953251128674,
+		1.0, 0.92387953251128674, 0.70710678118654752, 0.38268343236508977 };
+
+	const size_t chunks = (count + s_grain - 1) / s_grain;
+	std::vector<Extremes<16>> partial(chunks);
+	ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		Extremes<16>& local = partial[begin / s_grain];
+		size_t i(begin);
+#ifdef MATH_SIMD_SSE2
+		if constexpr (std::is_same_v<T, float> && sizeof(Vector2) == 2 * sizeof(float))
+		{
+			// 每次 4 个点，各通道独立记录最大/最小投影及其下标，最后按通道归并
+			const float* raw = reinterpret_cast<const float*>(points);
+			__m128 high[8], low[8];
+			__m128i highIndex[8], lowIndex[8];
+			for (int k(0); k < 8; ++k)
+			{
+				high[k] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+				low[k] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				highIndex[k] = lowIndex[k] = _mm_setzero_si128();
+			}
+
+			__m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+			const __m128i step = _mm_set1_epi32(4);
+			for (; i + 4 <= end; i += 4, lane = _mm_add_epi32(lane, step))
+			{
+				const __m128 a = _mm_loadu_ps(raw + 2 * i);
+				const __m128 b = _mm_loadu_ps(raw + 2 * i + 4);
+				const __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				for (int k(0); k < 8; ++k)
+				{
+					const __m128 key = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(float(s_cos[k])), x),
+						_mm_mul_ps(_mm_set1_ps(float(s_sin[k])), y));
+
+					const __m128 greater = _mm_cmpgt_ps(key, high[k]);
+					high[k] = _mm_or_ps(_mm_and_ps(greater, key), _mm_andnot_ps(greater, high[k]));
+					highIndex[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(greater), lane),
+						_mm_andnot_si128(_mm_castps_si128(greater), highIndex[k]));
+
+					const __m128 less = _mm_cmplt_ps(key, low[k]);
+					low[k] = _mm_or_ps(_mm_and_ps(less, key), _mm_andnot_ps(less, low[k]));
+					lowIndex[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(less), lane),
+						_mm_andnot_si128(_mm_castps_si128(less), lowIndex[k]));
+				}
+			}
+
+			for (int k(0); k < 8; ++k)
+			{
+				float highValue[4], lowValue[4];
+				int32_t highLane[4], lowLane[4];
+				_mm_storeu_ps(highValue, high[k]);
+				_mm_storeu_ps(lowValue, low[k]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(highLane), highIndex[k]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(lowLane), lowIndex[k]);
+
+				Extremes<16> lanes;
+				for (int l(0); l < 4 && i > begin; ++l)
+				{
+					Extremes<16> one;
+					one.update(k, highValue[l], begin + highLane[l]);
+					one.update(k + 8, -lowValue[l], begin + lowLane[l]);
+					lanes.merge(one);
+				}
+				local.merge(lanes);
+			}
+		}
+#endif
+		for (; i < end; ++i)
+		{
+			const double x = static_cast<double>(points[i].x());
+			const double y = static_cast<double>(points[i].y());
+			for (int k(0); k < 8; ++k)
+			{
+				const double key = s_cos[k] * x + s_sin[k] * y;
+				local.update(k, key, i);
+				local.update(k + 8, -key, i);
+			}
+		}
+	});
+
+	Extremes<16> result;
+	for (const Extremes<16>& local : partial)
+	{
+		result.merge(local);
+	}
+	return result.index;
+}
+
+template <validtype T, CheckPolicy P>
+template <typename Func>
+void TConvexHull<T, P>::outsideBox(const Vector2* points, const size_t begin, const size_t end, const double* box,
+	Func func)
+{
+	size_t i(begin);
+#ifdef MATH_SIMD_SSE2
+	// 边界取自输入点坐标，转换回 T 是精确的
+	if constexpr (std::is_same_v<T, float> && sizeof(Vector2) == 2 * sizeof(float))
+	{
+		const float* raw = reinterpret_cast<const float*>(points);
+		const __m128 lo = _mm_setr_ps(float(box[0]), float(box[1]), float(box[0]), float(box[1]));
+		const __m128 hi = _mm_setr_ps(float(box[2]), float(box[3]), float(box[2]), float(box[3]));
+		for (; i + 2 <= end; i += 2)
+		{
+			const __m128 v = _mm_loadu_ps(raw + 2 * i);
+			const int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(v, lo), _mm_cmplt_ps(v, hi)));
+			if (0x3 != (mask & 0x3))
+			{
+				func(i);
+			}
+			if (0xc != (mask & 0xc))
+			{
+				func(i + 1);
+			}
+		}
+	}
+	else if constexpr (std::is_same_v<T, double> && sizeof(Vector2) == 2 * sizeof(double))
+	{
+		const double* raw = reinterpret_cast<const double*>(points);
+		const __m128d lo = _mm_loadu_pd(box);
+		const __m128d hi = _mm_loadu_pd(box + 2);
+		for (; i < end; ++i)
+		{
+			const __m128d v = _mm_loadu_pd(raw + 2 * i);
+			if (0x3 != _mm_movemask_pd(_mm_and_pd(_mm_cmpgt_pd(v, lo), _mm_cmplt_pd(v, hi))))
+			{
+				func(i);
+			}
+		}
+	}
+#endif
+	for (; i < end; ++i)
+	{
+		const double x = static_cast<double>(points[i].x());
+		const double y = static_cast<double>(points[i].y());
+		if (!(x > box[0] && y > box[1] && x < box[2] && y < box[3]))
+		{
+			func(i);
+		}
+	}
+}
+
+template <validtype T, CheckPolicy P>
+void TConvexHull<T, P>::hull2d(const Vector2* points, const size_t count, std::vector<uint32_t>& hull)
+{
+	hull.clear();
+	if (0 == count)
+	{
+		return;
+	}
+
+	// 16 个方向按逆时针排列
+	const std::array<size_t, 16> extreme = extremes2d(points, count);
+
+	// 去掉重合的多边形顶点
+	std::vector<std::array<double, 2>> polygon;
+	for (const size_t index : extreme)
+	{
+		std::array<double, 2> v;
+		load(points[index], v.data());
+		if (polygon.empty() || polygon.back() != v)
+		{
+			polygon.push_back(v);
+		}
+	}
+	while (polygon.size() > 1 && polygon.front() == polygon.back())
+	{
+		polygon.pop_back();
+	}
+
+	const size_t chunks = (count + s_grain - 1) / s_grain;
+	std::vector<std::vector<uint32_t>> kept(chunks);
+	if (polygon.size() >= 3)
+	{
+		// 点严格在多边形每条边左侧时不可能在凸包上。剔除只用近似值并留出误差余量，不可靠时保留
+		std::vector<std::array<double, 4>> edges(polygon.size());
+		for (size_t e(0); e < polygon.size(); ++e)
+		{
+			const std::array<double, 2>& a = polygon[e];
+			const std::array<double, 2>& b = polygon[(e + 1) % polygon.size()];
+			edges[e] = { a[0], a[1], b[0] - a[0], b[1] - a[1] };
+		}
+		auto surelyInside = [&edges](const double x, const double y)
+		{
+			for (const std::array<double, 4>& edge : edges)
+			{
+				const double dx = x - edge[0], dy = y - edge[1];
+				const double value = edge[2] * dy - edge[3] * dx;
+				if (value <= s_planeError * (std::abs(edge[2] * dy) + std::abs(edge[3] * dx)))
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		// 内接矩形：左边取 135、180、225 度三个极值点 x 的最大值，其余三边类似。
+		// 开矩形的四个角都在闭多边形内时，开矩形内的点都严格在多边形内部，否则退化为空矩形
+		auto coord = [points, &extreme](const int dir, const int axis)
+		{
+			return static_cast<double>(0 == axis ? points[extreme[dir]].x() : points[extreme[dir]].y());
+		};
+		double box[4] = {
+			std::max({ coord(6, 0), coord(8, 0), coord(10, 0) }),
+			std::max({ coord(10, 1), coord(12, 1), coord(14, 1) }),
+			std::min({ coord(14, 0), coord(0, 0), coord(2, 0) }),
+			std::min({ coord(2, 1), coord(4, 1), coord(6, 1) }) };
+		const double corners[4][2] = { { box[0], box[1] }, { box[2], box[1] }, { box[2], box[3] }, { box[0], box[3] } };
+		bool boxInside = box[0] < box[2] && box[1] < box[3];
+		for (int c(0); c < 4 && boxInside; ++c)
+		{
+			for (size_t e(0); e < polygon.size() && boxInside; ++e)
+			{
+				boxInside = Predicates::orient2d(polygon[e].data(), polygon[(e + 1) % polygon.size()].data(), corners[c]) >= 0.0;
+			}
+		}
+		if (!boxInside)
+		{
+			box[0] = box[1] = box[2] = box[3] = 0.0;
+		}
+
+		// 内切圆：以顶点均值为圆心，半径取到各边距离的下界并留出余量；多边形退化时半径为 0
+		double center[2] = { 0.0, 0.0 };
+		for (const std::array<double, 2>& v : polygon)
+		{
+			center[0] += v[0] / static_cast<double>(polygon.size());
+			center[1] += v[1] / static_cast<double>(polygon.size());
+		}
+		double radius = std::numeric_limits<double>::infinity();
+		for (const std::array<double, 4>& edge : edges)
+		{
+			const double dx = center[0] - edge[0], dy = center[1] - edge[1];
+			const double value = edge[2] * dy - edge[3] * dx;
+			const double error = s_planeError * (std::abs(edge[2] * dy) + std::abs(edge[3] * dx));
+			radius = std::min(radius, (value - error) / (std::sqrt(edge[2] * edge[2] + edge[3] * edge[3]) * (1.0 + s_planeError)));
+		}
+		const double radius2 = radius > 0.0 ? radius * radius * (1.0 - s_planeError) : 0.0;
+
+		// 每个分块先剔除再求局部凸包，最后合并各分块的凸包顶点
+		ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+		{
+			std::vector<uint32_t>& local = kept[begin / s_grain];
+			outsideBox(points, begin, end, box, [&](const size_t i)
+			{
+				const double x = static_cast<double>(points[i].x());
+				const double y = static_cast<double>(points[i].y());
+				const double dx = x - center[0], dy = y - center[1];
+				if (dx * dx + dy * dy >= radius2 && !surelyInside(x, y))
+				{
+					local.push_back(static_cast<uint32_t>(i));
+				}
+			});
+
+			std::vector<uint32_t> chain;
+			monotoneChain(points, local, chain);
+			local.swap(chain);
+		});
+	}
+	else
+	{
+		// 所有点重合时多边形退化，直接逐块求局部凸包
+		ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+		{
+			std::vector<uint32_t> local(end - begin);
+			for (size_t i(begin); i < end; ++i)
+			{
+				local[i - begin] = static_cast<uint32_t>(i);
+			}
+			monotoneChain(points, local, kept[begin / s_grain]);
+		});
+	}
+
+	std::vector<uint32_t> candidates;
+	for (const std::vector<uint32_t>& local : kept)
+	{
+		candidates.insert(candidates.end(), local.begin(), local.end());
+	}
+	monotoneChain(points, candidates, hull);
+}
+
+template <validtype T, CheckPolicy P>
+void TConvexHull<T, P>::monotoneChain(const Vector2* points, std::vector<uint32_t>& candidates,
+	std::vector<uint32_t>& hull)
+{
+	hull.clear();
+	if (candidates.empty())
+	{
+		return;
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [points](const uint32_t a, const uint32_t b)
+	{
+		if (points[a].x() != points[b].x())
+		{
+			return points[a].x() < points[b].x();
+		}
+		if (points[a].y() != points[b].y())
+		{
+			return points[a].y() < points[b].y();
+		}
+		return a < b;
+	});
+
+	// 下链从左到右，上链从右到左
+	auto turnsLeft = [points](const uint32_t a, const uint32_t b, const uint32_t c)
+	{
+		double pa[2], pb[2], pc[2];
+		load(points[a], pa);
+		load(points[b], pb);
+		load(points[c], pc);
+		return Predicates::orient2d(pa, pb, pc) > 0.0;
+	};
+
+	hull.resize(2 * candidates.size());
+	size_t k(0);
+	for (size_t i(0); i < candidates.size(); ++i)
+	{
+		while (k >= 2 && !turnsLeft(hull[k - 2], hull[k - 1], candidates[i]))
+		{
+			--k;
+		}
+		hull[k++] = candidates[i];
+	}
+	for (size_t i(candidates.size() - 1), lower(k + 1); i > 0; --i)
+	{
+		while (k >= lower && !turnsLeft(hull[k - 2], hull[k - 1], candidates[i - 1]))
+		{
+			--k;
+		}
+		hull[k++] = candidates[i - 1];
+	}
+
+	// 最后一个点与起点重合
+	hull.resize(k > 1 ? k - 1 : k);
+}
+
+template <validtype T, CheckPolicy P>
+typename TConvexHull<T, P>::Face TConvexHull<T, P>::makeFace(const Vector3* points, const double* scale,
+	const uint32_t a, const uint32_t b, const uint32_t c)
+{
+	Face face{ { a, b, c }, {}, {}, {}, 0.0, 0.0, {}, true };
+	double pb[3], pc[3];
+	load(points[a], face.origin);
+	load(points[b], pb);
+	load(points[c], pc);
+
+	const double u[3] = { pb[0] - face.origin[0], pb[1] - face.origin[1], pb[2] - face.origin[2] };
+	const double v[3] = { pc[0] - face.origin[0], pc[1] - face.origin[1], pc[2] - face.origin[2] };
+	face.normal[0] = u[1] * v[2] - u[2] * v[1];
+	face.normal[1] = u[2] * v[0] - u[0] * v[2];
+	face.normal[2] = u[0] * v[1] - u[1] * v[0];
+	face.bound[0] = std::abs(u[1] * v[2]) + std::abs(u[2] * v[1]);
+	face.bound[1] = std::abs(u[2] * v[0]) + std::abs(u[0] * v[2]);
+	face.bound[2] = std::abs(u[0] * v[1]) + std::abs(u[1] * v[0]);
+	face.offset = face.normal[0] * face.origin[0] + face.normal[1] * face.origin[1] + face.normal[2] * face.origin[2];
+	face.error = s_planeError * (face.bound[0] * (scale[0] + std::abs(face.origin[0]))
+		+ face.bound[1] * (scale[1] + std::abs(face.origin[1])) + face.bound[2] * (scale[2] + std::abs(face.origin[2])));
+	return face;
+}
+
+template <validtype T, CheckPolicy P>
+double TConvexHull<T, P>::distance(const Face& face, const double* q)
+{
+	return face.normal[0] * q[0] + face.normal[1] * q[1] + face.normal[2] * q[2] - face.offset;
+}
+
+template <validtype T, CheckPolicy P>
+bool TConvexHull<T, P>::outside(const Vector3* points, const Face& face, const double* q)
+{
+	// 先用预先算好的平面和整体误差界，落在误差带内再按该点重新估计误差，仍不可靠才用精确谓词
+	const double approx = face.normal[0] * q[0] + face.normal[1] * q[1] + face.normal[2] * q[2];
+	if (approx > face.offset + face.error || approx < face.offset - face.error)
+	{
+		return approx > face.offset;
+	}
+
+	const double d[3] = { q[0] - face.origin[0], q[1] - face.origin[1], q[2] - face.origin[2] };
+	const double value = face.normal[0] * d[0] + face.normal[1] * d[1] + face.normal[2] * d[2];
+	const double error = s_planeError
+		* (face.bound[0] * std::abs(d[0]) + face.bound[1] * std::abs(d[1]) + face.bound[2] * std::abs(d[2]));
+	if (value > error || value < -error)
+	{
+		return value > 0.0;
+	}
+
+	// 外侧即 orient3d < 0（见 Predicates）
+	double b[3], c[3];
+	load(points[face.v[1]], b);
+	load(points[face.v[2]], c);
+	return Predicates::orient3d(face.origin, b, c, q) < 0.0;
+}
+
+template <validtype T, CheckPolicy P>
+void TConvexHull<T, P>::assign(const Vector3* points, const std::vector<uint32_t>& candidates,
+	std::vector<Face>& faces, const std::vector<uint32_t>& targets)
+{
+	// 每个点分给第一个可见它的面；不在任何面外侧的点已被包住，直接丢弃
+	auto classify = [&](const uint32_t index, std::vector<std::vector<uint32_t>>& lists)
+	{
+		double q[3];
+		load(points[index], q);
+		for (size_t t(0); t < targets.size(); ++t)
+		{
+			if (outside(points, faces[targets[t]], q))
+			{
+				lists[t].push_back(index);
+				return;
+			}
+		}
+	};
+
+	if (candidates.size() < s_grain)
+	{
+		std::vector<std::vector<uint32_t>> lists(targets.size());
+		for (const uint32_t index : candidates)
+		{
+			classify(index, lists);
+		}
+		for (size_t t(0); t < targets.size(); ++t)
+		{
+			std::vector<uint32_t>& list = faces[targets[t]].outside;
+			list.insert(list.end(), lists[t].begin(), lists[t].end());
+		}
+		return;
+	}
+
+	const size_t chunks = (candidates.size() + s_grain - 1) / s_grain;
+	std::vector<std::vector<std::vector<uint32_t>>> partial(chunks, std::vector<std::vector<uint32_t>>(targets.size()));
+	ThreadPool::instance().parallelFor(0, candidates.size(), s_grain, [&](size_t begin, size_t end)
+	{
+		std::vector<std::vector<uint32_t>>& lists = partial[begin / s_grain];
+		for (size_t i(begin); i < end; ++i)
+		{
+			classify(candidates[i], lists);
+		}
+	});
+
+	for (size_t t(0); t < targets.size(); ++t)
+	{
+		std::vector<uint32_t>& list = faces[targets[t]].outside;
+		for (const std::vector<std::vector<uint32_t>>& lists : partial)
+		{
+			list.insert(list.end(), lists[t].begin(), lists[t].end());
+		}
+	}
+}
+
+template <validtype T, CheckPolicy P>
+bool TConvexHull<T, P>::simplex(const Vector3* points, const double* scale, const std::vector<uint32_t>& input,
+	std::vector<Face>& faces)
+{
+	faces.clear();
+	if (input.size() < 4)
+	{
+		return false;
+	}
+
+	// 坐标轴极值点中最远的两点，离该直线最远的点，离该平面最远的点
+	const std::array<size_t, 6> axis = extremes<6>(input.size(), [points, &input](const size_t i, double* value)
+	{
+		load(points[input[i]], value);
+		value[3] = -value[0];
+		value[4] = -value[1];
+		value[5] = -value[2];
+	});
+
+	auto squaredDistance = [points](const uint32_t a, const uint32_t b)
+	{
+		double pa[3], pb[3];
+		load(points[a], pa);
+		load(points[b], pb);
+		return (pa[0] - pb[0]) * (pa[0] - pb[0]) + (pa[1] - pb[1]) * (pa[1] - pb[1]) + (pa[2] - pb[2]) * (pa[2] - pb[2]);
+	};
+
+	uint32_t i0(input[axis[0]]), i1(input[axis[3]]);
+	for (int a(0); a < 6; ++a)
+	{
+		for (int b(a + 1); b < 6; ++b)
+		{
+			if (squaredDistance(input[axis[a]], input[axis[b]]) > squaredDistance(i0, i1))
+			{
+				i0 = input[axis[a]];
+				i1 = input[axis[b]];
+			}
+		}
+	}
+	if (0.0 == squaredDistance(i0, i1))
+	{
+		return false;
+	}
+
+	double p0[3], p1[3];
+	load(points[i0], p0);
+	load(points[i1], p1);
+	const double dir[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+	const uint32_t i2 = input[extremes<1>(input.size(), [&](const size_t i, double* value)
+	{
+		double q[3];
+		load(points[input[i]], q);
+		const double v[3] = { q[0] - p0[0], q[1] - p0[1], q[2] - p0[2] };
+		const double cx = v[1] * dir[2] - v[2] * dir[1];
+		const double cy = v[2] * dir[0] - v[0] * dir[2];
+		const double cz = v[0] * dir[1] - v[1] * dir[0];
+		value[0] = cx * cx + cy * cy + cz * cz;
+	})[0]];
+
+	double p2[3];
+	load(points[i2], p2);
+	const uint32_t i3 = input[extremes<1>(input.size(), [&](const size_t i, double* value)
+	{
+		double q[3];
+		load(points[input[i]], q);
+		value[0] = std::abs(Predicates::orient3d(p0, p1, p2, q));
+	})[0]];
+
+	double p3[3];
+	load(points[i3], p3);
+	if (0.0 == Predicates::orient3d(p0, p1, p2, p3))
+	{
+		return false;
+	}
+
+	// 每个面的对顶点都应位于其内侧
+	const uint32_t vertices[4] = { i0, i1, i2, i3 };
+	for (int skip(0); skip < 4; ++skip)
+	{
+		uint32_t v[3];
+		for (int i(0), k(0); i < 4; ++i)
+		{
+			if (i != skip)
+			{
+				v[k++] = vertices[i];
+			}
+		}
+
+		double q[3];
+		load(points[vertices[skip]], q);
+		if (outside(points, makeFace(points, scale, v[0], v[1], v[2]), q))
+		{
+			std::swap(v[1], v[2]);
+		}
+		faces.push_back(makeFace(points, scale, v[0], v[1], v[2]));
+	}
+	return true;
+}
+
+template <validtype T, CheckPolicy P>
+bool TConvexHull<T, P>::expand(const Vector3* points, const double* scale, const std::vector<uint32_t>& candidates,
+	std::vector<Face>& faces)
+{
+	// 只保留存活的面并重建有向边到面的映射
+	faces.erase(std::remove_if(faces.begin(), faces.end(), [](const Face& face) { return !face.alive; }), faces.end());
+
+	std::unordered_map<uint64_t, uint32_t> edges;
+	auto edgeKey = [](const uint32_t a, const uint32_t b)
+	{
+		return (static_cast<uint64_t>(a) << 32) | b;
+	};
+	auto link = [&](const uint32_t id)
+	{
+		const Face& face = faces[id];
+		edges[edgeKey(face.v[0], face.v[1])] = id;
+		edges[edgeKey(face.v[1], face.v[2])] = id;
+		edges[edgeKey(face.v[2], face.v[0])] = id;
+	};
+	// 闭合多面体上每条有向边 a -> b 都有反向边 b -> a；查不到说明拓扑已损坏，不能默认插入一条指向面 0 的邻接
+	auto neighborOf = [&](const uint32_t a, const uint32_t b, uint32_t& id)
+	{
+		const auto it = edges.find(edgeKey(b, a));
+		assert(edges.end() != it);
+		if (edges.end() == it)
+		{
+			return false;
+		}
+		id = it->second;
+		return true;
+	};
+
+	std::vector<uint32_t> pending(faces.size());
+	for (size_t f(0); f < faces.size(); ++f)
+	{
+		pending[f] = static_cast<uint32_t>(f);
+		link(static_cast<uint32_t>(f));
+	}
+	assign(points, candidates, faces, pending);
+
+	// 可见标记用递增的轮次号，避免每轮清空
+	std::vector<uint32_t> visited(faces.size(), 0);
+	uint32_t round(0);
+	std::vector<uint32_t> visible;
+	std::vector<std::pair<uint32_t, uint32_t>> horizon;
+	std::vector<uint32_t> orphans;
+	std::vector<uint32_t> created;
+
+	while (!pending.empty())
+	{
+		const uint32_t current = pending.back();
+		pending.pop_back();
+		if (!faces[current].alive || faces[current].outside.empty())
+		{
+			continue;
+		}
+
+		// 取离该面最远的外侧点作为视点，任何外侧点都正确，远近只影响效率
+		uint32_t eye = faces[current].outside.front();
+		double farthest = -std::numeric_limits<double>::infinity();
+		for (const uint32_t index : faces[current].outside)
+		{
+			double q[3];
+			load(points[index], q);
+			const double d = distance(faces[current], q);
+			if (d > farthest)
+			{
+				farthest = d;
+				eye = index;
+			}
+		}
+
+		double e[3];
+		load(points[eye], e);
+
+		// 从当前面出发沿邻接关系找出所有可见面
+		++round;
+		visible.assign(1, current);
+		visited[current] = round;
+		for (size_t i(0); i < visible.size(); ++i)
+		{
+			const Face& face = faces[visible[i]];
+			for (int k(0); k < 3; ++k)
+			{
+				uint32_t neighbor;
+				if (!neighborOf(face.v[k], face.v[(k + 1) % 3], neighbor))
+				{
+					return false;
+				}
+				if (round != visited[neighbor] && outside(points, faces[neighbor], e))
+				{
+					visited[neighbor] = round;
+					visible.push_back(neighbor);
+				}
+			}
+		}
+
+		// 可见区域内部的边直接删除，地平线上的边由新面覆盖
+		horizon.clear();
+		orphans.clear();
+		for (const uint32_t id : visible)
+		{
+			Face& face = faces[id];
+			for (int k(0); k < 3; ++k)
+			{
+				const uint32_t a = face.v[k], b = face.v[(k + 1) % 3];
+				uint32_t neighbor;
+				if (!neighborOf(a, b, neighbor))
+				{
+					return false;
+				}
+				if (round != visited[neighbor])
+				{
+					horizon.emplace_back(a, b);
+				}
+			}
+
+			for (const uint32_t index : face.outside)
+			{
+				if (index != eye)
+				{
+					orphans.push_back(index);
+				}
+			}
+			std::vector<uint32_t>().swap(face.outside);
+			face.alive = false;
+		}
+		for (const uint32_t id : visible)
+		{
+			const Face& face = faces[id];
+			for (int k(0); k < 3; ++k)
+			{
+				const uint32_t a = face.v[k], b = face.v[(k + 1) % 3];
+				uint32_t neighbor;
+				if (a < b && neighborOf(a, b, neighbor) && round == visited[neighbor])
+				{
+					edges.erase(edgeKey(a, b));
+					edges.erase(edgeKey(b, a));
+				}
+			}
+		}
+
+		created.clear();
+		for (const std::pair<uint32_t, uint32_t>& edge : horizon)
+		{
+			const uint32_t id = static_cast<uint32_t>(faces.size());
+			faces.push_back(makeFace(points, scale, edge.first, edge.second, eye));
+			link(id);
+			created.push_back(id);
+		}
+		visited.resize(faces.size(), 0);
+
+		assign(points, orphans, faces, created);
+		pending.insert(pending.end(), created.begin(), created.end());
+	}
+	return true;
+}
+
+template <validtype T, CheckPolicy P>
+bool TConvexHull<T, P>::hull3d(const Vector3* points, const size_t count, std::vector<uint32_t>& triangles)
+{
+	triangles.clear();
+	std::vector<uint32_t> input(count);
+	for (size_t i(0); i < count; ++i)
+	{
+		input[i] = static_cast<uint32_t>(i);
+	}
+
+	std::vector<Face> faces;
+	if (count < s_grain)
+	{
+		double scale[3] = { 0.0, 0.0, 0.0 };
+		for (size_t i(0); i < count; ++i)
+		{
+			double q[3];
+			load(points[i], q);
+			for (int k(0); k < 3; ++k)
+			{
+				scale[k] = std::max(scale[k], std::abs(q[k]));
+			}
+		}
+
+		if (!simplex(points, scale, input, faces) || !expand(points, scale, input, faces))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// 13 条轴（坐标轴、面对角线、体对角线）正反两个方向上的极值点
+		const std::array<size_t, 26> extreme = extremes<26>(count, [points](const size_t i, double* value)
+		{
+			double q[3];
+			load(points[i], q);
+			value[0] = q[0];
+			value[1] = q[1];
+			value[2] = q[2];
+			value[3] = q[0] + q[1];
+			value[4] = q[0] - q[1];
+			value[5] = q[0] + q[2];
+			value[6] = q[0] - q[2];
+			value[7] = q[1] + q[2];
+			value[8] = q[1] - q[2];
+			value[9] = value[3] + q[2];
+			value[10] = value[3] - q[2];
+			value[11] = value[4] + q[2];
+			value[12] = value[4] - q[2];
+			for (int a(0); a < 13; ++a)
+			{
+				value[a + 13] = -value[a];
+			}
+		});
+
+		// 坐标轴方向的极值点给出坐标范围
+		double scale[3];
+		for (int k(0); k < 3; ++k)
+		{
+			double high[3], low[3];
+			load(points[extreme[k]], high);
+			load(points[extreme[k + 13]], low);
+			scale[k] = std::max(std::abs(high[k]), std::abs(low[k]));
+		}
+
+		std::vector<uint32_t> seeds(extreme.begin(), extreme.end());
+		std::sort(seeds.begin(), seeds.end());
+		seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+		// 种子点共面时整个点集可能仍是三维的，退回到对全部点构造初始四面体
+		if (simplex(points, scale, seeds, faces))
+		{
+			if (!expand(points, scale, seeds, faces))
+			{
+				return false;
+			}
+		}
+		else if (!simplex(points, scale, input, faces))
+		{
+			return false;
+		}
+		faces.erase(std::remove_if(faces.begin(), faces.end(), [](const Face& face) { return !face.alive; }), faces.end());
+
+		// 内切球：以多面体顶点均值为圆心，半径取到各面距离的下界并留出余量
+		double center[3] = { 0.0, 0.0, 0.0 };
+		for (const Face& face : faces)
+		{
+			for (int k(0); k < 3; ++k)
+			{
+				center[k] += face.origin[k] / static_cast<double>(faces.size());
+			}
+		}
+		double radius = std::numeric_limits<double>::infinity();
+		for (const Face& face : faces)
+		{
+			const double value = face.normal[0] * center[0] + face.normal[1] * center[1] + face.normal[2] * center[2];
+			const double length = std::sqrt(face.normal[0] * face.normal[0] + face.normal[1] * face.normal[1]
+				+ face.normal[2] * face.normal[2]);
+			radius = std::min(radius, (face.offset - face.error - value) / (length * (1.0 + s_planeError)));
+		}
+		const double radius2 = radius > 0.0 ? radius * radius * (1.0 - s_planeError) : 0.0;
+
+		// 先比较内切球，再逐面判断：可靠在所有面内侧的点丢弃，可靠在某面外侧的点直接归入该面，其余留待精确判断
+		static constexpr uint32_t s_unknown = std::numeric_limits<uint32_t>::max();
+		const size_t chunks = (count + s_grain - 1) / s_grain;
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> kept(chunks);
+		ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+		{
+			std::vector<std::pair<uint32_t, uint32_t>>& local = kept[begin / s_grain];
+			for (size_t i(begin); i < end; ++i)
+			{
+				double q[3];
+				load(points[i], q);
+				const double dx = q[0] - center[0], dy = q[1] - center[1], dz = q[2] - center[2];
+				if (dx * dx + dy * dy + dz * dz < radius2)
+				{
+					continue;
+				}
+
+				for (size_t f(0); f < faces.size(); ++f)
+				{
+					const Face& face = faces[f];
+					const double value = face.normal[0] * q[0] + face.normal[1] * q[1] + face.normal[2] * q[2];
+					if (value >= face.offset - face.error)
+					{
+						const uint32_t target = value > face.offset + face.error ? static_cast<uint32_t>(f) : s_unknown;
+						local.emplace_back(static_cast<uint32_t>(i), target);
+						break;
+					}
+				}
+			}
+		});
+
+		input.clear();
+		for (const std::vector<std::pair<uint32_t, uint32_t>>& local : kept)
+		{
+			for (const std::pair<uint32_t, uint32_t>& entry : local)
+			{
+				if (s_unknown == entry.second)
+				{
+					input.push_back(entry.first);
+				}
+				else
+				{
+					faces[entry.second].outside.push_back(entry.first);
+				}
+			}
+		}
+		if (!expand(points, scale, input, faces))
+		{
+			return false;
+		}
+	}
+
+	for (const Face& face : faces)
+	{
+		if (face.alive)
+		{
+			triangles.insert(triangles.end(), face.v, face.v + 3);
+		}
+	}
+	return true;
+}
+
+END_NAMESPACE
+
+#endif
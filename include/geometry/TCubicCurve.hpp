@@ -0,0 +1,614 @@
+#ifndef __TCUBIC_CURVE_HPP__
+#define __TCUBIC_CURVE_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector.hpp"
+#include "vector/TVectorTraits.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 三次曲线的基
+ * Bezier     : 每段 4 个控制点，相邻段共用端点，控制点数为 3k + 1，曲线经过每段的首末控制点
+ * CatmullRom : 均匀 Catmull-Rom，段 i 使用控制点 i..i+3，曲线经过控制点 1..n-2
+ * BSpline    : 均匀三次 B 样条，段 i 使用控制点 i..i+3，C2 连续但不经过控制点
+ */
+enum class CurveBasis
+{
+	Bezier,
+	CatmullRom,
+	BSpline
+};
+
+/**
+ * @brief 基矩阵：第 k 行为 u^(3-k) 的系数在 4 个控制点上的权重
+ */
+template <floattype T>
+constexpr std::array<T, 16> cubicBasisMatrix(const CurveBasis basis)
+{
+	switch (basis)
+	{
+	case CurveBasis::Bezier:
+		return { T(-1), T(3), T(-3), T(1),
+			T(3), T(-6), T(3), T(0),
+			T(-3), T(3), T(0), T(0),
+			T(1), T(0), T(0), T(0) };
+	case CurveBasis::CatmullRom:
+		return { T(-0.5), T(1.5), T(-1.5), T(0.5),
+			T(1), T(-2.5), T(2), T(-0.5),
+			T(-0.5), T(0), T(0.5), T(0),
+			T(0), T(1), T(0), T(0) };
+	default:
+		return { T(-1) / T(6), T(3) / T(6), T(-3) / T(6), T(1) / T(6),
+			T(3) / T(6), T(-6) / T(6), T(3) / T(6), T(0),
+			T(-3) / T(6), T(0), T(3) / T(6), T(0),
+			T(1) / T(6), T(4) / T(6), T(1) / T(6), T(0) };
+	}
+}
+
+/**
+ * @brief 前向差分求三次多项式 ((a u + b) u + c) u + d 在 u = i / steps（i = 0..steps）处的值
+ * 每步只需 3 次加法；最后一个值直接取 a + b + c + d，避免误差累积到端点
+ * @param coefficients a, b, c, d
+ * @param steps 步数，至少为 1
+ * @param out 输出 steps + 1 个值
+ * @param stride 相邻输出的间隔（以 T 计）
+ */
+template <floattype T>
+void cubicForwardDifference(const T* coefficients, const size_t steps, T* out, const size_t stride)
+{
+	const T a = coefficients[0], b = coefficients[1], c = coefficients[2], d = coefficients[3];
+	const T h = T(1) / static_cast<T>(steps);
+	T f = d;
+	T d1 = ((a * h + b) * h + c) * h;
+	T d2 = (T(6) * a * h + T(2) * b) * h * h;
+	const T d3 = T(6) * a * h * h * h;
+	for (size_t i(0); i < steps; ++i)
+	{
+		out[i * stride] = f;
+		f += d1;
+		d1 += d2;
+		d2 += d3;
+	}
+	out[steps * stride] = a + b + c + d;
+}
+
+/*!
+ * 分段三次曲线，控制点为 TVector2/3/4 或 TVector<N>（浮点）
+ * 构建时把每段转换为幂基系数，每个分量 4 个系数（u^3, u^2, u, 1）连续存放：
+ *   单点求值为 Horner；批量求值在 float + SSE2 下每 4 个参数一组，4 段的系数转置后跨参数一次求值；
+ *   均匀细分用前向差分；弧长表用于按弧长（匀速）采样
+ * 参数 t 取值 [0, segmentCount()]，整数部分为段号，超出范围时截断
+ */
+template <vectortype Vector>
+class TCubicCurve
+{
+public:
+	using Scalar = typename TVectorTraits<Vector>::Scalar;
+	static constexpr size_t s_dimension = TVectorTraits<Vector>::s_size;
+
+	static_assert(floattype<Scalar>, "floating point vector required");
+	static_assert(sizeof(Vector) == s_dimension * sizeof(Scalar), "vector must be tightly packed");
+
+	TCubicCurve() = default;
+
+	/**
+	 * @brief 设置控制点，清空弧长表
+	 * @param basis 曲线基
+	 * @param points 控制点
+	 * @param count 控制点数，Bezier 为 3k + 1（k >= 1），其余至少为 4
+	 * @return 控制点数不合法时返回 false，曲线置空
+	 */
+	bool set(const CurveBasis basis, const Vector* points, const size_t count);
+
+	bool empty() const;
+	size_t segmentCount() const;
+	CurveBasis basis() const;
+
+	Vector evaluate(const Scalar t) const;
+
+	/**
+	 * @brief 对 t 的一阶导数
+	 */
+	Vector derivative(const Scalar t) const;
+
+	/**
+	 * @brief 批量求值
+	 * @param t 参数
+	 * @param count 参数个数
+	 * @param out 输出
+	 */
+	void evaluate(const Scalar* t, const size_t count, Vector* out) const;
+
+	/**
+	 * @brief 均匀细分：每段 stepsPerSegment 步，用前向差分
+	 * @param out 输出 segmentCount() * stepsPerSegment + 1 个点
+	 * @return 输出点数，曲线为空或步数为 0 时返回 0
+	 */
+	size_t tessellate(const size_t stepsPerSegment, Vector* out) const;
+
+	/**
+	 * @brief 构建弧长表：每段均匀取 samplesPerSegment 个弦长累加
+	 */
+	void buildArcLengthTable(const size_t samplesPerSegment = 32);
+
+	/**
+	 * @brief 弧长表给出的曲线全长，未构建时返回 0
+	 */
+	Scalar length() const;
+
+	/**
+	 * @brief 弧长 s 处的参数，在弧长表相邻两项间线性插值；s 超出 [0, length()] 时截断，未构建弧长表时返回 0
+	 */
+	Scalar parameterAtLength(const Scalar s) const;
+
+	/**
+	 * @brief 沿曲线按等弧长取 count 个点（含首尾），未构建弧长表时按等参数取点
+	 */
+	void sampleUniform(const size_t count, Vector* out) const;
+
+private:
+	/*!
+	 * 段号与段内参数
+	 */
+	struct Location
+	{
+		size_t segment;
+		Scalar u;
+	};
+
+	Location locate(const Scalar t) const;
+	const Scalar* coefficients(const size_t segment, const size_t component) const;
+
+private:
+	CurveBasis m_basis = CurveBasis::Bezier;
+	size_t m_segments = 0;
+	std::vector<Scalar> m_coefficients;
+	size_t m_samplesPerSegment = 0;
+	std::vector<Scalar> m_arcLengths;
+};
+
+/*!
+ * 双三次曲面片，4x4 控制点，u、v 两个方向使用同一种基
+ * 构建时对每个分量求出 4x4 幂基系数 M * G * M^T，细分时逐行（v 固定）得到关于 u 的三次多项式后前向差分
+ */
+template <vectortype Vector>
+class TBicubicPatch
+{
+public:
+	using Scalar = typename TVectorTraits<Vector>::Scalar;
+	static constexpr size_t s_dimension = TVectorTraits<Vector>::s_size;
+
+	static_assert(floattype<Scalar>, "floating point vector required");
+	static_assert(sizeof(Vector) == s_dimension * sizeof(Scalar), "vector must be tightly packed");
+
+	TBicubicPatch() = default;
+
+	/**
+	 * @brief 设置控制点
+	 * @param basis 曲线基，Catmull-Rom 与 B 样条只覆盖中间一格
+	 * @param points 16 个控制点，按行存放：points[4 * row + column]，column 沿 u，row 沿 v
+	 */
+	void set(const CurveBasis basis, const Vector* points);
+
+	/**
+	 * @brief 求值，u、v 取值 [0, 1]
+	 */
+	Vector evaluate(const Scalar u, const Scalar v) const;
+
+	/**
+	 * @brief 均匀细分为 (uSteps + 1) x (vSteps + 1) 的顶点网格，按行存放：下标 j * (uSteps + 1) + i
+	 * @param uSteps u 方向步数
+	 * @param vSteps v 方向步数
+	 * @param positions 输出位置
+	 * @param normals 可选，输出单位法线 normalize(dP/du x dP/dv)，退化处为零向量；仅三维向量有效
+	 * @return 输出顶点数，步数为 0 时返回 0
+	 */
+	size_t tessellate(const size_t uSteps, const size_t vSteps, Vector* positions, Vector* normals = nullptr) const;
+
+private:
+	// m_coefficients[c][k][l]：分量 c 中 v^(3-k) * u^(3-l) 的系数
+	std::array<std::array<std::array<Scalar, 4>, 4>, s_dimension> m_coefficients{};
+};
+
+template <vectortype Vector>
+bool TCubicCurve<Vector>::set(const CurveBasis basis, const Vector* points, const size_t count)
+{
+	m_basis = basis;
+	m_arcLengths.clear();
+	m_samplesPerSegment = 0;
+	if (CurveBasis::Bezier == basis)
+	{
+		m_segments = (count >= 4 && 0 == (count - 1) % 3) ? (count - 1) / 3 : 0;
+	}
+	else
+	{
+		m_segments = count >= 4 ? count - 3 : 0;
+	}
+	if (0 == m_segments)
+	{
+		m_coefficients.clear();
+		return false;
+	}
+
+	const std::array<Scalar, 16> matrix = cubicBasisMatrix<Scalar>(basis);
+	const size_t stride = CurveBasis::Bezier == basis ? 3 : 1;
+	m_coefficients.resize(m_segments * s_dimension * 4);
+	for (size_t s(0); s < m_segments; ++s)
+	{
+		const Vector* p = points + s * stride;
+		for (size_t c(0); c < s_dimension; ++c)
+		{
+			Scalar* coef = m_coefficients.data() + (s * s_dimension + c) * 4;
+			for (size_t k(0); k < 4; ++k)
+			{
+				coef[k] = matrix[4 * k] * p[0].data()[c] + matrix[4 * k + 1] * p[1].data()[c]
+					+ matrix[4 * k + 2] * p[2].data()[c] + matrix[4 * k + 3] * p[3].data()[c];
+			}
+		}
+	}
+	return true;
+}
+
+template <vectortype Vector>
+bool TCubicCurve<Vector>::empty() const
+{
+	return 0 == m_segments;
+}
+
+template <vectortype Vector>
+size_t TCubicCurve<Vector>::segmentCount() const
+{
+	return m_segments;
+}
+
+template <vectortype Vector>
+CurveBasis TCubicCurve<Vector>::basis() const
+{
+	return m_basis;
+}
+
+template <vectortype Vector>
+typename TCubicCurve<Vector>::Location TCubicCurve<Vector>::locate(const Scalar t) const
+{
+	// 比较写法同时把 NaN 映射到 0
+	const Scalar last = static_cast<Scalar>(m_segments);
+	const Scalar x = t > Scalar(0) ? (t < last ? t : last) : Scalar(0);
+	const size_t segment = std::min(static_cast<size_t>(x), m_segments - 1);
+	return { segment, x - static_cast<Scalar>(segment) };
+}
+
+template <vectortype Vector>
+const typename TCubicCurve<Vector>::Scalar* TCubicCurve<Vector>::coefficients(const size_t segment,
+	const size_t component) const
+{
+	return m_coefficients.data() + (segment * s_dimension + component) * 4;
+}
+
+template <vectortype Vector>
+Vector TCubicCurve<Vector>::evaluate(const Scalar t) const
+{
+	Vector result;
+	if (empty())
+	{
+		return result;
+	}
+
+	const Location at = locate(t);
+	for (size_t c(0); c < s_dimension; ++c)
+	{
+		const Scalar* k = coefficients(at.segment, c);
+		result.data()[c] = ((k[0] * at.u + k[1]) * at.u + k[2]) * at.u + k[3];
+	}
+	return result;
+}
+
+template <vectortype Vector>
+Vector TCubicCurve<Vector>::derivative(const Scalar t) const
+{
+	Vector result;
+	if (empty())
+	{
+		return result;
+	}
+
+	const Location at = locate(t);
+	for (size_t c(0); c < s_dimension; ++c)
+	{
+		const Scalar* k = coefficients(at.segment, c);
+		result.data()[c] = (Scalar(3) * k[0] * at.u + Scalar(2) * k[1]) * at.u + k[2];
+	}
+	return result;
+}
+
+template <vectortype Vector>
+void TCubicCurve<Vector>::evaluate(const Scalar* t, const size_t count, Vector* out) const
+{
+	if (empty())
+	{
+		std::fill(out, out + count, Vector());
+		return;
+	}
+
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<Scalar, float>)
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			Location at[4];
+			for (size_t k(0); k < 4; ++k)
+			{
+				at[k] = locate(t[i + k]);
+			}
+			const __m128 u = _mm_setr_ps(at[0].u, at[1].u, at[2].u, at[3].u);
+
+			alignas(16) float lanes[s_dimension][4];
+			for (size_t c(0); c < s_dimension; ++c)
+			{
+				// 4 段的 (a, b, c, d) 转置为跨参数的 a、b、c、d
+				__m128 a = _mm_loadu_ps(coefficients(at[0].segment, c));
+				__m128 b = _mm_loadu_ps(coefficients(at[1].segment, c));
+				__m128 q = _mm_loadu_ps(coefficients(at[2].segment, c));
+				__m128 d = _mm_loadu_ps(coefficients(at[3].segment, c));
+				_MM_TRANSPOSE4_PS(a, b, q, d);
+				const __m128 value = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a, u), b), u), q), u), d);
+				_mm_store_ps(lanes[c], value);
+			}
+			for (size_t k(0); k < 4; ++k)
+			{
+				float* target = out[i + k].data();
+				for (size_t c(0); c < s_dimension; ++c)
+				{
+					target[c] = lanes[c][k];
+				}
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		out[i] = evaluate(t[i]);
+	}
+}
+
+template <vectortype Vector>
+size_t TCubicCurve<Vector>::tessellate(const size_t stepsPerSegment, Vector* out) const
+{
+	if (empty() || 0 == stepsPerSegment)
+	{
+		return 0;
+	}
+
+	// 每段末点与下一段首点相同，由下一段覆盖
+	Scalar* raw = out[0].data();
+	for (size_t s(0); s < m_segments; ++s)
+	{
+		for (size_t c(0); c < s_dimension; ++c)
+		{
+			cubicForwardDifference(coefficients(s, c), stepsPerSegment,
+				raw + s * stepsPerSegment * s_dimension + c, s_dimension);
+		}
+	}
+	return m_segments * stepsPerSegment + 1;
+}
+
+template <vectortype Vector>
+void TCubicCurve<Vector>::buildArcLengthTable(const size_t samplesPerSegment)
+{
+	m_arcLengths.clear();
+	m_samplesPerSegment = 0;
+	if (empty() || 0 == samplesPerSegment)
+	{
+		return;
+	}
+
+	std::vector<Vector> points(m_segments * samplesPerSegment + 1);
+	tessellate(samplesPerSegment, points.data());
+	m_arcLengths.resize(points.size());
+	m_arcLengths[0] = Scalar(0);
+	// 弦长很多时 float 逐项累加误差明显，累加器用 double
+	double total(0);
+	for (size_t i(1); i < points.size(); ++i)
+	{
+		Scalar squared(0);
+		for (size_t c(0); c < s_dimension; ++c)
+		{
+			const Scalar delta = points[i].data()[c] - points[i - 1].data()[c];
+			squared += delta * delta;
+		}
+		total += static_cast<double>(std::sqrt(squared));
+		m_arcLengths[i] = static_cast<Scalar>(total);
+	}
+	m_samplesPerSegment = samplesPerSegment;
+}
+
+template <vectortype Vector>
+typename TCubicCurve<Vector>::Scalar TCubicCurve<Vector>::length() const
+{
+	return m_arcLengths.empty() ? Scalar(0) : m_arcLengths.back();
+}
+
+template <vectortype Vector>
+typename TCubicCurve<Vector>::Scalar TCubicCurve<Vector>::parameterAtLength(const Scalar s) const
+{
+	if (m_arcLengths.empty())
+	{
+		return Scalar(0);
+	}
+
+	const auto upper = std::upper_bound(m_arcLengths.begin() + 1, m_arcLengths.end() - 1, s);
+	const size_t i = static_cast<size_t>(upper - m_arcLengths.begin()) - 1;
+	const Scalar span = m_arcLengths[i + 1] - m_arcLengths[i];
+	Scalar fraction = span > Scalar(0) ? (s - m_arcLengths[i]) / span : Scalar(0);
+	fraction = fraction > Scalar(0) ? (fraction < Scalar(1) ? fraction : Scalar(1)) : Scalar(0);
+	return (static_cast<Scalar>(i) + fraction) / static_cast<Scalar>(m_samplesPerSegment);
+}
+
+template <vectortype Vector>
+void TCubicCurve<Vector>::sampleUniform(const size_t count, Vector* out) const
+{
+	if (0 == count)
+	{
+		return;
+	}
+
+	std::vector<Scalar> parameters(count);
+	const Scalar denominator = count > 1 ? static_cast<Scalar>(count - 1) : Scalar(1);
+	if (m_arcLengths.empty())
+	{
+		for (size_t i(0); i < count; ++i)
+		{
+			parameters[i] = static_cast<Scalar>(m_segments) * static_cast<Scalar>(i) / denominator;
+		}
+	}
+	else
+	{
+		// 目标弧长单调递增，表项下标只需向前推进
+		const Scalar total = length();
+		size_t j(0);
+		for (size_t i(0); i < count; ++i)
+		{
+			const Scalar s = total * static_cast<Scalar>(i) / denominator;
+			while (j + 2 < m_arcLengths.size() && m_arcLengths[j + 1] <= s)
+			{
+				++j;
+			}
+			const Scalar span = m_arcLengths[j + 1] - m_arcLengths[j];
+			Scalar fraction = span > Scalar(0) ? (s - m_arcLengths[j]) / span : Scalar(0);
+			fraction = fraction > Scalar(0) ? (fraction < Scalar(1) ? fraction : Scalar(1)) : Scalar(0);
+			parameters[i] = (static_cast<Scalar>(j) + fraction) / static_cast<Scalar>(m_samplesPerSegment);
+		}
+	}
+	evaluate(parameters.data(), count, out);
+}
+
+template <vectortype Vector>
+void TBicubicPatch<Vector>::set(const CurveBasis basis, const Vector* points)
+{
+	const std::array<Scalar, 16> m = cubicBasisMatrix<Scalar>(basis);
+	for (size_t c(0); c < s_dimension; ++c)
+	{
+		// t = M * G，再右乘 M^T
+		Scalar t[4][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			for (size_t col(0); col < 4; ++col)
+			{
+				t[k][col] = Scalar(0);
+				for (size_t row(0); row < 4; ++row)
+				{
+					t[k][col] += m[4 * k + row] * points[4 * row + col].data()[c];
+				}
+			}
+		}
+		for (size_t k(0); k < 4; ++k)
+		{
+			for (size_t l(0); l < 4; ++l)
+			{
+				Scalar sum(0);
+				for (size_t col(0); col < 4; ++col)
+				{
+					sum += t[k][col] * m[4 * l + col];
+				}
+				m_coefficients[c][k][l] = sum;
+			}
+		}
+	}
+}
+
+template <vectortype Vector>
+Vector TBicubicPatch<Vector>::evaluate(const Scalar u, const Scalar v) const
+{
+	Vector result;
+	for (size_t c(0); c < s_dimension; ++c)
+	{
+		Scalar value(0);
+		for (size_t k(0); k < 4; ++k)
+		{
+			const std::array<Scalar, 4>& row = m_coefficients[c][k];
+			value = value * v + (((row[0] * u + row[1]) * u + row[2]) * u + row[3]);
+		}
+		result.data()[c] = value;
+	}
+	return result;
+}
+
+template <vectortype Vector>
+size_t TBicubicPatch<Vector>::tessellate(const size_t uSteps, const size_t vSteps, Vector* positions,
+	Vector* normals) const
+{
+	if (0 == uSteps || 0 == vSteps)
+	{
+		return 0;
+	}
+
+	const size_t columns = uSteps + 1;
+	std::vector<Scalar> du;
+	std::vector<Scalar> dv;
+	const bool withNormals = 3 == s_dimension && nullptr != normals;
+	if (withNormals)
+	{
+		du.resize(columns * s_dimension);
+		dv.resize(columns * s_dimension);
+	}
+
+	for (size_t j(0); j <= vSteps; ++j)
+	{
+		const Scalar v = static_cast<Scalar>(j) / static_cast<Scalar>(vSteps);
+		Scalar* row = positions[j * columns].data();
+		for (size_t c(0); c < s_dimension; ++c)
+		{
+			// 固定 v 后关于 u 的三次多项式，以及它对 u、对 v 的导数多项式
+			Scalar p[4];
+			Scalar pv[4];
+			for (size_t l(0); l < 4; ++l)
+			{
+				const auto& k = m_coefficients[c];
+				p[l] = ((k[0][l] * v + k[1][l]) * v + k[2][l]) * v + k[3][l];
+				pv[l] = (Scalar(3) * k[0][l] * v + Scalar(2) * k[1][l]) * v + k[2][l];
+			}
+			cubicForwardDifference(p, uSteps, row + c, s_dimension);
+			if (withNormals)
+			{
+				const Scalar pu[4] = { Scalar(0), Scalar(3) * p[0], Scalar(2) * p[1], p[2] };
+				cubicForwardDifference(pu, uSteps, du.data() + c, s_dimension);
+				cubicForwardDifference(pv, uSteps, dv.data() + c, s_dimension);
+			}
+		}
+
+		if constexpr (3 == s_dimension)
+		{
+			for (size_t i(0); withNormals && i < columns; ++i)
+			{
+				const Scalar* a = du.data() + i * s_dimension;
+				const Scalar* b = dv.data() + i * s_dimension;
+				Scalar n[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+				const Scalar squared = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+				const Scalar scale = squared > Scalar(0) ? Scalar(1) / std::sqrt(squared) : Scalar(0);
+				Scalar* target = normals[j * columns + i].data();
+				for (size_t c(0); c < 3; ++c)
+				{
+					target[c] = n[c] * scale;
+				}
+			}
+		}
+	}
+	return columns * (vSteps + 1);
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,608 @@
+#ifndef __TSWEEP_AND_PRUNE_HPP__
+#define __TSWEEP_AND_PRUNE_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 重叠的包围盒对，first < second，为 update 输入中的下标
+ */
+struct BroadphasePair
+{
+	uint32_t first;
+	uint32_t second;
+};
+
+/*!
+ * 网格分区的扫掠裁剪（sweep and prune）宽相位
+ * 扫掠轴取包围盒中心方差最大的轴，另外两个轴（次轴）划分为均匀网格，包围盒放入它覆盖的每个格子；
+ * 每个格子内包围盒按扫掠轴上的最小值排序，只需向后扫描最小值不超过自身最大值的包围盒，再测试两个次轴
+ * 次轴数据按 SoA 存放，float + SSE2 下一次测试 4 个候选；一对包围盒只在两者次轴最小值所在的格子中报告
+ * 帧间连贯时排序结果几乎不变：update 沿用上一帧的全局顺序做插入排序（移动次数过多时改为整体排序），
+ * 再按该顺序稳定地分发到格子，因此格子内无需再排序
+ * 其他轴的中心方差明显超过当前扫掠轴时才切换，切换后整体排序
+ * 包围盒的各轴区间为闭区间，相接即视为重叠
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TSweepAndPrune
+{
+public:
+	using Vector3 = TVector3<T, P>;
+
+	TSweepAndPrune() = default;
+
+	/**
+	 * @brief 更新全部包围盒；数量与上一次不同时重新建立排序
+	 * @param minimum 各包围盒的最小角
+	 * @param maximum 各包围盒的最大角
+	 * @param count 包围盒数，需小于 2^32
+	 * @param pool 线程池，校验统计、取数与填充格子按块并行
+	 * @return 数量超出范围、有包围盒不满足 minimum <= maximum（含 NaN）或含无穷时返回 false，状态清空
+	 */
+	bool update(const Vector3* minimum, const Vector3* maximum, const size_t count,
+		ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 清空状态，下一次 update 整体排序
+	 */
+	void clear();
+
+	size_t size() const;
+
+	/**
+	 * @brief 当前扫掠轴，0 / 1 / 2 对应 x / y / z
+	 */
+	size_t axis() const;
+
+	/**
+	 * @brief 次轴网格的格子数
+	 */
+	size_t cellCount() const;
+
+	/**
+	 * @brief 上一次 update 的插入排序移动次数，整体排序时为 0
+	 */
+	size_t moveCount() const;
+
+	/**
+	 * @brief 求出全部重叠的包围盒对
+	 * @param pairs 输出，先清空；顺序只取决于包围盒及其排序，与线程数无关
+	 * @param pool 线程池，按格子数据的区间分块并行，各块结果依次拼接
+	 * @return 重叠对数
+	 */
+	size_t findPairs(std::vector<BroadphasePair>& pairs, ThreadPool& pool = ThreadPool::instance());
+
+private:
+	static constexpr size_t s_grain = 4096;
+	static constexpr size_t s_padding = 4;
+	// 插入排序移动次数超过 s_maxMovesPerBox * count 时放弃，改为整体排序
+	static constexpr size_t s_maxMovesPerBox = 8;
+	// 其他轴的中心方差超过当前轴的倍数时才切换扫掠轴
+	static constexpr double s_axisHysteresis = 2.0;
+	// 格子边长为包围盒平均尺寸的倍数，格子平均至少容纳 s_minBoxesPerCell 个包围盒
+	static constexpr double s_cellScale = 4.0;
+	static constexpr size_t s_maxCellsPerAxis = 1024;
+	static constexpr size_t s_minBoxesPerCell = 16;
+
+	/*!
+	 * 一段包围盒的统计：范围、各轴尺寸之和、中心之和与中心平方和
+	 */
+	struct Statistics
+	{
+		T lower[3];
+		T upper[3];
+		double extent[3];
+		double sum[3];
+		double squared[3];
+		bool valid;
+	};
+
+	static Statistics statistics(const Vector3* minimum, const Vector3* maximum, const size_t first, const size_t last);
+
+	bool insertionSort(const Vector3* minimum);
+	void fullSort(const Vector3* minimum);
+	void buildCells(const Vector3* minimum, const Vector3* maximum, const Statistics& bounds, ThreadPool& pool);
+	void sweep(const size_t begin, const size_t end, std::vector<BroadphasePair>& pairs) const;
+	void emit(const size_t i, const size_t j, std::vector<BroadphasePair>& pairs) const;
+
+private:
+	size_t m_count = 0;
+	size_t m_axis = 0;
+	size_t m_moves = 0;
+	size_t m_cells = 0;
+	// 按扫掠轴最小值排序后的包围盒下标及其排序键
+	std::vector<uint32_t> m_order;
+	std::vector<T> m_keys;
+	// 按排序顺序的各包围盒：扫掠轴最大值与两个次轴的区间，及其覆盖的格子范围 [a0, a1] x [b0, b1]
+	std::vector<std::array<T, 5>> m_sorted;
+	std::vector<std::array<uint32_t, 4>> m_spans;
+	std::vector<size_t> m_cellCursor;
+	// 各条目对应的排序位置，填充项为 UINT32_MAX
+	std::vector<uint32_t> m_sources;
+	// 各格子的条目依次存放，每个格子及整体末尾各留 s_padding 个填充（最小值为正无穷，最大值为负无穷）
+	std::vector<T> m_entryKeys;
+	std::vector<T> m_entryMaxKeys;
+	std::vector<T> m_minA;
+	std::vector<T> m_maxA;
+	std::vector<T> m_minB;
+	std::vector<T> m_maxB;
+	// 第 0 位：包围盒在次轴 A 上从本格开始；第 1 位：在次轴 B 上从本格开始
+	std::vector<int32_t> m_flags;
+	std::vector<uint32_t> m_boxes;
+	std::vector<Statistics> m_statistics;
+	std::vector<std::vector<BroadphasePair>> m_chunkPairs;
+};
+
+template <floattype T, CheckPolicy P>
+bool TSweepAndPrune<T, P>::update(const Vector3* minimum, const Vector3* maximum, const size_t count,
+	ThreadPool& pool)
+{
+	if (!checkCondition<P>(count < UINT32_MAX && (0 == count || (nullptr != minimum && nullptr != maximum))))
+	{
+		clear();
+		return false;
+	}
+
+	// 分块并行校验并统计范围、平均尺寸与各轴中心的方差，按块的顺序合并
+	const size_t chunkCount = (count + s_grain - 1) / s_grain;
+	m_statistics.resize(chunkCount);
+	pool.parallelFor(0, chunkCount, 1, [=, this](size_t begin, size_t end)
+	{
+		for (size_t c(begin); c < end; ++c)
+		{
+			m_statistics[c] = statistics(minimum, maximum, c * s_grain, std::min(count, (c + 1) * s_grain));
+		}
+	});
+	Statistics bounds{};
+	bounds.valid = true;
+	if (chunkCount > 0)
+	{
+		bounds = m_statistics[0];
+	}
+	for (size_t c(1); c < chunkCount; ++c)
+	{
+		const Statistics& chunk = m_statistics[c];
+		bounds.valid = bounds.valid && chunk.valid;
+		for (size_t a(0); a < 3; ++a)
+		{
+			bounds.lower[a] = std::min(bounds.lower[a], chunk.lower[a]);
+			bounds.upper[a] = std::max(bounds.upper[a], chunk.upper[a]);
+			bounds.extent[a] += chunk.extent[a];
+			bounds.sum[a] += chunk.sum[a];
+			bounds.squared[a] += chunk.squared[a];
+		}
+	}
+	for (size_t a(0); a < 3; ++a)
+	{
+		bounds.valid = bounds.valid && std::isfinite(bounds.lower[a]) && std::isfinite(bounds.upper[a]);
+	}
+	if (!checkCondition<P>(bounds.valid))
+	{
+		clear();
+		return false;
+	}
+
+	size_t best(m_axis);
+	double variance[3];
+	for (size_t a(0); a < 3; ++a)
+	{
+		const double mean = count > 0 ? bounds.sum[a] / static_cast<double>(count) : 0.0;
+		variance[a] = count > 0 ? bounds.squared[a] / static_cast<double>(count) - mean * mean : 0.0;
+		if (variance[a] > variance[best])
+		{
+			best = a;
+		}
+	}
+
+	const bool rebuild = count != m_count || variance[best] > s_axisHysteresis * variance[m_axis];
+	m_count = count;
+	if (rebuild)
+	{
+		m_axis = best;
+		fullSort(minimum);
+	}
+	else if (!insertionSort(minimum))
+	{
+		fullSort(minimum);
+	}
+
+	buildCells(minimum, maximum, bounds, pool);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+typename TSweepAndPrune<T, P>::Statistics TSweepAndPrune<T, P>::statistics(const Vector3* minimum,
+	const Vector3* maximum, const size_t first, const size_t last)
+{
+	Statistics result{};
+	result.valid = true;
+	for (size_t a(0); a < 3; ++a)
+	{
+		result.lower[a] = minimum[first].data()[a];
+		result.upper[a] = maximum[first].data()[a];
+	}
+	for (size_t i(first); i < last; ++i)
+	{
+		const T* lo = minimum[i].data();
+		const T* hi = maximum[i].data();
+		result.valid = result.valid && lo[0] <= hi[0] && lo[1] <= hi[1] && lo[2] <= hi[2];
+		for (size_t a(0); a < 3; ++a)
+		{
+			result.lower[a] = std::min(result.lower[a], lo[a]);
+			result.upper[a] = std::max(result.upper[a], hi[a]);
+			const double l = static_cast<double>(lo[a]);
+			const double h = static_cast<double>(hi[a]);
+			result.extent[a] += h - l;
+			result.sum[a] += 0.5 * (l + h);
+			result.squared[a] += 0.25 * (l + h) * (l + h);
+		}
+	}
+	return result;
+}
+
+template <floattype T, CheckPolicy P>
+void TSweepAndPrune<T, P>::clear()
+{
+	m_count = 0;
+	m_moves = 0;
+	m_cells = 0;
+	m_order.clear();
+	m_keys.clear();
+	m_sorted.clear();
+	m_spans.clear();
+	m_cellCursor.clear();
+	m_sources.clear();
+	m_entryKeys.clear();
+	m_entryMaxKeys.clear();
+	m_minA.clear();
+	m_maxA.clear();
+	m_minB.clear();
+	m_maxB.clear();
+	m_flags.clear();
+	m_boxes.clear();
+}
+
+template <floattype T, CheckPolicy P>
+size_t TSweepAndPrune<T, P>::size() const
+{
+	return m_count;
+}
+
+template <floattype T, CheckPolicy P>
+size_t TSweepAndPrune<T, P>::axis() const
+{
+	return m_axis;
+}
+
+template <floattype T, CheckPolicy P>
+size_t TSweepAndPrune<T, P>::cellCount() const
+{
+	return m_cells;
+}
+
+template <floattype T, CheckPolicy P>
+size_t TSweepAndPrune<T, P>::moveCount() const
+{
+	return m_moves;
+}
+
+template <floattype T, CheckPolicy P>
+bool TSweepAndPrune<T, P>::insertionSort(const Vector3* minimum)
+{
+	const size_t limit = s_maxMovesPerBox * m_count;
+	m_keys.resize(m_count);
+	for (size_t i(0); i < m_count; ++i)
+	{
+		m_keys[i] = minimum[m_order[i]].data()[m_axis];
+	}
+
+	size_t moves(0);
+	for (size_t i(1); i < m_count; ++i)
+	{
+		const T key = m_keys[i];
+		if (!(key < m_keys[i - 1]))
+		{
+			continue;
+		}
+		const uint32_t index = m_order[i];
+		size_t j(i);
+		do
+		{
+			m_keys[j] = m_keys[j - 1];
+			m_order[j] = m_order[j - 1];
+			--j;
+		} while (j > 0 && key < m_keys[j - 1]);
+		m_keys[j] = key;
+		m_order[j] = index;
+
+		moves += i - j;
+		if (moves > limit)
+		{
+			return false;
+		}
+	}
+	m_moves = moves;
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+void TSweepAndPrune<T, P>::fullSort(const Vector3* minimum)
+{
+	const size_t axis = m_axis;
+	m_order.resize(m_count);
+	std::iota(m_order.begin(), m_order.end(), uint32_t(0));
+	std::sort(m_order.begin(), m_order.end(), [minimum, axis](const uint32_t lhs, const uint32_t rhs)
+	{
+		const T l = minimum[lhs].data()[axis];
+		const T r = minimum[rhs].data()[axis];
+		return l < r || (l == r && lhs < rhs);
+	});
+	m_keys.resize(m_count);
+	for (size_t i(0); i < m_count; ++i)
+	{
+		m_keys[i] = minimum[m_order[i]].data()[axis];
+	}
+	m_moves = 0;
+}
+
+template <floattype T, CheckPolicy P>
+void TSweepAndPrune<T, P>::buildCells(const Vector3* minimum, const Vector3* maximum, const Statistics& bounds,
+	ThreadPool& pool)
+{
+	// 次轴网格：格子边长取包围盒平均尺寸的 s_cellScale 倍，格子总数不超过 count / s_minBoxesPerCell
+	// 范围小到 cells / range 在 T 中溢出为无穷（如非规格化数）时，0 * inf 会得到 NaN，该轴只用一个格子
+	const double minRange = static_cast<double>(s_maxCellsPerAxis) / static_cast<double>(std::numeric_limits<T>::max());
+	const size_t axes[2] = { (m_axis + 1) % 3, (m_axis + 2) % 3 };
+	size_t cells[2];
+	double range[2];
+	for (size_t k(0); k < 2; ++k)
+	{
+		const size_t a = axes[k];
+		range[k] = static_cast<double>(bounds.upper[a]) - static_cast<double>(bounds.lower[a]);
+		const double average = m_count > 0 ? bounds.extent[a] / static_cast<double>(m_count) : 0.0;
+		const double cell = std::max(s_cellScale * average, range[k] / static_cast<double>(s_maxCellsPerAxis));
+		cells[k] = cell > 0.0 && range[k] >= minRange
+			? std::clamp(static_cast<size_t>(std::ceil(range[k] / cell)), size_t(1), s_maxCellsPerAxis) : 1;
+	}
+	const size_t capacity = std::max(size_t(1), m_count / s_minBoxesPerCell);
+	while (cells[0] * cells[1] > capacity)
+	{
+		size_t& larger = cells[0] >= cells[1] ? cells[0] : cells[1];
+		larger = (larger + 1) / 2;
+	}
+	m_cells = cells[0] * cells[1];
+
+	// 格子号只要求随坐标单调不减（同一包围盒总得到同一结果），按 T 计算即可
+	T origin[2];
+	T inverse[2];
+	T last[2];
+	for (size_t k(0); k < 2; ++k)
+	{
+		origin[k] = bounds.lower[axes[k]];
+		inverse[k] = cells[k] > 1 ? static_cast<T>(static_cast<double>(cells[k]) / range[k]) : T(0);
+		last[k] = static_cast<T>(cells[k] - 1);
+	}
+	const auto cellOf = [&](const T value, const size_t k)
+	{
+		const T position = (value - origin[k]) * inverse[k];
+		return static_cast<uint32_t>(static_cast<int32_t>(std::clamp(position, T(0), last[k])));
+	};
+
+	// 按排序顺序取出包围盒（输入只随机访问这一次）并求出覆盖的格子，再统计各格子的条目数
+	m_sorted.resize(m_count);
+	m_spans.resize(m_count);
+	pool.parallelFor(0, m_count, s_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			const T* lo = minimum[m_order[i]].data();
+			const T* hi = maximum[m_order[i]].data();
+			m_sorted[i] = { hi[m_axis], lo[axes[0]], hi[axes[0]], lo[axes[1]], hi[axes[1]] };
+			m_spans[i] = { cellOf(lo[axes[0]], 0), cellOf(hi[axes[0]], 0), cellOf(lo[axes[1]], 1), cellOf(hi[axes[1]], 1) };
+		}
+	});
+	m_cellCursor.assign(m_cells, 0);
+	for (size_t i(0); i < m_count; ++i)
+	{
+		const std::array<uint32_t, 4>& span = m_spans[i];
+		for (uint32_t b(span[2]); b <= span[3]; ++b)
+		{
+			for (uint32_t a(span[0]); a <= span[1]; ++a)
+			{
+				++m_cellCursor[b * cells[0] + a];
+			}
+		}
+	}
+	size_t total(0);
+	for (size_t c(0); c < m_cells; ++c)
+	{
+		const size_t entries = m_cellCursor[c];
+		m_cellCursor[c] = total;
+		total += entries + s_padding;
+	}
+	total += s_padding;
+
+	// 先只分发排序位置与标志（按全局顺序分发，格子内自然有序），再顺序填充条目，避免同时向各格子写多路数据
+	m_sources.assign(total, UINT32_MAX);
+	m_flags.assign(total, 0);
+	for (size_t i(0); i < m_count; ++i)
+	{
+		const std::array<uint32_t, 4>& span = m_spans[i];
+		for (uint32_t b(span[2]); b <= span[3]; ++b)
+		{
+			for (uint32_t a(span[0]); a <= span[1]; ++a)
+			{
+				const size_t e = m_cellCursor[b * cells[0] + a]++;
+				m_sources[e] = static_cast<uint32_t>(i);
+				m_flags[e] = (a == span[0] ? 1 : 0) | (b == span[2] ? 2 : 0);
+			}
+		}
+	}
+
+	m_entryKeys.resize(total);
+	m_entryMaxKeys.resize(total);
+	m_minA.resize(total);
+	m_maxA.resize(total);
+	m_minB.resize(total);
+	m_maxB.resize(total);
+	m_boxes.resize(total);
+	pool.parallelFor(0, total, s_grain, [this](size_t begin, size_t end)
+	{
+		for (size_t e(begin); e < end; ++e)
+		{
+			const uint32_t source = m_sources[e];
+			if (UINT32_MAX == source)
+			{
+				m_entryKeys[e] = std::numeric_limits<T>::infinity();
+				m_entryMaxKeys[e] = -std::numeric_limits<T>::infinity();
+				m_minA[e] = m_maxA[e] = m_minB[e] = m_maxB[e] = T(0);
+				m_boxes[e] = 0;
+				continue;
+			}
+			const std::array<T, 5>& box = m_sorted[source];
+			m_entryKeys[e] = m_keys[source];
+			m_entryMaxKeys[e] = box[0];
+			m_minA[e] = box[1];
+			m_maxA[e] = box[2];
+			m_minB[e] = box[3];
+			m_maxB[e] = box[4];
+			m_boxes[e] = m_order[source];
+		}
+	});
+}
+
+template <floattype T, CheckPolicy P>
+size_t TSweepAndPrune<T, P>::findPairs(std::vector<BroadphasePair>& pairs, ThreadPool& pool)
+{
+	pairs.clear();
+	if (m_count < 2)
+	{
+		return 0;
+	}
+
+	const size_t entries = m_entryKeys.size() - s_padding;
+	const size_t chunkCount = (entries + s_grain - 1) / s_grain;
+	if (m_chunkPairs.size() < chunkCount)
+	{
+		m_chunkPairs.resize(chunkCount);
+	}
+	pool.parallelFor(0, chunkCount, 1, [=, this](size_t begin, size_t end)
+	{
+		for (size_t c(begin); c < end; ++c)
+		{
+			m_chunkPairs[c].clear();
+			sweep(c * s_grain, std::min(entries, (c + 1) * s_grain), m_chunkPairs[c]);
+		}
+	});
+
+	size_t total(0);
+	for (size_t c(0); c < chunkCount; ++c)
+	{
+		total += m_chunkPairs[c].size();
+	}
+	pairs.reserve(total);
+	for (size_t c(0); c < chunkCount; ++c)
+	{
+		pairs.insert(pairs.end(), m_chunkPairs[c].begin(), m_chunkPairs[c].end());
+	}
+	return total;
+}
+
+template <floattype T, CheckPolicy P>
+void TSweepAndPrune<T, P>::emit(const size_t i, const size_t j, std::vector<BroadphasePair>& pairs) const
+{
+	const uint32_t lhs = m_boxes[i];
+	const uint32_t rhs = m_boxes[j];
+	pairs.push_back(lhs < rhs ? BroadphasePair{ lhs, rhs } : BroadphasePair{ rhs, lhs });
+}
+
+template <floattype T, CheckPolicy P>
+void TSweepAndPrune<T, P>::sweep(const size_t begin, const size_t end, std::vector<BroadphasePair>& pairs) const
+{
+	// 填充项作为 i 时最大值为负无穷，作为 j 时最小值为正无穷，扫描都不会越过格子末尾
+	const T* keys = m_entryKeys.data();
+	const T* minA = m_minA.data();
+	const T* maxA = m_maxA.data();
+	const T* minB = m_minB.data();
+	const T* maxB = m_maxB.data();
+	const int32_t* flags = m_flags.data();
+
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float>)
+	{
+		const __m128i owned = _mm_set1_epi32(3);
+		for (size_t i(begin); i < end; ++i)
+		{
+			const __m128 limit = _mm_set1_ps(m_entryMaxKeys[i]);
+			const __m128 loA = _mm_set1_ps(minA[i]);
+			const __m128 hiA = _mm_set1_ps(maxA[i]);
+			const __m128 loB = _mm_set1_ps(minB[i]);
+			const __m128 hiB = _mm_set1_ps(maxB[i]);
+			const __m128i flagI = _mm_set1_epi32(flags[i]);
+			for (size_t j(i + 1);; j += 4)
+			{
+				// 键已排序且填充不少于 4 个，4 个候选中超出范围的必然在末尾
+				const __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(keys + j), limit);
+				const int rangeMask = _mm_movemask_ps(inRange);
+				if (0 == rangeMask)
+				{
+					break;
+				}
+				__m128 overlap = _mm_and_ps(inRange, _mm_cmple_ps(_mm_loadu_ps(minA + j), hiA));
+				overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(maxA + j), loA));
+				overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(minB + j), hiB));
+				overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(maxB + j), loB));
+				const __m128i flagJ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + j));
+				overlap = _mm_and_ps(overlap, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_or_si128(flagI, flagJ), owned)));
+				unsigned mask = static_cast<unsigned>(_mm_movemask_ps(overlap));
+				while (0 != mask)
+				{
+					emit(i, j + static_cast<size_t>(std::countr_zero(mask)), pairs);
+					mask &= mask - 1;
+				}
+				if (0xF != rangeMask)
+				{
+					break;
+				}
+			}
+		}
+		return;
+	}
+#endif
+
+	for (size_t i(begin); i < end; ++i)
+	{
+		const T limit = m_entryMaxKeys[i];
+		const T loA = minA[i], hiA = maxA[i], loB = minB[i], hiB = maxB[i];
+		const int32_t flagI = flags[i];
+		for (size_t j(i + 1); keys[j] <= limit; ++j)
+		{
+			if (minA[j] <= hiA && maxA[j] >= loA && minB[j] <= hiB && maxB[j] >= loB && 3 == (flagI | flags[j]))
+			{
+				emit(i, j, pairs);
+			}
+		}
+	}
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef __VECTOR_PARSER_H__
+#define __VECTOR_PARSER_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVectorTraits.hpp"
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * OBJ 顶点数据的种类
+ */
+enum class ObjElement
+{
+	Position,	// v x y z [w]，w 缺省为 1
+	Normal,		// vn x y z
+	TexCoord	// vt u [v [w]]，缺省为 0
+};
+
+/*!
+ * ASCII 向量数据解析（OBJ / ASCII PLY / XYZ / CSV），结果直接写入 TVector2/3/4 或 TVector<N> 数组
+ * 文本按行对齐切成约 1MB 的块：第一遍并行统计每块的记录数，前缀和确定每块的写入位置，
+ * 第二遍并行用 std::from_chars 解析并直接写入输出数组，逐行不分配内存，结果与线程数无关
+ * 文件接口按 64MB 的块流式读取，内存占用与文件大小无关（输出除外）
+ * 字段以空白、逗号或分号分隔，支持 \r\n 行尾；多余字段忽略，格式错误时返回 false 且输出为空
+ */
+class MATH_API VectorParser
+{
+public:
+	/**
+	 * @brief 解析 OBJ 中的 v / vn / vt 行，其余行忽略
+	 * @param text 文本
+	 * @param size 文本字节数
+	 * @param element 顶点数据种类
+	 * @param out 输出向量，维数取自 Vector，缺少的分量按 ObjElement 的缺省值补齐
+	 * @return 成功返回 true
+	 */
+	template <typename Vector>
+	static bool parseObj(const char* text, const size_t size, const ObjElement element, std::vector<Vector>& out);
+
+	/**
+	 * @brief 解析每行一个向量的文本（XYZ、CSV），空行与 # 开头的行忽略
+	 * @param headerLines 开头跳过的行数（如 CSV 表头）
+	 */
+	template <typename Vector>
+	static bool parseRows(const char* text, const size_t size, const size_t headerLines, std::vector<Vector>& out);
+
+	/**
+	 * @brief 解析 ASCII PLY 的 vertex 元素
+	 * @param properties 依次取出的属性名，个数等于向量维数，如 { "x", "y", "z" }
+	 * @return 二进制格式、属性缺失或顶点行数不足时返回 false
+	 */
+	template <typename Vector>
+	static bool parsePly(const char* text, const size_t size, const std::vector<std::string>& properties,
+		std::vector<Vector>& out);
+
+	/**
+	 * @brief 文件版本，参数含义同上
+	 * @param path 文件路径，无法打开时返回 false
+	 */
+	template <typename Vector>
+	static bool parseObjFile(const std::string& path, const ObjElement element, std::vector<Vector>& out);
+
+	template <typename Vector>
+	static bool parseRowsFile(const std::string& path, const size_t headerLines, std::vector<Vector>& out);
+
+	template <typename Vector>
+	static bool parsePlyFile(const std::string& path, const std::vector<std::string>& properties,
+		std::vector<Vector>& out);
+
+private:
+	enum class Format
+	{
+		Obj,
+		Rows,
+		Ply
+	};
+
+	struct Options
+	{
+		Format format;
+		size_t dimension;
+		ObjElement element;
+		size_t headerLines;
+		const std::vector<std::string>* properties;
+	};
+
+	/*!
+	 * 输出缓冲：append 在末尾扩展 components 个分量并返回写入位置
+	 */
+	template <typename Scalar>
+	struct Output
+	{
+		void* target;
+		Scalar* (*append)(void* target, const size_t components);
+	};
+
+	static bool parseText(const char* text, const size_t size, const Options& options, const Output<float>& out);
+	static bool parseText(const char* text, const size_t size, const Options& options, const Output<double>& out);
+	static bool parseFile(const std::string& path, const Options& options, const Output<float>& out);
+	static bool parseFile(const std::string& path, const Options& options, const Output<double>& out);
+
+	template <typename Vector>
+	static Output<typename TVectorTraits<Vector>::Scalar> output(std::vector<Vector>& out);
+};
+
+template <typename Vector>
+VectorParser::Output<typename TVectorTraits<Vector>::Scalar> VectorParser::output(std::vector<Vector>& out)
+{
+	using Scalar = typename TVectorTraits<Vector>::Scalar;
+	static_assert(floattype<Scalar>, "floating point vector required");
+	static_assert(sizeof(Vector) == TVectorTraits<Vector>::s_size * sizeof(Scalar), "vector must be tightly packed");
+
+	out.clear();
+	return { &out, [](void* target, const size_t components) -> Scalar*
+	{
+		std::vector<Vector>& vec = *static_cast<std::vector<Vector>*>(target);
+		const size_t first = vec.size();
+		vec.resize(first + components / TVectorTraits<Vector>::s_size);
+		return reinterpret_cast<Scalar*>(vec.data() + first);
+	} };
+}
+
+template <typename Vector>
+bool VectorParser::parseObj(const char* text, const size_t size, const ObjElement element, std::vector<Vector>& out)
+{
+	const Options options{ Format::Obj, TVectorTraits<Vector>::s_size, element, 0, nullptr };
+	const bool ok = parseText(text, size, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+template <typename Vector>
+bool VectorParser::parseRows(const char* text, const size_t size, const size_t headerLines, std::vector<Vector>& out)
+{
+	const Options options{ Format::Rows, TVectorTraits<Vector>::s_size, ObjElement::Position, headerLines, nullptr };
+	const bool ok = parseText(text, size, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+template <typename Vector>
+bool VectorParser::parsePly(const char* text, const size_t size, const std::vector<std::string>& properties,
+	std::vector<Vector>& out)
+{
+	const Options options{ Format::Ply, TVectorTraits<Vector>::s_size, ObjElement::Position, 0, &properties };
+	const bool ok = parseText(text, size, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+template <typename Vector>
+bool VectorParser::parseObjFile(const std::string& path, const ObjElement element, std::vector<Vector>& out)
+{
+	const Options options{ Format::Obj, TVectorTraits<Vector>::s_size, element, 0, nullptr };
+	const bool ok = parseFile(path, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+template <typename Vector>
+bool VectorParser::parseRowsFile(const std::string& path, const size_t headerLines, std::vector<Vector>& out)
+{
+	const Options options{ Format::Rows, TVectorTraits<Vector>::s_size, ObjElement::Position, headerLines, nullptr };
+	const bool ok = parseFile(path, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+template <typename Vector>
+bool VectorParser::parsePlyFile(const std::string& path, const std::vector<std::string>& properties,
+	std::vector<Vector>& out)
+{
+	const Options options{ Format::Ply, TVectorTraits<Vector>::s_size, ObjElement::Position, 0, &properties };
+	const bool ok = parseFile(path, options, output(out));
+	if (!ok)
+	{
+		out.clear();
+	}
+	return ok;
+}
+
+END_NAMESPACE
+
+#endif
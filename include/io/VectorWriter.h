@@ -0,0 +1,162 @@
+#ifndef __VECTOR_WRITER_H__
+#define __VECTOR_WRITER_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVectorTraits.hpp"
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 向量数组的文本输出，每个向量一行："<prefix>x<sep>y<sep>z\n"
+ * 分量用 std::to_chars 输出最短且可精确往返的十进制表示，不分配逐行内存
+ * 按块并行格式化到有界的暂存区（约 16 块一个窗口），再按顺序拷贝到调用方缓冲区或写入文件，结果与线程数无关
+ */
+class MATH_API VectorWriter
+{
+public:
+	/**
+	 * @brief 输出单个向量（不含前缀与换行）
+	 * @param first 缓冲区起点
+	 * @param last 缓冲区终点
+	 * @param vec 向量
+	 * @param separator 分量分隔符
+	 * @return 同 std::to_chars，空间不足时 ec 为 errc::value_too_large
+	 */
+	template <typename Vector>
+	static std::to_chars_result toChars(char* first, char* last, const Vector& vec, const char separator = ' ');
+
+	/**
+	 * @brief 输出向量数组到调用方缓冲区
+	 * @param first 缓冲区起点
+	 * @param last 缓冲区终点
+	 * @param vectors 向量
+	 * @param count 向量数
+	 * @param prefix 行首前缀，如 OBJ 的 "v "
+	 * @param separator 分量分隔符
+	 * @return ptr 为写入末尾；空间不足时 ec 为 errc::value_too_large，缓冲区内容不完整
+	 */
+	template <typename Vector>
+	static std::to_chars_result write(char* first, char* last, const Vector* vectors, const size_t count,
+		const std::string_view prefix = {}, const char separator = ' ');
+
+	/**
+	 * @brief 输出向量数组到文件（覆盖），参数含义同上
+	 * @return 无法打开或写入失败时返回 false
+	 */
+	template <typename Vector>
+	static bool writeFile(const std::string& path, const Vector* vectors, const size_t count,
+		const std::string_view prefix = {}, const char separator = ' ');
+
+	/**
+	 * @brief 输出所需字节数的上界，可用于预先分配 write 的缓冲区
+	 */
+	template <typename Vector>
+	static size_t maxLength(const size_t count, const std::string_view prefix = {});
+
+	/**
+	 * @brief 单个分量最短往返表示的最大字符数
+	 */
+	template <typename Scalar>
+	static constexpr size_t maxChars();
+
+private:
+	static std::to_chars_result write(char* first, char* last, const int* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+	static std::to_chars_result write(char* first, char* last, const float* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+	static std::to_chars_result write(char* first, char* last, const double* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+
+	static bool writeFile(const std::string& path, const int* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+	static bool writeFile(const std::string& path, const float* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+	static bool writeFile(const std::string& path, const double* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator);
+
+	template <typename Vector>
+	static const typename TVectorTraits<Vector>::Scalar* components(const Vector* vectors);
+};
+
+template <typename Scalar>
+constexpr size_t VectorWriter::maxChars()
+{
+	// 最短往返表示的最长情形：-2147483648、-1.17549435e-38、-2.2250738585072014e-308
+	if constexpr (std::is_same_v<Scalar, int>)
+	{
+		return 11;
+	}
+	else if constexpr (std::is_same_v<Scalar, float>)
+	{
+		return 15;
+	}
+	else
+	{
+		return 24;
+	}
+}
+
+template <typename Vector>
+const typename TVectorTraits<Vector>::Scalar* VectorWriter::components(const Vector* vectors)
+{
+	using Scalar = typename TVectorTraits<Vector>::Scalar;
+	static_assert(sizeof(Vector) == TVectorTraits<Vector>::s_size * sizeof(Scalar), "vector must be tightly packed");
+	return reinterpret_cast<const Scalar*>(vectors);
+}
+
+template <typename Vector>
+std::to_chars_result VectorWriter::toChars(char* first, char* last, const Vector& vec, const char separator)
+{
+	const auto values = TVectorTraits<Vector>::components(vec);
+	for (size_t i(0); i < values.size(); ++i)
+	{
+		if (i > 0)
+		{
+			if (first == last)
+			{
+				return { last, std::errc::value_too_large };
+			}
+			*first++ = separator;
+		}
+		const std::to_chars_result result = std::to_chars(first, last, values[i]);
+		if (std::errc() != result.ec)
+		{
+			return result;
+		}
+		first = result.ptr;
+	}
+	return { first, std::errc() };
+}
+
+template <typename Vector>
+std::to_chars_result VectorWriter::write(char* first, char* last, const Vector* vectors, const size_t count,
+	const std::string_view prefix, const char separator)
+{
+	return write(first, last, components(vectors), TVectorTraits<Vector>::s_size, count, prefix, separator);
+}
+
+template <typename Vector>
+bool VectorWriter::writeFile(const std::string& path, const Vector* vectors, const size_t count,
+	const std::string_view prefix, const char separator)
+{
+	return writeFile(path, components(vectors), TVectorTraits<Vector>::s_size, count, prefix, separator);
+}
+
+template <typename Vector>
+size_t VectorWriter::maxLength(const size_t count, const std::string_view prefix)
+{
+	constexpr size_t dimension = TVectorTraits<Vector>::s_size;
+	return count * (prefix.size() + dimension * (maxChars<typename TVectorTraits<Vector>::Scalar>() + 1));
+}
+
+END_NAMESPACE
+
+#endif
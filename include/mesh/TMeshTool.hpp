@@ -0,0 +1,305 @@
+#ifndef __TMESH_TOOL_HPP__
+#define __TMESH_TOOL_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include "mesh/VertexAdjacency.h"
+#include "parallel/ThreadPool.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 顶点法线加权方式
+ */
+enum class NormalWeight
+{
+	Uniform,
+	Area,
+	Angle
+};
+
+/*!
+ * 索引三角网格的批量法线/切线计算
+ * 先并行计算每个面的数据，再通过 VertexAdjacency 按顶点并行收集（gather），
+ * 每个顶点只由一个线程写入，无需原子操作或锁
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TMeshTool
+{
+public:
+	using Vector2 = TVector2<T, P>;
+	using Vector3 = TVector3<T, P>;
+	using Vector4 = TVector4<T, P>;
+
+	/**
+	 * @brief 批量计算面法线
+	 * @param positions 顶点位置
+	 * @param indices 三角形索引，长度为 3 * faceCount
+	 * @param faceCount 三角形数
+	 * @param faceNormals 输出面法线（单位长度，退化三角形输出零向量）
+	 */
+	static void computeFaceNormals(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+		Vector3* faceNormals);
+
+	/**
+	 * @brief 批量计算顶点法线
+	 * @param positions 顶点位置
+	 * @param indices 三角形索引
+	 * @param faceCount 三角形数
+	 * @param adjacency 由相同索引构建的邻接表
+	 * @param weight 加权方式
+	 * @param normals 输出顶点法线，长度为 adjacency.vertexCount()
+	 */
+	static void computeVertexNormals(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+		const VertexAdjacency& adjacency, const NormalWeight weight, Vector3* normals);
+
+	/**
+	 * @brief 批量计算顶点切线（MikkTSpace 风格：角度加权、Gram-Schmidt 正交化、w 存储副切线方向）
+	 * @param positions 顶点位置
+	 * @param normals 顶点法线
+	 * @param uvs 顶点纹理坐标
+	 * @param indices 三角形索引
+	 * @param faceCount 三角形数
+	 * @param adjacency 由相同索引构建的邻接表
+	 * @param tangents 输出切线，w 为 1 或 -1
+	 */
+	static void computeTangents(const Vector3* positions, const Vector3* normals, const Vector2* uvs,
+		const uint32_t* indices, const size_t faceCount, const VertexAdjacency& adjacency, Vector4* tangents);
+
+private:
+	static constexpr size_t s_grain = 4096;
+
+	struct FaceData
+	{
+		std::vector<T> x;
+		std::vector<T> y;
+		std::vector<T> z;
+
+		void resize(const size_t count)
+		{
+			x.resize(count);
+			y.resize(count);
+			z.resize(count);
+		}
+	};
+
+	static void faceCrossProducts(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+		FaceData& cross);
+
+	static T cornerAngle(const Vector3* positions, const uint32_t* indices, const uint32_t corner);
+};
+
+template <floattype T, CheckPolicy P>
+void TMeshTool<T, P>::faceCrossProducts(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+	FaceData& cross)
+{
+	cross.resize(faceCount);
+	T* cx = cross.x.data();
+	T* cy = cross.y.data();
+	T* cz = cross.z.data();
+
+	ThreadPool::instance().parallelFor(0, faceCount, s_grain, [=](size_t begin, size_t end)
+	{
+		for (size_t f(begin); f < end; ++f)
+		{
+			const Vector3& p0 = positions[indices[3 * f]];
+			const Vector3& p1 = positions[indices[3 * f + 1]];
+			const Vector3& p2 = positions[indices[3 * f + 2]];
+
+			const T e1x = p1.x() - p0.x(), e1y = p1.y() - p0.y(), e1z = p1.z() - p0.z();
+			const T e2x = p2.x() - p0.x(), e2y = p2.y() - p0.y(), e2z = p2.z() - p0.z();
+
+			// 叉乘长度为面积的两倍，直接作为面积权重
+			cx[f] = e1y * e2z - e1z * e2y;
+			cy[f] = e1z * e2x - e1x * e2z;
+			cz[f] = e1x * e2y - e1y * e2x;
+		}
+	});
+}
+
+template <floattype T, CheckPolicy P>
+T TMeshTool<T, P>::cornerAngle(const Vector3* positions, const uint32_t* indices, const uint32_t corner)
+{
+	const uint32_t face = corner / 3;
+	const uint32_t local = corner % 3;
+	const Vector3& p = positions[indices[3 * face + local]];
+	const Vector3& a = positions[indices[3 * face + (local + 1) % 3]];
+	const Vector3& b = positions[indices[3 * face + (local + 2) % 3]];
+
+	const T ax = a.x() - p.x(), ay = a.y() - p.y(), az = a.z() - p.z();
+	const T bx = b.x() - p.x(), by = b.y() - p.y(), bz = b.z() - p.z();
+	const T denom = std::sqrt((ax * ax + ay * ay + az * az) * (bx * bx + by * by + bz * bz));
+	if (!(denom > T(0)))
+	{
+		return T(0);
+	}
+
+	T c = (ax * bx + ay * by + az * bz) / denom;
+	c = c < T(-1) ? T(-1) : (c > T(1) ? T(1) : c);
+	return std::acos(c);
+}
+
+template <floattype T, CheckPolicy P>
+void TMeshTool<T, P>::computeFaceNormals(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+	Vector3* faceNormals)
+{
+	ThreadPool::instance().parallelFor(0, faceCount, s_grain, [=](size_t begin, size_t end)
+	{
+		for (size_t f(begin); f < end; ++f)
+		{
+			const Vector3& p0 = positions[indices[3 * f]];
+			const Vector3& p1 = positions[indices[3 * f + 1]];
+			const Vector3& p2 = positions[indices[3 * f + 2]];
+
+			const T e1x = p1.x() - p0.x(), e1y = p1.y() - p0.y(), e1z = p1.z() - p0.z();
+			const T e2x = p2.x() - p0.x(), e2y = p2.y() - p0.y(), e2z = p2.z() - p0.z();
+			const T nx = e1y * e2z - e1z * e2y;
+			const T ny = e1z * e2x - e1x * e2z;
+			const T nz = e1x * e2y - e1y * e2x;
+
+			const T len = std::sqrt(nx * nx + ny * ny + nz * nz);
+			const T inv = len > T(0) ? T(1) / len : T(0);
+			faceNormals[f].set(nx * inv, ny * inv, nz * inv);
+		}
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TMeshTool<T, P>::computeVertexNormals(const Vector3* positions, const uint32_t* indices, const size_t faceCount,
+	const VertexAdjacency& adjacency, const NormalWeight weight, Vector3* normals)
+{
+	FaceData cross;
+	faceCrossProducts(positions, indices, faceCount, cross);
+
+	const T* cx = cross.x.data();
+	const T* cy = cross.y.data();
+	const T* cz = cross.z.data();
+	const uint32_t* offsets = adjacency.offsets().data();
+	const uint32_t* corners = adjacency.corners().data();
+
+	ThreadPool::instance().parallelFor(0, adjacency.vertexCount(), s_grain, [=](size_t begin, size_t end)
+	{
+		for (size_t v(begin); v < end; ++v)
+		{
+			T nx(0), ny(0), nz(0);
+			for (uint32_t i(offsets[v]); i < offsets[v + 1]; ++i)
+			{
+				const uint32_t corner = corners[i];
+				const uint32_t f = corner / 3;
+
+				T w(1);
+				if (NormalWeight::Area != weight)
+				{
+					// 非面积加权时先把面法线归一化
+					const T len = std::sqrt(cx[f] * cx[f] + cy[f] * cy[f] + cz[f] * cz[f]);
+					w = len > T(0) ? T(1) / len : T(0);
+					if (NormalWeight::Angle == weight)
+					{
+						w *= cornerAngle(positions, indices, corner);
+					}
+				}
+
+				nx += cx[f] * w;
+				ny += cy[f] * w;
+				nz += cz[f] * w;
+			}
+
+			const T len = std::sqrt(nx * nx + ny * ny + nz * nz);
+			const T inv = len > T(0) ? T(1) / len : T(0);
+			normals[v].set(nx * inv, ny * inv, nz * inv);
+		}
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TMeshTool<T, P>::computeTangents(const Vector3* positions, const Vector3* normals, const Vector2* uvs,
+	const uint32_t* indices, const size_t faceCount, const VertexAdjacency& adjacency, Vector4* tangents)
+{
+	FaceData faceT;
+	FaceData faceB;
+	faceT.resize(faceCount);
+	faceB.resize(faceCount);
+	T* tx = faceT.x.data();
+	T* ty = faceT.y.data();
+	T* tz = faceT.z.data();
+	T* bx = faceB.x.data();
+	T* by = faceB.y.data();
+	T* bz = faceB.z.data();
+
+	ThreadPool::instance().parallelFor(0, faceCount, s_grain, [=](size_t begin, size_t end)
+	{
+		for (size_t f(begin); f < end; ++f)
+		{
+			const uint32_t i0 = indices[3 * f], i1 = indices[3 * f + 1], i2 = indices[3 * f + 2];
+			const Vector3& p0 = positions[i0];
+			const Vector3& p1 = positions[i1];
+			const Vector3& p2 = positions[i2];
+
+			const T e1x = p1.x() - p0.x(), e1y = p1.y() - p0.y(), e1z = p1.z() - p0.z();
+			const T e2x = p2.x() - p0.x(), e2y = p2.y() - p0.y(), e2z = p2.z() - p0.z();
+			const T du1 = uvs[i1].x() - uvs[i0].x(), dv1 = uvs[i1].y() - uvs[i0].y();
+			const T du2 = uvs[i2].x() - uvs[i0].x(), dv2 = uvs[i2].y() - uvs[i0].y();
+
+			const T det = du1 * dv2 - du2 * dv1;
+			const T r = det != T(0) ? T(1) / det : T(0);
+
+			// 面切线按单位长度存储，顶点处再做角度加权
+			T sx = (e1x * dv2 - e2x * dv1) * r, sy = (e1y * dv2 - e2y * dv1) * r, sz = (e1z * dv2 - e2z * dv1) * r;
+			T ux = (e2x * du1 - e1x * du2) * r, uy = (e2y * du1 - e1y * du2) * r, uz = (e2z * du1 - e1z * du2) * r;
+			const T sl = std::sqrt(sx * sx + sy * sy + sz * sz);
+			const T ul = std::sqrt(ux * ux + uy * uy + uz * uz);
+			const T si = sl > T(0) ? T(1) / sl : T(0);
+			const T ui = ul > T(0) ? T(1) / ul : T(0);
+
+			tx[f] = sx * si; ty[f] = sy * si; tz[f] = sz * si;
+			bx[f] = ux * ui; by[f] = uy * ui; bz[f] = uz * ui;
+		}
+	});
+
+	const uint32_t* offsets = adjacency.offsets().data();
+	const uint32_t* corners = adjacency.corners().data();
+
+	ThreadPool::instance().parallelFor(0, adjacency.vertexCount(), s_grain, [=](size_t begin, size_t end)
+	{
+		for (size_t v(begin); v < end; ++v)
+		{
+			T sx(0), sy(0), sz(0), ux(0), uy(0), uz(0);
+			for (uint32_t i(offsets[v]); i < offsets[v + 1]; ++i)
+			{
+				const uint32_t corner = corners[i];
+				const uint32_t f = corner / 3;
+				const T w = cornerAngle(positions, indices, corner);
+				sx += tx[f] * w; sy += ty[f] * w; sz += tz[f] * w;
+				ux += bx[f] * w; uy += by[f] * w; uz += bz[f] * w;
+			}
+
+			// Gram-Schmidt：去掉切线在法线方向上的分量
+			const T nx = normals[v].x(), ny = normals[v].y(), nz = normals[v].z();
+			const T nd = nx * sx + ny * sy + nz * sz;
+			sx -= nx * nd;
+			sy -= ny * nd;
+			sz -= nz * nd;
+
+			const T len = std::sqrt(sx * sx + sy * sy + sz * sz);
+			const T inv = len > T(0) ? T(1) / len : T(0);
+			sx *= inv;
+			sy *= inv;
+			sz *= inv;
+
+			// cross(n, t) 与累加副切线同向时 w = 1
+			const T cx = ny * sz - nz * sy, cy = nz * sx - nx * sz, cz = nx * sy - ny * sx;
+			const T handedness = (cx * ux + cy * uy + cz * uz) < T(0) ? T(-1) : T(1);
+			tangents[v].set(sx, sy, sz, handedness);
+		}
+	});
+}
+
+END_NAMESPACE
+
+#endif
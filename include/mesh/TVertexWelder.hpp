@@ -0,0 +1,254 @@
+#ifndef __TVERTEX_WELDER_HPP__
+#define __TVERTEX_WELDER_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "vector/TVectorHash.hpp"
+#include "parallel/ThreadPool.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 顶点焊接（去重），用于 OBJ/STL 等未焊接网格的导入
+ * 先并行计算每个顶点的散列槽位，再以 CAS 并行插入开放寻址表（线性探测，负载不超过 1/2，按散列预取槽位），
+ * 同键的槽位保留最小的顶点下标，因此代表顶点与输出顺序只取决于输入，与线程数无关
+ */
+template <validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TVertexWelder
+{
+public:
+	using Vector3 = TVector3<T, P>;
+
+	/**
+	 * @brief 精确焊接：各分量相等的顶点合并（+0 与 -0 视为相等，位模式相同的 NaN 视为相等）
+	 * @param vertices 输入顶点
+	 * @param count 顶点数，需小于 2^32 - 1
+	 * @param unique 输出去重后的顶点，按首次出现的顺序排列
+	 * @param remap 输出每个输入顶点在 unique 中的下标
+	 * @return 顶点数超出 32 位索引范围时返回 false，输出为空
+	 */
+	static bool weld(const Vector3* vertices, const size_t count, std::vector<Vector3>& unique,
+		std::vector<uint32_t>& remap);
+
+	/**
+	 * @brief 量化焊接：落在边长为 cell 的同一网格内的顶点合并，取该格中首个顶点的位置
+	 * @param cell 网格边长，需大于 0
+	 */
+	static bool weld(const Vector3* vertices, const size_t count, const double cell, std::vector<Vector3>& unique,
+		std::vector<uint32_t>& remap);
+
+	/**
+	 * @brief 按 remap 就地改写三角形索引
+	 * @param indices 索引
+	 * @param count 索引数
+	 * @param remap weld 输出的映射
+	 */
+	static void remapIndices(uint32_t* indices, const size_t count, const std::vector<uint32_t>& remap);
+
+private:
+	static constexpr size_t s_grain = 16384;
+	static constexpr size_t s_prefetch = 16;
+
+	using Key = std::array<uint64_t, 3>;
+
+	static void prefetch(const void* address);
+
+	template <typename KeyFunc>
+	static bool weldKeys(const Vector3* vertices, const size_t count, KeyFunc keyFunc, std::vector<Vector3>& unique,
+		std::vector<uint32_t>& remap);
+};
+
+template <validtype T, CheckPolicy P>
+bool TVertexWelder<T, P>::weld(const Vector3* vertices, const size_t count, std::vector<Vector3>& unique,
+	std::vector<uint32_t>& remap)
+{
+	return weldKeys(vertices, count, [](const Vector3& vec)
+	{
+		return Key{ hashBits(vec.x()), hashBits(vec.y()), hashBits(vec.z()) };
+	}, unique, remap);
+}
+
+template <validtype T, CheckPolicy P>
+bool TVertexWelder<T, P>::weld(const Vector3* vertices, const size_t count, const double cell,
+	std::vector<Vector3>& unique, std::vector<uint32_t>& remap)
+{
+	const TQuantizer<Vector3> quantizer(cell);
+	return weldKeys(vertices, count, [&quantizer](const Vector3& vec)
+	{
+		const auto k = quantizer.key(vec);
+		return Key{ static_cast<uint64_t>(k[0]), static_cast<uint64_t>(k[1]), static_cast<uint64_t>(k[2]) };
+	}, unique, remap);
+}
+
+template <validtype T, CheckPolicy P>
+void TVertexWelder<T, P>::remapIndices(uint32_t* indices, const size_t count, const std::vector<uint32_t>& remap)
+{
+	ThreadPool::instance().parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			indices[i] = remap[indices[i]];
+		}
+	});
+}
+
+template <validtype T, CheckPolicy P>
+void TVertexWelder<T, P>::prefetch(const void* address)
+{
+#ifdef MATH_SIMD_SSE2
+	_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+	(void)address;
+#endif
+}
+
+template <validtype T, CheckPolicy P>
+template <typename KeyFunc>
+bool TVertexWelder<T, P>::weldKeys(const Vector3* vertices, const size_t count, KeyFunc keyFunc,
+	std::vector<Vector3>& unique, std::vector<uint32_t>& remap)
+{
+	unique.clear();
+	remap.clear();
+	if (!checkCondition<P>(count < UINT32_MAX))
+	{
+		return false;
+	}
+	if (0 == count)
+	{
+		return true;
+	}
+
+	ThreadPool& pool = ThreadPool::instance();
+
+	size_t capacity(16);
+	while (capacity < 2 * count)
+	{
+		capacity <<= 1;
+	}
+	const size_t mask = capacity - 1;
+
+	// 先存放散列起始槽位，插入后改为实际所在槽位
+	std::vector<uint64_t> positions(count);
+	pool.parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			const Key k = keyFunc(vertices[i]);
+			positions[i] = hashMix(hashMix(hashMix(k[0]) ^ k[1]) ^ k[2]) & mask;
+		}
+	});
+
+	// 槽位为 0 表示空，否则为顶点下标 + 1；同键槽以 CAS 取较小下标
+	std::vector<std::atomic<uint32_t>> slots(capacity);
+	pool.parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			// 散列已知，提前预取远处的槽位，以及近处槽位中已有顶点的位置
+			if (i + s_prefetch < end)
+			{
+				prefetch(&slots[positions[i + s_prefetch]]);
+			}
+			if (i + s_prefetch / 2 < end)
+			{
+				const uint32_t ahead = slots[positions[i + s_prefetch / 2]].load(std::memory_order_relaxed);
+				if (0 != ahead)
+				{
+					prefetch(&vertices[ahead - 1]);
+				}
+			}
+
+			const Key key = keyFunc(vertices[i]);
+			const uint32_t entry = static_cast<uint32_t>(i + 1);
+			size_t pos = positions[i];
+			uint32_t current = slots[pos].load(std::memory_order_relaxed);
+			while (true)
+			{
+				if (0 == current)
+				{
+					if (slots[pos].compare_exchange_weak(current, entry, std::memory_order_relaxed))
+					{
+						break;
+					}
+					continue;
+				}
+				if (keyFunc(vertices[current - 1]) == key)
+				{
+					while (entry < current
+						&& !slots[pos].compare_exchange_weak(current, entry, std::memory_order_relaxed))
+					{
+					}
+					break;
+				}
+				pos = (pos + 1) & mask;
+				current = slots[pos].load(std::memory_order_relaxed);
+			}
+			positions[i] = pos;
+		}
+	});
+
+	// 记录代表顶点，并统计每块中代表顶点的个数
+	remap.resize(count);
+	const size_t chunkCount = (count + s_grain - 1) / s_grain;
+	std::vector<uint32_t> offsets(chunkCount + 1, 0);
+	pool.parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		uint32_t representatives(0);
+		for (size_t i(begin); i < end; ++i)
+		{
+			if (i + s_prefetch < end)
+			{
+				prefetch(&slots[positions[i + s_prefetch]]);
+			}
+			remap[i] = slots[positions[i]].load(std::memory_order_relaxed) - 1;
+			representatives += i == remap[i] ? 1 : 0;
+		}
+		offsets[begin / s_grain + 1] = representatives;
+	});
+
+	for (size_t c(0); c < chunkCount; ++c)
+	{
+		offsets[c + 1] += offsets[c];
+	}
+
+	// 代表顶点按下标顺序写出，并把新下标写回其槽位
+	unique.assign(offsets[chunkCount], Vector3(T(0), T(0), T(0)));
+	pool.parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		uint32_t next = offsets[begin / s_grain];
+		for (size_t i(begin); i < end; ++i)
+		{
+			if (i == remap[i])
+			{
+				unique[next] = vertices[i];
+				slots[positions[i]].store(next++, std::memory_order_relaxed);
+			}
+		}
+	});
+
+	pool.parallelFor(0, count, s_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			if (i + s_prefetch < end)
+			{
+				prefetch(&slots[positions[i + s_prefetch]]);
+			}
+			remap[i] = slots[positions[i]].load(std::memory_order_relaxed);
+		}
+	});
+	return true;
+}
+
+END_NAMESPACE
+
+#endif
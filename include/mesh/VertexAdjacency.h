@@ -0,0 +1,41 @@
+#ifndef __VERTEX_ADJACENCY_H__
+#define __VERTEX_ADJACENCY_H__
+
+#include "MathMacro.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 顶点到三角形角点的邻接表（CSR 压缩存储）
+ * 顶点 v 的角点为 corners[offsets[v]] ~ corners[offsets[v + 1] - 1]，
+ * 角点编码为 3 * 面索引 + 角点序号
+ */
+class MATH_API VertexAdjacency
+{
+public:
+	VertexAdjacency() = default;
+
+	/**
+	 * @brief 由三角形索引构建邻接表，拓扑不变时可在多帧间复用
+	 * @param indices 三角形索引，长度为 3 * faceCount
+	 * @param faceCount 三角形数
+	 * @param vertexCount 顶点数
+	 */
+	void build(const uint32_t* indices, const size_t faceCount, const size_t vertexCount);
+
+	size_t vertexCount() const;
+
+	const std::vector<uint32_t>& offsets() const;
+	const std::vector<uint32_t>& corners() const;
+
+private:
+	std::vector<uint32_t> m_offsets;
+	std::vector<uint32_t> m_corners;
+};
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,1202 @@
+#ifndef __TNOISE_HPP__
+#define __TNOISE_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include "algorithm/MathTool.h"
+#include "parallel/ThreadPool.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 噪声类型
+ */
+enum class NoiseType
+{
+	Value,
+	Perlin,
+	Simplex
+};
+
+/*!
+ * 分形布朗运动（fBm）参数
+ */
+template <floattype T>
+struct TFbmParams
+{
+	int octaves = 5;
+	T frequency = T(1);
+	T lacunarity = T(2);
+	T gain = T(0.5);
+};
+
+/*!
+ * 梯度噪声与值噪声，输出范围约为 [-1, 1]
+ * 同一种子生成固定的置换表，结果与调用方式（单点、批量、线程数）无关
+ * float 的批量接口按块用 MathTool::floor / fraction 求格点与小数部分，SSE2 下 4 个点一组计算，
+ * 置换表查找按通道进行，其余运算与单点版本逐条对应，结果逐位相同
+ * 坐标需落在 int 范围内
+ */
+template <floattype T>
+class TNoise
+{
+public:
+	explicit TNoise(const uint32_t seed = 0);
+
+	T value(const T x, const T y) const;
+	T value(const T x, const T y, const T z) const;
+
+	T perlin(const T x, const T y) const;
+	T perlin(const T x, const T y, const T z) const;
+	T perlin(const T x, const T y, const T z, const T w) const;
+
+	T simplex(const T x, const T y) const;
+	T simplex(const T x, const T y, const T z) const;
+	T simplex(const T x, const T y, const T z, const T w) const;
+
+	/**
+	 * @brief 按类型计算单点噪声（4D 不支持值噪声，返回 0）
+	 * @param type 噪声类型
+	 * @param p 坐标
+	 * @return 噪声值
+	 */
+	template <CheckPolicy P>
+	T evaluate(const NoiseType type, const TVector2<T, P>& p) const;
+	template <CheckPolicy P>
+	T evaluate(const NoiseType type, const TVector3<T, P>& p) const;
+	template <CheckPolicy P>
+	T evaluate(const NoiseType type, const TVector4<T, P>& p) const;
+
+	/**
+	 * @brief 分形布朗运动，逐倍频叠加并按振幅和归一化
+	 * @param type 噪声类型
+	 * @param p 坐标
+	 * @param params fBm 参数
+	 * @return 噪声值
+	 */
+	template <CheckPolicy P>
+	T fbm(const NoiseType type, const TVector2<T, P>& p, const TFbmParams<T>& params = {}) const;
+	template <CheckPolicy P>
+	T fbm(const NoiseType type, const TVector3<T, P>& p, const TFbmParams<T>& params = {}) const;
+	template <CheckPolicy P>
+	T fbm(const NoiseType type, const TVector4<T, P>& p, const TFbmParams<T>& params = {}) const;
+
+	/**
+	 * @brief 批量计算 SoA 坐标流上的噪声
+	 * @param type 噪声类型
+	 * @param coords 每维一个坐标流，dimension 为 2、3 或 4
+	 * @param dimension 维数
+	 * @param count 点数
+	 * @param out 输出
+	 * @param params 非空时计算 fBm
+	 */
+	void evaluate(const NoiseType type, const T* const* coords, const size_t dimension, const size_t count,
+		T* out, const TFbmParams<T>* params = nullptr) const;
+
+private:
+	static constexpr size_t s_block = 64;
+	static constexpr size_t s_grain = 16384;
+
+	// 1 之下最大的浮点数，小数部分舍入为 1 时取此值，与 MathTool::fraction 一致
+	static constexpr T s_belowOne = T(1) - std::numeric_limits<T>::epsilon() / T(2);
+
+	static constexpr T s_f2 = T(0.36602540378443864676);
+	static constexpr T s_g2 = T(0.21132486540518711775);
+	static constexpr T s_f3 = T(1) / T(3);
+	static constexpr T s_g3 = T(1) / T(6);
+	static constexpr T s_f4 = T(0.30901699437494742410);
+	static constexpr T s_g4 = T(0.13819660112501051518);
+
+	static constexpr int s_simplexGrad2[12][2] = {
+		{ 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }, { 1, 0 }, { -1, 0 },
+		{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 0, 1 }, { 0, -1 }
+	};
+	static constexpr int s_simplexGrad3[12][3] = {
+		{ 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+		{ 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+		{ 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 }
+	};
+	static constexpr int s_simplexGrad4[32][4] = {
+		{ 0, 1, 1, 1 }, { 0, 1, 1, -1 }, { 0, 1, -1, 1 }, { 0, 1, -1, -1 },
+		{ 0, -1, 1, 1 }, { 0, -1, 1, -1 }, { 0, -1, -1, 1 }, { 0, -1, -1, -1 },
+		{ 1, 0, 1, 1 }, { 1, 0, 1, -1 }, { 1, 0, -1, 1 }, { 1, 0, -1, -1 },
+		{ -1, 0, 1, 1 }, { -1, 0, 1, -1 }, { -1, 0, -1, 1 }, { -1, 0, -1, -1 },
+		{ 1, 1, 0, 1 }, { 1, 1, 0, -1 }, { 1, -1, 0, 1 }, { 1, -1, 0, -1 },
+		{ -1, 1, 0, 1 }, { -1, 1, 0, -1 }, { -1, -1, 0, 1 }, { -1, -1, 0, -1 },
+		{ 1, 1, 1, 0 }, { 1, 1, -1, 0 }, { 1, -1, 1, 0 }, { 1, -1, -1, 0 },
+		{ -1, 1, 1, 0 }, { -1, 1, -1, 0 }, { -1, -1, 1, 0 }, { -1, -1, -1, 0 }
+	};
+
+	// 无分支向下取整，输入需在 int 范围内
+	static int floorToInt(const T v);
+	// v 相对格点 i 的小数部分，语义同 MathTool::fraction
+	static T latticeFraction(const T v, const int i);
+	static T fade(const T t);
+	static T lerp(const T a, const T b, const T t);
+
+	T hashToUnit(const int hash) const;
+
+	static T grad(const int hash, const T x, const T y);
+	static T grad(const int hash, const T x, const T y, const T z);
+	static T grad(const int hash, const T x, const T y, const T z, const T w);
+
+	template <size_t D>
+	T sample(const NoiseType type, const T* p) const;
+
+	template <size_t D>
+	T fbmSample(const NoiseType type, const T* p, const TFbmParams<T>& params) const;
+
+	template <size_t D>
+	void sampleBlock(const NoiseType type, const T* const* p, const size_t count, T* out) const;
+
+	template <size_t D>
+	void evaluateRange(const NoiseType type, const T* const* coords, const size_t begin, const size_t end,
+		T* out, const TFbmParams<T>* params) const;
+
+#ifdef MATH_SIMD_SSE2
+	// float 的 4 点一组内核：floors / fracs 为 MathTool 按块算出的格点与小数部分，i 为组内首点
+	static __m128 selectLanes(const __m128 mask, const __m128 a, const __m128 b);
+	static __m128 fadeLanes(const __m128 t);
+	static __m128 lerpLanes(const __m128 a, const __m128 b, const __m128 t);
+	static __m128 gradLanes(const __m128i hash, const __m128 x, const __m128 y);
+	static __m128 gradLanes(const __m128i hash, const __m128 x, const __m128 y, const __m128 z);
+	static __m128 gradLanes(const __m128i hash, const __m128 x, const __m128 y, const __m128 z, const __m128 w);
+	static __m128 hashToUnitLanes(const int32_t* hash);
+	static __m128i loadLanes(const int32_t* v);
+	static void latticeLanes(const float* floors, const size_t i, int32_t* lattice);
+
+	template <size_t D>
+	__m128 valueLanes(const float* const* floors, const float* const* fracs, const size_t i) const;
+	template <size_t D>
+	__m128 perlinLanes(const float* const* floors, const float* const* fracs, const size_t i) const;
+	template <size_t D>
+	__m128 simplexLanes(const float* const* p, const float* const* floors, const size_t i) const;
+#endif
+
+private:
+	std::array<int, 512> m_perm;
+};
+
+template <floattype T>
+TNoise<T>::TNoise(const uint32_t seed)
+{
+	for (int i(0); i < 256; ++i)
+	{
+		m_perm[i] = i;
+	}
+
+	// splitmix32 驱动的 Fisher-Yates 洗牌，跨平台结果一致
+	uint32_t state = seed;
+	for (int i(255); i > 0; --i)
+	{
+		state += 0x9e3779b9u;
+		uint32_t z = state;
+		z = (z ^ (z >> 16)) * 0x85ebca6bu;
+		z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+		z ^= z >> 16;
+
+		const int j = static_cast<int>(z % static_cast<uint32_t>(i + 1));
+		std::swap(m_perm[i], m_perm[j]);
+	}
+
+	for (int i(0); i < 256; ++i)
+	{
+		m_perm[256 + i] = m_perm[i];
+	}
+}
+
+template <floattype T>
+int TNoise<T>::floorToInt(const T v)
+{
+	const int i = static_cast<int>(v);
+	return i - static_cast<int>(v < static_cast<T>(i));
+}
+
+template <floattype T>
+T TNoise<T>::latticeFraction(const T v, const int i)
+{
+	const T f = v - static_cast<T>(i);
+	return f >= T(1) ? s_belowOne : f;
+}
+
+template <floattype T>
+T TNoise<T>::fade(const T t)
+{
+	return t * t * t * (t * (t * T(6) - T(15)) + T(10));
+}
+
+template <floattype T>
+T TNoise<T>::lerp(const T a, const T b, const T t)
+{
+	return a + (b - a) * t;
+}
+
+template <floattype T>
+T TNoise<T>::hashToUnit(const int hash) const
+{
+	return static_cast<T>(hash) * (T(2) / T(255)) - T(1);
+}
+
+template <floattype T>
+T TNoise<T>::grad(const int hash, const T x, const T y)
+{
+	const int h = hash & 7;
+	const T u = h < 4 ? x : y;
+	const T v = h < 4 ? y : x;
+	return ((h & 1) ? -u : u) + ((h & 2) ? T(-2) * v : T(2) * v);
+}
+
+template <floattype T>
+T TNoise<T>::grad(const int hash, const T x, const T y, const T z)
+{
+	const int h = hash & 15;
+	const T u = h < 8 ? x : y;
+	const T v = h < 4 ? y : (12 == h || 14 == h ? x : z);
+	return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+template <floattype T>
+T TNoise<T>::grad(const int hash, const T x, const T y, const T z, const T w)
+{
+	const int h = hash & 31;
+	const T u = h < 24 ? x : y;
+	const T v = h < 16 ? y : z;
+	const T s = h < 8 ? z : w;
+	return ((h & 1) ? -u : u) + ((h & 2) ? -v : v) + ((h & 4) ? -s : s);
+}
+
+template <floattype T>
+T TNoise<T>::value(const T x, const T y) const
+{
+	const int xi = floorToInt(x), yi = floorToInt(y);
+	const int X = xi & 255, Y = yi & 255;
+	const T u = fade(latticeFraction(x, xi)), v = fade(latticeFraction(y, yi));
+
+	const T a = hashToUnit(m_perm[m_perm[X] + Y]);
+	const T b = hashToUnit(m_perm[m_perm[X + 1] + Y]);
+	const T c = hashToUnit(m_perm[m_perm[X] + Y + 1]);
+	const T d = hashToUnit(m_perm[m_perm[X + 1] + Y + 1]);
+	return lerp(lerp(a, b, u), lerp(c, d, u), v);
+}
+
+template <floattype T>
+T TNoise<T>::value(const T x, const T y, const T z) const
+{
+	const int xi = floorToInt(x), yi = floorToInt(y), zi = floorToInt(z);
+	const int X = xi & 255, Y = yi & 255, Z = zi & 255;
+	const T u = fade(latticeFraction(x, xi)), v = fade(latticeFraction(y, yi)), w = fade(latticeFraction(z, zi));
+
+	const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+	const int AA = m_perm[A] + Z, AB = m_perm[A + 1] + Z, BA = m_perm[B] + Z, BB = m_perm[B + 1] + Z;
+	return lerp(
+		lerp(lerp(hashToUnit(m_perm[AA]), hashToUnit(m_perm[BA]), u),
+			lerp(hashToUnit(m_perm[AB]), hashToUnit(m_perm[BB]), u), v),
+		lerp(lerp(hashToUnit(m_perm[AA + 1]), hashToUnit(m_perm[BA + 1]), u),
+			lerp(hashToUnit(m_perm[AB + 1]), hashToUnit(m_perm[BB + 1]), u), v),
+		w);
+}
+
+template <floattype T>
+T TNoise<T>::perlin(const T x, const T y) const
+{
+	const int xi = floorToInt(x), yi = floorToInt(y);
+	const int X = xi & 255, Y = yi & 255;
+	const T fx = latticeFraction(x, xi), fy = latticeFraction(y, yi);
+	const T u = fade(fx), v = fade(fy);
+
+	const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+	const T n = lerp(
+		lerp(grad(m_perm[A], fx, fy), grad(m_perm[B], fx - 1, fy), u),
+		lerp(grad(m_perm[A + 1], fx, fy - 1), grad(m_perm[B + 1], fx - 1, fy - 1), u),
+		v);
+	// 2D 梯度最大模长为 sqrt(5)，缩放到约 [-1, 1]
+	return n * T(0.5);
+}
+
+template <floattype T>
+T TNoise<T>::perlin(const T x, const T y, const T z) const
+{
+	const int xi = floorToInt(x), yi = floorToInt(y), zi = floorToInt(z);
+	const int X = xi & 255, Y = yi & 255, Z = zi & 255;
+	const T fx = latticeFraction(x, xi), fy = latticeFraction(y, yi), fz = latticeFraction(z, zi);
+	const T u = fade(fx), v = fade(fy), w = fade(fz);
+
+	const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+	const int AA = m_perm[A] + Z, AB = m_perm[A + 1] + Z, BA = m_perm[B] + Z, BB = m_perm[B + 1] + Z;
+	return lerp(
+		lerp(lerp(grad(m_perm[AA], fx, fy, fz), grad(m_perm[BA], fx - 1, fy, fz), u),
+			lerp(grad(m_perm[AB], fx, fy - 1, fz), grad(m_perm[BB], fx - 1, fy - 1, fz), u), v),
+		lerp(lerp(grad(m_perm[AA + 1], fx, fy, fz - 1), grad(m_perm[BA + 1], fx - 1, fy, fz - 1), u),
+			lerp(grad(m_perm[AB + 1], fx, fy - 1, fz - 1), grad(m_perm[BB + 1], fx - 1, fy - 1, fz - 1), u), v),
+		w);
+}
+
+template <floattype T>
+T TNoise<T>::perlin(const T x, const T y, const T z, const T w) const
+{
+	const int xi = floorToInt(x), yi = floorToInt(y), zi = floorToInt(z), wi = floorToInt(w);
+	const int X = xi & 255, Y = yi & 255, Z = zi & 255, W = wi & 255;
+	const T fx = latticeFraction(x, xi), fy = latticeFraction(y, yi);
+	const T fz = latticeFraction(z, zi), fw = latticeFraction(w, wi);
+	const T a = fade(fx), b = fade(fy), c = fade(fz), d = fade(fw);
+
+	T corners[16];
+	for (int i(0); i < 16; ++i)
+	{
+		const int dx = i & 1, dy = (i >> 1) & 1, dz = (i >> 2) & 1, dw = (i >> 3) & 1;
+		const int h = m_perm[m_perm[m_perm[m_perm[X + dx] + Y + dy] + Z + dz] + W + dw];
+		corners[i] = grad(h, fx - dx, fy - dy, fz - dz, fw - dw);
+	}
+
+	T lx[8];
+	for (int i(0); i < 8; ++i)
+	{
+		lx[i] = lerp(corners[2 * i], corners[2 * i + 1], a);
+	}
+	const T ly[4] = { lerp(lx[0], lx[1], b), lerp(lx[2], lx[3], b), lerp(lx[4], lx[5], b), lerp(lx[6], lx[7], b) };
+	return lerp(lerp(ly[0], ly[1], c), lerp(ly[2], ly[3], c), d) * T(0.75);
+}
+
+template <floattype T>
+T TNoise<T>::simplex(const T x, const T y) const
+{
+	constexpr T F2 = s_f2;
+	constexpr T G2 = s_g2;
+	const auto& grad3 = s_simplexGrad2;
+
+	const T s = (x + y) * F2;
+	const int i = floorToInt(x + s), j = floorToInt(y + s);
+	const T t = (i + j) * G2;
+	const T x0 = x - (i - t), y0 = y - (j - t);
+
+	const int i1 = x0 > y0 ? 1 : 0;
+	const int j1 = 1 - i1;
+	const T x1 = x0 - i1 + G2, y1 = y0 - j1 + G2;
+	const T x2 = x0 - T(1) + T(2) * G2, y2 = y0 - T(1) + T(2) * G2;
+
+	const int ii = i & 255, jj = j & 255;
+	const int g0 = m_perm[ii + m_perm[jj]] % 12;
+	const int g1 = m_perm[ii + i1 + m_perm[jj + j1]] % 12;
+	const int g2 = m_perm[ii + 1 + m_perm[jj + 1]] % 12;
+
+	T n(0);
+	T t0 = T(0.5) - x0 * x0 - y0 * y0;
+	if (t0 > T(0))
+	{
+		t0 *= t0;
+		n += t0 * t0 * (grad3[g0][0] * x0 + grad3[g0][1] * y0);
+	}
+	T t1 = T(0.5) - x1 * x1 - y1 * y1;
+	if (t1 > T(0))
+	{
+		t1 *= t1;
+		n += t1 * t1 * (grad3[g1][0] * x1 + grad3[g1][1] * y1);
+	}
+	T t2 = T(0.5) - x2 * x2 - y2 * y2;
+	if (t2 > T(0))
+	{
+		t2 *= t2;
+		n += t2 * t2 * (grad3[g2][0] * x2 + grad3[g2][1] * y2);
+	}
+	return T(70) * n;
+}
+
+template <floattype T>
+T TNoise<T>::simplex(const T x, const T y, const T z) const
+{
+	constexpr T F3 = s_f3;
+	constexpr T G3 = s_g3;
+	const auto& grad3 = s_simplexGrad3;
+
+	const T s = (x + y + z) * F3;
+	const int i = floorToInt(x + s), j = floorToInt(y + s), k = floorToInt(z + s);
+	const T t = (i + j + k) * G3;
+	const T x0 = x - (i - t), y0 = y - (j - t), z0 = z - (k - t);
+
+	int i1, j1, k1, i2, j2, k2;
+	if (x0 >= y0)
+	{
+		if (y0 >= z0)
+		{
+			i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0;
+		}
+		else if (x0 >= z0)
+		{
+			i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1;
+		}
+		else
+		{
+			i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1;
+		}
+	}
+	else
+	{
+		if (y0 < z0)
+		{
+			i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1;
+		}
+		else if (x0 < z0)
+		{
+			i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1;
+		}
+		else
+		{
+			i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0;
+		}
+	}
+
+	const T offsets[4][3] = {
+		{ x0, y0, z0 },
+		{ x0 - i1 + G3, y0 - j1 + G3, z0 - k1 + G3 },
+		{ x0 - i2 + T(2) * G3, y0 - j2 + T(2) * G3, z0 - k2 + T(2) * G3 },
+		{ x0 - T(1) + T(3) * G3, y0 - T(1) + T(3) * G3, z0 - T(1) + T(3) * G3 }
+	};
+
+	const int ii = i & 255, jj = j & 255, kk = k & 255;
+	const int g[4] = {
+		m_perm[ii + m_perm[jj + m_perm[kk]]] % 12,
+		m_perm[ii + i1 + m_perm[jj + j1 + m_perm[kk + k1]]] % 12,
+		m_perm[ii + i2 + m_perm[jj + j2 + m_perm[kk + k2]]] % 12,
+		m_perm[ii + 1 + m_perm[jj + 1 + m_perm[kk + 1]]] % 12
+	};
+
+	T n(0);
+	for (int c(0); c < 4; ++c)
+	{
+		const T* o = offsets[c];
+		T tc = T(0.6) - o[0] * o[0] - o[1] * o[1] - o[2] * o[2];
+		if (tc > T(0))
+		{
+			tc *= tc;
+			n += tc * tc * (grad3[g[c]][0] * o[0] + grad3[g[c]][1] * o[1] + grad3[g[c]][2] * o[2]);
+		}
+	}
+	return T(32) * n;
+}
+
+template <floattype T>
+T TNoise<T>::simplex(const T x, const T y, const T z, const T w) const
+{
+	constexpr T F4 = s_f4;
+	constexpr T G4 = s_g4;
+	const auto& grad4 = s_simplexGrad4;
+
+	const T s = (x + y + z + w) * F4;
+	const int i = floorToInt(x + s), j = floorToInt(y + s), k = floorToInt(z + s), l = floorToInt(w + s);
+	const T t = (i + j + k + l) * G4;
+	const T x0 = x - (i - t), y0 = y - (j - t), z0 = z - (k - t), w0 = w - (l - t);
+
+	// 按分量大小排序确定单纯形顶点的遍历顺序
+	int rx(0), ry(0), rz(0), rw(0);
+	x0 > y0 ? ++rx : ++ry;
+	x0 > z0 ? ++rx : ++rz;
+	x0 > w0 ? ++rx : ++rw;
+	y0 > z0 ? ++ry : ++rz;
+	y0 > w0 ? ++ry : ++rw;
+	z0 > w0 ? ++rz : ++rw;
+
+	const int steps[5][4] = {
+		{ 0, 0, 0, 0 },
+		{ rx >= 3, ry >= 3, rz >= 3, rw >= 3 },
+		{ rx >= 2, ry >= 2, rz >= 2, rw >= 2 },
+		{ rx >= 1, ry >= 1, rz >= 1, rw >= 1 },
+		{ 1, 1, 1, 1 }
+	};
+
+	const int ii = i & 255, jj = j & 255, kk = k & 255, ll = l & 255;
+	T n(0);
+	for (int c(0); c < 5; ++c)
+	{
+		const int* d = steps[c];
+		const T ox = x0 - d[0] + c * G4;
+		const T oy = y0 - d[1] + c * G4;
+		const T oz = z0 - d[2] + c * G4;
+		const T ow = w0 - d[3] + c * G4;
+
+		T tc = T(0.6) - ox * ox - oy * oy - oz * oz - ow * ow;
+		if (tc > T(0))
+		{
+			const int g = m_perm[ii + d[0] + m_perm[jj + d[1] + m_perm[kk + d[2] + m_perm[ll + d[3]]]]] % 32;
+			tc *= tc;
+			n += tc * tc * (grad4[g][0] * ox + grad4[g][1] * oy + grad4[g][2] * oz + grad4[g][3] * ow);
+		}
+	}
+	return T(27) * n;
+}
+
+template <floattype T>
+template <size_t D>
+T TNoise<T>::sample(const NoiseType type, const T* p) const
+{
+	if constexpr (2 == D)
+	{
+		switch (type)
+		{
+		case NoiseType::Value:
+			return value(p[0], p[1]);
+		case NoiseType::Perlin:
+			return perlin(p[0], p[1]);
+		default:
+			return simplex(p[0], p[1]);
+		}
+	}
+	else if constexpr (3 == D)
+	{
+		switch (type)
+		{
+		case NoiseType::Value:
+			return value(p[0], p[1], p[2]);
+		case NoiseType::Perlin:
+			return perlin(p[0], p[1], p[2]);
+		default:
+			return simplex(p[0], p[1], p[2]);
+		}
+	}
+	else
+	{
+		switch (type)
+		{
+		case NoiseType::Value:
+			return T(0);
+		case NoiseType::Perlin:
+			return perlin(p[0], p[1], p[2], p[3]);
+		default:
+			return simplex(p[0], p[1], p[2], p[3]);
+		}
+	}
+}
+
+template <floattype T>
+template <size_t D>
+T TNoise<T>::fbmSample(const NoiseType type, const T* p, const TFbmParams<T>& params) const
+{
+	T sum(0), amplitude(1), norm(0), frequency(params.frequency);
+	for (int o(0); o < params.octaves; ++o)
+	{
+		T q[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			q[d] = p[d] * frequency;
+		}
+		sum += amplitude * sample<D>(type, q);
+		norm += amplitude;
+		amplitude *= params.gain;
+		frequency *= params.lacunarity;
+	}
+	return norm > T(0) ? sum / norm : T(0);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::evaluate(const NoiseType type, const TVector2<T, P>& p) const
+{
+	const T q[] = { p.x(), p.y() };
+	return sample<2>(type, q);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::evaluate(const NoiseType type, const TVector3<T, P>& p) const
+{
+	const T q[] = { p.x(), p.y(), p.z() };
+	return sample<3>(type, q);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::evaluate(const NoiseType type, const TVector4<T, P>& p) const
+{
+	const T q[] = { p.x(), p.y(), p.z(), p.w() };
+	return sample<4>(type, q);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::fbm(const NoiseType type, const TVector2<T, P>& p, const TFbmParams<T>& params) const
+{
+	const T q[] = { p.x(), p.y() };
+	return fbmSample<2>(type, q, params);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::fbm(const NoiseType type, const TVector3<T, P>& p, const TFbmParams<T>& params) const
+{
+	const T q[] = { p.x(), p.y(), p.z() };
+	return fbmSample<3>(type, q, params);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+T TNoise<T>::fbm(const NoiseType type, const TVector4<T, P>& p, const TFbmParams<T>& params) const
+{
+	const T q[] = { p.x(), p.y(), p.z(), p.w() };
+	return fbmSample<4>(type, q, params);
+}
+
+#ifdef MATH_SIMD_SSE2
+template <floattype T>
+__m128 TNoise<T>::selectLanes(const __m128 mask, const __m128 a, const __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+template <floattype T>
+__m128 TNoise<T>::fadeLanes(const __m128 t)
+{
+	const __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.f)), _mm_set1_ps(15.f))),
+		_mm_set1_ps(10.f));
+	return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+template <floattype T>
+__m128 TNoise<T>::lerpLanes(const __m128 a, const __m128 b, const __m128 t)
+{
+	return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+template <floattype T>
+__m128 TNoise<T>::gradLanes(const __m128i hash, const __m128 x, const __m128 y)
+{
+	const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+	const __m128 low = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+	const __m128 u = selectLanes(low, x, y);
+	const __m128 v = _mm_mul_ps(_mm_set1_ps(2.f), selectLanes(low, y, x));
+	// 哈希位直接移到符号位上取反
+	const __m128 su = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+	const __m128 sv = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+	return _mm_add_ps(_mm_xor_ps(u, su), _mm_xor_ps(v, sv));
+}
+
+template <floattype T>
+__m128 TNoise<T>::gradLanes(const __m128i hash, const __m128 x, const __m128 y, const __m128 z)
+{
+	const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+	const __m128 u = selectLanes(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8))), x, y);
+	const __m128 useX = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+		_mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+	const __m128 v = selectLanes(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4))), y, selectLanes(useX, x, z));
+	const __m128 su = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+	const __m128 sv = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+	return _mm_add_ps(_mm_xor_ps(u, su), _mm_xor_ps(v, sv));
+}
+
+template <floattype T>
+__m128 TNoise<T>::gradLanes(const __m128i hash, const __m128 x, const __m128 y, const __m128 z, const __m128 w)
+{
+	const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(31));
+	const __m128 u = selectLanes(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(24))), x, y);
+	const __m128 v = selectLanes(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(16))), y, z);
+	const __m128 s = selectLanes(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8))), z, w);
+	const __m128 su = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+	const __m128 sv = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+	const __m128 ss = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(4)), 29));
+	return _mm_add_ps(_mm_add_ps(_mm_xor_ps(u, su), _mm_xor_ps(v, sv)), _mm_xor_ps(s, ss));
+}
+
+template <floattype T>
+__m128 TNoise<T>::hashToUnitLanes(const int32_t* hash)
+{
+	return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(loadLanes(hash)), _mm_set1_ps(2.f / 255.f)), _mm_set1_ps(1.f));
+}
+
+template <floattype T>
+__m128i TNoise<T>::loadLanes(const int32_t* v)
+{
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(v));
+}
+
+template <floattype T>
+void TNoise<T>::latticeLanes(const float* floors, const size_t i, int32_t* lattice)
+{
+	_mm_store_si128(reinterpret_cast<__m128i*>(lattice), _mm_cvttps_epi32(_mm_loadu_ps(floors + i)));
+}
+
+template <floattype T>
+template <size_t D>
+__m128 TNoise<T>::valueLanes(const float* const* floors, const float* const* fracs, const size_t i) const
+{
+	alignas(16) int32_t lattice[D][4];
+	__m128 f[D];
+	for (size_t d(0); d < D; ++d)
+	{
+		latticeLanes(floors[d], i, lattice[d]);
+		f[d] = fadeLanes(_mm_loadu_ps(fracs[d] + i));
+	}
+
+	if constexpr (2 == D)
+	{
+		alignas(16) int32_t h[4][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			const int X = lattice[0][k] & 255, Y = lattice[1][k] & 255;
+			h[0][k] = m_perm[m_perm[X] + Y];
+			h[1][k] = m_perm[m_perm[X + 1] + Y];
+			h[2][k] = m_perm[m_perm[X] + Y + 1];
+			h[3][k] = m_perm[m_perm[X + 1] + Y + 1];
+		}
+		return lerpLanes(lerpLanes(hashToUnitLanes(h[0]), hashToUnitLanes(h[1]), f[0]),
+			lerpLanes(hashToUnitLanes(h[2]), hashToUnitLanes(h[3]), f[0]), f[1]);
+	}
+	else if constexpr (3 == D)
+	{
+		alignas(16) int32_t h[8][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			const int X = lattice[0][k] & 255, Y = lattice[1][k] & 255, Z = lattice[2][k] & 255;
+			const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+			const int AA = m_perm[A] + Z, AB = m_perm[A + 1] + Z, BA = m_perm[B] + Z, BB = m_perm[B + 1] + Z;
+			h[0][k] = m_perm[AA];
+			h[1][k] = m_perm[BA];
+			h[2][k] = m_perm[AB];
+			h[3][k] = m_perm[BB];
+			h[4][k] = m_perm[AA + 1];
+			h[5][k] = m_perm[BA + 1];
+			h[6][k] = m_perm[AB + 1];
+			h[7][k] = m_perm[BB + 1];
+		}
+		return lerpLanes(
+			lerpLanes(lerpLanes(hashToUnitLanes(h[0]), hashToUnitLanes(h[1]), f[0]),
+				lerpLanes(hashToUnitLanes(h[2]), hashToUnitLanes(h[3]), f[0]), f[1]),
+			lerpLanes(lerpLanes(hashToUnitLanes(h[4]), hashToUnitLanes(h[5]), f[0]),
+				lerpLanes(hashToUnitLanes(h[6]), hashToUnitLanes(h[7]), f[0]), f[1]),
+			f[2]);
+	}
+	else
+	{
+		return _mm_setzero_ps();
+	}
+}
+
+template <floattype T>
+template <size_t D>
+__m128 TNoise<T>::perlinLanes(const float* const* floors, const float* const* fracs, const size_t i) const
+{
+	const __m128 one = _mm_set1_ps(1.f);
+	alignas(16) int32_t lattice[D][4];
+	__m128 f0[D], f1[D], u[D];
+	for (size_t d(0); d < D; ++d)
+	{
+		latticeLanes(floors[d], i, lattice[d]);
+		f0[d] = _mm_loadu_ps(fracs[d] + i);
+		f1[d] = _mm_sub_ps(f0[d], one);
+		u[d] = fadeLanes(f0[d]);
+	}
+
+	if constexpr (2 == D)
+	{
+		alignas(16) int32_t h[4][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			const int X = lattice[0][k] & 255, Y = lattice[1][k] & 255;
+			const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+			h[0][k] = m_perm[A];
+			h[1][k] = m_perm[B];
+			h[2][k] = m_perm[A + 1];
+			h[3][k] = m_perm[B + 1];
+		}
+		const __m128 n = lerpLanes(
+			lerpLanes(gradLanes(loadLanes(h[0]), f0[0], f0[1]), gradLanes(loadLanes(h[1]), f1[0], f0[1]), u[0]),
+			lerpLanes(gradLanes(loadLanes(h[2]), f0[0], f1[1]), gradLanes(loadLanes(h[3]), f1[0], f1[1]), u[0]),
+			u[1]);
+		return _mm_mul_ps(n, _mm_set1_ps(0.5f));
+	}
+	else if constexpr (3 == D)
+	{
+		alignas(16) int32_t h[8][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			const int X = lattice[0][k] & 255, Y = lattice[1][k] & 255, Z = lattice[2][k] & 255;
+			const int A = m_perm[X] + Y, B = m_perm[X + 1] + Y;
+			const int AA = m_perm[A] + Z, AB = m_perm[A + 1] + Z, BA = m_perm[B] + Z, BB = m_perm[B + 1] + Z;
+			h[0][k] = m_perm[AA];
+			h[1][k] = m_perm[BA];
+			h[2][k] = m_perm[AB];
+			h[3][k] = m_perm[BB];
+			h[4][k] = m_perm[AA + 1];
+			h[5][k] = m_perm[BA + 1];
+			h[6][k] = m_perm[AB + 1];
+			h[7][k] = m_perm[BB + 1];
+		}
+		__m128 corners[8];
+		for (size_t c(0); c < 8; ++c)
+		{
+			corners[c] = gradLanes(loadLanes(h[c]), (c & 1) ? f1[0] : f0[0], (c & 2) ? f1[1] : f0[1],
+				(c & 4) ? f1[2] : f0[2]);
+		}
+		return lerpLanes(
+			lerpLanes(lerpLanes(corners[0], corners[1], u[0]), lerpLanes(corners[2], corners[3], u[0]), u[1]),
+			lerpLanes(lerpLanes(corners[4], corners[5], u[0]), lerpLanes(corners[6], corners[7], u[0]), u[1]),
+			u[2]);
+	}
+	else
+	{
+		alignas(16) int32_t h[16][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			const int X = lattice[0][k] & 255, Y = lattice[1][k] & 255, Z = lattice[2][k] & 255, W = lattice[3][k] & 255;
+			for (int c(0); c < 16; ++c)
+			{
+				const int dx = c & 1, dy = (c >> 1) & 1, dz = (c >> 2) & 1, dw = (c >> 3) & 1;
+				h[c][k] = m_perm[m_perm[m_perm[m_perm[X + dx] + Y + dy] + Z + dz] + W + dw];
+			}
+		}
+
+		// 标量版本对零偏移也做减法（fx - 0），这里同样减去 0 以保持逐位一致
+		const __m128 zero = _mm_setzero_ps();
+		__m128 corners[16];
+		for (size_t c(0); c < 16; ++c)
+		{
+			corners[c] = gradLanes(loadLanes(h[c]),
+				(c & 1) ? f1[0] : _mm_sub_ps(f0[0], zero), (c & 2) ? f1[1] : _mm_sub_ps(f0[1], zero),
+				(c & 4) ? f1[2] : _mm_sub_ps(f0[2], zero), (c & 8) ? f1[3] : _mm_sub_ps(f0[3], zero));
+		}
+
+		__m128 lx[8];
+		for (size_t c(0); c < 8; ++c)
+		{
+			lx[c] = lerpLanes(corners[2 * c], corners[2 * c + 1], u[0]);
+		}
+		const __m128 ly[4] = { lerpLanes(lx[0], lx[1], u[1]), lerpLanes(lx[2], lx[3], u[1]),
+			lerpLanes(lx[4], lx[5], u[1]), lerpLanes(lx[6], lx[7], u[1]) };
+		return _mm_mul_ps(lerpLanes(lerpLanes(ly[0], ly[1], u[2]), lerpLanes(ly[2], ly[3], u[2]), u[3]),
+			_mm_set1_ps(0.75f));
+	}
+}
+
+template <floattype T>
+template <size_t D>
+__m128 TNoise<T>::simplexLanes(const float* const* p, const float* const* floors, const size_t i) const
+{
+	constexpr float G = 2 == D ? s_g2 : (3 == D ? s_g3 : s_g4);
+	const __m128 one = _mm_set1_ps(1.f);
+
+	// t = (i + j + ...) * G 在整数中求和，与标量版本一致
+	alignas(16) int32_t lattice[D][4];
+	__m128i latticeSum = _mm_setzero_si128();
+	for (size_t d(0); d < D; ++d)
+	{
+		latticeLanes(floors[d], i, lattice[d]);
+		latticeSum = _mm_add_epi32(latticeSum, loadLanes(lattice[d]));
+		for (size_t k(0); k < 4; ++k)
+		{
+			lattice[d][k] &= 255;
+		}
+	}
+	const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(latticeSum), _mm_set1_ps(G));
+	__m128 x0[D];
+	for (size_t d(0); d < D; ++d)
+	{
+		x0[d] = _mm_sub_ps(_mm_loadu_ps(p[d] + i), _mm_sub_ps(_mm_loadu_ps(floors[d] + i), t));
+	}
+
+	// 各顶点相对首顶点的整数步长（每维 0 或 1）
+	constexpr size_t corners = D + 1;
+	__m128 steps[corners][D];
+	for (size_t d(0); d < D; ++d)
+	{
+		steps[0][d] = _mm_setzero_ps();
+		steps[D][d] = one;
+	}
+	if constexpr (2 == D)
+	{
+		const __m128 i1 = _mm_cmpgt_ps(x0[0], x0[1]);
+		steps[1][0] = _mm_and_ps(i1, one);
+		steps[1][1] = _mm_andnot_ps(i1, one);
+	}
+	else if constexpr (3 == D)
+	{
+		const __m128 a = _mm_cmpge_ps(x0[0], x0[1]);
+		const __m128 b = _mm_cmpge_ps(x0[1], x0[2]);
+		const __m128 c = _mm_cmpge_ps(x0[0], x0[2]);
+		const __m128 i1 = _mm_and_ps(a, c);
+		const __m128 j1 = _mm_andnot_ps(a, b);
+		const __m128 i2 = _mm_or_ps(a, _mm_and_ps(b, c));
+		const __m128 j2 = _mm_or_ps(_mm_andnot_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))), b);
+		steps[1][0] = _mm_and_ps(i1, one);
+		steps[1][1] = _mm_and_ps(j1, one);
+		steps[1][2] = _mm_andnot_ps(_mm_or_ps(i1, j1), one);
+		steps[2][0] = _mm_and_ps(i2, one);
+		steps[2][1] = _mm_and_ps(j2, one);
+		steps[2][2] = _mm_andnot_ps(_mm_and_ps(i2, j2), one);
+	}
+	else
+	{
+		// 按分量大小计数排名，排名 >= 4 - c 的维在第 c 个顶点上加 1
+		__m128i rank[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+		for (size_t a(0); a < 4; ++a)
+		{
+			for (size_t b(a + 1); b < 4; ++b)
+			{
+				const __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(x0[a], x0[b]));
+				rank[a] = _mm_sub_epi32(rank[a], greater);
+				rank[b] = _mm_sub_epi32(rank[b], _mm_andnot_si128(greater, _mm_set1_epi32(-1)));
+			}
+		}
+		for (size_t c(1); c < 4; ++c)
+		{
+			const __m128i threshold = _mm_set1_epi32(static_cast<int>(3 - c));
+			for (size_t d(0); d < 4; ++d)
+			{
+				steps[c][d] = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(rank[d], threshold)), one);
+			}
+		}
+	}
+
+	// 每个顶点的梯度下标，按通道查表
+	alignas(16) int32_t grads[corners][4];
+	alignas(16) float stepValues[corners][D][4];
+	for (size_t c(0); c < corners; ++c)
+	{
+		for (size_t d(0); d < D; ++d)
+		{
+			_mm_store_ps(stepValues[c][d], steps[c][d]);
+		}
+	}
+	for (size_t k(0); k < 4; ++k)
+	{
+		for (size_t c(0); c < corners; ++c)
+		{
+			int index = 0;
+			for (size_t d(D); d-- > 0;)
+			{
+				index = m_perm[lattice[d][k] + static_cast<int>(stepValues[c][d][k]) + index];
+			}
+			grads[c][k] = 2 == D || 3 == D ? index % 12 : index % 32;
+		}
+	}
+
+	const __m128 radius = _mm_set1_ps(2 == D ? 0.5f : 0.6f);
+	__m128 n = _mm_setzero_ps();
+	for (size_t c(0); c < corners; ++c)
+	{
+		__m128 o[D];
+		__m128 tc = radius;
+		for (size_t d(0); d < D; ++d)
+		{
+			if (0 == c)
+			{
+				o[d] = x0[d];
+			}
+			else if (D == c)
+			{
+				o[d] = _mm_add_ps(_mm_sub_ps(x0[d], one), _mm_set1_ps(static_cast<float>(c) * G));
+			}
+			else
+			{
+				o[d] = _mm_add_ps(_mm_sub_ps(x0[d], steps[c][d]), _mm_set1_ps(static_cast<float>(c) * G));
+			}
+			tc = _mm_sub_ps(tc, _mm_mul_ps(o[d], o[d]));
+		}
+
+		alignas(16) float g[D][4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			for (size_t d(0); d < D; ++d)
+			{
+				if constexpr (2 == D)
+				{
+					g[d][k] = static_cast<float>(s_simplexGrad2[grads[c][k]][d]);
+				}
+				else if constexpr (3 == D)
+				{
+					g[d][k] = static_cast<float>(s_simplexGrad3[grads[c][k]][d]);
+				}
+				else
+				{
+					g[d][k] = static_cast<float>(s_simplexGrad4[grads[c][k]][d]);
+				}
+			}
+		}
+		__m128 dot = _mm_mul_ps(_mm_load_ps(g[0]), o[0]);
+		for (size_t d(1); d < D; ++d)
+		{
+			dot = _mm_add_ps(dot, _mm_mul_ps(_mm_load_ps(g[d]), o[d]));
+		}
+
+		const __m128 inside = _mm_cmpgt_ps(tc, _mm_setzero_ps());
+		tc = _mm_mul_ps(tc, tc);
+		n = _mm_add_ps(n, _mm_and_ps(inside, _mm_mul_ps(_mm_mul_ps(tc, tc), dot)));
+	}
+	return _mm_mul_ps(_mm_set1_ps(2 == D ? 70.f : (3 == D ? 32.f : 27.f)), n);
+}
+#endif
+
+template <floattype T>
+template <size_t D>
+void TNoise<T>::sampleBlock(const NoiseType type, const T* const* p, const size_t count, T* out) const
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float>)
+	{
+		// 4D 值噪声恒为 0，留给标量尾部
+		const size_t lanes = (4 == D && NoiseType::Value == type) ? 0 : count & ~size_t(3);
+		float floors[D][s_block], fracs[D][s_block];
+		const float* floorRows[D];
+		const float* fracRows[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			floorRows[d] = floors[d];
+			fracRows[d] = fracs[d];
+		}
+
+		if (NoiseType::Simplex == type)
+		{
+			// 斜切后的坐标按块取整，求和顺序与标量版本一致
+			constexpr float F = 2 == D ? s_f2 : (3 == D ? s_f3 : s_f4);
+			for (size_t j(0); j < lanes; ++j)
+			{
+				float s = p[0][j];
+				for (size_t d(1); d < D; ++d)
+				{
+					s += p[d][j];
+				}
+				s *= F;
+				for (size_t d(0); d < D; ++d)
+				{
+					floors[d][j] = p[d][j] + s;
+				}
+			}
+			for (size_t d(0); d < D; ++d)
+			{
+				MathTool::floor(floors[d], floors[d], lanes);
+			}
+		}
+		else
+		{
+			for (size_t d(0); d < D; ++d)
+			{
+				MathTool::floor(p[d], floors[d], lanes);
+				MathTool::fraction(p[d], fracs[d], lanes);
+			}
+		}
+
+		for (; i < lanes; i += 4)
+		{
+			__m128 n;
+			switch (type)
+			{
+			case NoiseType::Value:
+				n = valueLanes<D>(floorRows, fracRows, i);
+				break;
+			case NoiseType::Perlin:
+				n = perlinLanes<D>(floorRows, fracRows, i);
+				break;
+			default:
+				n = simplexLanes<D>(p, floorRows, i);
+				break;
+			}
+			_mm_storeu_ps(out + i, n);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		T q[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			q[d] = p[d][i];
+		}
+		out[i] = sample<D>(type, q);
+	}
+}
+
+template <floattype T>
+template <size_t D>
+void TNoise<T>::evaluateRange(const NoiseType type, const T* const* coords, const size_t begin, const size_t end,
+	T* out, const TFbmParams<T>* params) const
+{
+	// 按块处理 SoA 坐标，类型与维数分派在块外完成；fBm 逐倍频在整块上求值，累加顺序与单点版本一致
+	T scaled[D][s_block];
+	T noise[s_block];
+	T sum[s_block];
+	for (size_t first(begin); first < end; first += s_block)
+	{
+		const size_t count = (end - first < s_block) ? end - first : s_block;
+		const T* rows[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			rows[d] = coords[d] + first;
+		}
+
+		if (nullptr == params)
+		{
+			sampleBlock<D>(type, rows, count, out + first);
+			continue;
+		}
+
+		const T* scaledRows[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			scaledRows[d] = scaled[d];
+		}
+		for (size_t i(0); i < count; ++i)
+		{
+			sum[i] = T(0);
+		}
+
+		T amplitude(1), norm(0), frequency(params->frequency);
+		for (int o(0); o < params->octaves; ++o)
+		{
+			for (size_t d(0); d < D; ++d)
+			{
+				for (size_t i(0); i < count; ++i)
+				{
+					scaled[d][i] = rows[d][i] * frequency;
+				}
+			}
+			sampleBlock<D>(type, scaledRows, count, noise);
+			for (size_t i(0); i < count; ++i)
+			{
+				sum[i] += amplitude * noise[i];
+			}
+			norm += amplitude;
+			amplitude *= params->gain;
+			frequency *= params->lacunarity;
+		}
+		for (size_t i(0); i < count; ++i)
+		{
+			out[first + i] = norm > T(0) ? sum[i] / norm : T(0);
+		}
+	}
+}
+
+template <floattype T>
+void TNoise<T>::evaluate(const NoiseType type, const T* const* coords, const size_t dimension, const size_t count,
+	T* out, const TFbmParams<T>* params) const
+{
+	ThreadPool::instance().parallelFor(0, count, s_grain, [=, this](size_t begin, size_t end)
+	{
+		switch (dimension)
+		{
+		case 2:
+			evaluateRange<2>(type, coords, begin, end, out, params);
+			break;
+		case 3:
+			evaluateRange<3>(type, coords, begin, end, out, params);
+			break;
+		case 4:
+			evaluateRange<4>(type, coords, begin, end, out, params);
+			break;
+		default:
+			break;
+		}
+	});
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef __BLOCKED_EXECUTOR_H__
+#define __BLOCKED_EXECUTOR_H__
+
+#include "MathMacro.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 面向远超缓存的大数组的执行器：固定的一组工作线程，区间按块静态划分，第 t 个线程总处理第 t 段块
+ * ThreadPool::parallelFor 的块由先到的线程领取，同一块每次可能落在不同线程上；
+ * 这里划分只取决于块数和线程数，配合 TNumaArray 的 first-touch 分配，每个线程读写的页都在其所在 NUMA 节点
+ * Linux 下工作线程按 NUMA 节点轮流绑定到进程允许的 CPU 上，其余平台不绑定
+ * 块大小按页对齐：块的字节数是 4096 的整数倍，数组起始按页对齐时相邻线程不会共享页
+ */
+class MATH_API BlockedExecutor
+{
+public:
+	static constexpr size_t s_pageSize = 4096;
+	static constexpr size_t s_cacheLineSize = 64;
+
+	/**
+	 * @brief 构造执行器，工作线程在构造返回前已启动并完成绑定
+	 * @param threadCount 工作线程数，0 表示使用硬件并发数；调用线程只等待，不参与计算
+	 * @param blockBytes 每块的目标字节数，应能与暂存区一起放进 L1/L2
+	 * @param pinThreads 是否把工作线程绑定到 CPU
+	 */
+	explicit BlockedExecutor(const size_t threadCount = 0, const size_t blockBytes = 16384, const bool pinThreads = true);
+	~BlockedExecutor();
+
+	BlockedExecutor(const BlockedExecutor&) = delete;
+	BlockedExecutor& operator=(const BlockedExecutor&) = delete;
+
+	/**
+	 * @brief 工作线程数
+	 */
+	size_t threadCount() const;
+
+	/**
+	 * @brief 每块的目标字节数
+	 */
+	size_t blockBytes() const;
+
+	/**
+	 * @brief 所有工作线程是否都已绑定到 CPU
+	 */
+	bool pinned() const;
+
+	/**
+	 * @brief 系统的 NUMA 节点数，无法获取时为 1
+	 */
+	static size_t nodeCount();
+
+	/**
+	 * @brief 元素大小为 elementSize 时每块的元素数：不少于 blockBytes 对应的元素数，且块字节数为页大小的整数倍
+	 */
+	size_t blockElements(const size_t elementSize) const;
+
+	/**
+	 * @brief 第 thread 个线程负责的块区间 [first, last)，同样的 blockCount 总得到同样的划分
+	 */
+	void blockRange(const size_t thread, const size_t blockCount, size_t& first, size_t& last) const;
+
+	/**
+	 * @brief 每个工作线程执行一次 func(线程序号)，等待全部完成；可被多个线程调用，调用之间串行
+	 *        func 抛出的异常在所有线程结束后于调用线程重新抛出，多个线程抛出时只保留第一个
+	 */
+	void run(const std::function<void(size_t)>& func);
+
+	/**
+	 * @brief 把 src 复制到 dst，同时预取 next 开始的等长区域（下一块的输入），next 可为空
+	 */
+	static void prefetchCopy(void* dst, const void* src, const size_t bytes, const void* next);
+
+	/**
+	 * @brief 用非临时存储把 src 写到 dst，绕过缓存且不读入目标行；结束时不做 fence
+	 */
+	static void streamCopy(void* dst, const void* src, const size_t bytes);
+
+	/**
+	 * @brief 使本线程之前的非临时存储对其他线程可见
+	 */
+	static void streamFence();
+
+private:
+	void workerLoop(const size_t index, const int cpu);
+
+private:
+	std::vector<std::thread> m_workers;
+	size_t m_blockBytes;
+	std::atomic<size_t> m_pinnedCount;
+	std::mutex m_runMutex;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::condition_variable m_finished;
+	const std::function<void(size_t)>* m_job;
+	size_t m_generation;
+	size_t m_pending;
+	std::exception_ptr m_error;
+	bool m_stop;
+};
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef __TFUSED_PIPELINE_HPP__
+#define __TFUSED_PIPELINE_HPP__
+
+#include "MathMacro.h"
+#include "parallel/BlockedExecutor.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 把一串逐元素的批量操作（变换、归一化……以及可选的归约）融合成一次遍历
+ * 每个线程逐块处理自己的区间：块从输入复制到线程私有的暂存区（同时预取下一块），
+ * 在暂存区上依次执行各阶段，数据始终在 L1/L2 中，最后用非临时存储写回输出，不读入也不占用目标缓存行
+ * 相比逐个操作各遍历一次，每个元素只从内存读一次、写一次，适用于远超缓存、受内存带宽限制的数组
+ * 块划分取自 BlockedExecutor，与 TNumaArray 的 first-touch 划分一致；归约按块序合并，结果与线程数无关
+ */
+template <typename T>
+class TFusedPipeline
+{
+	static_assert(std::is_trivially_copyable_v<T>, "TFusedPipeline requires trivially copyable elements");
+
+public:
+	/**
+	 * @brief 阶段函数，参数为暂存区中的块与元素数，原地修改
+	 */
+	using Stage = std::function<void(T*, size_t)>;
+
+	TFusedPipeline() = default;
+
+	/**
+	 * @brief 追加一个阶段，按追加顺序执行
+	 */
+	TFusedPipeline& then(Stage stage);
+
+	/**
+	 * @brief 是否用非临时存储写输出，默认开启；输出随后立即被读且能放进缓存时应关闭
+	 */
+	TFusedPipeline& streamingStores(const bool enable);
+
+	/**
+	 * @brief 阶段数
+	 */
+	size_t stageCount() const;
+
+	/**
+	 * @brief 执行各阶段，in 与 out 可以相同
+	 * @param executor 执行器
+	 * @param in 输入
+	 * @param out 输出
+	 * @param count 元素数
+	 * @return 指针为空（count 为 0 时除外）时返回 false
+	 */
+	bool run(BlockedExecutor& executor, const T* in, T* out, const size_t count) const;
+
+	/**
+	 * @brief 执行各阶段后对每块归约，按块序合并
+	 * @param executor 执行器
+	 * @param in 输入
+	 * @param out 输出，为空时不写回（只归约）
+	 * @param count 元素数
+	 * @param identity 归约的单位元，也是每块部分结果的初值
+	 * @param blockReduce 块归约函数 R(const T*, size_t)，在各阶段之后调用
+	 * @param combine 合并函数 R(const R&, const R&)
+	 * @param result 输出结果
+	 * @return 输入为空（count 为 0 时除外）时返回 false
+	 */
+	template <typename R, typename Reduce, typename Combine>
+	bool reduce(BlockedExecutor& executor, const T* in, T* out, const size_t count, const R& identity,
+		Reduce blockReduce, Combine combine, R& result) const;
+
+private:
+	template <typename Visit>
+	void execute(BlockedExecutor& executor, const T* in, T* out, const size_t count, Visit visit) const;
+
+private:
+	std::vector<Stage> m_stages;
+	bool m_streaming = true;
+};
+
+template <typename T>
+TFusedPipeline<T>& TFusedPipeline<T>::then(Stage stage)
+{
+	m_stages.push_back(std::move(stage));
+	return *this;
+}
+
+template <typename T>
+TFusedPipeline<T>& TFusedPipeline<T>::streamingStores(const bool enable)
+{
+	m_streaming = enable;
+	return *this;
+}
+
+template <typename T>
+size_t TFusedPipeline<T>::stageCount() const
+{
+	return m_stages.size();
+}
+
+template <typename T>
+bool TFusedPipeline<T>::run(BlockedExecutor& executor, const T* in, T* out, const size_t count) const
+{
+	if (0 == count)
+	{
+		return true;
+	}
+	if (nullptr == in || nullptr == out)
+	{
+		return false;
+	}
+
+	execute(executor, in, out, count, [](size_t, const T*, size_t) {});
+	return true;
+}
+
+template <typename T>
+template <typename R, typename Reduce, typename Combine>
+bool TFusedPipeline<T>::reduce(BlockedExecutor& executor, const T* in, T* out, const size_t count, const R& identity,
+	Reduce blockReduce, Combine combine, R& result) const
+{
+	result = identity;
+	if (0 == count)
+	{
+		return true;
+	}
+	if (nullptr == in)
+	{
+		return false;
+	}
+
+	const size_t blockElements = executor.blockElements(sizeof(T));
+	std::vector<R> partials((count + blockElements - 1) / blockElements, identity);
+	execute(executor, in, out, count, [&partials, &blockReduce](const size_t block, const T* data, const size_t size)
+	{
+		partials[block] = blockReduce(data, size);
+	});
+
+	for (const R& partial : partials)
+	{
+		result = combine(result, partial);
+	}
+	return true;
+}
+
+template <typename T>
+template <typename Visit>
+void TFusedPipeline<T>::execute(BlockedExecutor& executor, const T* in, T* out, const size_t count, Visit visit) const
+{
+	const size_t blockElements = executor.blockElements(sizeof(T));
+	const size_t blockCount = (count + blockElements - 1) / blockElements;
+	executor.run([&](const size_t thread)
+	{
+		size_t first, last;
+		executor.blockRange(thread, blockCount, first, last);
+		if (first == last)
+		{
+			return;
+		}
+
+		std::vector<T> scratch(blockElements);
+		for (size_t block(first); block < last; ++block)
+		{
+			const size_t begin = block * blockElements;
+			const size_t size = std::min(blockElements, count - begin);
+			const T* next = block + 1 < last ? in + begin + blockElements : nullptr;
+			BlockedExecutor::prefetchCopy(scratch.data(), in + begin, size * sizeof(T), next);
+
+			for (const Stage& stage : m_stages)
+			{
+				stage(scratch.data(), size);
+			}
+			visit(block, scratch.data(), size);
+
+			if (nullptr != out)
+			{
+				if (m_streaming)
+				{
+					BlockedExecutor::streamCopy(out + begin, scratch.data(), size * sizeof(T));
+				}
+				else
+				{
+					std::copy(scratch.begin(), scratch.begin() + size, out + begin);
+				}
+			}
+		}
+		BlockedExecutor::streamFence();
+	});
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef __TNUMA_ARRAY_HPP__
+#define __TNUMA_ARRAY_HPP__
+
+#include "MathMacro.h"
+#include "parallel/BlockedExecutor.h"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 按 first-touch 分布到 NUMA 节点的定长数组
+ * 内存按页对齐分配后不做初始化，由 executor 的各工作线程按与 TFusedPipeline 相同的块划分并行写入 T()；
+ * Linux 默认策略把页分配在首次写入它的 CPU 所在节点，之后用同一 executor 处理时各线程只访问本地内存
+ * 只支持可平凡复制、平凡析构的元素（TVector2/3/4 等），便于按字节流式读写
+ */
+template <typename T>
+class TNumaArray
+{
+	static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+		"TNumaArray requires trivially copyable elements");
+
+public:
+	TNumaArray() = default;
+
+	/**
+	 * @brief 分配 count 个元素并由 executor 的工作线程完成首次写入
+	 */
+	TNumaArray(BlockedExecutor& executor, const size_t count);
+	~TNumaArray();
+
+	TNumaArray(const TNumaArray&) = delete;
+	TNumaArray& operator=(const TNumaArray&) = delete;
+	TNumaArray(TNumaArray&& other) noexcept;
+	TNumaArray& operator=(TNumaArray&& other) noexcept;
+
+	size_t size() const;
+	bool empty() const;
+
+	T* data();
+	const T* data() const;
+
+	T& operator[](const size_t index);
+	const T& operator[](const size_t index) const;
+
+	T* begin();
+	T* end();
+	const T* begin() const;
+	const T* end() const;
+
+private:
+	void release();
+
+private:
+	T* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+template <typename T>
+TNumaArray<T>::TNumaArray(BlockedExecutor& executor, const size_t count)
+{
+	if (0 == count)
+	{
+		return;
+	}
+
+	m_data = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(BlockedExecutor::s_pageSize)));
+	m_size = count;
+
+	const size_t blockElements = executor.blockElements(sizeof(T));
+	const size_t blockCount = (count + blockElements - 1) / blockElements;
+	T* data = m_data;
+	executor.run([&executor, data, count, blockElements, blockCount](const size_t thread)
+	{
+		size_t first, last;
+		executor.blockRange(thread, blockCount, first, last);
+		const size_t end = std::min(count, last * blockElements);
+		for (size_t i(first * blockElements); i < end; ++i)
+		{
+			new (data + i) T();
+		}
+	});
+}
+
+template <typename T>
+TNumaArray<T>::~TNumaArray()
+{
+	release();
+}
+
+template <typename T>
+TNumaArray<T>::TNumaArray(TNumaArray&& other) noexcept
+	: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+{
+}
+
+template <typename T>
+TNumaArray<T>& TNumaArray<T>::operator=(TNumaArray&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+	}
+	return *this;
+}
+
+template <typename T>
+void TNumaArray<T>::release()
+{
+	if (nullptr != m_data)
+	{
+		::operator delete(m_data, std::align_val_t(BlockedExecutor::s_pageSize));
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
+
+template <typename T>
+size_t TNumaArray<T>::size() const
+{
+	return m_size;
+}
+
+template <typename T>
+bool TNumaArray<T>::empty() const
+{
+	return 0 == m_size;
+}
+
+template <typename T>
+T* TNumaArray<T>::data()
+{
+	return m_data;
+}
+
+template <typename T>
+const T* TNumaArray<T>::data() const
+{
+	return m_data;
+}
+
+template <typename T>
+T& TNumaArray<T>::operator[](const size_t index)
+{
+	return m_data[index];
+}
+
+template <typename T>
+const T& TNumaArray<T>::operator[](const size_t index) const
+{
+	return m_data[index];
+}
+
+template <typename T>
+T* TNumaArray<T>::begin()
+{
+	return m_data;
+}
+
+template <typename T>
+T* TNumaArray<T>::end()
+{
+	return m_data + m_size;
+}
+
+template <typename T>
+const T* TNumaArray<T>::begin() const
+{
+	return m_data;
+}
+
+template <typename T>
+const T* TNumaArray<T>::end() const
+{
+	return m_data + m_size;
+}
+
+END_NAMESPACE
+
+#endif
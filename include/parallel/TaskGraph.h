@@ -0,0 +1,99 @@
+#ifndef __TASK_GRAPH_H__
+#define __TASK_GRAPH_H__
+
+#include "MathMacro.h"
+#include "parallel/ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 轻量任务图：每个任务是一段按 grain 分块的区间（单个任务即只有一块）
+ * 任务间可加两种依赖：
+ *   addDependency      : 整体依赖，前驱的所有块完成后后继的各块才可执行
+ *   addChunkDependency : 逐块延续，前驱第 c 块完成后后继第 c 块即可执行，
+ *                        并由完成前驱块的线程直接接着执行，数据仍在缓存中，阶段之间没有全局屏障
+ * 图构建一次后可反复 run（例如每帧一次），在 ThreadPool 上执行，调用线程参与计算
+ */
+class MATH_API TaskGraph
+{
+public:
+	using TaskId = size_t;
+
+	TaskGraph() = default;
+
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	/**
+	 * @brief 添加单块任务
+	 * @param task 任务
+	 * @return 任务编号
+	 */
+	TaskId addTask(std::function<void()> task);
+
+	/**
+	 * @brief 添加分块任务，分块方式与 ThreadPool::parallelFor 相同
+	 * @param begin 起始下标
+	 * @param end 结束下标
+	 * @param grain 每块元素数
+	 * @param func 块处理函数，参数为块的 [begin, end)；区间为空时不调用，任务视为立即完成
+	 * @return 任务编号
+	 */
+	TaskId addParallelTask(const size_t begin, const size_t end, const size_t grain,
+		std::function<void(size_t, size_t)> func);
+
+	/**
+	 * @brief 添加整体依赖：before 全部完成后才执行 after
+	 * @return 编号无效或自依赖时返回 false
+	 */
+	bool addDependency(const TaskId before, const TaskId after);
+
+	/**
+	 * @brief 添加逐块依赖：before 第 c 块完成后即可执行 after 第 c 块
+	 * @return 编号无效、自依赖或两任务块数不同时返回 false
+	 */
+	bool addChunkDependency(const TaskId before, const TaskId after);
+
+	/**
+	 * @brief 执行整张图并等待完成
+	 * 任务抛出异常时，尚未开始的块不再执行，等图排空后在调用线程重新抛出第一个异常
+	 * @param pool 线程池
+	 * @return 图中存在环时不执行并返回 false
+	 */
+	bool run(ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 任务数
+	 */
+	size_t taskCount() const;
+
+	/**
+	 * @brief 清空所有任务与依赖
+	 */
+	void clear();
+
+private:
+	struct Node
+	{
+		std::function<void(size_t, size_t)> func;
+		size_t begin = 0;
+		size_t end = 0;
+		size_t grain = 1;
+		size_t chunkCount = 0;
+		std::vector<TaskId> successors;
+		std::vector<TaskId> chunkSuccessors;
+		size_t predecessorCount = 0;
+	};
+
+	bool acyclic() const;
+
+private:
+	std::vector<Node> m_nodes;
+};
+
+END_NAMESPACE
+
+#endif
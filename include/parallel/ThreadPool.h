@@ -0,0 +1,69 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include "MathMacro.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+class MATH_API ThreadPool
+{
+public:
+	/**
+	 * @brief 构造线程池
+	 * @param threadCount 工作线程数，0 表示使用硬件并发数
+	 */
+	explicit ThreadPool(const size_t threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief 全局共享线程池
+	 * @return 线程池实例
+	 */
+	static ThreadPool& instance();
+
+	/**
+	 * @brief 参与计算的线程数（含调用线程）
+	 * @return 线程数
+	 */
+	size_t threadCount() const;
+
+	/**
+	 * @brief 提交异步任务
+	 * @param task 任务
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 * @brief 并行执行区间 [begin, end)，调用线程参与计算并等待全部完成
+	 * @param begin 起始下标
+	 * @param end 结束下标
+	 * @param grain 每块最少元素数，分块只取决于区间和 grain，与线程数无关
+	 * @param func 块处理函数，参数为块的 [begin, end)
+	 */
+	void parallelFor(const size_t begin, const size_t end, const size_t grain,
+		const std::function<void(size_t, size_t)>& func);
+
+private:
+	void workerLoop();
+
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stop;
+};
+
+END_NAMESPACE
+
+#endif
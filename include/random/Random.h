@@ -0,0 +1,86 @@
+#ifndef __RANDOM_H__
+#define __RANDOM_H__
+
+#include "MathMacro.h"
+#include <cstddef>
+#include <cstdint>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 基于计数器的随机数生成器（Philox4x32-10）
+ * 第 i 个随机数只取决于 (seed, i)，与分块方式和线程数无关，结果可复现
+ */
+class MATH_API Random
+{
+public:
+	/**
+	 * @brief Philox4x32-10 变换，一个计数器生成 4 个 32 位随机数
+	 * @param seed 种子（密钥）
+	 * @param counter 计数器
+	 * @param out 输出 4 个随机数
+	 */
+	static void philox(const uint64_t seed, const uint64_t counter, uint32_t out[4]);
+
+	/**
+	 * @brief 32 位随机数转换为 [0, 1) 浮点数
+	 */
+	static float toFloat(const uint32_t v);
+
+	/**
+	 * @brief 两个 32 位随机数组合为 [0, 1) 双精度浮点数（53 位精度）
+	 */
+	static double toDouble(const uint32_t hi, const uint32_t lo);
+
+	/**
+	 * @brief 批量生成 [0, 1) 均匀分布随机数，第 j 个元素对应序号 offset + j
+	 * @param seed 种子
+	 * @param offset 起始序号，用于把一个随机流分段填充
+	 * @param out 输出
+	 * @param count 数量
+	 */
+	static void fillUniform(const uint64_t seed, const uint64_t offset, float* out, const size_t count);
+	static void fillUniform(const uint64_t seed, const uint64_t offset, double* out, const size_t count);
+};
+
+inline void Random::philox(const uint64_t seed, const uint64_t counter, uint32_t out[4])
+{
+	uint32_t c0 = static_cast<uint32_t>(counter);
+	uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+	uint32_t c2 = 0;
+	uint32_t c3 = 0;
+	uint32_t k0 = static_cast<uint32_t>(seed);
+	uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+	for (int round(0); round < 10; ++round)
+	{
+		const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+		const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+		c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+		c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+		c1 = static_cast<uint32_t>(p1);
+		c3 = static_cast<uint32_t>(p0);
+		k0 += 0x9E3779B9u;
+		k1 += 0xBB67AE85u;
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+}
+
+inline float Random::toFloat(const uint32_t v)
+{
+	return static_cast<float>(v >> 8) * (1.f / 16777216.f);
+}
+
+inline double Random::toDouble(const uint32_t hi, const uint32_t lo)
+{
+	const uint64_t bits = (static_cast<uint64_t>(hi) << 21) ^ (lo >> 11);
+	return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef __TSAMPLER_HPP__
+#define __TSAMPLER_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "random/Random.h"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 批量采样器，输出 TVector2/3 流
+ * 第 i 个样本由 (seed, first + i) 唯一确定，可分段、多线程生成，结果与线程数无关
+ * 半球均以 +z 为法线方向
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TSampler
+{
+public:
+	using Vector2 = TVector2<T, P>;
+	using Vector3 = TVector3<T, P>;
+
+	/**
+	 * @brief 半球均匀采样
+	 * @param seed 种子
+	 * @param first 第一个样本的序号
+	 * @param count 样本数
+	 * @param out 输出单位方向
+	 */
+	static void uniformHemisphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out);
+
+	/**
+	 * @brief 半球余弦加权采样（同心圆盘映射后投影）
+	 */
+	static void cosineHemisphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out);
+
+	/**
+	 * @brief 球面均匀采样
+	 */
+	static void uniformSphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out);
+
+	/**
+	 * @brief 单位圆盘均匀采样（Shirley 同心映射，保持分层性）
+	 */
+	static void uniformDisk(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out);
+
+	/**
+	 * @brief 三角形均匀采样
+	 * @param out 输出重心坐标 (b0, b1, b2)
+	 */
+	static void triangle(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out);
+
+	/**
+	 * @brief 单位正方形分层抖动采样，输出 nx * ny 个样本，行优先
+	 */
+	static void stratified(const uint64_t seed, const size_t nx, const size_t ny, Vector2* out);
+
+	/**
+	 * @brief Halton 序列（底数 2、3），按种子做 Cranley-Patterson 旋转
+	 */
+	static void halton(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out);
+
+	/**
+	 * @brief Sobol 序列前两维，按种子做随机位异或扰动
+	 */
+	static void sobol(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out);
+
+private:
+	static constexpr size_t s_grain = 16384;
+
+	template <typename Func>
+	static void generate(const size_t count, Func func);
+
+	static void uniform2(const uint64_t seed, const uint64_t index, T& u0, T& u1);
+	static void concentricDisk(const T u0, const T u1, T& x, T& y);
+	static uint32_t reverseBits(uint32_t v);
+	static T radicalInverse3(uint64_t index);
+	static T wrap(const T v);
+};
+
+template <floattype T, CheckPolicy P>
+template <typename Func>
+void TSampler<T, P>::generate(const size_t count, Func func)
+{
+	ThreadPool::instance().parallelFor(0, count, s_grain, [&func](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			func(i);
+		}
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::uniform2(const uint64_t seed, const uint64_t index, T& u0, T& u1)
+{
+	uint32_t r[4];
+	Random::philox(seed, index, r);
+	if constexpr (std::is_same_v<T, float>)
+	{
+		u0 = Random::toFloat(r[0]);
+		u1 = Random::toFloat(r[1]);
+	}
+	else
+	{
+		u0 = Random::toDouble(r[0], r[1]);
+		u1 = Random::toDouble(r[2], r[3]);
+	}
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::concentricDisk(const T u0, const T u1, T& x, T& y)
+{
+	const T a = T(2) * u0 - T(1);
+	const T b = T(2) * u1 - T(1);
+	if (T(0) == a && T(0) == b)
+	{
+		x = T(0);
+		y = T(0);
+		return;
+	}
+
+	constexpr T quarterPi = std::numbers::pi_v<T> / T(4);
+	T r, phi;
+	if (std::abs(a) > std::abs(b))
+	{
+		r = a;
+		phi = quarterPi * (b / a);
+	}
+	else
+	{
+		r = b;
+		phi = T(2) * quarterPi - quarterPi * (a / b);
+	}
+	x = r * std::cos(phi);
+	y = r * std::sin(phi);
+}
+
+template <floattype T, CheckPolicy P>
+uint32_t TSampler<T, P>::reverseBits(uint32_t v)
+{
+	v = (v << 16) | (v >> 16);
+	v = ((v & 0x00ff00ffu) << 8) | ((v & 0xff00ff00u) >> 8);
+	v = ((v & 0x0f0f0f0fu) << 4) | ((v & 0xf0f0f0f0u) >> 4);
+	v = ((v & 0x33333333u) << 2) | ((v & 0xccccccccu) >> 2);
+	v = ((v & 0x55555555u) << 1) | ((v & 0xaaaaaaaau) >> 1);
+	return v;
+}
+
+template <floattype T, CheckPolicy P>
+T TSampler<T, P>::radicalInverse3(uint64_t index)
+{
+	constexpr T invBase = T(1) / T(3);
+	T inv(invBase);
+	T result(0);
+	while (index > 0)
+	{
+		result += static_cast<T>(index % 3) * inv;
+		index /= 3;
+		inv *= invBase;
+	}
+	return result;
+}
+
+template <floattype T, CheckPolicy P>
+T TSampler<T, P>::wrap(const T v)
+{
+	// 结果保持在 [0, 1)，避免舍入得到 1
+	const T w = v >= T(1) ? v - T(1) : v;
+	return w < T(1) ? w : std::nextafter(T(1), T(0));
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::uniformHemisphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out)
+{
+	generate(count, [=](size_t i)
+	{
+		T u0, u1;
+		uniform2(seed, first + i, u0, u1);
+		const T z = u0;
+		const T r = std::sqrt(std::max(T(0), T(1) - z * z));
+		const T phi = T(2) * std::numbers::pi_v<T> * u1;
+		out[i].set(r * std::cos(phi), r * std::sin(phi), z);
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::cosineHemisphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out)
+{
+	generate(count, [=](size_t i)
+	{
+		T u0, u1, x, y;
+		uniform2(seed, first + i, u0, u1);
+		concentricDisk(u0, u1, x, y);
+		out[i].set(x, y, std::sqrt(std::max(T(0), T(1) - x * x - y * y)));
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::uniformSphere(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out)
+{
+	generate(count, [=](size_t i)
+	{
+		T u0, u1;
+		uniform2(seed, first + i, u0, u1);
+		const T z = T(1) - T(2) * u0;
+		const T r = std::sqrt(std::max(T(0), T(1) - z * z));
+		const T phi = T(2) * std::numbers::pi_v<T> * u1;
+		out[i].set(r * std::cos(phi), r * std::sin(phi), z);
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::uniformDisk(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out)
+{
+	generate(count, [=](size_t i)
+	{
+		T u0, u1, x, y;
+		uniform2(seed, first + i, u0, u1);
+		concentricDisk(u0, u1, x, y);
+		out[i].set(x, y);
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::triangle(const uint64_t seed, const uint64_t first, const size_t count, Vector3* out)
+{
+	generate(count, [=](size_t i)
+	{
+		T u0, u1;
+		uniform2(seed, first + i, u0, u1);
+		const T su = std::sqrt(u0);
+		const T b0 = T(1) - su;
+		const T b1 = u1 * su;
+		out[i].set(b0, b1, T(1) - b0 - b1);
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::stratified(const uint64_t seed, const size_t nx, const size_t ny, Vector2* out)
+{
+	const T dx = T(1) / static_cast<T>(nx);
+	const T dy = T(1) / static_cast<T>(ny);
+	generate(nx * ny, [=](size_t i)
+	{
+		T u0, u1;
+		uniform2(seed, i, u0, u1);
+		const size_t cx = i % nx;
+		const size_t cy = i / nx;
+		out[i].set((static_cast<T>(cx) + u0) * dx, (static_cast<T>(cy) + u1) * dy);
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::halton(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out)
+{
+	T offset0, offset1;
+	uniform2(seed, ~0ull, offset0, offset1);
+	generate(count, [=](size_t i)
+	{
+		const uint64_t index = first + i;
+		const T h0 = static_cast<T>(reverseBits(static_cast<uint32_t>(index))) * T(2.3283064365386963e-10);
+		const T h1 = radicalInverse3(index);
+		out[i].set(wrap(h0 + offset0), wrap(h1 + offset1));
+	});
+}
+
+template <floattype T, CheckPolicy P>
+void TSampler<T, P>::sobol(const uint64_t seed, const uint64_t first, const size_t count, Vector2* out)
+{
+	uint32_t scramble[4];
+	Random::philox(seed, ~0ull, scramble);
+	generate(count, [=](size_t i)
+	{
+		const uint32_t index = static_cast<uint32_t>(first + i);
+
+		// 第二维生成矩阵：方向数 v_k = v_{k-1} ^ (v_{k-1} >> 1)
+		uint32_t s1(0);
+		uint32_t v(1u << 31);
+		for (uint32_t n(index); 0 != n; n >>= 1, v ^= v >> 1)
+		{
+			if (n & 1u)
+			{
+				s1 ^= v;
+			}
+		}
+
+		const uint32_t s0 = reverseBits(index);
+		out[i].set(static_cast<T>((s0 ^ scramble[0]) >> 8) * T(1.0 / 16777216.0),
+			static_cast<T>((s1 ^ scramble[1]) >> 8) * T(1.0 / 16777216.0));
+	});
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef __COLOR_TOOL_H__
+#define __COLOR_TOOL_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <cstddef>
+#include <cstdint>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 8 位像素的字节顺序
+ */
+enum class PixelFormat
+{
+	RGBA8,
+	BGRA8
+};
+
+/*!
+ * 像素颜色空间，Linear 表示直接量化，SRGB 表示 RGB 分量做 sRGB 编码（alpha 始终线性）
+ */
+enum class ColorSpace
+{
+	Linear,
+	SRGB
+};
+
+class MATH_API ColorTool
+{
+public:
+	/**
+	 * @brief 批量把浮点颜色转换为 8 位像素，分量先截断到 [0, 1]，NaN 视为 0，四舍五入
+	 * @param rgba 交错存储的浮点颜色，长度为 4 * count
+	 * @param count 像素数（通常为一条扫描线或一个 tile）
+	 * @param pixels 输出像素，每个像素 4 字节，按 format 的字节顺序存储
+	 * @param format 像素字节顺序
+	 * @param space 颜色空间
+	 */
+	static void packColors(const float* rgba, const size_t count, uint8_t* pixels,
+		const PixelFormat format = PixelFormat::RGBA8, const ColorSpace space = ColorSpace::Linear);
+
+	/**
+	 * @brief 批量把 8 位像素转换为浮点颜色
+	 * @param pixels 输入像素
+	 * @param count 像素数
+	 * @param rgba 输出浮点颜色，长度为 4 * count
+	 * @param format 像素字节顺序
+	 * @param space 颜色空间
+	 */
+	static void unpackColors(const uint8_t* pixels, const size_t count, float* rgba,
+		const PixelFormat format = PixelFormat::RGBA8, const ColorSpace space = ColorSpace::Linear);
+
+	/**
+	 * @brief TVector4<float> 数组版本
+	 */
+	template <CheckPolicy P>
+	static void packColors(const TVector4<float, P>* colors, const size_t count, uint8_t* pixels,
+		const PixelFormat format = PixelFormat::RGBA8, const ColorSpace space = ColorSpace::Linear);
+
+	/**
+	 * @brief TVector4<float> 数组版本
+	 */
+	template <CheckPolicy P>
+	static void unpackColors(const uint8_t* pixels, const size_t count, TVector4<float, P>* colors,
+		const PixelFormat format = PixelFormat::RGBA8, const ColorSpace space = ColorSpace::Linear);
+
+	/**
+	 * @brief 线性值转 sRGB 8 位值（查表）
+	 * @param v 线性值
+	 * @return sRGB 编码值
+	 */
+	static uint8_t linearToSrgb8(const float v);
+
+	/**
+	 * @brief sRGB 8 位值转线性值（查表）
+	 * @param v sRGB 编码值
+	 * @return 线性值
+	 */
+	static float srgb8ToLinear(const uint8_t v);
+};
+
+template <CheckPolicy P>
+void ColorTool::packColors(const TVector4<float, P>* colors, const size_t count, uint8_t* pixels,
+	const PixelFormat format, const ColorSpace space)
+{
+	static_assert(sizeof(TVector4<float, P>) == 4 * sizeof(float), "TVector4<float> must be tightly packed");
+	if (0 != count)
+	{
+		packColors(&colors[0].cx(), count, pixels, format, space);
+	}
+}
+
+template <CheckPolicy P>
+void ColorTool::unpackColors(const uint8_t* pixels, const size_t count, TVector4<float, P>* colors,
+	const PixelFormat format, const ColorSpace space)
+{
+	static_assert(sizeof(TVector4<float, P>) == 4 * sizeof(float), "TVector4<float> must be tightly packed");
+	if (0 != count)
+	{
+		unpackColors(pixels, count, &colors[0].rx(), format, space);
+	}
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef __DEPTH_BUFFER_H__
+#define __DEPTH_BUFFER_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "render/TClipper.hpp"
+#include "parallel/ThreadPool.h"
+#include "vector/TVector4.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 分块深度缓冲与层次 Z（Hi-Z）
+ * 深度取值 [0, 1]，越小越近，测试为严格小于；像素按 8x8 tile 存放，tile 内按行连续，一行 8 个深度可一次比较
+ * 每个 tile 记录最小/最大深度，向上逐级 2x2 合并为金字塔；写入只标记脏 tile，updateHierarchy 只重算脏 tile 及其祖先
+ * 深度只会变小（clear 除外），因此未更新的金字塔仍是保守的：遮挡查询不会错误剔除可见物体
+ * 不同线程可以同时写入不同的 tile
+ * 屏幕坐标：x 向右，y 向下，第 0 行在顶部；NDC 的 y = 1 对应第 0 行
+ */
+class MATH_API DepthBuffer
+{
+public:
+	static constexpr size_t s_tileSize = 8;
+
+	DepthBuffer() = default;
+
+	/**
+	 * @brief 分配缓冲并以 1 清空
+	 * @return 尺寸为 0 时返回 false
+	 */
+	bool create(const size_t width, const size_t height);
+
+	/**
+	 * @brief 清空为同一深度，金字塔同时重置
+	 */
+	void clear(const float depth = 1.f);
+
+	size_t width() const;
+	size_t height() const;
+	size_t tilesX() const;
+	size_t tilesY() const;
+
+	float depth(const size_t x, const size_t y) const;
+
+	/**
+	 * @brief 测试一行中连续的像素，通过（depth < 已存深度）的像素可选写入
+	 * @param x 起始列
+	 * @param y 行
+	 * @param count 像素数，超出屏幕的部分忽略
+	 * @param depths 各像素深度
+	 * @param pass 可选，输出每个像素是否通过（0 / 1）
+	 * @param write 是否写入通过的深度
+	 * @return 通过的像素数
+	 */
+	size_t testSpan(const size_t x, const size_t y, const size_t count, const float* depths, uint8_t* pass = nullptr,
+		const bool write = true);
+
+	/**
+	 * @brief 测试一个 8x8 tile
+	 * @param tileX tile 列
+	 * @param tileY tile 行
+	 * @param depths 64 个深度，按行存放
+	 * @param coverage 参与测试的像素，第 (8 * row + column) 位，屏幕外的像素自动排除
+	 * @param write 是否写入通过的深度
+	 * @return 通过的像素掩码，位序同 coverage
+	 */
+	uint64_t testTile(const size_t tileX, const size_t tileY, const float* depths,
+		const uint64_t coverage = ~uint64_t(0), const bool write = true);
+
+	/**
+	 * @brief 重算脏 tile 的最小/最大深度并向上更新金字塔
+	 * @param pool 线程池，脏 tile 较多时并行
+	 * @return 重算的 tile 数
+	 */
+	size_t updateHierarchy(ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 屏幕矩形是否被完全遮挡
+	 * @param minX, minY, maxX, maxY 像素坐标的包围矩形
+	 * @param minDepth 物体最近的深度
+	 * @return 矩形内所有 tile 的最大深度都不大于 minDepth 时返回 true；矩形完全在屏幕外也返回 true
+	 */
+	bool isOccluded(const float minX, const float minY, const float maxX, const float maxY, const float minDepth) const;
+
+	/**
+	 * @brief 投影后的包围盒是否被完全遮挡
+	 * @param corners 裁剪空间的包围盒顶点（通常为 8 个）
+	 * @param count 顶点数
+	 * @param clipDepth 裁剪空间深度范围
+	 * @return 有顶点 w 不为正（跨过相机平面）或投影坐标为 NaN 时保守地返回 false
+	 */
+	template <CheckPolicy P>
+	bool isOccluded(const TVector4<float, P>* corners, const size_t count,
+		const ClipDepth clipDepth = ClipDepth::ZeroToOne) const;
+
+	/**
+	 * @brief 批量遮挡剔除，每个包围盒 8 个裁剪空间顶点
+	 * @param corners 顶点，长度为 8 * boxCount
+	 * @param boxCount 包围盒数
+	 * @param visible 输出，未被遮挡为 1
+	 * @param clipDepth 裁剪空间深度范围
+	 * @param pool 线程池
+	 * @return 可见的包围盒数
+	 */
+	template <CheckPolicy P>
+	size_t cullBoxes(const TVector4<float, P>* corners, const size_t boxCount, uint8_t* visible,
+		const ClipDepth clipDepth = ClipDepth::ZeroToOne, ThreadPool& pool = ThreadPool::instance()) const;
+
+private:
+	struct Level
+	{
+		size_t width;
+		size_t height;
+		size_t offset;
+	};
+
+	static constexpr size_t s_tilePixels = s_tileSize * s_tileSize;
+	static constexpr size_t s_cullGrain = 256;
+
+	float* tile(const size_t tileX, const size_t tileY);
+	const float* tile(const size_t tileX, const size_t tileY) const;
+	uint64_t validMask(const size_t tileX, const size_t tileY) const;
+	void updateTile(const size_t index);
+	bool isOccluded(const float* corners, const size_t count, const ClipDepth clipDepth) const;
+	bool isOccluded(const size_t level, const size_t nodeX, const size_t nodeY, const size_t tileX0,
+		const size_t tileY0, const size_t tileX1, const size_t tileY1, const float minDepth) const;
+
+private:
+	size_t m_width = 0;
+	size_t m_height = 0;
+	size_t m_tilesX = 0;
+	size_t m_tilesY = 0;
+	std::vector<float> m_depths;
+	std::vector<uint8_t> m_dirty;
+	std::vector<Level> m_levels;
+	std::vector<float> m_minDepths;
+	std::vector<float> m_maxDepths;
+};
+
+template <CheckPolicy P>
+bool DepthBuffer::isOccluded(const TVector4<float, P>* corners, const size_t count, const ClipDepth clipDepth) const
+{
+	static_assert(sizeof(TVector4<float, P>) == 4 * sizeof(float), "TVector4<float> must be tightly packed");
+	return 0 != count && isOccluded(corners[0].data(), count, clipDepth);
+}
+
+template <CheckPolicy P>
+size_t DepthBuffer::cullBoxes(const TVector4<float, P>* corners, const size_t boxCount, uint8_t* visible,
+	const ClipDepth clipDepth, ThreadPool& pool) const
+{
+	static_assert(sizeof(TVector4<float, P>) == 4 * sizeof(float), "TVector4<float> must be tightly packed");
+	if (0 == boxCount)
+	{
+		return 0;
+	}
+
+	const float* raw = corners[0].data();
+	pool.parallelFor(0, boxCount, s_cullGrain, [=, this](size_t begin, size_t end)
+	{
+		for (size_t i(begin); i < end; ++i)
+		{
+			visible[i] = isOccluded(raw + 32 * i, 8, clipDepth) ? 0 : 1;
+		}
+	});
+
+	size_t count(0);
+	for (size_t i(0); i < boxCount; ++i)
+	{
+		count += visible[i];
+	}
+	return count;
+}
+
+END_NAMESPACE
+
+#endif
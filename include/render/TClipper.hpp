@@ -0,0 +1,405 @@
+#ifndef __TCLIPPER_HPP__
+#define __TCLIPPER_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 裁剪空间深度范围
+ * NegativeOneToOne : -w <= z <= w（OpenGL）
+ * ZeroToOne        : 0 <= z <= w（Direct3D / Vulkan）
+ */
+enum class ClipDepth
+{
+	NegativeOneToOne,
+	ZeroToOne
+};
+
+/*!
+ * 批量裁剪结果，按三角形列表存储（每 3 个顶点一个三角形）
+ * 重心坐标相对原三角形，用于插值其余顶点属性
+ * 跨帧复用同一对象可避免重复分配
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+struct TClipResult
+{
+	std::vector<TVector4<T, P>> positions;
+	std::vector<TVector3<T, P>> barycentrics;
+	std::vector<uint32_t> triangles;
+
+	/**
+	 * @brief 清空结果，保留容量
+	 */
+	void clear()
+	{
+		positions.clear();
+		barycentrics.clear();
+		triangles.clear();
+	}
+
+	/**
+	 * @brief 输出三角形数
+	 */
+	size_t triangleCount() const
+	{
+		return triangles.size();
+	}
+};
+
+/*!
+ * 齐次空间三角形裁剪
+ * 每个顶点的 outcode 先批量计算（float 下以 SSE2 每次处理 4 个顶点），再逐三角形：
+ *   三个顶点在视锥同一平面外侧 -> 直接剔除
+ *   三个顶点都在保护带内       -> 直接接受，不做裁剪，由光栅化阶段做屏幕裁剪
+ *   其余                       -> Sutherland-Hodgman 依次裁剪涉及的平面，近/远平面按视锥，左右上下按保护带
+ * 输出顶点满足 w >= 0，可安全做透视除法
+ * 实例内含 outcode 缓存，不可被多个线程同时使用
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TClipper
+{
+public:
+	using Vector3 = TVector3<T, P>;
+	using Vector4 = TVector4<T, P>;
+
+	/**
+	 * outcode 各位：0 左，1 下，2 近，3 右，4 上，5 远
+	 * 低 6 位相对保护带，再左移 s_frustumShift 位为相对视锥
+	 */
+	static constexpr uint32_t s_planeMask = 0x3f;
+	static constexpr uint32_t s_frustumShift = 8;
+
+	/**
+	 * 裁剪后多边形顶点数上界
+	 * 精确运算下每个平面至多增加 1 个顶点（3 + 6 = 9）；但插值出的顶点到后续平面的距离有舍入，
+	 * 近退化输入上内外符号可能交替，n 边形过一个平面最多得到 n 个内侧顶点中的 k 个加 2 * min(k, n - k) 个交点，
+	 * 即 floor(3n / 2)，6 个平面依次为 3 -> 4 -> 6 -> 9 -> 13 -> 19 -> 28
+	 */
+	static constexpr size_t s_maxVertices = 28;
+
+	/**
+	 * @param depth 深度范围
+	 * @param guardBand 保护带倍数，左右上下平面放宽为 |x|, |y| <= guardBand * w，小于 1 时按 1 处理
+	 */
+	explicit TClipper(const ClipDepth depth = ClipDepth::NegativeOneToOne, const T guardBand = T(1));
+
+	/**
+	 * @brief 计算单个顶点的 outcode
+	 */
+	uint32_t outcode(const Vector4& vertex) const;
+
+	/**
+	 * @brief 裁剪单个三角形
+	 * @param a, b, c 裁剪空间顶点
+	 * @param positions 输出多边形顶点，容量至少 s_maxVertices
+	 * @param barycentrics 输出各顶点相对原三角形的重心坐标，容量至少 s_maxVertices
+	 * @return 多边形顶点数，完全裁掉时返回 0
+	 */
+	size_t clipTriangle(const Vector4& a, const Vector4& b, const Vector4& c, Vector4* positions,
+		Vector3* barycentrics) const;
+
+	/**
+	 * @brief 批量裁剪索引三角形，结果追加到 result 末尾
+	 * @param positions 裁剪空间顶点
+	 * @param vertexCount 顶点数
+	 * @param indices 三角形索引
+	 * @param triangleCount 三角形数
+	 * @param result 输出，triangles 记录每个输出三角形对应的输入三角形序号
+	 */
+	void clip(const Vector4* positions, const size_t vertexCount, const uint32_t* indices, const size_t triangleCount,
+		TClipResult<T, P>& result);
+
+private:
+	struct ClipVertex
+	{
+		T position[4];
+		T barycentric[3];
+	};
+
+	void computeOutcodes(const Vector4* positions, const size_t count);
+	T distance(const T* position, const uint32_t plane) const;
+	size_t clipPolygon(const uint32_t planes, ClipVertex* polygon, size_t count) const;
+
+private:
+	T m_guardBand;
+	T m_near;
+	std::vector<uint16_t> m_codes;
+};
+
+template <floattype T, CheckPolicy P>
+TClipper<T, P>::TClipper(const ClipDepth depth, const T guardBand)
+	: m_guardBand(std::max(T(1), guardBand))
+	, m_near(ClipDepth::NegativeOneToOne == depth ? T(1) : T(0))
+{
+}
+
+template <floattype T, CheckPolicy P>
+uint32_t TClipper<T, P>::outcode(const Vector4& vertex) const
+{
+	const T x = vertex.x(), y = vertex.y(), z = vertex.z(), w = vertex.w();
+	const T gw = m_guardBand * w;
+	uint32_t code(0);
+	code |= x < -gw ? 1u : 0u;
+	code |= y < -gw ? 2u : 0u;
+	code |= z < -m_near * w ? 4u : 0u;
+	code |= x > gw ? 8u : 0u;
+	code |= y > gw ? 16u : 0u;
+	code |= z > w ? 32u : 0u;
+
+	uint32_t frustum(code & 36u);
+	frustum |= x < -w ? 1u : 0u;
+	frustum |= y < -w ? 2u : 0u;
+	frustum |= x > w ? 8u : 0u;
+	frustum |= y > w ? 16u : 0u;
+	return code | (frustum << s_frustumShift);
+}
+
+template <floattype T, CheckPolicy P>
+void TClipper<T, P>::computeOutcodes(const Vector4* positions, const size_t count)
+{
+	m_codes.resize(count);
+	size_t i(0);
+
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float>)
+	{
+		static_assert(sizeof(Vector4) == 4 * sizeof(float), "TVector4<float> must be tightly packed");
+		const float* raw = reinterpret_cast<const float*>(positions);
+		const __m128 guard = _mm_set1_ps(m_guardBand);
+		const __m128 nearScale = _mm_set1_ps(-m_near);
+		const __m128 zero = _mm_setzero_ps();
+		auto bits = [](const __m128 mask, const int bit)
+		{
+			return _mm_and_si128(_mm_castps_si128(mask), _mm_set1_epi32(bit));
+		};
+
+		alignas(16) int32_t lanes[4];
+		for (; i + 4 <= count; i += 4)
+		{
+			// 4 个顶点转置为 SoA 后一次比较
+			__m128 x = _mm_loadu_ps(raw + 4 * i);
+			__m128 y = _mm_loadu_ps(raw + 4 * i + 4);
+			__m128 z = _mm_loadu_ps(raw + 4 * i + 8);
+			__m128 w = _mm_loadu_ps(raw + 4 * i + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+
+			const __m128 gw = _mm_mul_ps(guard, w);
+			const __m128 negGw = _mm_sub_ps(zero, gw);
+			const __m128 negW = _mm_sub_ps(zero, w);
+			const __m128 zNear = _mm_cmplt_ps(z, _mm_mul_ps(nearScale, w));
+			const __m128 zFar = _mm_cmpgt_ps(z, w);
+
+			__m128i code = _mm_or_si128(bits(_mm_cmplt_ps(x, negGw), 1), bits(_mm_cmplt_ps(y, negGw), 2));
+			code = _mm_or_si128(code, _mm_or_si128(bits(zNear, 4 | (4 << s_frustumShift)),
+				bits(zFar, 32 | (32 << s_frustumShift))));
+			code = _mm_or_si128(code, _mm_or_si128(bits(_mm_cmpgt_ps(x, gw), 8), bits(_mm_cmpgt_ps(y, gw), 16)));
+			code = _mm_or_si128(code, _mm_or_si128(bits(_mm_cmplt_ps(x, negW), 1 << s_frustumShift),
+				bits(_mm_cmplt_ps(y, negW), 2 << s_frustumShift)));
+			code = _mm_or_si128(code, _mm_or_si128(bits(_mm_cmpgt_ps(x, w), 8 << s_frustumShift),
+				bits(_mm_cmpgt_ps(y, w), 16 << s_frustumShift)));
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), code);
+			for (int k(0); k < 4; ++k)
+			{
+				m_codes[i + k] = static_cast<uint16_t>(lanes[k]);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		m_codes[i] = static_cast<uint16_t>(outcode(positions[i]));
+	}
+}
+
+template <floattype T, CheckPolicy P>
+T TClipper<T, P>::distance(const T* position, const uint32_t plane) const
+{
+	const T gw = m_guardBand * position[3];
+	switch (plane)
+	{
+	case 0:
+		return position[0] + gw;
+	case 1:
+		return position[1] + gw;
+	case 2:
+		return position[2] + m_near * position[3];
+	case 3:
+		return gw - position[0];
+	case 4:
+		return gw - position[1];
+	default:
+		return position[3] - position[2];
+	}
+}
+
+template <floattype T, CheckPolicy P>
+size_t TClipper<T, P>::clipPolygon(const uint32_t planes, ClipVertex* polygon, size_t count) const
+{
+	ClipVertex buffer[s_maxVertices];
+	ClipVertex* input = polygon;
+	ClipVertex* output = buffer;
+
+	// 先裁近平面，保证后续平面上的交点 w > 0
+	for (const uint32_t plane : { 2u, 5u, 0u, 3u, 1u, 4u })
+	{
+		if (0 == (planes & (1u << plane)))
+		{
+			continue;
+		}
+
+		T d[s_maxVertices];
+		for (size_t i(0); i < count; ++i)
+		{
+			d[i] = distance(input[i].position, plane);
+		}
+
+		size_t produced(0);
+		for (size_t i(0); i < count; ++i)
+		{
+			const size_t j = i + 1 == count ? 0 : i + 1;
+			const bool inside = d[i] >= T(0);
+			if (inside)
+			{
+				assert(produced < s_maxVertices);
+				output[produced++] = input[i];
+			}
+			if (inside != (d[j] >= T(0)))
+			{
+				// 总是从内侧顶点向外侧顶点插值，相邻三角形的公共边得到完全相同的交点
+				const ClipVertex& from = inside ? input[i] : input[j];
+				const ClipVertex& to = inside ? input[j] : input[i];
+				const T dFrom = inside ? d[i] : d[j];
+				const T dTo = inside ? d[j] : d[i];
+				const T t = dFrom / (dFrom - dTo);
+
+				assert(produced < s_maxVertices);
+				ClipVertex& v = output[produced++];
+				for (int k(0); k < 4; ++k)
+				{
+					v.position[k] = from.position[k] + (to.position[k] - from.position[k]) * t;
+				}
+				for (int k(0); k < 3; ++k)
+				{
+					v.barycentric[k] = from.barycentric[k] + (to.barycentric[k] - from.barycentric[k]) * t;
+				}
+			}
+		}
+
+		count = produced;
+		if (count < 3)
+		{
+			return 0;
+		}
+		std::swap(input, output);
+	}
+
+	if (input != polygon)
+	{
+		std::copy(input, input + count, polygon);
+	}
+	return count;
+}
+
+template <floattype T, CheckPolicy P>
+size_t TClipper<T, P>::clipTriangle(const Vector4& a, const Vector4& b, const Vector4& c, Vector4* positions,
+	Vector3* barycentrics) const
+{
+	const uint32_t ca = outcode(a), cb = outcode(b), cc = outcode(c);
+	if (0 != (ca & cb & cc & (s_planeMask << s_frustumShift)))
+	{
+		return 0;
+	}
+
+	ClipVertex polygon[s_maxVertices] = {
+		{ { a.x(), a.y(), a.z(), a.w() }, { T(1), T(0), T(0) } },
+		{ { b.x(), b.y(), b.z(), b.w() }, { T(0), T(1), T(0) } },
+		{ { c.x(), c.y(), c.z(), c.w() }, { T(0), T(0), T(1) } }
+	};
+	const size_t count = clipPolygon((ca | cb | cc) & s_planeMask, polygon, 3);
+	for (size_t i(0); i < count; ++i)
+	{
+		const ClipVertex& v = polygon[i];
+		positions[i].set(v.position[0], v.position[1], v.position[2], v.position[3]);
+		barycentrics[i].set(v.barycentric[0], v.barycentric[1], v.barycentric[2]);
+	}
+	return count;
+}
+
+template <floattype T, CheckPolicy P>
+void TClipper<T, P>::clip(const Vector4* positions, const size_t vertexCount, const uint32_t* indices,
+	const size_t triangleCount, TClipResult<T, P>& result)
+{
+	computeOutcodes(positions, vertexCount);
+
+	const Vector3 corner0(T(1), T(0), T(0));
+	const Vector3 corner1(T(0), T(1), T(0));
+	const Vector3 corner2(T(0), T(0), T(1));
+	for (size_t t(0); t < triangleCount; ++t)
+	{
+		const uint32_t i0 = indices[3 * t], i1 = indices[3 * t + 1], i2 = indices[3 * t + 2];
+		if (!checkCondition<P>(i0 < vertexCount && i1 < vertexCount && i2 < vertexCount))
+		{
+			continue;
+		}
+
+		const uint32_t c0 = m_codes[i0], c1 = m_codes[i1], c2 = m_codes[i2];
+		if (0 != (c0 & c1 & c2 & (s_planeMask << s_frustumShift)))
+		{
+			continue;
+		}
+
+		const uint32_t planes = (c0 | c1 | c2) & s_planeMask;
+		if (0 == planes)
+		{
+			result.positions.push_back(positions[i0]);
+			result.positions.push_back(positions[i1]);
+			result.positions.push_back(positions[i2]);
+			result.barycentrics.push_back(corner0);
+			result.barycentrics.push_back(corner1);
+			result.barycentrics.push_back(corner2);
+			result.triangles.push_back(static_cast<uint32_t>(t));
+			continue;
+		}
+
+		const Vector4& a = positions[i0];
+		const Vector4& b = positions[i1];
+		const Vector4& c = positions[i2];
+		ClipVertex polygon[s_maxVertices] = {
+			{ { a.x(), a.y(), a.z(), a.w() }, { T(1), T(0), T(0) } },
+			{ { b.x(), b.y(), b.z(), b.w() }, { T(0), T(1), T(0) } },
+			{ { c.x(), c.y(), c.z(), c.w() }, { T(0), T(0), T(1) } }
+		};
+		const size_t count = clipPolygon(planes, polygon, 3);
+
+		// 凸多边形按扇形三角化
+		for (size_t k(1); k + 1 < count; ++k)
+		{
+			for (const size_t v : { size_t(0), k, k + 1 })
+			{
+				const ClipVertex& cv = polygon[v];
+				result.positions.push_back(Vector4(cv.position[0], cv.position[1], cv.position[2], cv.position[3]));
+				result.barycentrics.push_back(Vector3(cv.barycentric[0], cv.barycentric[1], cv.barycentric[2]));
+			}
+			result.triangles.push_back(static_cast<uint32_t>(t));
+		}
+	}
+}
+
+END_NAMESPACE
+
+#endif
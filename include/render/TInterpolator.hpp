@@ -0,0 +1,316 @@
+#ifndef __TINTERPOLATOR_HPP__
+#define __TINTERPOLATOR_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <cstddef>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 三角形三个顶点的属性，按分量平铺存储
+ * 可把 UV（TVector2）、法线（TVector3）、颜色（TVector4）等依次追加，
+ * 插值时一次处理全部分量
+ */
+template <floattype T>
+class TTriangleAttributes
+{
+public:
+	static constexpr size_t s_maxComponents = 32;
+
+	TTriangleAttributes() = default;
+
+	/**
+	 * @brief 追加一个标量属性
+	 * @return 该属性第一个分量的序号，失败返回 s_maxComponents
+	 */
+	size_t append(const T a0, const T a1, const T a2);
+
+	template <CheckPolicy P>
+	size_t append(const TVector2<T, P>& a0, const TVector2<T, P>& a1, const TVector2<T, P>& a2);
+
+	template <CheckPolicy P>
+	size_t append(const TVector3<T, P>& a0, const TVector3<T, P>& a1, const TVector3<T, P>& a2);
+
+	template <CheckPolicy P>
+	size_t append(const TVector4<T, P>& a0, const TVector4<T, P>& a1, const TVector4<T, P>& a2);
+
+	/**
+	 * @brief 清空属性
+	 */
+	void clear();
+
+	size_t componentCount() const;
+
+	/**
+	 * @brief 第 vertex 个顶点第 component 个分量
+	 */
+	T value(const size_t vertex, const size_t component) const;
+
+private:
+	size_t appendComponents(const T* a0, const T* a1, const T* a2, const size_t count);
+
+private:
+	T m_values[3][s_maxComponents] = {};
+	size_t m_count = 0;
+};
+
+/*!
+ * 批量属性插值，输入输出均为 SoA 流
+ * 像素按 2x2 像素块（4 个一组）处理，每组一次完成全部分量，便于编译器向量化
+ */
+template <floattype T>
+class TInterpolator
+{
+public:
+	/**
+	 * @brief 标量流线性插值 out = a + (b - a) * t
+	 * @param a 起点
+	 * @param b 终点
+	 * @param t 插值参数
+	 * @param out 输出
+	 * @param count 元素数
+	 */
+	static void lerp(const T* a, const T* b, const T* t, T* out, const size_t count);
+
+	/**
+	 * @brief 向量数组线性插值，支持 TVector2/3/4
+	 * @param a 起点
+	 * @param b 终点
+	 * @param t 插值参数
+	 * @param out 输出
+	 * @param count 元素数
+	 */
+	template <typename Vector>
+	static void lerp(const Vector* a, const Vector* b, const T* t, Vector* out, const size_t count);
+
+	/**
+	 * @brief 重心坐标插值，attr = b0 * A0 + b1 * A1 + b2 * A2
+	 * @param attributes 三角形顶点属性
+	 * @param b0 第一个重心坐标流
+	 * @param b1 第二个重心坐标流
+	 * @param b2 第三个重心坐标流
+	 * @param pixelCount 像素数
+	 * @param out 每个分量一个输出流，数量为 attributes.componentCount()
+	 */
+	static void barycentric(const TTriangleAttributes<T>& attributes, const T* b0, const T* b1, const T* b2,
+		const size_t pixelCount, T* const* out);
+
+	/**
+	 * @brief 透视校正插值，attr = sum(bi * Ai / wi) / sum(bi / wi)
+	 * @param attributes 三角形顶点属性
+	 * @param invW 三个顶点裁剪空间 w 的倒数
+	 * @param b0 第一个屏幕空间重心坐标流
+	 * @param b1 第二个屏幕空间重心坐标流
+	 * @param b2 第三个屏幕空间重心坐标流
+	 * @param pixelCount 像素数
+	 * @param out 每个分量一个输出流
+	 * @param outW 可选，输出插值后的 w，为 nullptr 时不输出
+	 */
+	static void perspectiveCorrect(const TTriangleAttributes<T>& attributes, const T invW[3],
+		const T* b0, const T* b1, const T* b2, const size_t pixelCount, T* const* out, T* outW = nullptr);
+
+private:
+	static constexpr size_t s_quad = 4;
+};
+
+template <floattype T>
+size_t TTriangleAttributes<T>::appendComponents(const T* a0, const T* a1, const T* a2, const size_t count)
+{
+	if (m_count + count > s_maxComponents)
+	{
+		return s_maxComponents;
+	}
+
+	const size_t first = m_count;
+	for (size_t i(0); i < count; ++i)
+	{
+		m_values[0][m_count] = a0[i];
+		m_values[1][m_count] = a1[i];
+		m_values[2][m_count] = a2[i];
+		++m_count;
+	}
+	return first;
+}
+
+template <floattype T>
+size_t TTriangleAttributes<T>::append(const T a0, const T a1, const T a2)
+{
+	return appendComponents(&a0, &a1, &a2, 1);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+size_t TTriangleAttributes<T>::append(const TVector2<T, P>& a0, const TVector2<T, P>& a1, const TVector2<T, P>& a2)
+{
+	const T v0[] = { a0.x(), a0.y() };
+	const T v1[] = { a1.x(), a1.y() };
+	const T v2[] = { a2.x(), a2.y() };
+	return appendComponents(v0, v1, v2, 2);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+size_t TTriangleAttributes<T>::append(const TVector3<T, P>& a0, const TVector3<T, P>& a1, const TVector3<T, P>& a2)
+{
+	const T v0[] = { a0.x(), a0.y(), a0.z() };
+	const T v1[] = { a1.x(), a1.y(), a1.z() };
+	const T v2[] = { a2.x(), a2.y(), a2.z() };
+	return appendComponents(v0, v1, v2, 3);
+}
+
+template <floattype T>
+template <CheckPolicy P>
+size_t TTriangleAttributes<T>::append(const TVector4<T, P>& a0, const TVector4<T, P>& a1, const TVector4<T, P>& a2)
+{
+	const T v0[] = { a0.x(), a0.y(), a0.z(), a0.w() };
+	const T v1[] = { a1.x(), a1.y(), a1.z(), a1.w() };
+	const T v2[] = { a2.x(), a2.y(), a2.z(), a2.w() };
+	return appendComponents(v0, v1, v2, 4);
+}
+
+template <floattype T>
+void TTriangleAttributes<T>::clear()
+{
+	m_count = 0;
+}
+
+template <floattype T>
+size_t TTriangleAttributes<T>::componentCount() const
+{
+	return m_count;
+}
+
+template <floattype T>
+T TTriangleAttributes<T>::value(const size_t vertex, const size_t component) const
+{
+	return m_values[vertex][component];
+}
+
+template <floattype T>
+void TInterpolator<T>::lerp(const T* a, const T* b, const T* t, T* out, const size_t count)
+{
+	for (size_t i(0); i < count; ++i)
+	{
+		out[i] = a[i] + (b[i] - a[i]) * t[i];
+	}
+}
+
+template <floattype T>
+template <typename Vector>
+void TInterpolator<T>::lerp(const Vector* a, const Vector* b, const T* t, Vector* out, const size_t count)
+{
+	for (size_t i(0); i < count; ++i)
+	{
+		const T s = t[i];
+		const T x = a[i].x() + (b[i].x() - a[i].x()) * s;
+		const T y = a[i].y() + (b[i].y() - a[i].y()) * s;
+		if constexpr (requires(const Vector& v) { v.w(); })
+		{
+			out[i].set(x, y, a[i].z() + (b[i].z() - a[i].z()) * s, a[i].w() + (b[i].w() - a[i].w()) * s);
+		}
+		else if constexpr (requires(const Vector& v) { v.z(); })
+		{
+			out[i].set(x, y, a[i].z() + (b[i].z() - a[i].z()) * s);
+		}
+		else
+		{
+			out[i].set(x, y);
+		}
+	}
+}
+
+template <floattype T>
+void TInterpolator<T>::barycentric(const TTriangleAttributes<T>& attributes, const T* b0, const T* b1, const T* b2,
+	const size_t pixelCount, T* const* out)
+{
+	const size_t components = attributes.componentCount();
+	const size_t quadEnd = pixelCount - pixelCount % s_quad;
+
+	for (size_t p(0); p < quadEnd; p += s_quad)
+	{
+		for (size_t c(0); c < components; ++c)
+		{
+			const T a0 = attributes.value(0, c);
+			const T a1 = attributes.value(1, c);
+			const T a2 = attributes.value(2, c);
+			T* dst = out[c] + p;
+			for (size_t i(0); i < s_quad; ++i)
+			{
+				dst[i] = b0[p + i] * a0 + b1[p + i] * a1 + b2[p + i] * a2;
+			}
+		}
+	}
+
+	for (size_t p(quadEnd); p < pixelCount; ++p)
+	{
+		for (size_t c(0); c < components; ++c)
+		{
+			out[c][p] = b0[p] * attributes.value(0, c) + b1[p] * attributes.value(1, c) + b2[p] * attributes.value(2, c);
+		}
+	}
+}
+
+template <floattype T>
+void TInterpolator<T>::perspectiveCorrect(const TTriangleAttributes<T>& attributes, const T invW[3],
+	const T* b0, const T* b1, const T* b2, const size_t pixelCount, T* const* out, T* outW)
+{
+	// 顶点属性预先除以 w，每个像素只需一次倒数
+	const size_t components = attributes.componentCount();
+	TTriangleAttributes<T> scaled;
+	for (size_t c(0); c < components; ++c)
+	{
+		scaled.append(attributes.value(0, c) * invW[0], attributes.value(1, c) * invW[1], attributes.value(2, c) * invW[2]);
+	}
+
+	const size_t quadEnd = pixelCount - pixelCount % s_quad;
+	for (size_t p(0); p < quadEnd; p += s_quad)
+	{
+		T w[s_quad];
+		for (size_t i(0); i < s_quad; ++i)
+		{
+			w[i] = T(1) / (b0[p + i] * invW[0] + b1[p + i] * invW[1] + b2[p + i] * invW[2]);
+		}
+
+		for (size_t c(0); c < components; ++c)
+		{
+			const T a0 = scaled.value(0, c);
+			const T a1 = scaled.value(1, c);
+			const T a2 = scaled.value(2, c);
+			T* dst = out[c] + p;
+			for (size_t i(0); i < s_quad; ++i)
+			{
+				dst[i] = (b0[p + i] * a0 + b1[p + i] * a1 + b2[p + i] * a2) * w[i];
+			}
+		}
+
+		if (nullptr != outW)
+		{
+			for (size_t i(0); i < s_quad; ++i)
+			{
+				outW[p + i] = w[i];
+			}
+		}
+	}
+
+	for (size_t p(quadEnd); p < pixelCount; ++p)
+	{
+		const T w = T(1) / (b0[p] * invW[0] + b1[p] * invW[1] + b2[p] * invW[2]);
+		for (size_t c(0); c < components; ++c)
+		{
+			out[c][p] = (b0[p] * scaled.value(0, c) + b1[p] * scaled.value(1, c) + b2[p] * scaled.value(2, c)) * w;
+		}
+
+		if (nullptr != outW)
+		{
+			outW[p] = w;
+		}
+	}
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef __TEXTURE_H__
+#define __TEXTURE_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "render/ColorTool.h"
+#include "parallel/ThreadPool.h"
+#include "vector/TVector4.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 纹素存储格式，RGBA8 采样结果为 [0, 1] 的线性值
+ */
+enum class TextureFormat
+{
+	RGBA8,
+	RGBA32F
+};
+
+/*!
+ * 纹理坐标超出 [0, 1] 时的寻址方式
+ */
+enum class WrapMode
+{
+	Repeat,
+	Clamp,
+	Mirror
+};
+
+/*!
+ * 采样过滤方式
+ * Bilinear  : 在最接近 lod 的一级 mip 上双线性插值
+ * Trilinear : 在相邻两级 mip 上双线性插值后再按 lod 的小数部分插值
+ */
+enum class TextureFilter
+{
+	Bilinear,
+	Trilinear
+};
+
+/*!
+ * mip 链的降采样滤波器
+ * Box    : 2x2 平均
+ * Kaiser : 8 抽头可分离 Kaiser 窗 sinc，更锐利，RGBA8 结果截断到 [0, 1]
+ */
+enum class MipFilter
+{
+	Box,
+	Kaiser
+};
+
+struct TextureSampler
+{
+	TextureFilter filter = TextureFilter::Bilinear;
+	WrapMode wrapU = WrapMode::Repeat;
+	WrapMode wrapV = WrapMode::Repeat;
+};
+
+/*!
+ * 软件渲染用的 2D 纹理及 mip 链
+ * 每级按 4x4 纹素的 tile 存放（RGBA8 一个 tile 恰为 64 字节的一条缓存行），双线性的 2x2 邻域大多落在同一 tile 内
+ * 批量采样每 4 个像素一组：纹理坐标的寻址、取整与权重跨像素用 SSE 计算，每个纹素的 RGBA 作为一个向量插值
+ * 采样结果与像素在批中的位置无关
+ */
+class MATH_API Texture
+{
+public:
+	static constexpr size_t s_maxSize = 32768;
+
+	Texture() = default;
+
+	/**
+	 * @brief 由 8 位像素创建纹理（只有第 0 级）
+	 * @param pixels 按行存储的像素，每行 width 个
+	 * @param width 宽度
+	 * @param height 高度
+	 * @param format 输入像素的字节顺序，存储时统一为 RGBA
+	 * @return 尺寸为 0、超过 s_maxSize 或 pixels 为空时返回 false
+	 */
+	bool create(const uint8_t* pixels, const size_t width, const size_t height,
+		const PixelFormat format = PixelFormat::RGBA8);
+
+	/**
+	 * @brief 由浮点 RGBA 创建纹理（只有第 0 级），参数含义同上
+	 */
+	bool create(const float* rgba, const size_t width, const size_t height);
+
+	/**
+	 * @brief 由第 0 级生成完整 mip 链（直到 1x1），每级尺寸为上一级的一半向下取整
+	 * @param filter 降采样滤波器
+	 * @param pool 线程池，按目标行并行
+	 */
+	void generateMips(const MipFilter filter = MipFilter::Box, ThreadPool& pool = ThreadPool::instance());
+
+	TextureFormat format() const;
+	size_t levelCount() const;
+	size_t width(const size_t level = 0) const;
+	size_t height(const size_t level = 0) const;
+
+	/**
+	 * @brief 读取单个纹素
+	 */
+	TVector4<float> texel(const size_t level, const size_t x, const size_t y) const;
+
+	/**
+	 * @brief 把一级 mip 按行展开为浮点 RGBA
+	 * @param rgba 输出，长度为 4 * width(level) * height(level)
+	 */
+	void readLevel(const size_t level, float* rgba) const;
+
+	/**
+	 * @brief 批量采样
+	 * @param u 纹理坐标 u 流
+	 * @param v 纹理坐标 v 流
+	 * @param lod mip 级别流（以第 0 级为 0），为 nullptr 时全部取 0
+	 * @param count 像素数
+	 * @param sampler 采样状态
+	 * @param rgba 输出颜色，交错存储，长度为 4 * count
+	 */
+	void sample(const float* u, const float* v, const float* lod, const size_t count, const TextureSampler& sampler,
+		float* rgba) const;
+
+	/**
+	 * @brief 按 2x2 像素块采样，每个块的 lod 由块内纹理坐标的差分求出
+	 * @param u 纹理坐标 u，每 4 个为一个块，顺序为 (0, 0) (1, 0) (0, 1) (1, 1)
+	 * @param v 纹理坐标 v
+	 * @param quadCount 块数
+	 * @param sampler 采样状态
+	 * @param rgba 输出颜色，长度为 16 * quadCount
+	 * @param lodBias 加到计算出的 lod 上的偏移
+	 */
+	void sampleQuads(const float* u, const float* v, const size_t quadCount, const TextureSampler& sampler,
+		float* rgba, const float lodBias = 0.f) const;
+
+private:
+	struct Level
+	{
+		size_t width;
+		size_t height;
+		size_t tilesX;
+		size_t offset;
+	};
+
+	static constexpr size_t s_tile = 4;
+
+	size_t texelIndex(const Level& level, const size_t x, const size_t y) const;
+	void appendLevel(const size_t width, const size_t height);
+	void storeRow(const size_t level, const size_t y, const float* rgba);
+
+	template <TextureFormat F>
+	void sampleGroup(const float* u, const float* v, const float* lod, const TextureSampler& sampler,
+		float* rgba) const;
+
+	template <TextureFormat F>
+	void samplePixel(const float u, const float v, const float lod, const TextureSampler& sampler,
+		float* rgba) const;
+
+	template <TextureFormat F>
+	void sampleBatch(const float* u, const float* v, const float* lod, const size_t count,
+		const TextureSampler& sampler, float* rgba) const;
+
+private:
+	TextureFormat m_format = TextureFormat::RGBA8;
+	std::vector<Level> m_levels;
+	std::vector<uint8_t> m_bytes;
+	std::vector<float> m_floats;
+};
+
+END_NAMESPACE
+
+#endif
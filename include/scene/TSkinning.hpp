@@ -0,0 +1,508 @@
+#ifndef __TSKINNING_HPP__
+#define __TSKINNING_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include "parallel/ThreadPool.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 批量顶点蒙皮：线性混合（LBS）与对偶四元数（DQS）
+ * 每个顶点最多受 4 根骨骼影响，骨骼下标为 TVector4<int>，权重为 TVector4（应归一化，未使用的槽位权重为 0、下标任取合法值）
+ * 位置与法线按 SoA 流输入输出（x、y、z 各一个数组），输出可与输入为同一数组
+ * 顶点按区间分块并行；float 且开启 SSE2 时每 4 个顶点一组，混合后的骨骼变换转置为 SoA，跨顶点一次完成变换
+ * 骨骼矩阵与 TTransformHierarchy::Matrix 相同，为按行存放的 3x4 仿射矩阵，通常为 世界矩阵 * 绑定姿态逆矩阵
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TSkinning
+{
+public:
+	using Vector3 = TVector3<T, P>;
+	using Vector4 = TVector4<T, P>;
+	using Quaternion = TVector4<T, P>;
+	using Matrix = std::array<TVector4<T, P>, 3>;
+	using BoneIndices = TVector4<int, P>;
+
+	/*!
+	 * 单位对偶四元数表示的刚体变换：real 为旋转（x, y, z, w），dual = 0.5 * (t, 0) * real
+	 */
+	struct DualQuaternion
+	{
+		Quaternion real;
+		Quaternion dual;
+	};
+
+	/*!
+	 * 三分量 SoA 输入流，x 为 nullptr 表示不存在
+	 */
+	struct ConstStreams
+	{
+		const T* x = nullptr;
+		const T* y = nullptr;
+		const T* z = nullptr;
+	};
+
+	/*!
+	 * 三分量 SoA 输出流
+	 */
+	struct Streams
+	{
+		T* x = nullptr;
+		T* y = nullptr;
+		T* z = nullptr;
+	};
+
+	/**
+	 * @brief 线性混合蒙皮：M = sum(wi * palette[ii])，p' = M * p，n' = normalize(M3x3 * n)
+	 * @param palette 骨骼矩阵
+	 * @param boneCount 骨骼数
+	 * @param indices 每个顶点的骨骼下标
+	 * @param weights 每个顶点的骨骼权重
+	 * @param count 顶点数
+	 * @param positions 输入位置
+	 * @param outPositions 输出位置
+	 * @param normals 输入法线，可省略
+	 * @param outNormals 输出法线，normals 存在时必须提供
+	 * @param pool 线程池
+	 * @return 指针缺失或骨骼下标越界时返回 false（仅 Checked），此时不写入输出
+	 */
+	static bool linearBlend(const Matrix* palette, const size_t boneCount, const BoneIndices* indices,
+		const Vector4* weights, const size_t count, const ConstStreams& positions, const Streams& outPositions,
+		const ConstStreams& normals = {}, const Streams& outNormals = {}, ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 对偶四元数蒙皮：与第一根骨骼的旋转取同一半球后按权重混合并归一化，避免 LBS 的体积塌陷
+	 * @param palette 骨骼的对偶四元数，可由 toDualQuaternion 得到，骨骼变换不能含缩放
+	 * @return 同 linearBlend，其余参数含义同上
+	 */
+	static bool dualQuaternion(const DualQuaternion* palette, const size_t boneCount, const BoneIndices* indices,
+		const Vector4* weights, const size_t count, const ConstStreams& positions, const Streams& outPositions,
+		const ConstStreams& normals = {}, const Streams& outNormals = {}, ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 由单位四元数与平移构造对偶四元数
+	 */
+	static DualQuaternion toDualQuaternion(const Quaternion& rotation, const Vector3& translation);
+
+	/**
+	 * @brief 由刚体仿射矩阵（旋转部分正交、无缩放）构造对偶四元数
+	 */
+	static DualQuaternion toDualQuaternion(const Matrix& matrix);
+
+private:
+	static constexpr size_t s_grain = 4096;
+
+	template <typename Bone>
+	struct Batch
+	{
+		const Bone* palette;
+		const BoneIndices* indices;
+		const Vector4* weights;
+		ConstStreams positions;
+		Streams outPositions;
+		ConstStreams normals;
+		Streams outNormals;
+	};
+
+	template <typename Bone>
+	static bool validate(const Batch<Bone>& batch, const size_t boneCount, const size_t count);
+
+	static void linearBlend(const Batch<Matrix>& batch, size_t first, const size_t last);
+	static void dualQuaternion(const Batch<DualQuaternion>& batch, size_t first, const size_t last);
+};
+
+template <floattype T, CheckPolicy P>
+template <typename Bone>
+bool TSkinning<T, P>::validate(const Batch<Bone>& batch, const size_t boneCount, const size_t count)
+{
+	const bool hasNormals = nullptr != batch.normals.x;
+	if (!checkCondition<P>(nullptr != batch.palette && nullptr != batch.indices && nullptr != batch.weights
+		&& nullptr != batch.positions.x && nullptr != batch.positions.y && nullptr != batch.positions.z
+		&& nullptr != batch.outPositions.x && nullptr != batch.outPositions.y && nullptr != batch.outPositions.z
+		&& (!hasNormals || (nullptr != batch.normals.y && nullptr != batch.normals.z && nullptr != batch.outNormals.x
+			&& nullptr != batch.outNormals.y && nullptr != batch.outNormals.z))))
+	{
+		return false;
+	}
+
+	const int bones = static_cast<int>(boneCount);
+	for (size_t i(0); i < count; ++i)
+	{
+		const int* idx = batch.indices[i].data();
+		if (!checkCondition<P>(idx[0] >= 0 && idx[0] < bones && idx[1] >= 0 && idx[1] < bones
+			&& idx[2] >= 0 && idx[2] < bones && idx[3] >= 0 && idx[3] < bones))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+bool TSkinning<T, P>::linearBlend(const Matrix* palette, const size_t boneCount, const BoneIndices* indices,
+	const Vector4* weights, const size_t count, const ConstStreams& positions, const Streams& outPositions,
+	const ConstStreams& normals, const Streams& outNormals, ThreadPool& pool)
+{
+	const Batch<Matrix> batch{ palette, indices, weights, positions, outPositions, normals, outNormals };
+	if (!validate(batch, boneCount, count))
+	{
+		return false;
+	}
+
+	pool.parallelFor(0, count, s_grain, [&batch](size_t begin, size_t end)
+	{
+		linearBlend(batch, begin, end);
+	});
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+bool TSkinning<T, P>::dualQuaternion(const DualQuaternion* palette, const size_t boneCount, const BoneIndices* indices,
+	const Vector4* weights, const size_t count, const ConstStreams& positions, const Streams& outPositions,
+	const ConstStreams& normals, const Streams& outNormals, ThreadPool& pool)
+{
+	const Batch<DualQuaternion> batch{ palette, indices, weights, positions, outPositions, normals, outNormals };
+	if (!validate(batch, boneCount, count))
+	{
+		return false;
+	}
+
+	pool.parallelFor(0, count, s_grain, [&batch](size_t begin, size_t end)
+	{
+		dualQuaternion(batch, begin, end);
+	});
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+void TSkinning<T, P>::linearBlend(const Batch<Matrix>& batch, size_t first, const size_t last)
+{
+	const ConstStreams& in = batch.positions;
+	const Streams& out = batch.outPositions;
+	const ConstStreams& inN = batch.normals;
+	const Streams& outN = batch.outNormals;
+	const bool hasNormals = nullptr != inN.x;
+
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float>)
+	{
+		static_assert(sizeof(Matrix) == 12 * sizeof(float), "skinning matrix must be tightly packed");
+		const float* raw = reinterpret_cast<const float*>(batch.palette);
+		for (; first + 4 <= last; first += 4)
+		{
+			// 逐顶点混合 3 行（每行一个 __m128），再把 4 个顶点的同一行转置为跨顶点的列
+			__m128 rows[3][4];
+			for (size_t k(0); k < 4; ++k)
+			{
+				const int* idx = batch.indices[first + k].data();
+				const __m128 w = _mm_loadu_ps(batch.weights[first + k].data());
+				const __m128 w0 = _mm_shuffle_ps(w, w, 0x00);
+				const __m128 w1 = _mm_shuffle_ps(w, w, 0x55);
+				const __m128 w2 = _mm_shuffle_ps(w, w, 0xAA);
+				const __m128 w3 = _mm_shuffle_ps(w, w, 0xFF);
+				const float* b0 = raw + 12 * idx[0];
+				const float* b1 = raw + 12 * idx[1];
+				const float* b2 = raw + 12 * idx[2];
+				const float* b3 = raw + 12 * idx[3];
+				for (size_t r(0); r < 3; ++r)
+				{
+					__m128 row = _mm_mul_ps(_mm_loadu_ps(b0 + 4 * r), w0);
+					row = _mm_add_ps(row, _mm_mul_ps(_mm_loadu_ps(b1 + 4 * r), w1));
+					row = _mm_add_ps(row, _mm_mul_ps(_mm_loadu_ps(b2 + 4 * r), w2));
+					rows[r][k] = _mm_add_ps(row, _mm_mul_ps(_mm_loadu_ps(b3 + 4 * r), w3));
+				}
+			}
+
+			const __m128 px = _mm_loadu_ps(in.x + first);
+			const __m128 py = _mm_loadu_ps(in.y + first);
+			const __m128 pz = _mm_loadu_ps(in.z + first);
+			__m128 nx = _mm_setzero_ps(), ny = _mm_setzero_ps(), nz = _mm_setzero_ps();
+			if (hasNormals)
+			{
+				nx = _mm_loadu_ps(inN.x + first);
+				ny = _mm_loadu_ps(inN.y + first);
+				nz = _mm_loadu_ps(inN.z + first);
+			}
+
+			__m128 skinned[3];
+			__m128 rotated[3];
+			for (size_t r(0); r < 3; ++r)
+			{
+				__m128 c0 = rows[r][0], c1 = rows[r][1], c2 = rows[r][2], c3 = rows[r][3];
+				_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+				__m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, px), _mm_mul_ps(c1, py)), _mm_mul_ps(c2, pz));
+				skinned[r] = _mm_add_ps(v, c3);
+				rotated[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, nx), _mm_mul_ps(c1, ny)), _mm_mul_ps(c2, nz));
+			}
+
+			_mm_storeu_ps(out.x + first, skinned[0]);
+			_mm_storeu_ps(out.y + first, skinned[1]);
+			_mm_storeu_ps(out.z + first, skinned[2]);
+			if (hasNormals)
+			{
+				const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rotated[0], rotated[0]),
+					_mm_mul_ps(rotated[1], rotated[1])), _mm_mul_ps(rotated[2], rotated[2]));
+				const __m128 positive = _mm_cmpgt_ps(len2, _mm_setzero_ps());
+				const __m128 inv = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(len2));
+				const __m128 scale = _mm_or_ps(_mm_and_ps(positive, inv), _mm_andnot_ps(positive, _mm_set1_ps(1.f)));
+				_mm_storeu_ps(outN.x + first, _mm_mul_ps(rotated[0], scale));
+				_mm_storeu_ps(outN.y + first, _mm_mul_ps(rotated[1], scale));
+				_mm_storeu_ps(outN.z + first, _mm_mul_ps(rotated[2], scale));
+			}
+		}
+	}
+#endif
+
+	for (size_t i(first); i < last; ++i)
+	{
+		const int* idx = batch.indices[i].data();
+		const T* w = batch.weights[i].data();
+		T m[3][4];
+		for (size_t r(0); r < 3; ++r)
+		{
+			const T* b0 = batch.palette[idx[0]][r].data();
+			const T* b1 = batch.palette[idx[1]][r].data();
+			const T* b2 = batch.palette[idx[2]][r].data();
+			const T* b3 = batch.palette[idx[3]][r].data();
+			for (size_t c(0); c < 4; ++c)
+			{
+				m[r][c] = b0[c] * w[0] + b1[c] * w[1] + b2[c] * w[2] + b3[c] * w[3];
+			}
+		}
+
+		const T px = in.x[i], py = in.y[i], pz = in.z[i];
+		out.x[i] = m[0][0] * px + m[0][1] * py + m[0][2] * pz + m[0][3];
+		out.y[i] = m[1][0] * px + m[1][1] * py + m[1][2] * pz + m[1][3];
+		out.z[i] = m[2][0] * px + m[2][1] * py + m[2][2] * pz + m[2][3];
+		if (hasNormals)
+		{
+			const T nx = inN.x[i], ny = inN.y[i], nz = inN.z[i];
+			const T rx = m[0][0] * nx + m[0][1] * ny + m[0][2] * nz;
+			const T ry = m[1][0] * nx + m[1][1] * ny + m[1][2] * nz;
+			const T rz = m[2][0] * nx + m[2][1] * ny + m[2][2] * nz;
+			const T len2 = rx * rx + ry * ry + rz * rz;
+			const T scale = len2 > T(0) ? T(1) / std::sqrt(len2) : T(1);
+			outN.x[i] = rx * scale;
+			outN.y[i] = ry * scale;
+			outN.z[i] = rz * scale;
+		}
+	}
+}
+
+template <floattype T, CheckPolicy P>
+void TSkinning<T, P>::dualQuaternion(const Batch<DualQuaternion>& batch, size_t first, const size_t last)
+{
+	const ConstStreams& in = batch.positions;
+	const Streams& out = batch.outPositions;
+	const ConstStreams& inN = batch.normals;
+	const Streams& outN = batch.outNormals;
+	const bool hasNormals = nullptr != inN.x;
+
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float>)
+	{
+		static_assert(sizeof(DualQuaternion) == 8 * sizeof(float), "dual quaternion must be tightly packed");
+		const float* raw = reinterpret_cast<const float*>(batch.palette);
+		const __m128 signBit = _mm_set1_ps(-0.f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 two = _mm_set1_ps(2.f);
+		for (; first + 4 <= last; first += 4)
+		{
+			__m128 real[4];
+			__m128 dual[4];
+			for (size_t k(0); k < 4; ++k)
+			{
+				const int* idx = batch.indices[first + k].data();
+				__m128 q[4];
+				__m128 e[4];
+				for (size_t j(0); j < 4; ++j)
+				{
+					q[j] = _mm_loadu_ps(raw + 8 * idx[j]);
+					e[j] = _mm_loadu_ps(raw + 8 * idx[j] + 4);
+				}
+
+				// 4 个槽位的旋转与第一个槽位点乘，按符号翻转权重使其位于同一半球
+				__m128 tx = q[0], ty = q[1], tz = q[2], tw = q[3];
+				_MM_TRANSPOSE4_PS(tx, ty, tz, tw);
+				const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(tx, _mm_shuffle_ps(q[0], q[0], 0x00)), _mm_mul_ps(ty, _mm_shuffle_ps(q[0], q[0], 0x55))),
+					_mm_mul_ps(tz, _mm_shuffle_ps(q[0], q[0], 0xAA))), _mm_mul_ps(tw, _mm_shuffle_ps(q[0], q[0], 0xFF)));
+				const __m128 w = _mm_xor_ps(_mm_loadu_ps(batch.weights[first + k].data()),
+					_mm_and_ps(_mm_cmplt_ps(dot, zero), signBit));
+				const __m128 w0 = _mm_shuffle_ps(w, w, 0x00);
+				const __m128 w1 = _mm_shuffle_ps(w, w, 0x55);
+				const __m128 w2 = _mm_shuffle_ps(w, w, 0xAA);
+				const __m128 w3 = _mm_shuffle_ps(w, w, 0xFF);
+				real[k] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], w0), _mm_mul_ps(q[1], w1)),
+					_mm_mul_ps(q[2], w2)), _mm_mul_ps(q[3], w3));
+				dual[k] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e[0], w0), _mm_mul_ps(e[1], w1)),
+					_mm_mul_ps(e[2], w2)), _mm_mul_ps(e[3], w3));
+			}
+
+			__m128 rx = real[0], ry = real[1], rz = real[2], rw = real[3];
+			__m128 dx = dual[0], dy = dual[1], dz = dual[2], dw = dual[3];
+			_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+			_MM_TRANSPOSE4_PS(dx, dy, dz, dw);
+
+			// 归一化；混合结果退化时 inv 取 0，变换退化为恒等
+			const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+				_mm_mul_ps(rz, rz)), _mm_mul_ps(rw, rw));
+			const __m128 inv = _mm_and_ps(_mm_cmpgt_ps(len2, zero), _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(len2)));
+			rx = _mm_mul_ps(rx, inv); ry = _mm_mul_ps(ry, inv); rz = _mm_mul_ps(rz, inv); rw = _mm_mul_ps(rw, inv);
+			dx = _mm_mul_ps(dx, inv); dy = _mm_mul_ps(dy, inv); dz = _mm_mul_ps(dz, inv); dw = _mm_mul_ps(dw, inv);
+
+			// 旋转 v' = v + 2 * r x (r x v + rw * v)
+			auto rotate = [&](const __m128 vx, const __m128 vy, const __m128 vz, __m128 result[3])
+			{
+				const __m128 ax = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ry, vz), _mm_mul_ps(rz, vy)), _mm_mul_ps(rw, vx));
+				const __m128 ay = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rz, vx), _mm_mul_ps(rx, vz)), _mm_mul_ps(rw, vy));
+				const __m128 az = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, vy), _mm_mul_ps(ry, vx)), _mm_mul_ps(rw, vz));
+				result[0] = _mm_add_ps(vx, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(ry, az), _mm_mul_ps(rz, ay))));
+				result[1] = _mm_add_ps(vy, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(rz, ax), _mm_mul_ps(rx, az))));
+				result[2] = _mm_add_ps(vz, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(rx, ay), _mm_mul_ps(ry, ax))));
+			};
+
+			// 平移 t = 2 * (rw * d - dw * r + r x d)
+			const __m128 tx = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)),
+				_mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy))));
+			const __m128 ty = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)),
+				_mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz))));
+			const __m128 tz = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)),
+				_mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx))));
+
+			__m128 p[3];
+			rotate(_mm_loadu_ps(in.x + first), _mm_loadu_ps(in.y + first), _mm_loadu_ps(in.z + first), p);
+			__m128 n[3];
+			if (hasNormals)
+			{
+				rotate(_mm_loadu_ps(inN.x + first), _mm_loadu_ps(inN.y + first), _mm_loadu_ps(inN.z + first), n);
+			}
+			_mm_storeu_ps(out.x + first, _mm_add_ps(p[0], tx));
+			_mm_storeu_ps(out.y + first, _mm_add_ps(p[1], ty));
+			_mm_storeu_ps(out.z + first, _mm_add_ps(p[2], tz));
+			if (hasNormals)
+			{
+				_mm_storeu_ps(outN.x + first, n[0]);
+				_mm_storeu_ps(outN.y + first, n[1]);
+				_mm_storeu_ps(outN.z + first, n[2]);
+			}
+		}
+	}
+#endif
+
+	for (size_t i(first); i < last; ++i)
+	{
+		const int* idx = batch.indices[i].data();
+		const T* weight = batch.weights[i].data();
+		const T* q0 = batch.palette[idx[0]].real.data();
+		T real[4] = {};
+		T dual[4] = {};
+		for (size_t j(0); j < 4; ++j)
+		{
+			const T* q = batch.palette[idx[j]].real.data();
+			const T* e = batch.palette[idx[j]].dual.data();
+			const T dot = q[0] * q0[0] + q[1] * q0[1] + q[2] * q0[2] + q[3] * q0[3];
+			const T w = dot < T(0) ? -weight[j] : weight[j];
+			for (size_t c(0); c < 4; ++c)
+			{
+				real[c] = 0 == j ? q[c] * w : real[c] + q[c] * w;
+				dual[c] = 0 == j ? e[c] * w : dual[c] + e[c] * w;
+			}
+		}
+
+		const T len2 = real[0] * real[0] + real[1] * real[1] + real[2] * real[2] + real[3] * real[3];
+		const T inv = len2 > T(0) ? T(1) / std::sqrt(len2) : T(0);
+		const T rx = real[0] * inv, ry = real[1] * inv, rz = real[2] * inv, rw = real[3] * inv;
+		const T dx = dual[0] * inv, dy = dual[1] * inv, dz = dual[2] * inv, dw = dual[3] * inv;
+
+		auto rotate = [&](const T vx, const T vy, const T vz, T result[3])
+		{
+			const T ax = ry * vz - rz * vy + rw * vx;
+			const T ay = rz * vx - rx * vz + rw * vy;
+			const T az = rx * vy - ry * vx + rw * vz;
+			result[0] = vx + T(2) * (ry * az - rz * ay);
+			result[1] = vy + T(2) * (rz * ax - rx * az);
+			result[2] = vz + T(2) * (rx * ay - ry * ax);
+		};
+
+		T p[3];
+		rotate(in.x[i], in.y[i], in.z[i], p);
+		T n[3];
+		if (hasNormals)
+		{
+			rotate(inN.x[i], inN.y[i], inN.z[i], n);
+		}
+		out.x[i] = p[0] + T(2) * (rw * dx - dw * rx + (ry * dz - rz * dy));
+		out.y[i] = p[1] + T(2) * (rw * dy - dw * ry + (rz * dx - rx * dz));
+		out.z[i] = p[2] + T(2) * (rw * dz - dw * rz + (rx * dy - ry * dx));
+		if (hasNormals)
+		{
+			outN.x[i] = n[0];
+			outN.y[i] = n[1];
+			outN.z[i] = n[2];
+		}
+	}
+}
+
+template <floattype T, CheckPolicy P>
+typename TSkinning<T, P>::DualQuaternion TSkinning<T, P>::toDualQuaternion(const Quaternion& rotation,
+	const Vector3& translation)
+{
+	// dual = 0.5 * (t, 0) * q
+	const T tx = translation.x(), ty = translation.y(), tz = translation.z();
+	const T qx = rotation.x(), qy = rotation.y(), qz = rotation.z(), qw = rotation.w();
+	const Quaternion dual(
+		T(0.5) * (tx * qw + ty * qz - tz * qy),
+		T(0.5) * (ty * qw + tz * qx - tx * qz),
+		T(0.5) * (tz * qw + tx * qy - ty * qx),
+		T(-0.5) * (tx * qx + ty * qy + tz * qz));
+	return DualQuaternion{ rotation, dual };
+}
+
+template <floattype T, CheckPolicy P>
+typename TSkinning<T, P>::DualQuaternion TSkinning<T, P>::toDualQuaternion(const Matrix& matrix)
+{
+	const T m00 = matrix[0].x(), m01 = matrix[0].y(), m02 = matrix[0].z();
+	const T m10 = matrix[1].x(), m11 = matrix[1].y(), m12 = matrix[1].z();
+	const T m20 = matrix[2].x(), m21 = matrix[2].y(), m22 = matrix[2].z();
+
+	// 按最大对角分量选择分支，保证开方的参数远离 0
+	Quaternion q;
+	const T trace = m00 + m11 + m22;
+	if (trace > T(0))
+	{
+		const T s = std::sqrt(trace + T(1)) * T(2);
+		q.set((m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s, T(0.25) * s);
+	}
+	else if (m00 > m11 && m00 > m22)
+	{
+		const T s = std::sqrt(T(1) + m00 - m11 - m22) * T(2);
+		q.set(T(0.25) * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s);
+	}
+	else if (m11 > m22)
+	{
+		const T s = std::sqrt(T(1) + m11 - m00 - m22) * T(2);
+		q.set((m01 + m10) / s, T(0.25) * s, (m12 + m21) / s, (m02 - m20) / s);
+	}
+	else
+	{
+		const T s = std::sqrt(T(1) + m22 - m00 - m11) * T(2);
+		q.set((m02 + m20) / s, (m12 + m21) / s, T(0.25) * s, (m10 - m01) / s);
+	}
+	return toDualQuaternion(q, Vector3(matrix[0].w(), matrix[1].w(), matrix[2].w()));
+}
+
+END_NAMESPACE
+
+#endif
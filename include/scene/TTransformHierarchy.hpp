@@ -0,0 +1,441 @@
+#ifndef __TTRANSFORM_HIERARCHY_HPP__
+#define __TTRANSFORM_HIERARCHY_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 变换层级（场景图）：每个节点保存局部平移、旋转（四元数 x, y, z, w）与缩放，世界矩阵 = 父节点世界矩阵 * 局部矩阵
+ * 节点按父在前、子在后的拓扑顺序存放于按下标索引的扁平数组中；修改局部变换只标记脏节点，
+ * update 时只重算脏节点所在的子树，并按层（深度）从上到下逐层并行计算，开销与变化的节点数成正比
+ * 世界矩阵为 3x4 仿射矩阵，按行存放，每行末尾为平移分量
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TTransformHierarchy
+{
+public:
+	using Vector3 = TVector3<T, P>;
+	using Quaternion = TVector4<T, P>;
+	using Matrix = std::array<TVector4<T, P>, 3>;
+
+	/** @brief 无父节点（根节点）的父下标 */
+	static constexpr size_t s_noParent = std::numeric_limits<size_t>::max();
+
+public:
+	/**
+	 * @brief 添加节点，新节点标记为脏
+	 * @param parent 父节点下标，需为已存在的节点，根节点传 s_noParent
+	 * @param translation 局部平移
+	 * @param rotation 局部旋转，四元数 (x, y, z, w)，不要求单位长度，零四元数视为不旋转
+	 * @param scale 局部缩放
+	 * @return 新节点下标，父节点无效时返回 s_noParent
+	 */
+	size_t addNode(const size_t parent, const Vector3& translation, const Quaternion& rotation,
+		const Vector3& scale);
+
+	/**
+	 * @brief 设置局部变换并标记节点为脏
+	 * @return 节点无效时返回 false
+	 */
+	bool setLocal(const size_t node, const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+	bool setTranslation(const size_t node, const Vector3& translation);
+	bool setRotation(const size_t node, const Quaternion& rotation);
+	bool setScale(const size_t node, const Vector3& scale);
+
+	/**
+	 * @brief 局部变换与层级信息，node 需有效
+	 */
+	const Vector3& translation(const size_t node) const;
+	const Quaternion& rotation(const size_t node) const;
+	const Vector3& scale(const size_t node) const;
+	size_t parent(const size_t node) const;
+	size_t depth(const size_t node) const;
+
+	/**
+	 * @brief 世界矩阵，反映最近一次 update 的结果，node 需有效
+	 */
+	const Matrix& worldMatrix(const size_t node) const;
+
+	/**
+	 * @brief 用节点的世界矩阵变换点
+	 */
+	Vector3 transformPoint(const size_t node, const Vector3& point) const;
+
+	/**
+	 * @brief 重算所有脏子树的世界矩阵
+	 * @param pool 线程池，单层节点数不超过一个分块时在调用线程执行
+	 * @return 本次重算的节点数
+	 */
+	size_t update(ThreadPool& pool = ThreadPool::instance());
+
+	/**
+	 * @brief 是否有未 update 的修改
+	 */
+	bool dirty() const;
+
+	size_t size() const;
+	void clear();
+
+private:
+	static constexpr size_t s_grain = 1024;
+
+	void markDirty(const size_t node);
+	void buildChildren();
+	void collectSubtrees();
+	Matrix localMatrix(const size_t node) const;
+
+private:
+	std::vector<size_t> m_parents;
+	std::vector<uint32_t> m_depths;
+	std::vector<Vector3> m_translations;
+	std::vector<Quaternion> m_rotations;
+	std::vector<Vector3> m_scales;
+	std::vector<Matrix> m_world;
+
+	// 子节点表（CSR），拓扑变化后在下一次 update 时重建
+	std::vector<size_t> m_childOffsets;
+	std::vector<size_t> m_children;
+	bool m_childrenStale = true;
+
+	std::vector<uint8_t> m_dirtyFlags;
+	std::vector<size_t> m_dirtyNodes;
+
+	// update 的临时数据，跨帧复用以避免分配
+	std::vector<uint32_t> m_stamps;
+	uint32_t m_epoch = 0;
+	std::vector<size_t> m_pending;
+	std::vector<size_t> m_order;
+	std::vector<size_t> m_levelOffsets;
+	std::vector<size_t> m_stack;
+};
+
+template <floattype T, CheckPolicy P>
+size_t TTransformHierarchy<T, P>::addNode(const size_t parent, const Vector3& translation,
+	const Quaternion& rotation, const Vector3& scale)
+{
+	if (!checkCondition<P>(s_noParent == parent || parent < m_parents.size()))
+	{
+		return s_noParent;
+	}
+
+	const size_t node = m_parents.size();
+	m_parents.push_back(parent);
+	m_depths.push_back(s_noParent == parent ? 0 : m_depths[parent] + 1);
+	m_translations.push_back(translation);
+	m_rotations.push_back(rotation);
+	m_scales.push_back(scale);
+	m_world.push_back(Matrix{ Quaternion::xAxisVector, Quaternion::yAxisVector, Quaternion::zAxisVector });
+	m_dirtyFlags.push_back(0);
+	m_stamps.push_back(0);
+	m_childrenStale = true;
+	markDirty(node);
+	return node;
+}
+
+template <floattype T, CheckPolicy P>
+bool TTransformHierarchy<T, P>::setLocal(const size_t node, const Vector3& translation,
+	const Quaternion& rotation, const Vector3& scale)
+{
+	if (!checkCondition<P>(node < m_parents.size()))
+	{
+		return false;
+	}
+	m_translations[node] = translation;
+	m_rotations[node] = rotation;
+	m_scales[node] = scale;
+	markDirty(node);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+bool TTransformHierarchy<T, P>::setTranslation(const size_t node, const Vector3& translation)
+{
+	if (!checkCondition<P>(node < m_parents.size()))
+	{
+		return false;
+	}
+	m_translations[node] = translation;
+	markDirty(node);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+bool TTransformHierarchy<T, P>::setRotation(const size_t node, const Quaternion& rotation)
+{
+	if (!checkCondition<P>(node < m_parents.size()))
+	{
+		return false;
+	}
+	m_rotations[node] = rotation;
+	markDirty(node);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+bool TTransformHierarchy<T, P>::setScale(const size_t node, const Vector3& scale)
+{
+	if (!checkCondition<P>(node < m_parents.size()))
+	{
+		return false;
+	}
+	m_scales[node] = scale;
+	markDirty(node);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+const typename TTransformHierarchy<T, P>::Vector3& TTransformHierarchy<T, P>::translation(const size_t node) const
+{
+	return m_translations[node];
+}
+
+template <floattype T, CheckPolicy P>
+const typename TTransformHierarchy<T, P>::Quaternion& TTransformHierarchy<T, P>::rotation(const size_t node) const
+{
+	return m_rotations[node];
+}
+
+template <floattype T, CheckPolicy P>
+const typename TTransformHierarchy<T, P>::Vector3& TTransformHierarchy<T, P>::scale(const size_t node) const
+{
+	return m_scales[node];
+}
+
+template <floattype T, CheckPolicy P>
+size_t TTransformHierarchy<T, P>::parent(const size_t node) const
+{
+	return m_parents[node];
+}
+
+template <floattype T, CheckPolicy P>
+size_t TTransformHierarchy<T, P>::depth(const size_t node) const
+{
+	return m_depths[node];
+}
+
+template <floattype T, CheckPolicy P>
+const typename TTransformHierarchy<T, P>::Matrix& TTransformHierarchy<T, P>::worldMatrix(const size_t node) const
+{
+	return m_world[node];
+}
+
+template <floattype T, CheckPolicy P>
+typename TTransformHierarchy<T, P>::Vector3 TTransformHierarchy<T, P>::transformPoint(const size_t node,
+	const Vector3& point) const
+{
+	const Quaternion homogeneous(point.x(), point.y(), point.z(), T(1));
+	const Matrix& m = m_world[node];
+	return Vector3(m[0] * homogeneous, m[1] * homogeneous, m[2] * homogeneous);
+}
+
+template <floattype T, CheckPolicy P>
+bool TTransformHierarchy<T, P>::dirty() const
+{
+	return !m_dirtyNodes.empty();
+}
+
+template <floattype T, CheckPolicy P>
+size_t TTransformHierarchy<T, P>::size() const
+{
+	return m_parents.size();
+}
+
+template <floattype T, CheckPolicy P>
+void TTransformHierarchy<T, P>::clear()
+{
+	*this = TTransformHierarchy();
+}
+
+template <floattype T, CheckPolicy P>
+void TTransformHierarchy<T, P>::markDirty(const size_t node)
+{
+	if (0 == m_dirtyFlags[node])
+	{
+		m_dirtyFlags[node] = 1;
+		m_dirtyNodes.push_back(node);
+	}
+}
+
+template <floattype T, CheckPolicy P>
+void TTransformHierarchy<T, P>::buildChildren()
+{
+	const size_t count = m_parents.size();
+	m_childOffsets.assign(count + 1, 0);
+	for (size_t i(0); i < count; ++i)
+	{
+		if (s_noParent != m_parents[i])
+		{
+			++m_childOffsets[m_parents[i] + 1];
+		}
+	}
+	for (size_t i(0); i < count; ++i)
+	{
+		m_childOffsets[i + 1] += m_childOffsets[i];
+	}
+
+	// 按子节点下标顺序填充，每个父节点的子表保持升序
+	std::vector<size_t> cursor(m_childOffsets.begin(), m_childOffsets.end() - 1);
+	m_children.resize(m_childOffsets[count]);
+	for (size_t i(0); i < count; ++i)
+	{
+		if (s_noParent != m_parents[i])
+		{
+			m_children[cursor[m_parents[i]]++] = i;
+		}
+	}
+	m_childrenStale = false;
+}
+
+template <floattype T, CheckPolicy P>
+void TTransformHierarchy<T, P>::collectSubtrees()
+{
+	if (0 == ++m_epoch)
+	{
+		std::fill(m_stamps.begin(), m_stamps.end(), 0);
+		m_epoch = 1;
+	}
+
+	// 已盖章的节点其整棵子树都已收集，遇到即可剪枝，因此每个节点只访问一次
+	m_pending.clear();
+	for (const size_t root : m_dirtyNodes)
+	{
+		m_dirtyFlags[root] = 0;
+		if (m_epoch == m_stamps[root])
+		{
+			continue;
+		}
+		m_stack.push_back(root);
+		while (!m_stack.empty())
+		{
+			const size_t node = m_stack.back();
+			m_stack.pop_back();
+			if (m_epoch == m_stamps[node])
+			{
+				continue;
+			}
+			m_stamps[node] = m_epoch;
+			m_pending.push_back(node);
+			for (size_t c(m_childOffsets[node]); c < m_childOffsets[node + 1]; ++c)
+			{
+				m_stack.push_back(m_children[c]);
+			}
+		}
+	}
+	m_dirtyNodes.clear();
+
+	// 按深度计数排序，同层节点之间互不依赖
+	uint32_t minDepth = std::numeric_limits<uint32_t>::max();
+	uint32_t maxDepth = 0;
+	for (const size_t node : m_pending)
+	{
+		minDepth = std::min(minDepth, m_depths[node]);
+		maxDepth = std::max(maxDepth, m_depths[node]);
+	}
+
+	const size_t levels = maxDepth - minDepth + 1;
+	m_levelOffsets.assign(levels + 1, 0);
+	for (const size_t node : m_pending)
+	{
+		++m_levelOffsets[m_depths[node] - minDepth + 1];
+	}
+	for (size_t l(0); l < levels; ++l)
+	{
+		m_levelOffsets[l + 1] += m_levelOffsets[l];
+	}
+
+	m_order.resize(m_pending.size());
+	std::vector<size_t> cursor(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+	for (const size_t node : m_pending)
+	{
+		m_order[cursor[m_depths[node] - minDepth]++] = node;
+	}
+}
+
+template <floattype T, CheckPolicy P>
+typename TTransformHierarchy<T, P>::Matrix TTransformHierarchy<T, P>::localMatrix(const size_t node) const
+{
+	const Quaternion& q = m_rotations[node];
+	const Vector3& t = m_translations[node];
+	const Vector3& s = m_scales[node];
+
+	const T norm = q.squaredLength();
+	const T k = norm > T(0) ? T(2) / norm : T(0);
+	const T xx = q.x() * q.x() * k, yy = q.y() * q.y() * k, zz = q.z() * q.z() * k;
+	const T xy = q.x() * q.y() * k, xz = q.x() * q.z() * k, yz = q.y() * q.z() * k;
+	const T wx = q.w() * q.x() * k, wy = q.w() * q.y() * k, wz = q.w() * q.z() * k;
+
+	return Matrix{
+		Quaternion((T(1) - yy - zz) * s.x(), (xy - wz) * s.y(), (xz + wy) * s.z(), t.x()),
+		Quaternion((xy + wz) * s.x(), (T(1) - xx - zz) * s.y(), (yz - wx) * s.z(), t.y()),
+		Quaternion((xz - wy) * s.x(), (yz + wx) * s.y(), (T(1) - xx - yy) * s.z(), t.z())
+	};
+}
+
+template <floattype T, CheckPolicy P>
+size_t TTransformHierarchy<T, P>::update(ThreadPool& pool)
+{
+	if (m_dirtyNodes.empty())
+	{
+		return 0;
+	}
+	if (m_childrenStale)
+	{
+		buildChildren();
+	}
+	collectSubtrees();
+
+	auto compute = [this](const size_t first, const size_t last)
+	{
+		for (size_t i(first); i < last; ++i)
+		{
+			const size_t node = m_order[i];
+			const Matrix local = localMatrix(node);
+			const size_t parentNode = m_parents[node];
+			if (s_noParent == parentNode)
+			{
+				m_world[node] = local;
+				continue;
+			}
+
+			// 行 r：W[r] = sum_k Pw[r][k] * L[k] + Pw[r][3] * (0, 0, 0, 1)
+			const Matrix& pw = m_world[parentNode];
+			Matrix& world = m_world[node];
+			for (int r(0); r < 3; ++r)
+			{
+				const Quaternion& row = pw[r];
+				world[r] = local[0] * row.x() + local[1] * row.y() + local[2] * row.z();
+				world[r].rw() += row.w();
+			}
+		}
+	};
+
+	// 逐层推进：上一层全部完成后才计算下一层，层内各节点并行
+	for (size_t l(0); l + 1 < m_levelOffsets.size(); ++l)
+	{
+		const size_t first = m_levelOffsets[l];
+		const size_t last = m_levelOffsets[l + 1];
+		if (last - first <= s_grain)
+		{
+			compute(first, last);
+		}
+		else
+		{
+			pool.parallelFor(first, last, s_grain, compute);
+		}
+	}
+	return m_order.size();
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef __INT_VECTOR_TOOL_H__
+#define __INT_VECTOR_TOOL_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVectorTraits.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 整数向量批量运算（Vector2i/3i/4i），除 isqrt 以浮点平方根作初值外全程为整数运算
+ * 输入为交错存储的 int 分量，dimension 取 2、3、4；SSE2 下按 4 个 32 位通道处理，
+ * 乘积与求和在 64 位通道中进行，其余平台走标量路径，结果一致
+ * 加减与缩放按二进制补码回绕，其余运算结果精确
+ */
+class MATH_API IntVectorTool
+{
+public:
+	/**
+	 * @brief 逐分量相加 out = a + b
+	 * @param a 输入分量
+	 * @param b 输入分量
+	 * @param out 输出分量，可与 a 或 b 相同
+	 * @param count 分量总数（向量数 * 维数）
+	 */
+	static void add(const int* a, const int* b, int* out, const size_t count);
+
+	/**
+	 * @brief 逐分量相减 out = a - b
+	 */
+	static void subtract(const int* a, const int* b, int* out, const size_t count);
+
+	/**
+	 * @brief 逐分量缩放 out = a * s
+	 */
+	static void scale(const int* a, const int s, int* out, const size_t count);
+
+	/**
+	 * @brief 点积，64 位累加
+	 * @param a 输入向量
+	 * @param b 输入向量
+	 * @param dimension 维数
+	 * @param out 输出，长度为 count
+	 * @param count 向量数
+	 */
+	static void dot(const int* a, const int* b, const size_t dimension, int64_t* out, const size_t count);
+
+	/**
+	 * @brief 长度平方，64 位累加；分量绝对值小于 2^31 时不会溢出
+	 */
+	static void squaredLength(const int* a, const size_t dimension, uint64_t* out, const size_t count);
+
+	/**
+	 * @brief 长度向下取整 floor(sqrt(squaredLength))
+	 */
+	static void length(const int* a, const size_t dimension, uint32_t* out, const size_t count);
+
+	/**
+	 * @brief 曼哈顿距离 sum(|a - b|)，分量差不受 32 位溢出影响
+	 */
+	static void manhattanDistance(const int* a, const int* b, const size_t dimension, uint64_t* out,
+		const size_t count);
+
+	/**
+	 * @brief 切比雪夫距离 max(|a - b|)
+	 */
+	static void chebyshevDistance(const int* a, const int* b, const size_t dimension, uint32_t* out,
+		const size_t count);
+
+	/**
+	 * @brief 整数平方根 floor(sqrt(v))，结果精确
+	 */
+	static uint32_t isqrt(const uint64_t v);
+
+	/**
+	 * @brief 批量整数平方根
+	 */
+	static void isqrt(const uint64_t* in, uint32_t* out, const size_t count);
+
+	/**
+	 * @brief 向量数组版本，Vector 为 TVector2/3/4<int>
+	 */
+	template <typename Vector>
+	static void add(const Vector* a, const Vector* b, Vector* out, const size_t count);
+
+	template <typename Vector>
+	static void subtract(const Vector* a, const Vector* b, Vector* out, const size_t count);
+
+	template <typename Vector>
+	static void scale(const Vector* a, const int s, Vector* out, const size_t count);
+
+	template <typename Vector>
+	static void dot(const Vector* a, const Vector* b, int64_t* out, const size_t count);
+
+	template <typename Vector>
+	static void squaredLength(const Vector* a, uint64_t* out, const size_t count);
+
+	template <typename Vector>
+	static void length(const Vector* a, uint32_t* out, const size_t count);
+
+	template <typename Vector>
+	static void manhattanDistance(const Vector* a, const Vector* b, uint64_t* out, const size_t count);
+
+	template <typename Vector>
+	static void chebyshevDistance(const Vector* a, const Vector* b, uint32_t* out, const size_t count);
+
+private:
+	template <typename Vector>
+	static const int* components(const Vector* vec);
+
+	template <typename Vector>
+	static int* components(Vector* vec);
+};
+
+template <typename Vector>
+const int* IntVectorTool::components(const Vector* vec)
+{
+	static_assert(std::is_same_v<typename TVectorTraits<Vector>::Scalar, int>, "integer vector required");
+	static_assert(sizeof(Vector) == TVectorTraits<Vector>::s_size * sizeof(int), "vector must be tightly packed");
+	return reinterpret_cast<const int*>(vec);
+}
+
+template <typename Vector>
+int* IntVectorTool::components(Vector* vec)
+{
+	static_assert(std::is_same_v<typename TVectorTraits<Vector>::Scalar, int>, "integer vector required");
+	static_assert(sizeof(Vector) == TVectorTraits<Vector>::s_size * sizeof(int), "vector must be tightly packed");
+	return reinterpret_cast<int*>(vec);
+}
+
+template <typename Vector>
+void IntVectorTool::add(const Vector* a, const Vector* b, Vector* out, const size_t count)
+{
+	add(components(a), components(b), components(out), count * TVectorTraits<Vector>::s_size);
+}
+
+template <typename Vector>
+void IntVectorTool::subtract(const Vector* a, const Vector* b, Vector* out, const size_t count)
+{
+	subtract(components(a), components(b), components(out), count * TVectorTraits<Vector>::s_size);
+}
+
+template <typename Vector>
+void IntVectorTool::scale(const Vector* a, const int s, Vector* out, const size_t count)
+{
+	scale(components(a), s, components(out), count * TVectorTraits<Vector>::s_size);
+}
+
+template <typename Vector>
+void IntVectorTool::dot(const Vector* a, const Vector* b, int64_t* out, const size_t count)
+{
+	dot(components(a), components(b), TVectorTraits<Vector>::s_size, out, count);
+}
+
+template <typename Vector>
+void IntVectorTool::squaredLength(const Vector* a, uint64_t* out, const size_t count)
+{
+	squaredLength(components(a), TVectorTraits<Vector>::s_size, out, count);
+}
+
+template <typename Vector>
+void IntVectorTool::length(const Vector* a, uint32_t* out, const size_t count)
+{
+	length(components(a), TVectorTraits<Vector>::s_size, out, count);
+}
+
+template <typename Vector>
+void IntVectorTool::manhattanDistance(const Vector* a, const Vector* b, uint64_t* out, const size_t count)
+{
+	manhattanDistance(components(a), components(b), TVectorTraits<Vector>::s_size, out, count);
+}
+
+template <typename Vector>
+void IntVectorTool::chebyshevDistance(const Vector* a, const Vector* b, uint32_t* out, const size_t count)
+{
+	chebyshevDistance(components(a), components(b), TVectorTraits<Vector>::s_size, out, count);
+}
+
+END_NAMESPACE
+
+#endif
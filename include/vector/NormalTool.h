@@ -0,0 +1,99 @@
+#ifndef __NORMAL_TOOL_H__
+#define __NORMAL_TOOL_H__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include <cstddef>
+#include <cstdint>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 单位法线的紧凑编码，编码值按小端序存放，每个法线 2 / 3 / 4 字节
+ * Octahedral   : 八面体映射到 [-1, 1]^2 后两轴各用一半位数量化（对称 SNORM，坐标轴方向可精确表示），
+ *                编码时在相邻 4 个量化点中取解码后夹角最小的一个
+ * Fibonacci    : 球面 Fibonacci 点集（2^位数 个点）中最近点的序号，点分布均匀，同样位数下最大误差略小，
+ *                但编解码需要三角函数，比八面体慢一个数量级
+ */
+enum class NormalEncoding
+{
+	Octahedral16,
+	Octahedral24,
+	Octahedral32,
+	Fibonacci16,
+	Fibonacci24,
+	Fibonacci32
+};
+
+class MATH_API NormalTool
+{
+public:
+	/**
+	 * @brief 每个法线编码后的字节数
+	 */
+	static size_t encodedSize(const NormalEncoding encoding);
+
+	/**
+	 * @brief 单位法线编码再解码后的最大夹角（弧度），为密集采样实测值上取整
+	 */
+	static double maxAngularError(const NormalEncoding encoding);
+
+	/**
+	 * @brief 批量编码，输入无需严格单位化；零向量与含无穷大或 NaN 的向量编码为 +z 方向
+	 * @param xyz 交错存储的法线分量，长度为 3 * count
+	 * @param count 法线数
+	 * @param out 输出，长度为 encodedSize(encoding) * count 字节
+	 * @param encoding 编码方式
+	 */
+	static void encode(const float* xyz, const size_t count, uint8_t* out, const NormalEncoding encoding);
+
+	/**
+	 * @brief 批量解码为单位法线
+	 * @param in 编码值，长度为 encodedSize(encoding) * count 字节
+	 * @param count 法线数
+	 * @param xyz 输出，长度为 3 * count
+	 * @param encoding 编码方式
+	 */
+	static void decode(const uint8_t* in, const size_t count, float* xyz, const NormalEncoding encoding);
+
+	/**
+	 * @brief TVector3<float> 数组版本
+	 */
+	template <CheckPolicy P>
+	static void encode(const TVector3<float, P>* normals, const size_t count, uint8_t* out,
+		const NormalEncoding encoding);
+
+	/**
+	 * @brief TVector3<float> 数组版本
+	 */
+	template <CheckPolicy P>
+	static void decode(const uint8_t* in, const size_t count, TVector3<float, P>* normals,
+		const NormalEncoding encoding);
+};
+
+template <CheckPolicy P>
+void NormalTool::encode(const TVector3<float, P>* normals, const size_t count, uint8_t* out,
+	const NormalEncoding encoding)
+{
+	static_assert(sizeof(TVector3<float, P>) == 3 * sizeof(float), "TVector3<float> must be tightly packed");
+	if (0 != count)
+	{
+		encode(&normals[0].cx(), count, out, encoding);
+	}
+}
+
+template <CheckPolicy P>
+void NormalTool::decode(const uint8_t* in, const size_t count, TVector3<float, P>* normals,
+	const NormalEncoding encoding)
+{
+	static_assert(sizeof(TVector3<float, P>) == 3 * sizeof(float), "TVector3<float> must be tightly packed");
+	if (0 != count)
+	{
+		decode(in, count, &normals[0].rx(), encoding);
+	}
+}
+
+END_NAMESPACE
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef __TUNIT_VECTOR2_HPP__
+#define __TUNIT_VECTOR2_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector2.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 单位长度的二维向量（方向），约定与 TUnitVector3 相同
+ * 旋转以单位向量表示（cos, sin），旋转即复数乘法，角度只在 fromAngle / angle 处与三角函数转换
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TUnitVector2
+{
+public:
+	using Vector = TVector2<T, P>;
+
+	/**
+	 * @brief 长度平方与 1 的允许偏差
+	 */
+	static constexpr T s_tolerance = std::numeric_limits<T>::epsilon() * T(256);
+
+	/**
+	 * @brief 默认为 +x 方向
+	 */
+	TUnitVector2();
+
+	/**
+	 * @brief 归一化构造
+	 * @param vec 任意向量
+	 * @param result 输出，失败时不修改
+	 * @return 零向量、含 NaN 或无穷分量时返回 false
+	 */
+	static bool normalize(const Vector& vec, TUnitVector2& result);
+
+	/**
+	 * @brief 归一化构造，无法归一化时返回 fallback
+	 */
+	static TUnitVector2 normalizeOr(const Vector& vec, const TUnitVector2& fallback = TUnitVector2());
+
+	/**
+	 * @brief 信任调用方保证 vec 为单位长度，不做开方
+	 *        Checked 策略下运行时校验，不是单位长度时退化为 normalizeOr(vec)；DebugAssert 策略下断言
+	 */
+	static TUnitVector2 trusted(const Vector& vec);
+
+	/**
+	 * @brief 由与 +x 轴的夹角（弧度，逆时针）构造 (cos, sin)
+	 */
+	static TUnitVector2 fromAngle(const T radian);
+
+	/**
+	 * @brief 长度平方是否在 s_tolerance 内等于 1
+	 */
+	static bool isUnitLength(const Vector& vec);
+
+public:
+	const Vector& vector() const;
+	operator const Vector&() const;
+
+	T x() const;
+	T y() const;
+	const T& cx() const;
+	const T& cy() const;
+
+	/**
+	 * @brief 恒为 1，供按 TVector2 接口编写的模板代码使用
+	 */
+	T length() const;
+	T squaredLength() const;
+
+	/**
+	 * @brief 已是单位向量，原样返回
+	 */
+	TUnitVector2 makeNormalize() const;
+
+	/**
+	 * @brief 与 +x 轴的夹角，范围 [-pi, pi]
+	 */
+	T angle() const;
+
+public:
+	TUnitVector2 operator-() const;
+	bool operator==(const TUnitVector2& other) const;
+	bool operator!=(const TUnitVector2& other) const;
+
+	Vector operator*(const T& val) const;
+	T operator*(const Vector& other) const;
+	T dot(const Vector& other) const;
+
+	/**
+	 * @brief 夹角的余弦，即点乘
+	 */
+	T cosAngle(const TUnitVector2& other) const;
+
+	/**
+	 * @brief 逆时针旋转 90 度 (-y, x)
+	 */
+	TUnitVector2 perpendicular() const;
+
+	/**
+	 * @brief 按 rotation = (cos a, sin a) 逆时针旋转 a
+	 */
+	TUnitVector2 rotated(const TUnitVector2& rotation) const;
+
+	/**
+	 * @brief 关于法线所在直线的镜面反射 v - 2 (v·n) n
+	 * @param normal 单位法线
+	 */
+	TUnitVector2 reflected(const TUnitVector2& normal) const;
+
+	/**
+	 * @brief 用一步 Newton 迭代 v * (3 - |v|^2) / 2 消除累积漂移，不开方
+	 */
+	TUnitVector2 renormalized() const;
+
+public:
+	static const TUnitVector2 xAxisVector;
+	static const TUnitVector2 yAxisVector;
+
+private:
+	explicit TUnitVector2(const Vector& vec);
+
+	static void verify(const Vector& vec);
+
+	Vector m_vector;
+};
+
+template <floattype T, CheckPolicy P>
+const TUnitVector2<T, P> TUnitVector2<T, P>::xAxisVector(Vector(T(1), T(0)));
+
+template <floattype T, CheckPolicy P>
+const TUnitVector2<T, P> TUnitVector2<T, P>::yAxisVector(Vector(T(0), T(1)));
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P>::TUnitVector2()
+	: m_vector(T(1), T(0))
+{
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P>::TUnitVector2(const Vector& vec)
+	: m_vector(vec)
+{
+}
+
+template <floattype T, CheckPolicy P>
+void TUnitVector2<T, P>::verify([[maybe_unused]] const Vector& vec)
+{
+	if constexpr (CheckPolicy::Unchecked != P)
+	{
+		assert(isUnitLength(vec));
+	}
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector2<T, P>::isUnitLength(const Vector& vec)
+{
+	return std::fabs(vec.squaredLength() - T(1)) <= s_tolerance;
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector2<T, P>::normalize(const Vector& vec, TUnitVector2& result)
+{
+	const T largest = std::max({ std::fabs(vec.x()), std::fabs(vec.y()) });
+	if (!(largest > T(0)) || !std::isfinite(largest))
+	{
+		return false;
+	}
+
+	// 先按最大分量的 2 的幂缩放（精确，不引入舍入），长度平方在极大或极小分量下也不会上溢或下溢
+	const int exponent = std::ilogb(largest);
+	const Vector scaled(std::scalbn(vec.x(), -exponent), std::scalbn(vec.y(), -exponent));
+	const T len = scaled.length();
+	if (!std::isfinite(len))
+	{
+		return false;
+	}
+	result.m_vector = scaled * (T(1) / len);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::normalizeOr(const Vector& vec, const TUnitVector2& fallback)
+{
+	TUnitVector2 result(fallback);
+	normalize(vec, result);
+	return result;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::trusted(const Vector& vec)
+{
+	if (!checkCondition<P>(isUnitLength(vec)))
+	{
+		return normalizeOr(vec);
+	}
+	return TUnitVector2(vec);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::fromAngle(const T radian)
+{
+	return TUnitVector2(Vector(std::cos(radian), std::sin(radian)));
+}
+
+template <floattype T, CheckPolicy P>
+const TVector2<T, P>& TUnitVector2<T, P>::vector() const
+{
+	return m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P>::operator const Vector&() const
+{
+	return m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::x() const
+{
+	return m_vector.x();
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::y() const
+{
+	return m_vector.y();
+}
+
+template <floattype T, CheckPolicy P>
+const T& TUnitVector2<T, P>::cx() const
+{
+	return m_vector.cx();
+}
+
+template <floattype T, CheckPolicy P>
+const T& TUnitVector2<T, P>::cy() const
+{
+	return m_vector.cy();
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::length() const
+{
+	return T(1);
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::squaredLength() const
+{
+	return T(1);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::makeNormalize() const
+{
+	return *this;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::angle() const
+{
+	return std::atan2(m_vector.y(), m_vector.x());
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::operator-() const
+{
+	return TUnitVector2(-m_vector);
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector2<T, P>::operator==(const TUnitVector2& other) const
+{
+	return m_vector == other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector2<T, P>::operator!=(const TUnitVector2& other) const
+{
+	return m_vector != other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TVector2<T, P> TUnitVector2<T, P>::operator*(const T& val) const
+{
+	return m_vector * val;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::operator*(const Vector& other) const
+{
+	return m_vector * other;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::dot(const Vector& other) const
+{
+	return m_vector * other;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector2<T, P>::cosAngle(const TUnitVector2& other) const
+{
+	return m_vector * other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::perpendicular() const
+{
+	return TUnitVector2(Vector(-m_vector.y(), m_vector.x()));
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::rotated(const TUnitVector2& rotation) const
+{
+	const T c = rotation.m_vector.x();
+	const T s = rotation.m_vector.y();
+	const Vector result(c * m_vector.x() - s * m_vector.y(), s * m_vector.x() + c * m_vector.y());
+	verify(result);
+	return TUnitVector2(result);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::reflected(const TUnitVector2& normal) const
+{
+	const Vector result = m_vector - normal.m_vector * (T(2) * (m_vector * normal.m_vector));
+	verify(result);
+	return TUnitVector2(result);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector2<T, P> TUnitVector2<T, P>::renormalized() const
+{
+	return TUnitVector2(m_vector * ((T(3) - m_vector.squaredLength()) * T(0.5)));
+}
+
+END_NAMESPACE
+
+#endif
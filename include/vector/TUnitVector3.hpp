@@ -0,0 +1,354 @@
+#ifndef __TUNIT_VECTOR3_HPP__
+#define __TUNIT_VECTOR3_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 单位长度的三维向量，类型本身即记录“已归一化”，持有者无需再调用 makeNormalize
+ * 只能通过 normalize（计算一次开方）或 trusted（调用方保证单位长度）构造；
+ * 取反、按单位四元数旋转、沿单位法线反射保持单位长度，结果直接返回，不再开方
+ * 非 NDEBUG 构建下，除 Unchecked 外的策略在上述运算后断言长度仍为 1；trusted 的校验见其说明
+ */
+template <floattype T, CheckPolicy P = CheckPolicy::Checked>
+class TUnitVector3
+{
+public:
+	using Vector = TVector3<T, P>;
+	using Quaternion = TVector4<T, P>;
+
+	/**
+	 * @brief 长度平方与 1 的允许偏差，覆盖归一化舍入与数十次旋转的累积误差
+	 */
+	static constexpr T s_tolerance = std::numeric_limits<T>::epsilon() * T(256);
+
+	/**
+	 * @brief 默认为 +z 方向
+	 */
+	TUnitVector3();
+
+	/**
+	 * @brief 归一化构造
+	 * @param vec 任意向量
+	 * @param result 输出，失败时不修改
+	 * @return 零向量、含 NaN 或无穷分量时返回 false
+	 */
+	static bool normalize(const Vector& vec, TUnitVector3& result);
+
+	/**
+	 * @brief 归一化构造，无法归一化时返回 fallback
+	 */
+	static TUnitVector3 normalizeOr(const Vector& vec, const TUnitVector3& fallback = TUnitVector3());
+
+	/**
+	 * @brief 信任调用方保证 vec 为单位长度，不做开方
+	 *        Checked 策略下运行时校验，不是单位长度时退化为 normalizeOr(vec)；DebugAssert 策略下断言
+	 */
+	static TUnitVector3 trusted(const Vector& vec);
+
+	/**
+	 * @brief 长度平方是否在 s_tolerance 内等于 1
+	 */
+	static bool isUnitLength(const Vector& vec);
+
+public:
+	const Vector& vector() const;
+	operator const Vector&() const;
+
+	T x() const;
+	T y() const;
+	T z() const;
+	const T& cx() const;
+	const T& cy() const;
+	const T& cz() const;
+
+	/**
+	 * @brief 恒为 1，供按 TVector3 接口编写的模板代码使用
+	 */
+	T length() const;
+	T squaredLength() const;
+
+	/**
+	 * @brief 已是单位向量，原样返回
+	 */
+	TUnitVector3 makeNormalize() const;
+
+public:
+	TUnitVector3 operator-() const;
+	bool operator==(const TUnitVector3& other) const;
+	bool operator!=(const TUnitVector3& other) const;
+
+	Vector operator*(const T& val) const;
+	T operator*(const Vector& other) const;
+	T dot(const Vector& other) const;
+
+	/**
+	 * @brief 叉乘，结果一般不是单位向量
+	 */
+	Vector cross(const Vector& other) const;
+
+	/**
+	 * @brief 夹角的余弦，即点乘，无需除以长度
+	 */
+	T cosAngle(const TUnitVector3& other) const;
+
+	/**
+	 * @brief 按单位四元数 (x, y, z, w) 旋转，w 为实部
+	 * @param quaternion 单位四元数，调试构建下校验
+	 */
+	TUnitVector3 rotated(const Quaternion& quaternion) const;
+
+	/**
+	 * @brief 关于法线所在平面的镜面反射 v - 2 (v·n) n
+	 * @param normal 单位法线
+	 */
+	TUnitVector3 reflected(const TUnitVector3& normal) const;
+
+	/**
+	 * @brief 用一步 Newton 迭代 v * (3 - |v|^2) / 2 消除累积漂移，不开方
+	 */
+	TUnitVector3 renormalized() const;
+
+public:
+	static const TUnitVector3 xAxisVector;
+	static const TUnitVector3 yAxisVector;
+	static const TUnitVector3 zAxisVector;
+
+private:
+	explicit TUnitVector3(const Vector& vec);
+
+	static void verify(const Vector& vec);
+
+	Vector m_vector;
+};
+
+template <floattype T, CheckPolicy P>
+const TUnitVector3<T, P> TUnitVector3<T, P>::xAxisVector(Vector(T(1), T(0), T(0)));
+
+template <floattype T, CheckPolicy P>
+const TUnitVector3<T, P> TUnitVector3<T, P>::yAxisVector(Vector(T(0), T(1), T(0)));
+
+template <floattype T, CheckPolicy P>
+const TUnitVector3<T, P> TUnitVector3<T, P>::zAxisVector(Vector(T(0), T(0), T(1)));
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P>::TUnitVector3()
+	: m_vector(T(0), T(0), T(1))
+{
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P>::TUnitVector3(const Vector& vec)
+	: m_vector(vec)
+{
+}
+
+template <floattype T, CheckPolicy P>
+void TUnitVector3<T, P>::verify([[maybe_unused]] const Vector& vec)
+{
+	if constexpr (CheckPolicy::Unchecked != P)
+	{
+		assert(isUnitLength(vec));
+	}
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector3<T, P>::isUnitLength(const Vector& vec)
+{
+	return std::fabs(vec.squaredLength() - T(1)) <= s_tolerance;
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector3<T, P>::normalize(const Vector& vec, TUnitVector3& result)
+{
+	const T largest = std::max({ std::fabs(vec.x()), std::fabs(vec.y()), std::fabs(vec.z()) });
+	if (!(largest > T(0)) || !std::isfinite(largest))
+	{
+		return false;
+	}
+
+	// 先按最大分量的 2 的幂缩放（精确，不引入舍入），长度平方在极大或极小分量下也不会上溢或下溢
+	const int exponent = std::ilogb(largest);
+	const Vector scaled(std::scalbn(vec.x(), -exponent), std::scalbn(vec.y(), -exponent), std::scalbn(vec.z(), -exponent));
+	const T len = scaled.length();
+	if (!std::isfinite(len))
+	{
+		return false;
+	}
+	result.m_vector = scaled * (T(1) / len);
+	return true;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::normalizeOr(const Vector& vec, const TUnitVector3& fallback)
+{
+	TUnitVector3 result(fallback);
+	normalize(vec, result);
+	return result;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::trusted(const Vector& vec)
+{
+	if (!checkCondition<P>(isUnitLength(vec)))
+	{
+		return normalizeOr(vec);
+	}
+	return TUnitVector3(vec);
+}
+
+template <floattype T, CheckPolicy P>
+const TVector3<T, P>& TUnitVector3<T, P>::vector() const
+{
+	return m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P>::operator const Vector&() const
+{
+	return m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::x() const
+{
+	return m_vector.x();
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::y() const
+{
+	return m_vector.y();
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::z() const
+{
+	return m_vector.z();
+}
+
+template <floattype T, CheckPolicy P>
+const T& TUnitVector3<T, P>::cx() const
+{
+	return m_vector.cx();
+}
+
+template <floattype T, CheckPolicy P>
+const T& TUnitVector3<T, P>::cy() const
+{
+	return m_vector.cy();
+}
+
+template <floattype T, CheckPolicy P>
+const T& TUnitVector3<T, P>::cz() const
+{
+	return m_vector.cz();
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::length() const
+{
+	return T(1);
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::squaredLength() const
+{
+	return T(1);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::makeNormalize() const
+{
+	return *this;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::operator-() const
+{
+	return TUnitVector3(-m_vector);
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector3<T, P>::operator==(const TUnitVector3& other) const
+{
+	return m_vector == other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+bool TUnitVector3<T, P>::operator!=(const TUnitVector3& other) const
+{
+	return m_vector != other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TVector3<T, P> TUnitVector3<T, P>::operator*(const T& val) const
+{
+	return m_vector * val;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::operator*(const Vector& other) const
+{
+	return m_vector * other;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::dot(const Vector& other) const
+{
+	return m_vector * other;
+}
+
+template <floattype T, CheckPolicy P>
+TVector3<T, P> TUnitVector3<T, P>::cross(const Vector& other) const
+{
+	return m_vector ^ other;
+}
+
+template <floattype T, CheckPolicy P>
+T TUnitVector3<T, P>::cosAngle(const TUnitVector3& other) const
+{
+	return m_vector * other.m_vector;
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::rotated(const Quaternion& quaternion) const
+{
+	if constexpr (CheckPolicy::Unchecked != P)
+	{
+		assert(std::fabs(quaternion.squaredLength() - T(1)) <= s_tolerance);
+	}
+
+	// v' = v + w t + q × t，t = 2 (q × v)
+	const Vector q(quaternion.x(), quaternion.y(), quaternion.z());
+	const Vector t = (q ^ m_vector) * T(2);
+	const Vector result = m_vector + t * quaternion.w() + (q ^ t);
+	verify(result);
+	return TUnitVector3(result);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::reflected(const TUnitVector3& normal) const
+{
+	const Vector result = m_vector - normal.m_vector * (T(2) * (m_vector * normal.m_vector));
+	verify(result);
+	return TUnitVector3(result);
+}
+
+template <floattype T, CheckPolicy P>
+TUnitVector3<T, P> TUnitVector3<T, P>::renormalized() const
+{
+	return TUnitVector3(m_vector * ((T(3) - m_vector.squaredLength()) * T(0.5)));
+}
+
+END_NAMESPACE
+
+#endif
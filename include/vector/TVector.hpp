@@ -0,0 +1,629 @@
+#ifndef __TVECTOR_HPP__
+#define __TVECTOR_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+BEGIN_NAMESPACE
+
+/*!
+ * 定长向量的公共实现（CRTP），Derived 为最终的向量类型
+ * 逐分量运算用折叠表达式在编译期展开，不含运行时循环；
+ * SSE2 下 float（N 为 4 的倍数）与 double（N 为 2 的倍数）按 128 位通道成组计算，其余走标量展开
+ * TVector2/3/4 在此之上补充具名分量、叉乘与静态常量，TVector<N, T> 用于 8、16 维等特征向量
+ */
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+class TVectorBase
+{
+public:
+	using Scalar = T;
+	static constexpr size_t s_size = N;
+
+public:
+	Derived operator+(const Derived& other) const;
+	Derived operator-(const Derived& other) const;
+	Derived operator-() const;
+	Derived operator*(const T& val) const;
+	Derived operator/(const T& val) const;
+	Derived& operator+=(const Derived& other);
+	Derived& operator-=(const Derived& other);
+	Derived& operator*=(const T& val);
+	Derived& operator/=(const T& val);
+
+	bool operator==(const TVectorBase& other) const;
+	bool operator!=(const TVectorBase& other) const;
+
+	T operator[](const int index) const;
+	T& operator[](const int index);
+
+	/**
+	 * @brief 向量点乘
+	 * @param other 另一个向量
+	 * @return 点乘结果
+	 */
+	T operator*(const Derived& other) const;
+
+	/**
+	 * @brief 向量点乘
+	 * @param other 另一个向量
+	 * @return 点乘结果
+	 */
+	T dot(const Derived& other) const;
+
+	/**
+	 * @brief 逐分量相乘
+	 * @param other 另一个向量
+	 * @return 逐分量乘积
+	 */
+	Derived multiply(const Derived& other) const;
+
+	/**
+	 * @brief 求向量长度的平方
+	 * @return 向量长度的平方
+	 */
+	T squaredLength() const;
+
+	/**
+	 * @brief 计算向量的长度（模）
+	 * @tparam R 精度策略
+	 * @return 向量长度
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native>
+	PrecisionType<T, R> length() const;
+
+	/**
+	 * @brief 计算两个向量的距离
+	 * @tparam R 精度策略
+	 * @param vec 另一个向量
+	 * @return 返回两个向量的距离
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native>
+	PrecisionType<T, R> distanceTo(const Derived& vec) const;
+
+	/**
+	 * @brief 向量归一化，零向量保持为零
+	 * @tparam R 精度策略
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native>
+	void normalized();
+
+	/**
+	 * @brief 向量归一化
+	 * @tparam R 精度策略
+	 * @return 向量归一化结果，零向量返回零向量
+	 */
+	template <PrecisionPolicy R = PrecisionPolicy::Native>
+	Derived makeNormalize() const;
+
+	/**
+	 * @brief 向量置 0
+	 */
+	void makeZero();
+
+	/**
+	 * @brief 用某个值填充向量
+	 * @param val 要填充的值
+	 */
+	void fill(const T& val);
+
+	/**
+	 * @brief 分量数组
+	 */
+	const std::array<T, N>& components() const;
+
+	/**
+	 * @brief 分量首地址，分量连续存放
+	 */
+	const T* data() const;
+	T* data();
+
+protected:
+	TVectorBase() = default;
+	explicit TVectorBase(const std::array<T, N>& values);
+
+	std::array<T, N> m_data{};
+
+private:
+	template <typename Op>
+	static std::array<T, N> lanewise(const std::array<T, N>& a, const std::array<T, N>& b, Op op);
+
+	template <typename Op>
+	static std::array<T, N> lanewise(const std::array<T, N>& a, const T& s, Op op);
+
+	static std::array<T, N> invalid();
+
+#ifdef MATH_SIMD_SSE2
+	template <typename Op>
+	static __m128 packed(const __m128 a, const __m128 b, Op op);
+
+	template <typename Op>
+	static __m128d packed(const __m128d a, const __m128d b, Op op);
+#endif
+};
+
+/*!
+ * 任意维数的向量，用于 8、16 维等特征向量
+ */
+template <size_t N, validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TVector : public TVectorBase<TVector<N, T, P>, N, T, P>
+{
+	static_assert(N > 0, "vector dimension must be positive");
+
+public:
+	using Base = TVectorBase<TVector, N, T, P>;
+
+	TVector() = default;
+	explicit TVector(const T& val);
+	explicit TVector(const std::array<T, N>& values);
+
+	/**
+	 * @brief 逐分量构造，参数个数须等于维数
+	 */
+	template <typename... Args>
+		requires (N > 1 && sizeof...(Args) == N && (std::is_convertible_v<Args, T> && ...))
+	TVector(const Args&... values);
+};
+
+/*!
+ * c++20 向量类型限定：派生自 TVectorBase 的类型（TVector2/3/4、TVector<N>）
+ */
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+std::true_type isVectorBase(const TVectorBase<Derived, N, T, P>*);
+std::false_type isVectorBase(const void*);
+
+template <typename Vector>
+concept vectortype = decltype(isVectorBase(static_cast<const Vector*>(nullptr)))::value;
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+TVectorBase<Derived, N, T, P>::TVectorBase(const std::array<T, N>& values)
+	: m_data(values)
+{
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+std::array<T, N> TVectorBase<Derived, N, T, P>::invalid()
+{
+	std::array<T, N> result;
+	result.fill(std::numeric_limits<T>::quiet_NaN());
+	return result;
+}
+
+#ifdef MATH_SIMD_SSE2
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <typename Op>
+__m128 TVectorBase<Derived, N, T, P>::packed(const __m128 a, const __m128 b, Op)
+{
+	if constexpr (std::is_same_v<Op, std::plus<>>)
+	{
+		return _mm_add_ps(a, b);
+	}
+	else if constexpr (std::is_same_v<Op, std::minus<>>)
+	{
+		return _mm_sub_ps(a, b);
+	}
+	else if constexpr (std::is_same_v<Op, std::multiplies<>>)
+	{
+		return _mm_mul_ps(a, b);
+	}
+	else
+	{
+		return _mm_div_ps(a, b);
+	}
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <typename Op>
+__m128d TVectorBase<Derived, N, T, P>::packed(const __m128d a, const __m128d b, Op)
+{
+	if constexpr (std::is_same_v<Op, std::plus<>>)
+	{
+		return _mm_add_pd(a, b);
+	}
+	else if constexpr (std::is_same_v<Op, std::minus<>>)
+	{
+		return _mm_sub_pd(a, b);
+	}
+	else if constexpr (std::is_same_v<Op, std::multiplies<>>)
+	{
+		return _mm_mul_pd(a, b);
+	}
+	else
+	{
+		return _mm_div_pd(a, b);
+	}
+}
+#endif
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <typename Op>
+std::array<T, N> TVectorBase<Derived, N, T, P>::lanewise(const std::array<T, N>& a, const std::array<T, N>& b, Op op)
+{
+	std::array<T, N> result;
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float> && 0 == N % 4)
+	{
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			(_mm_storeu_ps(&result[K * 4], packed(_mm_loadu_ps(&a[K * 4]), _mm_loadu_ps(&b[K * 4]), op)), ...);
+		}(std::make_index_sequence<N / 4>());
+		return result;
+	}
+	else if constexpr (std::is_same_v<T, double> && 0 == N % 2)
+	{
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			(_mm_storeu_pd(&result[K * 2], packed(_mm_loadu_pd(&a[K * 2]), _mm_loadu_pd(&b[K * 2]), op)), ...);
+		}(std::make_index_sequence<N / 2>());
+		return result;
+	}
+#endif
+	[&]<size_t... I>(std::index_sequence<I...>)
+	{
+		((result[I] = op(a[I], b[I])), ...);
+	}(std::make_index_sequence<N>());
+	return result;
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <typename Op>
+std::array<T, N> TVectorBase<Derived, N, T, P>::lanewise(const std::array<T, N>& a, const T& s, Op op)
+{
+	std::array<T, N> result;
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float> && 0 == N % 4)
+	{
+		const __m128 b = _mm_set1_ps(s);
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			(_mm_storeu_ps(&result[K * 4], packed(_mm_loadu_ps(&a[K * 4]), b, op)), ...);
+		}(std::make_index_sequence<N / 4>());
+		return result;
+	}
+	else if constexpr (std::is_same_v<T, double> && 0 == N % 2)
+	{
+		const __m128d b = _mm_set1_pd(s);
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			(_mm_storeu_pd(&result[K * 2], packed(_mm_loadu_pd(&a[K * 2]), b, op)), ...);
+		}(std::make_index_sequence<N / 2>());
+		return result;
+	}
+#endif
+	[&]<size_t... I>(std::index_sequence<I...>)
+	{
+		((result[I] = op(a[I], s)), ...);
+	}(std::make_index_sequence<N>());
+	return result;
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::operator+(const Derived& other) const
+{
+	return Derived(lanewise(m_data, other.m_data, std::plus<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::operator-(const Derived& other) const
+{
+	return Derived(lanewise(m_data, other.m_data, std::minus<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::operator-() const
+{
+	return Derived(lanewise(m_data, T(-1), std::multiplies<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::operator*(const T& val) const
+{
+	return Derived(lanewise(m_data, val, std::multiplies<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::operator/(const T& val) const
+{
+	if (!checkCondition<P>(T() != val))
+	{
+		// std::cerr << "Error: Division by zero" << std::endl;
+		return Derived(invalid());
+	}
+	return Derived(lanewise(m_data, val, std::divides<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived& TVectorBase<Derived, N, T, P>::operator+=(const Derived& other)
+{
+	m_data = lanewise(m_data, other.m_data, std::plus<>());
+	return static_cast<Derived&>(*this);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived& TVectorBase<Derived, N, T, P>::operator-=(const Derived& other)
+{
+	m_data = lanewise(m_data, other.m_data, std::minus<>());
+	return static_cast<Derived&>(*this);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived& TVectorBase<Derived, N, T, P>::operator*=(const T& val)
+{
+	m_data = lanewise(m_data, val, std::multiplies<>());
+	return static_cast<Derived&>(*this);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived& TVectorBase<Derived, N, T, P>::operator/=(const T& val)
+{
+	if (!checkCondition<P>(T() != val))
+	{
+		// std::cerr << "Error: Division by zero" << std::endl;
+		m_data = invalid();
+		return static_cast<Derived&>(*this);
+	}
+
+	m_data = lanewise(m_data, val, std::divides<>());
+	return static_cast<Derived&>(*this);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+bool TVectorBase<Derived, N, T, P>::operator==(const TVectorBase& other) const
+{
+	return [&]<size_t... I>(std::index_sequence<I...>)
+	{
+		return ((m_data[I] == other.m_data[I]) && ...);
+	}(std::make_index_sequence<N>());
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+bool TVectorBase<Derived, N, T, P>::operator!=(const TVectorBase& other) const
+{
+	return !(*this == other);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T TVectorBase<Derived, N, T, P>::operator[](const int index) const
+{
+	if (!checkCondition<P>(index >= 0 && index < static_cast<int>(N)))
+	{
+		// std::cerr << "Error: illegal index" << std::endl;
+		return std::numeric_limits<T>::quiet_NaN();
+	}
+	return m_data[index];
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T& TVectorBase<Derived, N, T, P>::operator[](const int index)
+{
+	if (!checkCondition<P>(index >= 0 && index < static_cast<int>(N)))
+	{
+		// std::cerr << "Error: illegal index" << std::endl;
+		static thread_local T invalid;
+		invalid = std::numeric_limits<T>::quiet_NaN();
+		return invalid;
+	}
+	return m_data[index];
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T TVectorBase<Derived, N, T, P>::operator*(const Derived& other) const
+{
+#ifdef MATH_SIMD_SSE2
+	if constexpr (std::is_same_v<T, float> && 0 == N % 4)
+	{
+		__m128 sum = _mm_setzero_ps();
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			((sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&m_data[K * 4]), _mm_loadu_ps(&other.m_data[K * 4])))), ...);
+		}(std::make_index_sequence<N / 4>());
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		return _mm_cvtss_f32(sum);
+	}
+	else if constexpr (std::is_same_v<T, double> && 0 == N % 2)
+	{
+		__m128d sum = _mm_setzero_pd();
+		[&]<size_t... K>(std::index_sequence<K...>)
+		{
+			((sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(&m_data[K * 2]), _mm_loadu_pd(&other.m_data[K * 2])))), ...);
+		}(std::make_index_sequence<N / 2>());
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+#endif
+	return [&]<size_t... I>(std::index_sequence<I...>)
+	{
+		return (... + (m_data[I] * other.m_data[I]));
+	}(std::make_index_sequence<N>());
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T TVectorBase<Derived, N, T, P>::dot(const Derived& other) const
+{
+	return *this * other;
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+Derived TVectorBase<Derived, N, T, P>::multiply(const Derived& other) const
+{
+	return Derived(lanewise(m_data, other.m_data, std::multiplies<>()));
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T TVectorBase<Derived, N, T, P>::squaredLength() const
+{
+	return *this * static_cast<const Derived&>(*this);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <PrecisionPolicy R>
+PrecisionType<T, R> TVectorBase<Derived, N, T, P>::length() const
+{
+	if constexpr (PrecisionPolicy::Native == R && !std::is_integral_v<T>)
+	{
+		return std::sqrt(squaredLength());
+	}
+	else
+	{
+		return euclideanLength<R>(m_data);
+	}
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <PrecisionPolicy R>
+PrecisionType<T, R> TVectorBase<Derived, N, T, P>::distanceTo(const Derived& vec) const
+{
+	if constexpr (PrecisionPolicy::Native == R && !std::is_integral_v<T>)
+	{
+		return (vec - static_cast<const Derived&>(*this)).template length<R>();
+	}
+	else
+	{
+		return euclideanDistance<R>(m_data, vec.m_data);
+	}
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <PrecisionPolicy R>
+void TVectorBase<Derived, N, T, P>::normalized()
+{
+	m_data = makeNormalize<R>().m_data;
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+template <PrecisionPolicy R>
+Derived TVectorBase<Derived, N, T, P>::makeNormalize() const
+{
+	if constexpr (PrecisionPolicy::Native == R && !std::is_integral_v<T>)
+	{
+		const T len = length<R>();
+		if (!(len > T(0)))
+		{
+			return Derived();
+		}
+		return *this * (T(1) / len);
+	}
+	else
+	{
+		return Derived(normalizedArray<R>(m_data));
+	}
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+void TVectorBase<Derived, N, T, P>::makeZero()
+{
+	m_data.fill(T());
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+void TVectorBase<Derived, N, T, P>::fill(const T& val)
+{
+	m_data.fill(val);
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+const std::array<T, N>& TVectorBase<Derived, N, T, P>::components() const
+{
+	return m_data;
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+const T* TVectorBase<Derived, N, T, P>::data() const
+{
+	return m_data.data();
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P>
+T* TVectorBase<Derived, N, T, P>::data()
+{
+	return m_data.data();
+}
+
+template <typename Derived, size_t N, validtype T, CheckPolicy P, validtype W>
+Derived operator*(const W val, const TVectorBase<Derived, N, T, P>& vec)
+{
+	return vec * static_cast<T>(val);
+}
+
+template <size_t N, validtype T, CheckPolicy P>
+TVector<N, T, P>::TVector(const T& val)
+{
+	this->m_data.fill(val);
+}
+
+template <size_t N, validtype T, CheckPolicy P>
+TVector<N, T, P>::TVector(const std::array<T, N>& values)
+	: Base(values)
+{
+}
+
+template <size_t N, validtype T, CheckPolicy P>
+template <typename... Args>
+	requires (N > 1 && sizeof...(Args) == N && (std::is_convertible_v<Args, T> && ...))
+TVector<N, T, P>::TVector(const Args&... values)
+	: Base({ static_cast<T>(values)... })
+{
+}
+
+END_NAMESPACE
+
+namespace std
+{
+	/*!
+	 * std::hash 特化，与 operator== 一致（+0 与 -0 相等）
+	 */
+	template <size_t N, math::validtype T, math::CheckPolicy P>
+	struct hash<math::TVector<N, T, P>>
+	{
+		size_t operator()(const math::TVector<N, T, P>& vec) const noexcept
+		{
+			return std::apply([](const auto... values) { return math::hashValues(values...); }, vec.components());
+		}
+	};
+
+#ifdef __cpp_lib_format
+	/*!
+	 * std::format 支持，输出 "(x, y, z)"；格式说明作用于每个分量，如 std::format("{:.3f}", vec)
+	 */
+	template <math::vectortype Vector>
+	struct formatter<Vector, char> : formatter<typename Vector::Scalar, char>
+	{
+		template <typename FormatContext>
+		auto format(const Vector& vec, FormatContext& context) const
+		{
+			auto out = context.out();
+			*out++ = '(';
+			for (size_t i(0); i < Vector::s_size; ++i)
+			{
+				if (i > 0)
+				{
+					*out++ = ',';
+					*out++ = ' ';
+				}
+				context.advance_to(out);
+				out = formatter<typename Vector::Scalar, char>::format(vec.components()[i], context);
+			}
+			*out++ = ')';
+			return out;
+		}
+	};
+#endif
+}
+
+#endif
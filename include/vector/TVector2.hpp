@@ -3,22 +3,22 @@
 
 #include "MathMacro.h"
 #include "MathCore.h"
+#include "vector/TVector.hpp"
 #include <array>
-#include <limits>
+#include <functional>
 
 BEGIN_NAMESPACE
 
-template <validtype T>
-class TVector2
+template <validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TVector2 : public TVectorBase<TVector2<T, P>, 2, T, P>
 {
 public:
-	TVector2();
-	TVector2(const T& val);
-	TVector2(const T& x = T(), const T& y = T());
-	TVector2(const TVector2& other);
-	TVector2(TVector2&& other) noexcept;
+	using Base = TVectorBase<TVector2, 2, T, P>;
 
-	~TVector2() = default;
+	TVector2() = default;
+	explicit TVector2(const T& val);
+	TVector2(const T& x, const T& y);
+	explicit TVector2(const std::array<T, 2>& xy);
 
 public:
 	void setX(const T& x);
@@ -32,418 +32,139 @@ public:
 	const T& cy() const;
 
 public:
-	TVector2 operator+(const TVector2& other);
-	TVector2 operator-(const TVector2& other);
-	TVector2 operator-();
-	TVector2 operator*(const T& val);
-	TVector2 operator/(const T& val);
-	TVector2& operator=(const TVector2& other);
-	TVector2& operator=(TVector2&& other) noexcept;
-	TVector2& operator+=(const TVector2& other);
-	TVector2& operator-=(const TVector2& other);
-	TVector2& operator*=(const T& val);
-	TVector2& operator/=(const T& val);
-
-	bool operator==(const TVector2& other) const;
-	bool operator!=(const TVector2& other) const;
-
-	T operator[](const int index) const;
-	T& operator[](const int index);
-
-	/**
-	 * @brief 向量点乘
-	 * @param other 另一个向量
-	 * @return 点乘结果
-	 */
-	T operator*(const TVector2& other);
-
-	/**
-	 * @brief 向量点乘
-	 * @param other 另一个向量
-	 * @return 点乘结果
-	 */
-	T dot(const TVector2& other);
-
 	/**
 	 * @brief 向量叉乘
 	 * @param other 另一个向量
 	 * @return 叉乘结果
 	 */
-	T operator^(const TVector2& other);
+	T operator^(const TVector2& other) const;
 
 	/**
 	 * @brief 向量叉乘
 	 * @param other 另一个向量
 	 * @return 叉乘结果
 	 */
-	T cross(const TVector2& other);
-
-	/**
-	 * @brief 求向量长度的平方
-	 * @return 向量长度的平方
-	 */
-	T squaredLength();
-
-	/**
-	 * @brief 计算向量的长度（模）
-	 * @return 向量长度
-	 */
-	double length();
-
-	/**
-	 * @brief 计算两个向量的距离
-	 * @param vec 另一个向量
-	 * @return 返回两个向量的距离
-	 */
-	double distanceTo(const TVector2& vec);
-
-	/**
-	 * @brief 向量归一化
-	 */
-	void normalized();
-
-	/**
-	 * @brief 向量归一化
-	 * @return 向量归一化结果
-	 */
-	TVector2 makeNormalize();
-
-	/**
-	 * @brief 向量置 0
-	 */
-	void makeZero();
-
-	/**
-	 * @brief 用某个值填充向量
-	 * @param val 要填充的值
-	 */
-	void fill(const T& val);
-
-	template <validtype U, validtype W>
-	friend TVector2<U> operator*(W val, const TVector2<U>& vec);
+	T cross(const TVector2& other) const;
 
 public:
 	static const TVector2 zeroVector;
 	static const TVector2 unitVector;
 	static const TVector2 xAxisVector;
 	static const TVector2 yAxisVector;
-
-private:
-	std::array<T, 2> m_xy;
 };
 
-template <validtype T>
-TVector2<T>::TVector2()
-{
-	m_xy.fill(T());
-}
-
-template <validtype T>
-TVector2<T>::TVector2(const T& val)
-{
-	m_xy.fill(T());
-}
-
-template<validtype T>
-TVector2<T>::TVector2(const T& x, const T& y)
-{
-	m_xy[0] = x;
-	m_xy[1] = y;
-}
-
-template<validtype T>
-TVector2<T>::TVector2(const TVector2& other)
-{
-	m_xy = other.m_xy;
-}
-
-template <validtype T>
-TVector2<T>::TVector2(TVector2&& other) noexcept
-{
-	m_xy = other.m_xy;
-	other = zeroVector;
-}
-
-
-template <validtype T>
-void TVector2<T>::setX(const T& x)
-{
-	m_xy[0] = x;
-}
-
-template <validtype T>
-void TVector2<T>::setY(const T& y)
-{
-	m_xy[1] = y;
-}
-
-template <validtype T>
-void TVector2<T>::set(const T& x, const T& y)
-{
-	m_xy[0] = x;
-	m_xy[1] = y;
-}
-
-template <validtype T>
-T TVector2<T>::x() const
-{
-	return m_xy[0];
-}
-
-template <validtype T>
-T TVector2<T>::y() const
-{
-	return m_xy[1];
-}
-
-template <validtype T>
-T& TVector2<T>::rx()
-{
-	return m_xy[0];
-}
-
-template <validtype T>
-T& TVector2<T>::ry()
-{
-	return m_xy[1];
-}
+// 静态常量的通用定义，MathHeader.h 中的显式特化优先
+template <validtype T, CheckPolicy P>
+const TVector2<T, P> TVector2<T, P>::zeroVector(T(0), T(0));
 
-template <validtype T>
-const T& TVector2<T>::cx() const
-{
-	return m_xy[0];
-}
+template <validtype T, CheckPolicy P>
+const TVector2<T, P> TVector2<T, P>::unitVector(T(1), T(1));
 
-template <validtype T>
-const T& TVector2<T>::cy() const
-{
-	return m_xy[1];
-}
+template <validtype T, CheckPolicy P>
+const TVector2<T, P> TVector2<T, P>::xAxisVector(T(1), T(0));
 
-template <validtype T>
-TVector2<T> TVector2<T>::operator+(const TVector2& other)
-{
-	return std::move(TVector2(m_xy[0] + other.m_xy[0], m_xy[1] + other.m_xy[1]));
-}
-
-template <validtype T>
-TVector2<T> TVector2<T>::operator-(const TVector2& other)
-{
-	return std::move(TVector2(m_xy[0] - other.m_xy[0], m_xy[1] - other.m_xy[1]));
-}
+template <validtype T, CheckPolicy P>
+const TVector2<T, P> TVector2<T, P>::yAxisVector(T(0), T(1));
 
-template <validtype T>
-TVector2<T> TVector2<T>::operator-()
+template <validtype T, CheckPolicy P>
+TVector2<T, P>::TVector2(const T& val)
+	: Base({ val, val })
 {
-	return std::move(TVector2(-m_xy[0], -m_xy[1]));
 }
 
-template <validtype T>
-TVector2<T> TVector2<T>::operator*(const T& val)
+template <validtype T, CheckPolicy P>
+TVector2<T, P>::TVector2(const T& x, const T& y)
+	: Base({ x, y })
 {
-	return std::move(TVector2(m_xy[0] * val, m_xy[1] * val));
 }
 
-template <validtype T>
-TVector2<T> TVector2<T>::operator/(const T& val)
+template <validtype T, CheckPolicy P>
+TVector2<T, P>::TVector2(const std::array<T, 2>& xy)
+	: Base(xy)
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-		return std::move(TVector2(std::numeric_limits<T>::quiet_NaN()));
-	}
-	return std::move(TVector2(m_xy[0] / val, m_xy[1] / val));
 }
 
-template <validtype T>
-TVector2<T>& TVector2<T>::operator=(const TVector2& other)
+template <validtype T, CheckPolicy P>
+void TVector2<T, P>::setX(const T& x)
 {
-	if (this != &other)
-	{
-		m_xy = other.m_xy;
-	}
-
-	return *this;
+	this->m_data[0] = x;
 }
 
-template <validtype T>
-TVector2<T>& TVector2<T>::operator=(TVector2&& other) noexcept
+template <validtype T, CheckPolicy P>
+void TVector2<T, P>::setY(const T& y)
 {
-	if (this != &other)
-	{
-		m_xy = other.m_xy;
-		other = zeroVector;
-	}
-
-	return *this;
-}
-
-template <validtype T>
-TVector2<T>& TVector2<T>::operator+=(const TVector2& other)
-{
-	for (int i(0); i < m_xy.size(); ++i)
-	{
-		m_xy[i] += other.m_xy[i];
-	}
-
-	return *this;
-}
-
-template <validtype T>
-TVector2<T>& TVector2<T>::operator-=(const TVector2& other)
-{
-	for (int i(0); i < m_xy.size(); ++i)
-	{
-		m_xy[i] -= other.m_xy[i];
-	}
-
-	return *this;
-}
-
-template <validtype T>
-TVector2<T>& TVector2<T>::operator*=(const T& val)
-{
-	for (int i(0); i < m_xy.size(); ++i)
-	{
-		m_xy[i] *= val;
-	}
-
-	return *this;
+	this->m_data[1] = y;
 }
 
-template <validtype T>
-TVector2<T>& TVector2<T>::operator/=(const T& val)
+template <validtype T, CheckPolicy P>
+void TVector2<T, P>::set(const T& x, const T& y)
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-
-		*this = TVector2(std::numeric_limits<T>::quiet_NaN());
-		return *this;
-	}
-
-	for (int i(0); i < m_xy.size(); ++i)
-	{
-		m_xy[i] /= val;
-	}
-
-	return *this;
+	this->m_data = { x, y };
 }
 
-template <validtype T>
-bool TVector2<T>::operator==(const TVector2& other) const
+template <validtype T, CheckPolicy P>
+T TVector2<T, P>::x() const
 {
-	return (m_xy == other.m_xy);
+	return this->m_data[0];
 }
 
-template <validtype T>
-bool TVector2<T>::operator!=(const TVector2& other) const
+template <validtype T, CheckPolicy P>
+T TVector2<T, P>::y() const
 {
-	return (m_xy != other.m_xy);
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector2<T>::operator[](const int index) const
+template <validtype T, CheckPolicy P>
+T& TVector2<T, P>::rx()
 {
-	if (index < 0 || index > 1)
-	{
-		// std::cerr << "Error: illegal index" << std::endl;
-		return TVector2(std::numeric_limits<T>::quiet_NaN());
-	}
-
-	return m_xy[index];
+	return this->m_data[0];
 }
 
-template <validtype T>
-T& TVector2<T>::operator[](const int index)
+template <validtype T, CheckPolicy P>
+T& TVector2<T, P>::ry()
 {
-	if (index < 0 || index > 1)
-	{
-		// std::cerr << "Error: illegal index" << std::endl;
-		return TVector2(std::numeric_limits<T>::quiet_NaN());
-	}
-
-	return m_xy[index];
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector2<T>::operator*(const TVector2& other)
+template <validtype T, CheckPolicy P>
+const T& TVector2<T, P>::cx() const
 {
-	return m_xy[0] * other.m_xy[0] + m_xy[1] * other.m_xy[1];
+	return this->m_data[0];
 }
 
-template <validtype T>
-T TVector2<T>::dot(const TVector2& other)
+template <validtype T, CheckPolicy P>
+const T& TVector2<T, P>::cy() const
 {
-	return *this * other;
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector2<T>::operator^(const TVector2& other)
+template <validtype T, CheckPolicy P>
+T TVector2<T, P>::operator^(const TVector2& other) const
 {
-	return m_xy[0] * other.m_xy[1] - m_xy[1] * other.m_xy[0];
+	return this->m_data[0] * other.m_data[1] - this->m_data[1] * other.m_data[0];
 }
 
-template <validtype T>
-T TVector2<T>::cross(const TVector2& other)
+template <validtype T, CheckPolicy P>
+T TVector2<T, P>::cross(const TVector2& other) const
 {
 	return *this ^ other;
 }
 
-template <validtype T>
-T TVector2<T>::squaredLength()
-{
-	return std::pow(m_xy[0], 2) + std::pow(m_xy[1], 2);
-}
-
-template <validtype T>
-double TVector2<T>::length()
-{
-	return std::sqrt(squaredLength());
-}
-
-template <validtype T>
-double TVector2<T>::distanceTo(const TVector2& vec)
-{
-	TVector2 result = vec - *this;
-	return result.length();
-}
-
-template <validtype T>
-void TVector2<T>::normalized()
-{
-	*this = makeNormalize();
-}
+END_NAMESPACE
 
-template <validtype T>
-TVector2<T> TVector2<T>::makeNormalize()
+namespace std
 {
-	double len = length();
-	if (std::abs(len) > 0.0)
+	/*!
+	 * std::hash 特化，与 operator== 一致（+0 与 -0 相等）
+	 */
+	template <math::validtype T, math::CheckPolicy P>
+	struct hash<math::TVector2<T, P>>
 	{
-		return *this / length();
-	}
-	return {};
-}
-
-template <validtype T>
-void TVector2<T>::makeZero()
-{
-	*this = zeroVector;
+		size_t operator()(const math::TVector2<T, P>& vec) const noexcept
+		{
+			return math::hashValues(vec.x(), vec.y());
+		}
+	};
 }
 
-template <validtype T>
-void TVector2<T>::fill(const T& val)
-{
-	m_xy.fill(val);
-}
-
-template <validtype U, validtype W>
-TVector2<U> operator*(W val, const TVector2<U>& vec)
-{
-	return TVector2<U>(val * vec.m_xy[0], val * vec.m_xy[1]);
-}
-
-END_NAMESPACE
-
 #endif // !__TVECTOR_H__
@@ -3,23 +3,24 @@
 
 #include "MathMacro.h"
 #include "MathCore.h"
-#include <limits>
+#include "vector/TVector.hpp"
+#include "vector/TVector2.hpp"
 #include <array>
+#include <functional>
 
 BEGIN_NAMESPACE
 
-template<validtype T>
-class TVector3
+template <validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TVector3 : public TVectorBase<TVector3<T, P>, 3, T, P>
 {
 public:
-	TVector3();
-	TVector3(const T& val);
-	TVector3(const T& x = T(), const T& y = T(), const T& z = T());
-	TVector3(const TVector2<T> other);
-	TVector3(const TVector3& other);
-	TVector3(TVector3&& other) noexcept;
+	using Base = TVectorBase<TVector3, 3, T, P>;
 
-	~TVector3() = default;
+	TVector3() = default;
+	explicit TVector3(const T& val);
+	TVector3(const T& x, const T& y, const T& z = T());
+	explicit TVector3(const std::array<T, 3>& xyz);
+	TVector3(const TVector2<T, P>& other);
 
 	void setX(const T& x);
 	void setY(const T& y);
@@ -32,51 +33,14 @@ public:
 	T& rx();
 	T& ry();
 	T& rz();
-	const T cx() const;
-	const T cy() const;
-	const T cz() const;
+	const T& cx() const;
+	const T& cy() const;
+	const T& cz() const;
 
 public:
-	TVector3 operator+(const TVector3& other);
-	TVector3 operator-(const TVector3& other);
-	TVector3 operator-();
-	TVector3 operator*(const T& val);
-	TVector3 operator/(const T& val);
-	TVector3& operator=(const TVector3& other);
-	TVector3& operator=(TVector3&& other) noexcept;
-	TVector3& operator+=(const TVector3& other);
-	TVector3& operator-=(const TVector3& other);
-	TVector3& operator*=(const T& val);
-	TVector3& operator/=(const T& val);
-
-	bool operator==(const TVector3& other) const;
-	bool operator!=(const TVector3& other) const;
-
-	T operator[](const int index) const;
-	T& operator[](const int index);
-
-	T operator*(const TVector3& other);
-	T dot(const TVector3& other);
-
-	TVector3 operator^(const TVector3& other);
+	TVector3 operator^(const TVector3& other) const;
 	TVector3& operator^=(const TVector3& other);
-	TVector3 cross(const TVector3& other);
-
-	void makeZero();
-
-	double length();
-
-	T squaredLength();
-
-	void normalized();
-	TVector3 makeNormalize();
-
-	double distanceTo(const TVector3& vec);
-
-	void fill(const T& val);
-
-	template <validtype U, validtype W>
-	friend TVector3<U> operator*(W val, const TVector3<U>& vec);
+	TVector3 cross(const TVector3& other) const;
 
 public:
 	static const TVector3 zeroVector;
@@ -84,362 +48,166 @@ public:
 	static const TVector3 xAxisVector;
 	static const TVector3 yAxisVector;
 	static const TVector3 zAxisVector;
-
-private:
-	std::array<T, 3> m_xyz;
 };
 
-template<validtype T>
-TVector3<T>::TVector3()
-{
-	m_xyz.fill(T());
-}
+// 静态常量的通用定义，MathHeader.h 中的显式特化优先
+template <validtype T, CheckPolicy P>
+const TVector3<T, P> TVector3<T, P>::zeroVector(T(0), T(0), T(0));
 
-template <validtype T>
-TVector3<T>::TVector3(const T& val)
-{
-	m_xyz.fill(val);
-}
-
-template<validtype T>
-TVector3<T>::TVector3(const T& x, const T& y, const T& z)
-{
-	m_xyz[0] = x;
-	m_xyz[1] = y;
-	m_xyz[2] = z;
-}
-
-template <validtype T>
-TVector3<T>::TVector3(const TVector2<T> other)
-{
-	m_xyz[0] = other.m_xy[0];
-	m_xyz[1] = other.m_xy[1];
-}
-
-template<validtype T>
-TVector3<T>::TVector3(const TVector3& other)
-{
-	m_xyz = other.m_xyz;
-}
-
-template<validtype T>
-TVector3<T>::TVector3(TVector3&& other) noexcept
-{
-	m_xyz = other.m_xyz;
-	other = zeroVector;
-}
-
-template <validtype T>
-void TVector3<T>::setX(const T& x)
-{
-	m_xyz[0] = x;
-}
-
-template <validtype T>
-void TVector3<T>::setY(const T& y)
-{
-	m_xyz[1] = y;
-}
-
-template <validtype T>
-void TVector3<T>::setZ(const T& z)
-{
-	m_xyz[2] = z;
-}
-
-template <validtype T>
-void TVector3<T>::set(const T& x, const T& y, const T& z)
-{
-	m_xyz[0] = x;
-	m_xyz[1] = y;
-	m_xyz[2] = z;
-}
-
-template <validtype T>
-T TVector3<T>::x() const
-{
-	return m_xyz[0];
-}
-
-template <validtype T>
-T TVector3<T>::y() const
-{
-	return m_xyz[1];
-}
-
-template <validtype T>
-T TVector3<T>::z() const
-{
-	return m_xyz[2];
-}
-
-template <validtype T>
-T& TVector3<T>::rx()
-{
-	return m_xyz[0];
-}
-
-template <validtype T>
-T& TVector3<T>::ry()
-{
-	return m_xyz[1];
-}
-
-template <validtype T>
-T& TVector3<T>::rz()
-{
-	return m_xyz[2];
-}
+template <validtype T, CheckPolicy P>
+const TVector3<T, P> TVector3<T, P>::unitVector(T(1), T(1), T(1));
 
-template <validtype T>
-const T TVector3<T>::cx() const
-{
-	return m_xyz[0];
-}
+template <validtype T, CheckPolicy P>
+const TVector3<T, P> TVector3<T, P>::xAxisVector(T(1), T(0), T(0));
 
-template <validtype T>
-const T TVector3<T>::cy() const
-{
-	return m_xyz[1];
-}
+template <validtype T, CheckPolicy P>
+const TVector3<T, P> TVector3<T, P>::yAxisVector(T(0), T(1), T(0));
 
-template <validtype T>
-const T TVector3<T>::cz() const
-{
-	return m_xyz[2];
-}
+template <validtype T, CheckPolicy P>
+const TVector3<T, P> TVector3<T, P>::zAxisVector(T(0), T(0), T(1));
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator+(const TVector3& other)
+template <validtype T, CheckPolicy P>
+TVector3<T, P>::TVector3(const T& val)
+	: Base({ val, val, val })
 {
-	return std::move(TVector3(m_xyz[0] + other.m_xyz[0], m_xyz[1] + other.m_xyz[1], m_xyz[2] + other.m_xyz[2]));
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator-(const TVector3& other)
+template <validtype T, CheckPolicy P>
+TVector3<T, P>::TVector3(const T& x, const T& y, const T& z)
+	: Base({ x, y, z })
 {
-	return std::move(TVector3(m_xyz[0] - other.m_xyz[0]), m_xyz[1] - other.m_xyz[1], m_xyz[2] - other.m_xyz[2]);
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator-()
+template <validtype T, CheckPolicy P>
+TVector3<T, P>::TVector3(const std::array<T, 3>& xyz)
+	: Base(xyz)
 {
-	return std::move(TVector3(-m_xyz[0], -m_xyz[1], -m_xyz[2]));
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator*(const T& val)
+template <validtype T, CheckPolicy P>
+TVector3<T, P>::TVector3(const TVector2<T, P>& other)
+	: Base({ other.x(), other.y(), T() })
 {
-	return std::move(TVector3(m_xyz[0] * val, m_xyz[1] * val, m_xyz[2] * val));
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator/(const T& val)
+template <validtype T, CheckPolicy P>
+void TVector3<T, P>::setX(const T& x)
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-		return std::move(TVector3(std::numeric_limits<T>::quiet_NaN()));
-	}
-
-	return std::move(TVector3(m_xyz[0] / val, m_xyz[1] / val, m_xyz[2] / val));
+	this->m_data[0] = x;
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator=(const TVector3& other)
+template <validtype T, CheckPolicy P>
+void TVector3<T, P>::setY(const T& y)
 {
-	if (*this != &other)
-	{
-		m_xyz = other.m_xyz;
-	}
-
-	return *this;
+	this->m_data[1] = y;
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator=(TVector3&& other) noexcept
+template <validtype T, CheckPolicy P>
+void TVector3<T, P>::setZ(const T& z)
 {
-	if (*this != other)
-	{
-		m_xyz = other.m_xyz;
-	}
-
-	return *this;
+	this->m_data[2] = z;
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator+=(const TVector3& other)
+template <validtype T, CheckPolicy P>
+void TVector3<T, P>::set(const T& x, const T& y, const T& z)
 {
-	for (int i(0); i < m_xyz.size(); ++i)
-	{
-		m_xyz[i] += other.m_xyz[i];
-	}
-
-	return *this;
+	this->m_data = { x, y, z };
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator-=(const TVector3& other)
+template <validtype T, CheckPolicy P>
+T TVector3<T, P>::x() const
 {
-	for (int i(0); i < m_xyz.size(); ++i)
-	{
-		m_xyz[i] -= other.m_xyz[i];
-	}
-
-	return *this;
+	return this->m_data[0];
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator*=(const T& val)
+template <validtype T, CheckPolicy P>
+T TVector3<T, P>::y() const
 {
-	for (int i(0); i < m_xyz.size(); ++i)
-	{
-		m_xyz[i] *= val;
-	}
-
-	return *this;
+	return this->m_data[1];
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator/=(const T& val)
+template <validtype T, CheckPolicy P>
+T TVector3<T, P>::z() const
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-		*this = TVector3(std::numeric_limits<T>::quiet_NaN());
-		return *this;
-	}
-
-	for (int i(0); i < m_xyz.size(); ++i)
-	{
-		m_xyz[i] /= val;
-	}
-
-	return *this;
+	return this->m_data[2];
 }
 
-template <validtype T>
-bool TVector3<T>::operator==(const TVector3& other) const
+template <validtype T, CheckPolicy P>
+T& TVector3<T, P>::rx()
 {
-	return (m_xyz == other.m_xyz);
+	return this->m_data[0];
 }
 
-template <validtype T>
-bool TVector3<T>::operator!=(const TVector3& other) const
+template <validtype T, CheckPolicy P>
+T& TVector3<T, P>::ry()
 {
-	return (m_xyz != other.m_xyz);
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector3<T>::operator[](const int index) const
+template <validtype T, CheckPolicy P>
+T& TVector3<T, P>::rz()
 {
-	if (index < 0 || index > 1)
-	{
-		// std::cerr << "Error: illegal index" << std::endl;
-		return TVector3(std::numeric_limits<T>::quiet_NaN());
-	}
-	return m_xyz[index];
+	return this->m_data[2];
 }
 
-template <validtype T>
-T& TVector3<T>::operator[](const int index)
+template <validtype T, CheckPolicy P>
+const T& TVector3<T, P>::cx() const
 {
-	if (index < 0 || index > 1)
-	{
-		// std::cerr << "Error: illegal index" << std::endl;
-		return TVector3(std::numeric_limits<T>::quiet_NaN());
-	}
-	return m_xyz[index];
+	return this->m_data[0];
 }
 
-template <validtype T>
-T TVector3<T>::operator*(const TVector3& other)
+template <validtype T, CheckPolicy P>
+const T& TVector3<T, P>::cy() const
 {
-	return m_xyz[0] * other.m_xyz[0] + m_xyz[1] * other.m_xyz[1] + m_xyz[2] * other.m_xyz[2];
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector3<T>::dot(const TVector3& other)
+template <validtype T, CheckPolicy P>
+const T& TVector3<T, P>::cz() const
 {
-	return *this * other;
+	return this->m_data[2];
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::operator^(const TVector3& other)
+template <validtype T, CheckPolicy P>
+TVector3<T, P> TVector3<T, P>::operator^(const TVector3& other) const
 {
-	return std::move(TVector3(
-		m_xyz[1] * other.m_xyz[2] - m_xyz[2] * other.m_xyz[1],
-		m_xyz[2] * other.m_xyz[0] - m_xyz[0] * other.m_xyz[2],
-		m_xyz[0] * other.m_xyz[1] - m_xyz[1] * other.m_xyz[0]
-	));	
+	const std::array<T, 3>& a = this->m_data;
+	const std::array<T, 3>& b = other.m_data;
+	return TVector3(
+		a[1] * b[2] - a[2] * b[1],
+		a[2] * b[0] - a[0] * b[2],
+		a[0] * b[1] - a[1] * b[0]
+	);
 }
 
-template <validtype T>
-TVector3<T>& TVector3<T>::operator^=(const TVector3& other)
+template <validtype T, CheckPolicy P>
+TVector3<T, P>& TVector3<T, P>::operator^=(const TVector3& other)
 {
 	*this = *this ^ other;
 	return *this;
 }
 
-template <validtype T>
-TVector3<T> TVector3<T>::cross(const TVector3& other)
-{
-	return std::move(*this ^ other);
-}
-
-template <validtype T>
-void TVector3<T>::makeZero()
-{
-	*this = zeroVector;
-}
-
-template <validtype T>
-double TVector3<T>::length()
-{
-	return std::sqrt(squaredLength());
-}
-
-template <validtype T>
-T TVector3<T>::squaredLength()
+template <validtype T, CheckPolicy P>
+TVector3<T, P> TVector3<T, P>::cross(const TVector3& other) const
 {
-	return std::pow(m_xyz[0], 2) + std::pow(m_xyz[1], 2) + std::pow(m_xyz[2], 2);
+	return *this ^ other;
 }
 
-template <validtype T>
-void TVector3<T>::normalized()
-{
-	*this - makeNormalize();
-}
+END_NAMESPACE
 
-template <validtype T>
-TVector3<T> TVector3<T>::makeNormalize()
+namespace std
 {
-	double len = length();
-	if (std::abs(len) > 0.0)
+	/*!
+	 * std::hash 特化，与 operator== 一致（+0 与 -0 相等）
+	 */
+	template <math::validtype T, math::CheckPolicy P>
+	struct hash<math::TVector3<T, P>>
 	{
-		return *this / length();
-	}
-	return {};
+		size_t operator()(const math::TVector3<T, P>& vec) const noexcept
+		{
+			return math::hashValues(vec.x(), vec.y(), vec.z());
+		}
+	};
 }
 
-template <validtype T>
-double TVector3<T>::distanceTo(const TVector3& vec)
-{
-	TVector3 result(vec.m_xyz[0] - m_xyz[0], vec.m_xyz[1] - m_xyz[1], vec.m_xyz[2] - m_xyz[2]);
-	return result.length();
-}
-
-template <validtype T>
-void TVector3<T>::fill(const T& val)
-{
-	m_xyz.fill(val);
-}
-
-template <validtype U, validtype W>
-TVector3<U> operator*(W val, const TVector3<U>& vec)
-{
-	return vec * val;
-}
-
-END_NAMESPACE
 #endif
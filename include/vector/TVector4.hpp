@@ -3,22 +3,26 @@
 
 #include "MathMacro.h"
 #include "MathCore.h"
-#include <limits>
+#include "vector/TVector.hpp"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
 #include <array>
+#include <functional>
 
 BEGIN_NAMESPACE
 
-template<validtype T>
-class TVector4
+template <validtype T, CheckPolicy P = CheckPolicy::Checked>
+class TVector4 : public TVectorBase<TVector4<T, P>, 4, T, P>
 {
 public:
-	TVector4();
-	TVector4(const T& val);
-	TVector4(const T& x = T(), const T& y = T(), const T& z = T(), const T& w = T());
-	TVector4(const TVector2<T>& other);
-	TVector4(const TVector3<T>& other);
-	TVector4(const TVector4& other);
-	TVector4(TVector4&& other) noexcept;
+	using Base = TVectorBase<TVector4, 4, T, P>;
+
+	TVector4() = default;
+	explicit TVector4(const T& val);
+	TVector4(const T& x, const T& y, const T& z = T(), const T& w = T());
+	explicit TVector4(const std::array<T, 4>& xyzw);
+	TVector4(const TVector2<T, P>& other);
+	TVector4(const TVector3<T, P>& other);
 
 public:
 	void setX(const T& val);
@@ -41,42 +45,15 @@ public:
 	const T& cw() const;
 
 public:
-	TVector4 operator+(const TVector4& other);
-	TVector4 operator-(const TVector4& other);
-	TVector4 operator-();
-	TVector4 operator*(const T& val);
-	TVector4 operator/(const T& val);
-	TVector4& operator+=(const TVector4& other);
-	TVector4& operator-=(const TVector4& other);
-	TVector4& operator*=(const T& val);
-	TVector4& operator/=(const T& val);
-	TVector4& operator=(const TVector4& other);
-	TVector4& operator=(TVector4&& other) noexcept;
-	bool operator==(const TVector4& other) const;
-	bool operator!=(const TVector4& other) const;
-
-	T operator*(const TVector4& other);
-	T dot(const TVector4& other);
-
-	TVector4 operator^(const TVector4& other);
+	TVector4 operator^(const TVector4& other) const;
 	TVector4& operator^=(const TVector4& other);
-	TVector4 cross(const TVector4& other);
-
-	void fill(const T& val);
-	void makeZero();
-	double length();
-	T squaredLength();
-	void normalized();
-	TVector4 makeNormalize();
+	TVector4 cross(const TVector4& other) const;
 
 	/**
 	 * @brief 
 	 */
 	void makeHomogeneous();
 
-	template <validtype U, validtype W>
-	friend TVector4<U> operator*(W val, const TVector4<U>& vec);
-
 public:
 	static const TVector4 zeroVector;
 	static const TVector4 unitVector;
@@ -84,394 +61,209 @@ public:
 	static const TVector4 yAxisVector;
 	static const TVector4 zAxisVector;
 	static const TVector4 wAxisVector;
-
-private:
-	std::array<T, 4> m_xyzw;
 };
 
-template <validtype T>
-TVector4<T>::TVector4()
-{
-	m_xyzw.fill(T());
-}
+// ̬ͨö壬MathHeader.h еʽػ
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::zeroVector(T(0), T(0), T(0), T(0));
 
-template <validtype T>
-TVector4<T>::TVector4(const T& val)
-{
-	m_xyzw.fill(val);
-}
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::unitVector(T(1), T(1), T(1), T(1));
 
-template <validtype T>
-TVector4<T>::TVector4(const T& x, const T& y, const T& z, const T& w)
-{
-	m_xyzw[0] = x;
-	m_xyzw[1] = y;
-	m_xyzw[2] = z;
-	m_xyzw[3] = w;
-}
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::xAxisVector(T(1), T(0), T(0), T(0));
 
-template <validtype T>
-TVector4<T>::TVector4(const TVector2<T>& other)
-{
-	m_xyzw[0] = other.m_xy[0];
-	m_xyzw[1] = other.m_xy[1];
-}
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::yAxisVector(T(0), T(1), T(0), T(0));
 
-template <validtype T>
-TVector4<T>::TVector4(const TVector3<T>& other)
-{
-	m_xyzw[0] = other.m_xyz[0];
-	m_xyzw[1] = other.m_xyz[1];
-	m_xyzw[2] = other.m_xyz[2];
-}
-
-template <validtype T>
-TVector4<T>::TVector4(const TVector4& other)
-{
-	m_xyzw = other.m_xyzw;
-}
-
-template <validtype T>
-TVector4<T>::TVector4(TVector4&& other) noexcept
-{
-	m_xyzw = other.m_xyzw;
-	other = zeroVector;
-}
-
-template <validtype T>
-void TVector4<T>::setX(const T& val)
-{
-	m_xyzw[0] = val;
-}
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::zAxisVector(T(0), T(0), T(1), T(0));
 
-template <validtype T>
-void TVector4<T>::setY(const T& val)
-{
-	m_xyzw[1] = val;
-}
-
-template <validtype T>
-void TVector4<T>::setZ(const T& val)
-{
-	m_xyzw[2] = val;
-}
-
-template <validtype T>
-void TVector4<T>::setW(const T& val)
-{
-	m_xyzw[3] = val;
-}
-
-template <validtype T>
-void TVector4<T>::set(const T& x, const T& y, const T& z, const T& w)
-{
-	m_xyzw[0] = x;
-	m_xyzw[1] = y;
-	m_xyzw[2] = z;
-	m_xyzw[3] = w;
-}
-
-template <validtype T>
-T TVector4<T>::x() const
-{
-	return m_xyzw[0];
-}
-
-template <validtype T>
-T TVector4<T>::y() const
-{
-	return m_xyzw[1];
-}
-
-template <validtype T>
-T TVector4<T>::z() const
-{
-	return m_xyzw[2];
-}
-
-template <validtype T>
-T TVector4<T>::w() const
-{
-	return m_xyzw[3];
-}
-
-template <validtype T>
-T& TVector4<T>::rx()
-{
-	return m_xyzw[0];
-}
+template <validtype T, CheckPolicy P>
+const TVector4<T, P> TVector4<T, P>::wAxisVector(T(0), T(0), T(0), T(1));
 
-template <validtype T>
-T& TVector4<T>::ry()
+template <validtype T, CheckPolicy P>
+TVector4<T, P>::TVector4(const T& val)
+	: Base({ val, val, val, val })
 {
-	return m_xyzw[1];
 }
 
-template <validtype T>
-T& TVector4<T>::rz()
+template <validtype T, CheckPolicy P>
+TVector4<T, P>::TVector4(const T& x, const T& y, const T& z, const T& w)
+	: Base({ x, y, z, w })
 {
-	return m_xyzw[2];
 }
 
-template <validtype T>
-T& TVector4<T>::rw()
+template <validtype T, CheckPolicy P>
+TVector4<T, P>::TVector4(const std::array<T, 4>& xyzw)
+	: Base(xyzw)
 {
-	return m_xyzw[3];
 }
 
-template <validtype T>
-const T& TVector4<T>::cx() const
+template <validtype T, CheckPolicy P>
+TVector4<T, P>::TVector4(const TVector2<T, P>& other)
+	: Base({ other.x(), other.y(), T(), T() })
 {
-	return m_xyzw[0];
 }
 
-template <validtype T>
-const T& TVector4<T>::cy() const
+template <validtype T, CheckPolicy P>
+TVector4<T, P>::TVector4(const TVector3<T, P>& other)
+	: Base({ other.x(), other.y(), other.z(), T() })
 {
-	return m_xyzw[1];
 }
 
-template <validtype T>
-const T& TVector4<T>::cz() const
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::setX(const T& val)
 {
-	return m_xyzw[2];
+	this->m_data[0] = val;
 }
 
-template <validtype T>
-const T& TVector4<T>::cw() const
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::setY(const T& val)
 {
-	return m_xyzw[3];
+	this->m_data[1] = val;
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator+(const TVector4& other)
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::setZ(const T& val)
 {
-	return std::move(TVector4(
-		m_xyzw[0] + other.m_xyzw[0],
-		m_xyzw[1] + other.m_xyzw[1],
-		m_xyzw[2] + other.m_xyzw[2],
-		m_xyzw[3] + other.m_xyzw[3]
-	));
+	this->m_data[2] = val;
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator-(const TVector4& other)
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::setW(const T& val)
 {
-	return std::move(TVector4(
-		m_xyzw[0] - other.m_xyzw[0],
-		m_xyzw[1] - other.m_xyzw[1],
-		m_xyzw[2] - other.m_xyzw[2],
-		m_xyzw[3] - other.m_xyzw[3]
-	));
+	this->m_data[3] = val;
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator-()
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::set(const T& x, const T& y, const T& z, const T& w)
 {
-	return std::move(-m_xyzw[0], -m_xyzw[1], -m_xyzw[2], -m_xyzw[3]);
+	this->m_data = { x, y, z, w };
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator*(const T& val)
+template <validtype T, CheckPolicy P>
+T TVector4<T, P>::x() const
 {
-	return std::move(TVector4(
-		m_xyzw[0] * val,
-		m_xyzw[1] * val,
-		m_xyzw[2] * val,
-		m_xyzw[3] * val
-	));
+	return this->m_data[0];
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator/(const T& val)
+template <validtype T, CheckPolicy P>
+T TVector4<T, P>::y() const
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-		return std::move(TVector4(std::numeric_limits<T>::quiet_NaN()));
-	}
-
-	return std::move(TVector4(
-		m_xyzw[0] / val,
-		m_xyzw[1] / val,
-		m_xyzw[2] / val,
-		m_xyzw[3] / val
-	));
+	return this->m_data[1];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator+=(const TVector4& other)
+template <validtype T, CheckPolicy P>
+T TVector4<T, P>::z() const
 {
-	for (int i(0); i < m_xyzw.size(); ++i)
-	{
-		m_xyzw[i] += other.m_xyzw[i];
-	}
-	return *this;
+	return this->m_data[2];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator-=(const TVector4& other)
+template <validtype T, CheckPolicy P>
+T TVector4<T, P>::w() const
 {
-	for (int i(0); i < m_xyzw.size(); ++i)
-	{
-		m_xyzw[i] -= other.m_xyzw[i];
-	}
-	return *this;
+	return this->m_data[3];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator*=(const T& val)
+template <validtype T, CheckPolicy P>
+T& TVector4<T, P>::rx()
 {
-	for (int i(0); i < m_xyzw.size(); ++i)
-	{
-		m_xyzw[i] *= val;
-	}
-	return *this;
+	return this->m_data[0];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator/=(const T& val)
+template <validtype T, CheckPolicy P>
+T& TVector4<T, P>::ry()
 {
-	if (T() == val)
-	{
-		// std::cerr << "Error: Division by zero" << std::endl;
-		return std::move(TVector4(std::numeric_limits<T>::quiet_NaN()));
-	}
-
-	for (int i(0); i < m_xyzw.size(); ++i)
-	{
-		m_xyzw[i] /= val;
-	}
-	return *this;
+	return this->m_data[1];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator=(const TVector4& other)
+template <validtype T, CheckPolicy P>
+T& TVector4<T, P>::rz()
 {
-	if (*this != &other)
-	{
-		m_xyzw = other.m_xyzw;
-	}
-
-	return *this;
+	return this->m_data[2];
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator=(TVector4&& other) noexcept
+template <validtype T, CheckPolicy P>
+T& TVector4<T, P>::rw()
 {
-	if (*this != &other)
-	{
-		m_xyzw = other.m_xyzw;
-		other = zeroVector;
-	}
-	
-	return *this;
+	return this->m_data[3];
 }
 
-template <validtype T>
-bool TVector4<T>::operator==(const TVector4& other) const
+template <validtype T, CheckPolicy P>
+const T& TVector4<T, P>::cx() const
 {
-	return (m_xyzw == other.m_xyzw);
+	return this->m_data[0];
 }
 
-template <validtype T>
-bool TVector4<T>::operator!=(const TVector4& other) const
+template <validtype T, CheckPolicy P>
+const T& TVector4<T, P>::cy() const
 {
-	return (m_xyzw != other.m_xyzw);
+	return this->m_data[1];
 }
 
-template <validtype T>
-T TVector4<T>::operator*(const TVector4& other)
+template <validtype T, CheckPolicy P>
+const T& TVector4<T, P>::cz() const
 {
-	return m_xyzw[0] * m_xyzw[0] + m_xyzw[1] * m_xyzw[1] + m_xyzw[2] * m_xyzw[2] + m_xyzw[3] * m_xyzw[3];
+	return this->m_data[2];
 }
 
-template <validtype T>
-T TVector4<T>::dot(const TVector4& other)
+template <validtype T, CheckPolicy P>
+const T& TVector4<T, P>::cw() const
 {
-	return *this * other;
+	return this->m_data[3];
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::operator^(const TVector4& other)
+template <validtype T, CheckPolicy P>
+TVector4<T, P> TVector4<T, P>::operator^(const TVector4& other) const
 {
+	const std::array<T, 4>& a = this->m_data;
+	const std::array<T, 4>& b = other.m_data;
 	return TVector4(
-		m_xyzw[1] * other.m_xyzw[2] - m_xyzw[2] * other.m_xyzw[1],
-		m_xyzw[2] * other.m_xyzw[0] - m_xyzw[0] * other.m_xyzw[2],
-		m_xyzw[0] * other.m_xyzw[1] - m_xyzw[1] * other.m_xyzw[0],
+		a[1] * b[2] - a[2] * b[1],
+		a[2] * b[0] - a[0] * b[2],
+		a[0] * b[1] - a[1] * b[0],
 		T()
 	);
 }
 
-template <validtype T>
-TVector4<T>& TVector4<T>::operator^=(const TVector4& other)
+template <validtype T, CheckPolicy P>
+TVector4<T, P>& TVector4<T, P>::operator^=(const TVector4& other)
 {
 	*this = *this ^ other;
 	return *this;
 }
 
-template <validtype T>
-TVector4<T> TVector4<T>::cross(const TVector4& other)
+template <validtype T, CheckPolicy P>
+TVector4<T, P> TVector4<T, P>::cross(const TVector4& other) const
 {
-	return std::move(*this ^ other);
+	return *this ^ other;
 }
 
-template <validtype T>
-void TVector4<T>::fill(const T& val)
+template <validtype T, CheckPolicy P>
+void TVector4<T, P>::makeHomogeneous()
 {
-	m_xyzw.fill(val);
-}
-
-template <validtype T>
-void TVector4<T>::makeZero()
-{
-	m_xyzw.fill(T());
-}
-
-template <validtype T>
-double TVector4<T>::length()
-{
-	return std::sqrt(squaredLength());
-}
-
-template <validtype T>
-T TVector4<T>::squaredLength()
-{
-	return m_xyzw[0] * m_xyzw[0] + m_xyzw[1] * m_xyzw[1] + m_xyzw[2] * m_xyzw[2] + m_xyzw[3] * m_xyzw[3];
-}
-
-template <validtype T>
-void TVector4<T>::normalized()
-{
-	*this = makeNormalize();
-}
-
-template <validtype T>
-TVector4<T> TVector4<T>::makeNormalize()
-{
-	double len = length();
-	if (std::abs(len) > 0.0)
+	if (this->m_data[3] != T())
 	{
-		return *this / length();
+		*this /= this->m_data[3];
 	}
-	return {};
 }
 
-template <validtype T>
-void TVector4<T>::makeHomogeneous()
-{
-	if (m_xyzw[3] != T())
-	{
-		*this /= m_xyzw[3];
-	}
-}
+END_NAMESPACE
 
-template <validtype U, validtype W>
-TVector4<U> operator*(W val, const TVector4<U>& vec)
+namespace std
 {
-	return vec * val;
+	/*!
+	 * std::hash ػ operator== һ£+0  -0 ȣ
+	 */
+	template <math::validtype T, math::CheckPolicy P>
+	struct hash<math::TVector4<T, P>>
+	{
+		size_t operator()(const math::TVector4<T, P>& vec) const noexcept
+		{
+			return math::hashValues(vec.x(), vec.y(), vec.z(), vec.w());
+		}
+	};
 }
 
-END_NAMESPACE
-
 #endif // !__TVECTOR4_HPP__
@@ -0,0 +1,133 @@
+#ifndef __TVECTOR_HASH_HPP__
+#define __TVECTOR_HASH_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVectorTraits.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 向量量化：按边长 cell 的网格对各分量向下取整，得到整数格坐标
+ * 同一格内的向量视为相等，散列与相等判定一致，可直接用于 std::unordered_map / unordered_set
+ * 距离小于 cell 但跨越格边界的两个向量不相等；NaN 分量统一映射到同一格
+ */
+template <typename Vector>
+class TQuantizer
+{
+public:
+	using Traits = TVectorTraits<Vector>;
+	using Key = std::array<int64_t, Traits::s_size>;
+
+	/**
+	 * @param cell 网格边长，需大于 0
+	 */
+	explicit TQuantizer(const double cell);
+
+	/**
+	 * @brief 计算格坐标
+	 */
+	Key key(const Vector& vec) const;
+
+	/**
+	 * @brief 格坐标的散列值
+	 */
+	size_t hash(const Vector& vec) const;
+
+	/**
+	 * @brief 两个向量是否落在同一格
+	 */
+	bool equal(const Vector& a, const Vector& b) const;
+
+private:
+	double m_invCell;
+};
+
+/*!
+ * 量化散列函数对象
+ */
+template <typename Vector>
+class TQuantizedHash
+{
+public:
+	explicit TQuantizedHash(const double cell) : m_quantizer(cell) {}
+
+	size_t operator()(const Vector& vec) const
+	{
+		return m_quantizer.hash(vec);
+	}
+
+private:
+	TQuantizer<Vector> m_quantizer;
+};
+
+/*!
+ * 量化相等函数对象，需与同一 cell 的 TQuantizedHash 搭配使用
+ */
+template <typename Vector>
+class TQuantizedEqual
+{
+public:
+	explicit TQuantizedEqual(const double cell) : m_quantizer(cell) {}
+
+	bool operator()(const Vector& a, const Vector& b) const
+	{
+		return m_quantizer.equal(a, b);
+	}
+
+private:
+	TQuantizer<Vector> m_quantizer;
+};
+
+template <typename Vector>
+TQuantizer<Vector>::TQuantizer(const double cell)
+	: m_invCell(1.0 / cell)
+{
+}
+
+template <typename Vector>
+typename TQuantizer<Vector>::Key TQuantizer<Vector>::key(const Vector& vec) const
+{
+	// 超出 int64 范围的格坐标截断到边界，NaN 映射到最小值
+	constexpr double limit = 9.2e18;
+	const auto values = Traits::components(vec);
+	Key result;
+	for (size_t i(0); i < Traits::s_size; ++i)
+	{
+		const double q = std::floor(static_cast<double>(values[i]) * m_invCell);
+		if (q >= -limit && q <= limit)
+		{
+			result[i] = static_cast<int64_t>(q);
+		}
+		else
+		{
+			result[i] = q > 0.0 ? INT64_MAX : INT64_MIN;
+		}
+	}
+	return result;
+}
+
+template <typename Vector>
+size_t TQuantizer<Vector>::hash(const Vector& vec) const
+{
+	const Key k = key(vec);
+	uint64_t h(0);
+	for (size_t i(0); i < Traits::s_size; ++i)
+	{
+		h = hashMix(h ^ static_cast<uint64_t>(k[i]));
+	}
+	return static_cast<size_t>(h);
+}
+
+template <typename Vector>
+bool TQuantizer<Vector>::equal(const Vector& a, const Vector& b) const
+{
+	return key(a) == key(b);
+}
+
+END_NAMESPACE
+
+#endif
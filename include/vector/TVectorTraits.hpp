@@ -0,0 +1,71 @@
+#ifndef __TVECTOR_TRAITS_HPP__
+#define __TVECTOR_TRAITS_HPP__
+
+#include "MathMacro.h"
+#include "MathCore.h"
+#include "vector/TVector.hpp"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <array>
+#include <cstddef>
+
+BEGIN_NAMESPACE
+
+/*!
+ * 向量类型萃取：维数与分量数组
+ */
+template <typename Vector>
+struct TVectorTraits;
+
+template <validtype T, CheckPolicy P>
+struct TVectorTraits<TVector2<T, P>>
+{
+	using Scalar = T;
+	static constexpr size_t s_size = 2;
+
+	static std::array<T, 2> components(const TVector2<T, P>& vec)
+	{
+		return { vec.x(), vec.y() };
+	}
+};
+
+template <validtype T, CheckPolicy P>
+struct TVectorTraits<TVector3<T, P>>
+{
+	using Scalar = T;
+	static constexpr size_t s_size = 3;
+
+	static std::array<T, 3> components(const TVector3<T, P>& vec)
+	{
+		return { vec.x(), vec.y(), vec.z() };
+	}
+};
+
+template <validtype T, CheckPolicy P>
+struct TVectorTraits<TVector4<T, P>>
+{
+	using Scalar = T;
+	static constexpr size_t s_size = 4;
+
+	static std::array<T, 4> components(const TVector4<T, P>& vec)
+	{
+		return { vec.x(), vec.y(), vec.z(), vec.w() };
+	}
+};
+
+template <size_t N, validtype T, CheckPolicy P>
+struct TVectorTraits<TVector<N, T, P>>
+{
+	using Scalar = T;
+	static constexpr size_t s_size = N;
+
+	static std::array<T, N> components(const TVector<N, T, P>& vec)
+	{
+		return vec.components();
+	}
+};
+
+END_NAMESPACE
+
+#endif
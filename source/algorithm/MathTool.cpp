@@ -1,6 +1,27 @@
 #include "algorithm/MathTool.h"
 #include <numbers>
 
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+
+namespace
+{
+	// SSE2 没有 floor 指令：先截断，再对截断后变大的负数减 1；
+	// |v| >= 2^23 的浮点数已是整数（NaN 比较也为假），直接保留原值
+	inline __m128 floorSse2(const __m128 v)
+	{
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 limit = _mm_set1_ps(8388608.f);
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+		__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+		t = _mm_sub_ps(t, _mm_and_ps(_mm_cmplt_ps(v, t), one));
+		const __m128 small = _mm_cmplt_ps(_mm_and_ps(v, absMask), limit);
+		return _mm_or_ps(_mm_and_ps(small, t), _mm_andnot_ps(small, v));
+	}
+}
+#endif
+
 double math::MathTool::degreeToRadian(const double degree)
 {
 	return degree * std::numbers::pi / 180;
@@ -11,7 +32,37 @@ double math::MathTool::radianToDegree(const double radian)
 	return radian * 180 / std::numbers::pi;
 }
 
-float math::MathTool::fraction(float v)
+void math::MathTool::floor(const float* in, float* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(out + i, floorSse2(_mm_loadu_ps(in + i)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = std::floor(in[i]);
+	}
+}
+
+void math::MathTool::fraction(const float* in, float* out, const size_t count)
 {
-	return v - static_cast<int>(v);
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 belowOne = _mm_set1_ps(0x1.fffffep-1f);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 v = _mm_loadu_ps(in + i);
+		const __m128 f = _mm_sub_ps(v, floorSse2(v));
+		const __m128 rounded = _mm_cmpge_ps(f, one);
+		_mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(rounded, belowOne), _mm_andnot_ps(rounded, f)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = fraction(in[i]);
+	}
 }
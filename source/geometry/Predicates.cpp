@@ -0,0 +1,226 @@
+#include "geometry/Predicates.h"
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	// 浮点展开：若干互不重叠的分量之和，按绝对值递增存储，最后一个分量决定符号
+	using Expansion = std::vector<double>;
+
+	inline void twoSum(const double a, const double b, double& x, double& y)
+	{
+		x = a + b;
+		const double bv = x - a;
+		const double av = x - bv;
+		y = (a - av) + (b - bv);
+	}
+
+	inline void fastTwoSum(const double a, const double b, double& x, double& y)
+	{
+		x = a + b;
+		y = b - (x - a);
+	}
+
+	inline void twoProduct(const double a, const double b, double& x, double& y)
+	{
+		x = a * b;
+		y = std::fma(a, b, -x);
+	}
+
+	// a - b 的精确两项展开
+	Expansion difference(const double a, const double b)
+	{
+		double x, y;
+		twoSum(a, -b, x, y);
+		Expansion e;
+		if (0.0 != y)
+		{
+			e.push_back(y);
+		}
+		e.push_back(x);
+		return e;
+	}
+
+	// 归并后逐项 two-sum，消去零分量
+	Expansion sum(const Expansion& e, const Expansion& f)
+	{
+		Expansion g;
+		g.reserve(e.size() + f.size());
+		std::merge(e.begin(), e.end(), f.begin(), f.end(), std::back_inserter(g),
+			[](double a, double b) { return std::abs(a) < std::abs(b); });
+
+		Expansion h;
+		if (g.empty())
+		{
+			h.push_back(0.0);
+			return h;
+		}
+
+		double q = g[0];
+		for (size_t i(1); i < g.size(); ++i)
+		{
+			double qNew, hh;
+			twoSum(q, g[i], qNew, hh);
+			if (0.0 != hh)
+			{
+				h.push_back(hh);
+			}
+			q = qNew;
+		}
+
+		if (0.0 != q || h.empty())
+		{
+			h.push_back(q);
+		}
+		return h;
+	}
+
+	Expansion negate(Expansion e)
+	{
+		for (double& v : e)
+		{
+			v = -v;
+		}
+		return e;
+	}
+
+	Expansion scale(const Expansion& e, const double b)
+	{
+		Expansion h;
+		if (e.empty() || 0.0 == b)
+		{
+			h.push_back(0.0);
+			return h;
+		}
+
+		double q, hh;
+		twoProduct(e[0], b, q, hh);
+		if (0.0 != hh)
+		{
+			h.push_back(hh);
+		}
+
+		for (size_t i(1); i < e.size(); ++i)
+		{
+			double p1, p0, s;
+			twoProduct(e[i], b, p1, p0);
+			twoSum(q, p0, s, hh);
+			if (0.0 != hh)
+			{
+				h.push_back(hh);
+			}
+			fastTwoSum(p1, s, q, hh);
+			if (0.0 != hh)
+			{
+				h.push_back(hh);
+			}
+		}
+
+		if (0.0 != q || h.empty())
+		{
+			h.push_back(q);
+		}
+		return h;
+	}
+
+	Expansion product(const Expansion& e, const Expansion& f)
+	{
+		Expansion h(1, 0.0);
+		for (const double b : f)
+		{
+			h = sum(h, scale(e, b));
+		}
+		return h;
+	}
+
+	// e * f - g * h
+	Expansion crossTerm(const Expansion& e, const Expansion& f, const Expansion& g, const Expansion& h)
+	{
+		return sum(product(e, f), negate(product(g, h)));
+	}
+
+	Expansion squaredNorm(const Expansion& x, const Expansion& y)
+	{
+		return sum(product(x, x), product(y, y));
+	}
+
+	Expansion squaredNorm(const Expansion& x, const Expansion& y, const Expansion& z)
+	{
+		return sum(squaredNorm(x, y), product(z, z));
+	}
+
+	// 取最高位的非零分量：它与精确值同号、数量级相同；逐项浮点求和可能舍入为 0 甚至变号
+	double estimate(const Expansion& e)
+	{
+		for (size_t i(e.size()); i > 0; --i)
+		{
+			if (0.0 != e[i - 1])
+			{
+				return e[i - 1];
+			}
+		}
+		return 0.0;
+	}
+}
+
+double math::Predicates::orient2dExact(const double* pa, const double* pb, const double* pc)
+{
+	const Expansion acx = difference(pa[0], pc[0]), acy = difference(pa[1], pc[1]);
+	const Expansion bcx = difference(pb[0], pc[0]), bcy = difference(pb[1], pc[1]);
+	return estimate(crossTerm(acx, bcy, acy, bcx));
+}
+
+double math::Predicates::orient3dExact(const double* pa, const double* pb, const double* pc, const double* pd)
+{
+	const Expansion adx = difference(pa[0], pd[0]), ady = difference(pa[1], pd[1]), adz = difference(pa[2], pd[2]);
+	const Expansion bdx = difference(pb[0], pd[0]), bdy = difference(pb[1], pd[1]), bdz = difference(pb[2], pd[2]);
+	const Expansion cdx = difference(pc[0], pd[0]), cdy = difference(pc[1], pd[1]), cdz = difference(pc[2], pd[2]);
+
+	const Expansion bc = crossTerm(bdx, cdy, cdx, bdy);
+	const Expansion ca = crossTerm(cdx, ady, adx, cdy);
+	const Expansion ab = crossTerm(adx, bdy, bdx, ady);
+	return estimate(sum(sum(product(adz, bc), product(bdz, ca)), product(cdz, ab)));
+}
+
+double math::Predicates::incircleExact(const double* pa, const double* pb, const double* pc, const double* pd)
+{
+	const Expansion adx = difference(pa[0], pd[0]), ady = difference(pa[1], pd[1]);
+	const Expansion bdx = difference(pb[0], pd[0]), bdy = difference(pb[1], pd[1]);
+	const Expansion cdx = difference(pc[0], pd[0]), cdy = difference(pc[1], pd[1]);
+
+	const Expansion bc = crossTerm(bdx, cdy, cdx, bdy);
+	const Expansion ca = crossTerm(cdx, ady, adx, cdy);
+	const Expansion ab = crossTerm(adx, bdy, bdx, ady);
+	return estimate(sum(sum(product(squaredNorm(adx, ady), bc), product(squaredNorm(bdx, bdy), ca)),
+		product(squaredNorm(cdx, cdy), ab)));
+}
+
+double math::Predicates::insphereExact(const double* pa, const double* pb, const double* pc, const double* pd,
+	const double* pe)
+{
+	const Expansion aex = difference(pa[0], pe[0]), aey = difference(pa[1], pe[1]), aez = difference(pa[2], pe[2]);
+	const Expansion bex = difference(pb[0], pe[0]), bey = difference(pb[1], pe[1]), bez = difference(pb[2], pe[2]);
+	const Expansion cex = difference(pc[0], pe[0]), cey = difference(pc[1], pe[1]), cez = difference(pc[2], pe[2]);
+	const Expansion dex = difference(pd[0], pe[0]), dey = difference(pd[1], pe[1]), dez = difference(pd[2], pe[2]);
+
+	const Expansion ab = crossTerm(aex, bey, bex, aey);
+	const Expansion bc = crossTerm(bex, cey, cex, bey);
+	const Expansion cd = crossTerm(cex, dey, dex, cey);
+	const Expansion da = crossTerm(dex, aey, aex, dey);
+	const Expansion ac = crossTerm(aex, cey, cex, aey);
+	const Expansion bd = crossTerm(bex, dey, dex, bey);
+
+	const Expansion abc = sum(sum(product(aez, bc), negate(product(bez, ac))), product(cez, ab));
+	const Expansion bcd = sum(sum(product(bez, cd), negate(product(cez, bd))), product(dez, bc));
+	const Expansion cda = sum(sum(product(cez, da), product(dez, ac)), product(aez, cd));
+	const Expansion dab = sum(sum(product(dez, ab), product(aez, bd)), product(bez, da));
+
+	const Expansion alift = squaredNorm(aex, aey, aez);
+	const Expansion blift = squaredNorm(bex, bey, bez);
+	const Expansion clift = squaredNorm(cex, cey, cez);
+	const Expansion dlift = squaredNorm(dex, dey, dez);
+
+	const Expansion left = crossTerm(dlift, abc, clift, dab);
+	const Expansion right = crossTerm(blift, cda, alift, bcd);
+	return estimate(sum(left, right));
+}
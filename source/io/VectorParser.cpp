@@ -0,0 +1,520 @@
+#include "io/VectorParser.h"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace
+{
+	constexpr size_t s_chunkSize = size_t(1) << 20;
+	constexpr size_t s_blockSize = size_t(64) << 20;
+	constexpr size_t s_unlimited = std::numeric_limits<size_t>::max();
+
+	// 与 VectorParser::Format 的取值一一对应
+	enum class Kind
+	{
+		Obj,
+		Rows,
+		Ply
+	};
+
+	// 解析请求，由 VectorParser::Options 转换而来
+	struct Request
+	{
+		Kind kind;
+		size_t dimension;
+		math::ObjElement element;
+		size_t headerLines;
+		const std::vector<std::string>* properties;
+	};
+
+	enum class Status
+	{
+		Ok,
+		Error,
+		NeedMore
+	};
+
+	// 记录格式：哪些行是记录，每个字段写到哪个分量
+	struct Layout
+	{
+		std::string_view prefix;		// 记录行的前缀（OBJ），为空时每个非空、非注释行都是记录
+		size_t dimension = 0;
+		size_t required = 0;			// 至少需要的字段数
+		double defaults[4] = { 0.0, 0.0, 0.0, 0.0 };	// 字段不足 dimension 时补齐的缺省值
+		std::vector<int> slots;			// 第 i 个字段写入的分量，-1 表示忽略；为空表示按顺序写入
+		size_t skipLines = 0;			// 正文前跳过的行数（表头、PLY 中排在 vertex 之前的元素）
+		size_t maxRecords = s_unlimited;	// 剩余可读取的记录数
+		bool exact = false;				// 记录数必须恰好达到 maxRecords（PLY）
+	};
+
+	template <typename Scalar>
+	using Append = Scalar* (*)(void* target, const size_t components);
+
+	inline const char* lineEnd(const char* p, const char* end)
+	{
+		const void* newline = std::memchr(p, '\n', end - p);
+		return newline ? static_cast<const char*>(newline) : end;
+	}
+
+	inline bool isBlank(const char c)
+	{
+		return ' ' == c || '\t' == c || '\r' == c;
+	}
+
+	inline bool isSeparator(const char c)
+	{
+		return ' ' == c || '\t' == c || '\r' == c || ',' == c || ';' == c;
+	}
+
+	// 记录行返回第一个字段的位置，否则返回 nullptr
+	inline const char* recordFields(const char* p, const char* end, const Layout& layout)
+	{
+		while (p < end && isBlank(*p))
+		{
+			++p;
+		}
+		if (p == end || '#' == *p)
+		{
+			return nullptr;
+		}
+		if (layout.prefix.empty())
+		{
+			return p;
+		}
+
+		const size_t length = layout.prefix.size();
+		if (static_cast<size_t>(end - p) <= length || 0 != std::memcmp(p, layout.prefix.data(), length)
+			|| !isBlank(p[length]))
+		{
+			return nullptr;
+		}
+		return p + length;
+	}
+
+	template <typename Scalar>
+	bool parseRecord(const char* p, const char* end, const Layout& layout, Scalar* out)
+	{
+		const size_t fieldLimit = layout.slots.empty() ? layout.dimension : layout.slots.size();
+		size_t field(0);
+		while (field < fieldLimit)
+		{
+			while (p < end && isSeparator(*p))
+			{
+				++p;
+			}
+			if (p == end)
+			{
+				break;
+			}
+
+			// from_chars 不接受前导 '+'
+			if ('+' == *p)
+			{
+				++p;
+			}
+			Scalar value;
+			const std::from_chars_result result = std::from_chars(p, end, value);
+			if (std::errc() != result.ec || (result.ptr < end && !isSeparator(*result.ptr)))
+			{
+				return false;
+			}
+			p = result.ptr;
+
+			const int slot = layout.slots.empty() ? static_cast<int>(field) : layout.slots[field];
+			if (slot >= 0)
+			{
+				out[slot] = value;
+			}
+			++field;
+		}
+
+		if (field < layout.required)
+		{
+			return false;
+		}
+		for (size_t i(field); i < layout.dimension; ++i)
+		{
+			out[i] = static_cast<Scalar>(layout.defaults[i]);
+		}
+		return true;
+	}
+
+	// 跳过 layout.skipLines 行，返回剩余文本的起点；文本不足时返回 end（未结束的行不计入）
+	const char* skipLines(const char* p, const char* end, Layout& layout, const bool last)
+	{
+		while (layout.skipLines > 0 && p < end)
+		{
+			const char* eol = lineEnd(p, end);
+			if (eol == end && !last)
+			{
+				return p;
+			}
+			--layout.skipLines;
+			p = eol == end ? end : eol + 1;
+		}
+		return p;
+	}
+
+	/*!
+	 * 解析 [begin, end) 中的完整行：按行对齐分块，先并行计数再并行写入
+	 */
+	template <typename Scalar>
+	bool parseLines(const char* begin, const char* end, Layout& layout, Append<Scalar> append, void* target)
+	{
+		if (begin >= end || 0 == layout.maxRecords)
+		{
+			return true;
+		}
+
+		std::vector<const char*> bounds(1, begin);
+		while (bounds.back() < end)
+		{
+			const char* next = bounds.back() + std::min<size_t>(s_chunkSize, end - bounds.back());
+			if (next < end)
+			{
+				next = lineEnd(next, end);
+				next = next < end ? next + 1 : end;
+			}
+			bounds.push_back(next);
+		}
+
+		const size_t chunkCount = bounds.size() - 1;
+		std::vector<size_t> offsets(chunkCount + 1, 0);
+		math::ThreadPool& pool = math::ThreadPool::instance();
+		pool.parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last)
+		{
+			for (size_t c(first); c < last; ++c)
+			{
+				size_t count(0);
+				for (const char* p(bounds[c]); p < bounds[c + 1];)
+				{
+					const char* eol = lineEnd(p, bounds[c + 1]);
+					if (recordFields(p, eol, layout))
+					{
+						++count;
+					}
+					p = eol + 1;
+				}
+				offsets[c + 1] = count;
+			}
+		});
+
+		for (size_t c(0); c < chunkCount; ++c)
+		{
+			offsets[c + 1] += offsets[c];
+		}
+		const size_t total = std::min(offsets[chunkCount], layout.maxRecords);
+		if (0 == total)
+		{
+			return true;
+		}
+
+		Scalar* const out = append(target, total * layout.dimension);
+		std::atomic<bool> valid(true);
+		pool.parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last)
+		{
+			for (size_t c(first); c < last && valid.load(std::memory_order_relaxed); ++c)
+			{
+				size_t index = offsets[c];
+				for (const char* p(bounds[c]); p < bounds[c + 1] && index < total;)
+				{
+					const char* eol = lineEnd(p, bounds[c + 1]);
+					const char* fields = recordFields(p, eol, layout);
+					if (fields)
+					{
+						if (!parseRecord(fields, eol, layout, out + index * layout.dimension))
+						{
+							valid.store(false, std::memory_order_relaxed);
+							return;
+						}
+						++index;
+					}
+					p = eol + 1;
+				}
+			}
+		});
+
+		if (s_unlimited != layout.maxRecords)
+		{
+			layout.maxRecords -= total;
+		}
+		return valid.load();
+	}
+
+	/*!
+	 * 根据选项建立记录格式；PLY 需要完整的文件头，返回正文起点
+	 */
+	Status prepare(const char* text, const char* end, const bool last, const Request& request, Layout& layout,
+		const char*& body)
+	{
+		const size_t dimension = request.dimension;
+		const std::vector<std::string>* properties = request.properties;
+		layout.dimension = dimension;
+		body = text;
+		if (Kind::Obj == request.kind)
+		{
+			static constexpr std::string_view prefixes[] = { "v", "vn", "vt" };
+			static constexpr size_t required[] = { 3, 3, 1 };
+			const size_t element = static_cast<size_t>(request.element);
+			layout.prefix = prefixes[element];
+			layout.required = std::min(required[element], dimension);
+			if (math::ObjElement::Position == request.element && dimension > 3)
+			{
+				layout.defaults[3] = 1.0;
+			}
+			return dimension <= 4 ? Status::Ok : Status::Error;
+		}
+
+		if (Kind::Rows == request.kind)
+		{
+			layout.required = dimension;
+			layout.skipLines = request.headerLines;
+			return Status::Ok;
+		}
+
+		// ASCII PLY 文件头
+		if (!properties || properties->size() != dimension)
+		{
+			return Status::Error;
+		}
+
+		bool ascii(false), inVertex(false), foundVertex(false);
+		size_t preceding(0);
+		std::vector<std::string_view> names;
+		const char* p = text;
+		size_t lineIndex(0);
+		while (true)
+		{
+			const char* eol = lineEnd(p, end);
+			if (eol == end)
+			{
+				return last ? Status::Error : Status::NeedMore;
+			}
+
+			std::string_view line(p, eol - p);
+			while (!line.empty() && isBlank(line.back()))
+			{
+				line.remove_suffix(1);
+			}
+			p = eol + 1;
+
+			if (0 == lineIndex++)
+			{
+				if ("ply" != line)
+				{
+					return Status::Error;
+				}
+				continue;
+			}
+
+			// 按空白拆分前 3 个单词
+			std::string_view words[3];
+			size_t wordCount(0);
+			for (size_t i(0); i < line.size() && wordCount < 3;)
+			{
+				while (i < line.size() && isBlank(line[i]))
+				{
+					++i;
+				}
+				const size_t start = i;
+				while (i < line.size() && !isBlank(line[i]))
+				{
+					++i;
+				}
+				if (i > start)
+				{
+					words[wordCount++] = line.substr(start, i - start);
+				}
+			}
+
+			if ("end_header" == words[0])
+			{
+				break;
+			}
+			if ("format" == words[0])
+			{
+				ascii = "ascii" == words[1];
+			}
+			else if ("element" == words[0])
+			{
+				size_t count(0);
+				const std::from_chars_result result = std::from_chars(words[2].data(), words[2].data() + words[2].size(), count);
+				if (std::errc() != result.ec)
+				{
+					return Status::Error;
+				}
+				inVertex = "vertex" == words[1];
+				if (inVertex)
+				{
+					foundVertex = true;
+					layout.maxRecords = count;
+				}
+				else if (!foundVertex)
+				{
+					preceding += count;
+				}
+			}
+			else if ("property" == words[0] && inVertex)
+			{
+				if ("list" == words[1])
+				{
+					return Status::Error;
+				}
+				names.push_back(words[2]);
+			}
+		}
+
+		if (!ascii || !foundVertex)
+		{
+			return Status::Error;
+		}
+
+		// 属性名映射到分量，字段只需读到最后一个被选中的属性
+		for (size_t i(0); i < dimension; ++i)
+		{
+			const auto found = std::find(names.begin(), names.end(), std::string_view((*properties)[i]));
+			if (found == names.end())
+			{
+				return Status::Error;
+			}
+			const size_t column = found - names.begin();
+			if (layout.slots.size() <= column)
+			{
+				layout.slots.resize(column + 1, -1);
+			}
+			layout.slots[column] = static_cast<int>(i);
+		}
+		layout.required = layout.slots.size();
+		layout.skipLines = preceding;
+		layout.exact = true;
+		body = p;
+		return Status::Ok;
+	}
+
+	template <typename Scalar>
+	bool parseTextImpl(const char* text, const size_t size, const Request& request, Append<Scalar> append,
+		void* target)
+	{
+		Layout layout;
+		const char* end = text + size;
+		const char* body = text;
+		if (Status::Ok != prepare(text, end, true, request, layout, body))
+		{
+			return false;
+		}
+
+		body = skipLines(body, end, layout, true);
+		if (!parseLines(body, end, layout, append, target))
+		{
+			return false;
+		}
+		return !layout.exact || 0 == layout.maxRecords;
+	}
+
+	template <typename Scalar>
+	bool parseFileImpl(const std::string& path, const Request& request, Append<Scalar> append, void* target)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		// 每次读入一块，解析到最后一个换行为止，未结束的行留到下一块
+		std::vector<char> buffer;
+		size_t used(0);
+		bool prepared(false);
+		Layout layout;
+		while (true)
+		{
+			if (buffer.size() < used + s_blockSize)
+			{
+				buffer.resize(used + s_blockSize);
+			}
+			file.read(buffer.data() + used, s_blockSize);
+			const size_t read = static_cast<size_t>(file.gcount());
+			const bool last = read < s_blockSize;
+			used += read;
+
+			const char* text = buffer.data();
+			const char* end = text + used;
+			const char* body = text;
+			if (!prepared)
+			{
+				const Status status = prepare(text, end, last, request, layout, body);
+				if (Status::Error == status)
+				{
+					return false;
+				}
+				if (Status::NeedMore == status)
+				{
+					continue;
+				}
+				prepared = true;
+			}
+
+			body = skipLines(body, end, layout, last);
+			const char* cut = end;
+			if (!last)
+			{
+				cut = body;
+				for (const char* p(end); p > body; --p)
+				{
+					if ('\n' == p[-1])
+					{
+						cut = p;
+						break;
+					}
+				}
+			}
+
+			if (!parseLines(body, cut, layout, append, target))
+			{
+				return false;
+			}
+			if (last)
+			{
+				break;
+			}
+
+			used = end - cut;
+			std::memmove(buffer.data(), cut, used);
+		}
+		return !layout.exact || 0 == layout.maxRecords;
+	}
+}
+
+bool math::VectorParser::parseText(const char* text, const size_t size, const Options& options,
+	const Output<float>& out)
+{
+	const Request request{ static_cast<Kind>(options.format), options.dimension, options.element,
+		options.headerLines, options.properties };
+	return parseTextImpl(text, size, request, out.append, out.target);
+}
+
+bool math::VectorParser::parseText(const char* text, const size_t size, const Options& options,
+	const Output<double>& out)
+{
+	const Request request{ static_cast<Kind>(options.format), options.dimension, options.element,
+		options.headerLines, options.properties };
+	return parseTextImpl(text, size, request, out.append, out.target);
+}
+
+bool math::VectorParser::parseFile(const std::string& path, const Options& options, const Output<float>& out)
+{
+	const Request request{ static_cast<Kind>(options.format), options.dimension, options.element,
+		options.headerLines, options.properties };
+	return parseFileImpl(path, request, out.append, out.target);
+}
+
+bool math::VectorParser::parseFile(const std::string& path, const Options& options, const Output<double>& out)
+{
+	const Request request{ static_cast<Kind>(options.format), options.dimension, options.element,
+		options.headerLines, options.properties };
+	return parseFileImpl(path, request, out.append, out.target);
+}
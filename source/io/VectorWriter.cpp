@@ -0,0 +1,152 @@
+#include "io/VectorWriter.h"
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+	constexpr size_t s_grain = 8192;
+	constexpr size_t s_chunksPerThread = 4;
+
+	/*!
+	 * 按窗口并行格式化：窗口内各块写入暂存区中各自的最坏长度区间，完成后按块顺序交给 sink
+	 */
+	template <typename Scalar, typename Sink>
+	bool format(const Scalar* components, const size_t dimension, const size_t count, const std::string_view prefix,
+		const char separator, Sink sink)
+	{
+		if (0 == count)
+		{
+			return true;
+		}
+
+		math::ThreadPool& pool = math::ThreadPool::instance();
+		const size_t lineLength = prefix.size() + dimension * (math::VectorWriter::maxChars<Scalar>() + 1);
+		const size_t chunkBytes = s_grain * lineLength;
+		const size_t chunkCount = (count + s_grain - 1) / s_grain;
+		const size_t window = std::min(chunkCount, pool.threadCount() * s_chunksPerThread);
+
+		std::vector<char> scratch(window * chunkBytes);
+		std::vector<size_t> lengths(window);
+		for (size_t base(0); base < chunkCount; base += window)
+		{
+			const size_t chunks = std::min(window, chunkCount - base);
+			pool.parallelFor(0, chunks, 1, [&](const size_t first, const size_t last)
+			{
+				for (size_t c(first); c < last; ++c)
+				{
+					const size_t begin = (base + c) * s_grain;
+					const size_t end = std::min(count, begin + s_grain);
+					char* const start = scratch.data() + c * chunkBytes;
+					char* out = start;
+					for (size_t i(begin); i < end; ++i)
+					{
+						std::memcpy(out, prefix.data(), prefix.size());
+						out += prefix.size();
+						const Scalar* values = components + i * dimension;
+						for (size_t k(0); k < dimension; ++k)
+						{
+							if (k > 0)
+							{
+								*out++ = separator;
+							}
+							// 暂存区按最坏长度预留，to_chars 不会越界
+							out = std::to_chars(out, out + math::VectorWriter::maxChars<Scalar>(), values[k]).ptr;
+						}
+						*out++ = '\n';
+					}
+					lengths[c] = out - start;
+				}
+			});
+
+			for (size_t c(0); c < chunks; ++c)
+			{
+				if (!sink(scratch.data() + c * chunkBytes, lengths[c]))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	template <typename Scalar>
+	std::to_chars_result writeBuffer(char* first, char* last, const Scalar* components, const size_t dimension,
+		const size_t count, const std::string_view prefix, const char separator)
+	{
+		char* out = first;
+		const bool fits = format(components, dimension, count, prefix, separator,
+			[&out, last](const char* data, const size_t length)
+			{
+				if (static_cast<size_t>(last - out) < length)
+				{
+					return false;
+				}
+				std::memcpy(out, data, length);
+				out += length;
+				return true;
+			});
+		if (!fits)
+		{
+			return { last, std::errc::value_too_large };
+		}
+		return { out, std::errc() };
+	}
+
+	template <typename Scalar>
+	bool writeStream(const std::string& path, const Scalar* components, const size_t dimension, const size_t count,
+		const std::string_view prefix, const char separator)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+
+		const bool written = format(components, dimension, count, prefix, separator,
+			[&file](const char* data, const size_t length)
+			{
+				file.write(data, static_cast<std::streamsize>(length));
+				return static_cast<bool>(file);
+			});
+		file.flush();
+		return written && static_cast<bool>(file);
+	}
+}
+
+std::to_chars_result math::VectorWriter::write(char* first, char* last, const int* components,
+	const size_t dimension, const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeBuffer(first, last, components, dimension, count, prefix, separator);
+}
+
+std::to_chars_result math::VectorWriter::write(char* first, char* last, const float* components,
+	const size_t dimension, const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeBuffer(first, last, components, dimension, count, prefix, separator);
+}
+
+std::to_chars_result math::VectorWriter::write(char* first, char* last, const double* components,
+	const size_t dimension, const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeBuffer(first, last, components, dimension, count, prefix, separator);
+}
+
+bool math::VectorWriter::writeFile(const std::string& path, const int* components, const size_t dimension,
+	const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeStream(path, components, dimension, count, prefix, separator);
+}
+
+bool math::VectorWriter::writeFile(const std::string& path, const float* components, const size_t dimension,
+	const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeStream(path, components, dimension, count, prefix, separator);
+}
+
+bool math::VectorWriter::writeFile(const std::string& path, const double* components, const size_t dimension,
+	const size_t count, const std::string_view prefix, const char separator)
+{
+	return writeStream(path, components, dimension, count, prefix, separator);
+}
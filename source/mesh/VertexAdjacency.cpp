@@ -0,0 +1,39 @@
+#include "mesh/VertexAdjacency.h"
+
+void math::VertexAdjacency::build(const uint32_t* indices, const size_t faceCount, const size_t vertexCount)
+{
+	m_offsets.assign(vertexCount + 1, 0);
+	m_corners.resize(faceCount * 3);
+
+	for (size_t i(0); i < faceCount * 3; ++i)
+	{
+		++m_offsets[indices[i] + 1];
+	}
+
+	for (size_t v(0); v < vertexCount; ++v)
+	{
+		m_offsets[v + 1] += m_offsets[v];
+	}
+
+	// 按角点顺序填充，保证同一顶点的角点按面索引递增，累加顺序与线程数无关
+	std::vector<uint32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+	for (size_t i(0); i < faceCount * 3; ++i)
+	{
+		m_corners[cursor[indices[i]]++] = static_cast<uint32_t>(i);
+	}
+}
+
+size_t math::VertexAdjacency::vertexCount() const
+{
+	return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+const std::vector<uint32_t>& math::VertexAdjacency::offsets() const
+{
+	return m_offsets;
+}
+
+const std::vector<uint32_t>& math::VertexAdjacency::corners() const
+{
+	return m_corners;
+}
@@ -0,0 +1,334 @@
+#include "parallel/BlockedExecutor.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+#ifdef __linux__
+	std::string readLine(const std::string& path)
+	{
+		std::ifstream file(path);
+		std::string line;
+		std::getline(file, line);
+		return line;
+	}
+
+	// 解析 sysfs 的列表格式，例如 "0-3,8-11"
+	std::vector<int> parseList(const std::string& text)
+	{
+		std::vector<int> values;
+		size_t position(0);
+		while (position < text.size())
+		{
+			const size_t comma = std::min(text.find(',', position), text.size());
+			const std::string item = text.substr(position, comma - position);
+			const size_t dash = item.find('-');
+			if (!item.empty() && item.find_first_not_of("0123456789-") == std::string::npos)
+			{
+				const int first = std::stoi(item.substr(0, dash));
+				const int last = std::string::npos == dash ? first : std::stoi(item.substr(dash + 1));
+				for (int value(first); value <= last; ++value)
+				{
+					values.push_back(value);
+				}
+			}
+			position = comma + 1;
+		}
+		return values;
+	}
+
+	std::vector<int> onlineNodes()
+	{
+		return parseList(readLine("/sys/devices/system/node/online"));
+	}
+
+	// 进程允许的 CPU，按 NUMA 节点轮流排列，使任意个数的线程都均匀分布到各节点
+	std::vector<int> cpuOrder()
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (0 != sched_getaffinity(0, sizeof(set), &set))
+		{
+			return {};
+		}
+
+		std::vector<std::vector<int>> perNode;
+		std::vector<bool> assigned(CPU_SETSIZE, false);
+		for (const int node : onlineNodes())
+		{
+			std::vector<int> cpus;
+			for (const int cpu : parseList(readLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")))
+			{
+				if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &set) && !assigned[cpu])
+				{
+					cpus.push_back(cpu);
+					assigned[cpu] = true;
+				}
+			}
+			if (!cpus.empty())
+			{
+				perNode.push_back(cpus);
+			}
+		}
+
+		size_t widest(0);
+		for (const std::vector<int>& cpus : perNode)
+		{
+			widest = std::max(widest, cpus.size());
+		}
+
+		std::vector<int> order;
+		for (size_t i(0); i < widest; ++i)
+		{
+			for (const std::vector<int>& cpus : perNode)
+			{
+				if (i < cpus.size())
+				{
+					order.push_back(cpus[i]);
+				}
+			}
+		}
+
+		// 读不到 sysfs 时按编号顺序使用全部允许的 CPU
+		for (int cpu(0); cpu < CPU_SETSIZE; ++cpu)
+		{
+			if (CPU_ISSET(cpu, &set) && !assigned[cpu])
+			{
+				order.push_back(cpu);
+			}
+		}
+		return order;
+	}
+
+	bool pinCurrentThread(const int cpu)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		return 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+#endif
+}
+
+math::BlockedExecutor::BlockedExecutor(const size_t threadCount, const size_t blockBytes, const bool pinThreads)
+	: m_blockBytes(std::max<size_t>(1, blockBytes)), m_pinnedCount(0), m_job(nullptr), m_generation(0), m_pending(0),
+	m_stop(false)
+{
+	size_t count = threadCount;
+	if (0 == count)
+	{
+		count = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	std::vector<int> cpus;
+#ifdef __linux__
+	if (pinThreads)
+	{
+		cpus = cpuOrder();
+	}
+#else
+	static_cast<void>(pinThreads);
+#endif
+
+	for (size_t i(0); i < count; ++i)
+	{
+		const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+		m_workers.emplace_back(&BlockedExecutor::workerLoop, this, i, cpu);
+	}
+
+	// 空任务作为屏障，确保返回前各线程已完成绑定
+	run([](size_t) {});
+}
+
+math::BlockedExecutor::~BlockedExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+size_t math::BlockedExecutor::threadCount() const
+{
+	return m_workers.size();
+}
+
+size_t math::BlockedExecutor::blockBytes() const
+{
+	return m_blockBytes;
+}
+
+bool math::BlockedExecutor::pinned() const
+{
+	return m_pinnedCount.load() == m_workers.size();
+}
+
+size_t math::BlockedExecutor::nodeCount()
+{
+#ifdef __linux__
+	return std::max<size_t>(1, onlineNodes().size());
+#else
+	return 1;
+#endif
+}
+
+size_t math::BlockedExecutor::blockElements(const size_t elementSize) const
+{
+	const size_t size = std::max<size_t>(1, elementSize);
+	const size_t granule = s_pageSize / std::gcd(size, s_pageSize);
+	const size_t elements = std::max<size_t>(1, m_blockBytes / size);
+	return (elements + granule - 1) / granule * granule;
+}
+
+void math::BlockedExecutor::blockRange(const size_t thread, const size_t blockCount, size_t& first, size_t& last) const
+{
+	const size_t threads = m_workers.size();
+	first = blockCount * thread / threads;
+	last = blockCount * (thread + 1) / threads;
+}
+
+void math::BlockedExecutor::run(const std::function<void(size_t)>& func)
+{
+	std::lock_guard<std::mutex> runLock(m_runMutex);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_job = &func;
+	m_pending = m_workers.size();
+	++m_generation;
+	m_condition.notify_all();
+	m_finished.wait(lock, [this]() { return 0 == m_pending; });
+	m_job = nullptr;
+
+	if (m_error)
+	{
+		std::rethrow_exception(std::exchange(m_error, nullptr));
+	}
+}
+
+void math::BlockedExecutor::prefetchCopy(void* dst, const void* src, const size_t bytes, const void* next)
+{
+	uint8_t* out = static_cast<uint8_t*>(dst);
+	const uint8_t* in = static_cast<const uint8_t*>(src);
+	const char* ahead = static_cast<const char*>(next);
+	for (size_t offset(0); offset < bytes; offset += s_pageSize)
+	{
+		const size_t size = std::min(s_pageSize, bytes - offset);
+#ifdef MATH_SIMD_SSE2
+		// 预取不会触发访存异常，最后一块之后越界的地址也无妨
+		if (nullptr != ahead)
+		{
+			for (size_t line(0); line < size; line += s_cacheLineSize)
+			{
+				_mm_prefetch(ahead + offset + line, _MM_HINT_T0);
+			}
+		}
+#else
+		static_cast<void>(ahead);
+#endif
+		std::memcpy(out + offset, in + offset, size);
+	}
+}
+
+void math::BlockedExecutor::streamCopy(void* dst, const void* src, const size_t bytes)
+{
+	uint8_t* out = static_cast<uint8_t*>(dst);
+	const uint8_t* in = static_cast<const uint8_t*>(src);
+	size_t offset(0);
+#ifdef MATH_SIMD_SSE2
+	// 非临时存储要求目标 16 字节对齐，对齐前的部分与末尾不足 16 字节的部分走普通存储
+	offset = std::min(bytes, (16 - (reinterpret_cast<uintptr_t>(out) & 15)) & 15);
+	std::memcpy(out, in, offset);
+	for (; offset + 64 <= bytes; offset += 64)
+	{
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 16));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 32));
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 48));
+		_mm_stream_si128(reinterpret_cast<__m128i*>(out + offset), a);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(out + offset + 16), b);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(out + offset + 32), c);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(out + offset + 48), d);
+	}
+	for (; offset + 16 <= bytes; offset += 16)
+	{
+		_mm_stream_si128(reinterpret_cast<__m128i*>(out + offset),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset)));
+	}
+#endif
+	std::memcpy(out + offset, in + offset, bytes - offset);
+}
+
+void math::BlockedExecutor::streamFence()
+{
+#ifdef MATH_SIMD_SSE2
+	_mm_sfence();
+#endif
+}
+
+void math::BlockedExecutor::workerLoop(const size_t index, const int cpu)
+{
+#ifdef __linux__
+	if (cpu >= 0 && pinCurrentThread(cpu))
+	{
+		m_pinnedCount.fetch_add(1);
+	}
+#else
+	static_cast<void>(cpu);
+#endif
+
+	size_t seen(0);
+	while (true)
+	{
+		const std::function<void(size_t)>* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this, seen]() { return m_stop || m_generation != seen; });
+			if (m_stop)
+			{
+				return;
+			}
+			seen = m_generation;
+			job = m_job;
+		}
+
+		// 异常留给 run 在调用线程重新抛出；无论成败都要计数，否则 run 永远等不到完成
+		std::exception_ptr error;
+		try
+		{
+			(*job)(index);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (error && !m_error)
+		{
+			m_error = error;
+		}
+		if (0 == --m_pending)
+		{
+			m_finished.notify_one();
+		}
+	}
+}
@@ -0,0 +1,269 @@
+#include "parallel/TaskGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+	struct WorkItem
+	{
+		size_t node;
+		size_t chunk;
+	};
+
+	// 单次 run 的执行状态，由参与线程共享持有，run 返回后迟到的线程也不会访问失效内存
+	struct RunState
+	{
+		std::vector<std::unique_ptr<std::atomic<size_t>[]>> pending;
+		std::unique_ptr<std::atomic<size_t>[]> finishedChunks;
+		std::atomic<size_t> completed{ 0 };
+		size_t total = 0;
+		// 第一个抛出的异常；此后尚未开始的块不再执行，只计为完成，图照常排空
+		std::atomic<bool> failed{ false };
+		std::exception_ptr error;
+		std::deque<WorkItem> ready;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+}
+
+math::TaskGraph::TaskId math::TaskGraph::addTask(std::function<void()> task)
+{
+	return addParallelTask(0, 1, 1, [task = std::move(task)](size_t, size_t) { task(); });
+}
+
+math::TaskGraph::TaskId math::TaskGraph::addParallelTask(const size_t begin, const size_t end, const size_t grain,
+	std::function<void(size_t, size_t)> func)
+{
+	Node node;
+	node.func = std::move(func);
+	node.begin = begin;
+	node.end = std::max(begin, end);
+	node.grain = std::max<size_t>(1, grain);
+	// 空区间按一个空块调度：不调用 func，但照常完成并释放后继
+	node.chunkCount = std::max<size_t>(1, (node.end - node.begin + node.grain - 1) / node.grain);
+	m_nodes.push_back(std::move(node));
+	return m_nodes.size() - 1;
+}
+
+bool math::TaskGraph::addDependency(const TaskId before, const TaskId after)
+{
+	if (before >= m_nodes.size() || after >= m_nodes.size() || before == after)
+	{
+		return false;
+	}
+	m_nodes[before].successors.push_back(after);
+	++m_nodes[after].predecessorCount;
+	return true;
+}
+
+bool math::TaskGraph::addChunkDependency(const TaskId before, const TaskId after)
+{
+	if (before >= m_nodes.size() || after >= m_nodes.size() || before == after
+		|| m_nodes[before].chunkCount != m_nodes[after].chunkCount)
+	{
+		return false;
+	}
+	m_nodes[before].chunkSuccessors.push_back(after);
+	++m_nodes[after].predecessorCount;
+	return true;
+}
+
+size_t math::TaskGraph::taskCount() const
+{
+	return m_nodes.size();
+}
+
+void math::TaskGraph::clear()
+{
+	m_nodes.clear();
+}
+
+bool math::TaskGraph::acyclic() const
+{
+	std::vector<size_t> inDegree(m_nodes.size());
+	for (size_t i(0); i < m_nodes.size(); ++i)
+	{
+		inDegree[i] = m_nodes[i].predecessorCount;
+	}
+
+	std::vector<size_t> stack;
+	for (size_t i(0); i < m_nodes.size(); ++i)
+	{
+		if (0 == inDegree[i])
+		{
+			stack.push_back(i);
+		}
+	}
+
+	size_t visited(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		++visited;
+		for (const std::vector<TaskId>* list : { &node.successors, &node.chunkSuccessors })
+		{
+			for (const TaskId next : *list)
+			{
+				if (0 == --inDegree[next])
+				{
+					stack.push_back(next);
+				}
+			}
+		}
+	}
+	return visited == m_nodes.size();
+}
+
+bool math::TaskGraph::run(ThreadPool& pool)
+{
+	if (!acyclic())
+	{
+		return false;
+	}
+
+	std::shared_ptr<RunState> state = std::make_shared<RunState>();
+	state->pending.resize(m_nodes.size());
+	state->finishedChunks = std::make_unique<std::atomic<size_t>[]>(m_nodes.size());
+	for (size_t i(0); i < m_nodes.size(); ++i)
+	{
+		const Node& node = m_nodes[i];
+		state->pending[i] = std::make_unique<std::atomic<size_t>[]>(node.chunkCount);
+		for (size_t c(0); c < node.chunkCount; ++c)
+		{
+			state->pending[i][c].store(node.predecessorCount, std::memory_order_relaxed);
+		}
+		state->finishedChunks[i].store(0, std::memory_order_relaxed);
+		state->total += node.chunkCount;
+		if (0 == node.predecessorCount)
+		{
+			for (size_t c(0); c < node.chunkCount; ++c)
+			{
+				state->ready.push_back({ i, c });
+			}
+		}
+	}
+
+	if (0 == state->total)
+	{
+		return true;
+	}
+
+	// 任务块完成：逐块后继中第一个就绪的由当前线程接着执行，其余就绪块放入队列
+	const std::vector<Node>& nodes = m_nodes;
+	auto complete = [&nodes](RunState& s, const WorkItem item, WorkItem& next) -> bool
+	{
+		const Node& node = nodes[item.node];
+		bool hasNext(false);
+		std::vector<WorkItem> released;
+
+		for (const TaskId successor : node.chunkSuccessors)
+		{
+			if (1 == s.pending[successor][item.chunk].fetch_sub(1, std::memory_order_acq_rel))
+			{
+				if (hasNext)
+				{
+					released.push_back({ successor, item.chunk });
+				}
+				else
+				{
+					next = { successor, item.chunk };
+					hasNext = true;
+				}
+			}
+		}
+
+		if (node.chunkCount == s.finishedChunks[item.node].fetch_add(1, std::memory_order_acq_rel) + 1)
+		{
+			for (const TaskId successor : node.successors)
+			{
+				for (size_t c(0); c < nodes[successor].chunkCount; ++c)
+				{
+					if (1 == s.pending[successor][c].fetch_sub(1, std::memory_order_acq_rel))
+					{
+						released.push_back({ successor, c });
+					}
+				}
+			}
+		}
+
+		const bool finished = s.total == s.completed.fetch_add(1, std::memory_order_acq_rel) + 1;
+		if (!released.empty() || finished)
+		{
+			{
+				std::lock_guard<std::mutex> lock(s.mutex);
+				s.ready.insert(s.ready.end(), released.begin(), released.end());
+			}
+			s.condition.notify_all();
+		}
+		return hasNext;
+	};
+
+	auto worker = [state, &nodes, complete]()
+	{
+		RunState& s = *state;
+		while (true)
+		{
+			WorkItem item;
+			{
+				std::unique_lock<std::mutex> lock(s.mutex);
+				s.condition.wait(lock, [&s]()
+				{
+					return !s.ready.empty() || s.completed.load(std::memory_order_acquire) == s.total;
+				});
+				if (s.ready.empty())
+				{
+					return;
+				}
+				item = s.ready.front();
+				s.ready.pop_front();
+			}
+
+			// 沿逐块依赖链连续执行，同一块的数据在各阶段之间保持在缓存中
+			while (true)
+			{
+				const Node& node = nodes[item.node];
+				const size_t first = node.begin + item.chunk * node.grain;
+				if (first < node.end && !s.failed.load(std::memory_order_acquire))
+				{
+					try
+					{
+						node.func(first, std::min(node.end, first + node.grain));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(s.mutex);
+						if (!s.error)
+						{
+							s.error = std::current_exception();
+						}
+						s.failed.store(true, std::memory_order_release);
+					}
+				}
+				if (!complete(s, item, item))
+				{
+					break;
+				}
+			}
+		}
+	};
+
+	const size_t helpers = std::min(pool.threadCount() - 1, state->total - 1);
+	for (size_t i(0); i < helpers; ++i)
+	{
+		pool.submit(worker);
+	}
+	worker();
+
+	// 调用线程退出时所有块均已完成，此后辅助线程只会访问 state
+	if (state->error)
+	{
+		std::rethrow_exception(state->error);
+	}
+	return true;
+}
@@ -0,0 +1,137 @@
+#include "parallel/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+	struct ParallelForState
+	{
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> done{ 0 };
+		size_t chunkCount = 0;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+}
+
+math::ThreadPool::ThreadPool(const size_t threadCount)
+	: m_stop(false)
+{
+	size_t count = threadCount;
+	if (0 == count)
+	{
+		count = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	// 调用线程也参与 parallelFor，因此少创建一个工作线程
+	for (size_t i(1); i < count; ++i)
+	{
+		m_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+math::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+math::ThreadPool& math::ThreadPool::instance()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+size_t math::ThreadPool::threadCount() const
+{
+	return m_workers.size() + 1;
+}
+
+void math::ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.push_back(std::move(task));
+	}
+	m_condition.notify_one();
+}
+
+void math::ThreadPool::parallelFor(const size_t begin, const size_t end, const size_t grain,
+	const std::function<void(size_t, size_t)>& func)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+
+	const size_t chunk = std::max<size_t>(1, grain);
+	const size_t chunkCount = (end - begin + chunk - 1) / chunk;
+	if (1 == chunkCount || m_workers.empty())
+	{
+		// 没有工作线程时也按同样的分块顺序执行，保证调用方看到的分块与线程数无关
+		for (size_t first(begin); first < end; first += chunk)
+		{
+			func(first, std::min(end, first + chunk));
+		}
+		return;
+	}
+
+	std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+	state->chunkCount = chunkCount;
+
+	// 块通过原子计数领取，先到先得；每个被领取的块都由领取者执行完毕
+	auto run = [state, begin, end, chunk, &func]()
+	{
+		size_t index = state->next.fetch_add(1);
+		while (index < state->chunkCount)
+		{
+			const size_t first = begin + index * chunk;
+			func(first, std::min(end, first + chunk));
+
+			if (state->done.fetch_add(1) + 1 == state->chunkCount)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->finished.notify_all();
+			}
+			index = state->next.fetch_add(1);
+		}
+	};
+
+	const size_t helpers = std::min(m_workers.size(), chunkCount - 1);
+	for (size_t i(0); i < helpers; ++i)
+	{
+		submit(run);
+	}
+	run();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state]() { return state->done.load() == state->chunkCount; });
+}
+
+void math::ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+			if (m_stop && m_tasks.empty())
+			{
+				return;
+			}
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,132 @@
+#include "random/Random.h"
+#include "parallel/ThreadPool.h"
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr size_t s_grain = 1 << 16;
+
+#ifdef MATH_SIMD_SSE2
+	constexpr size_t s_batch = 4;
+
+	/*!
+	 * 4 路 32x32 -> 64 位无符号乘法，拆成低 32 位与高 32 位
+	 * _mm_mul_epu32 只乘第 0、2 路，第 1、3 路右移后再乘一次
+	 */
+	inline void mulHiLo(const __m128i a, const __m128i m, __m128i& hi, __m128i& lo)
+	{
+		const __m128i even = _mm_mul_epu32(a, m);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+		const __m128i low32 = _mm_set_epi32(0, -1, 0, -1);
+		lo = _mm_or_si128(_mm_and_si128(even, low32), _mm_slli_epi64(odd, 32));
+		hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low32, odd));
+	}
+
+	/*!
+	 * 计数器 counter .. counter + 3 的 Philox4x32-10，每路一个计数器，结果与 Random::philox 逐位相同
+	 * out[4 * i + k] 为第 i 个计数器的第 k 个输出
+	 */
+	void philox4(const uint64_t seed, const uint64_t counter, uint32_t out[4 * s_batch])
+	{
+		uint32_t lo[s_batch], hi[s_batch];
+		for (size_t i(0); i < s_batch; ++i)
+		{
+			lo[i] = static_cast<uint32_t>(counter + i);
+			hi[i] = static_cast<uint32_t>((counter + i) >> 32);
+		}
+
+		__m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+		__m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+		__m128i c2 = _mm_setzero_si128();
+		__m128i c3 = _mm_setzero_si128();
+		uint32_t k0 = static_cast<uint32_t>(seed);
+		uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+		const __m128i m0 = _mm_set1_epi32(static_cast<int>(0xD2511F53u));
+		const __m128i m1 = _mm_set1_epi32(static_cast<int>(0xCD9E8D57u));
+
+		for (int round(0); round < 10; ++round)
+		{
+			__m128i hi0, lo0, hi1, lo1;
+			mulHiLo(c0, m0, hi0, lo0);
+			mulHiLo(c2, m1, hi1, lo1);
+			c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+			c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+			c1 = lo1;
+			c3 = lo0;
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+
+		// 转置：每个计数器的 4 个输出连续存放
+		const __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+		const __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+		const __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+		const __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+		__m128i* dst = reinterpret_cast<__m128i*>(out);
+		_mm_storeu_si128(dst, _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128(dst + 2, _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128(dst + 3, _mm_unpackhi_epi64(t2, t3));
+	}
+#endif
+
+	// 元素 j 取计数器 j / lanes 的第 j % lanes 路输出
+	template <typename T, size_t lanes, typename Convert>
+	void fillRange(const uint64_t seed, const uint64_t offset, T* out, const size_t begin, const size_t end,
+		Convert convert)
+	{
+		size_t j(begin);
+		while (j < end)
+		{
+			const uint64_t index = offset + j;
+#ifdef MATH_SIMD_SSE2
+			// 对齐到计数器边界后，每次 4 个计数器一起计算
+			if (0 == index % lanes && end - j >= s_batch * lanes)
+			{
+				uint32_t r[4 * s_batch];
+				philox4(seed, index / lanes, r);
+				for (size_t i(0); i < s_batch; ++i)
+				{
+					for (size_t lane(0); lane < lanes; ++lane, ++j)
+					{
+						out[j] = convert(r + 4 * i, lane);
+					}
+				}
+				continue;
+			}
+#endif
+			uint32_t r[4];
+			math::Random::philox(seed, index / lanes, r);
+
+			for (size_t lane(index % lanes); lane < lanes && j < end; ++lane, ++j)
+			{
+				out[j] = convert(r, lane);
+			}
+		}
+	}
+}
+
+void math::Random::fillUniform(const uint64_t seed, const uint64_t offset, float* out, const size_t count)
+{
+	ThreadPool::instance().parallelFor(0, count, s_grain, [=](size_t begin, size_t end)
+	{
+		fillRange<float, 4>(seed, offset, out, begin, end, [](const uint32_t* r, size_t lane)
+		{
+			return toFloat(r[lane]);
+		});
+	});
+}
+
+void math::Random::fillUniform(const uint64_t seed, const uint64_t offset, double* out, const size_t count)
+{
+	ThreadPool::instance().parallelFor(0, count, s_grain, [=](size_t begin, size_t end)
+	{
+		fillRange<double, 2>(seed, offset, out, begin, end, [](const uint32_t* r, size_t lane)
+		{
+			return toDouble(r[2 * lane], r[2 * lane + 1]);
+		});
+	});
+}
@@ -0,0 +1,208 @@
+#include "render/ColorTool.h"
+#include <cmath>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// 编码表按线性值均匀采样，14 位精度可保证暗部斜率最大处误差不超过 1
+	constexpr int s_encodeBits = 14;
+	constexpr int s_encodeSize = 1 << s_encodeBits;
+	constexpr float s_encodeScale = static_cast<float>(s_encodeSize - 1);
+
+	struct SrgbTables
+	{
+		uint8_t encode[s_encodeSize];
+		float decode[256];
+
+		SrgbTables()
+		{
+			for (int i(0); i < s_encodeSize; ++i)
+			{
+				const double v = static_cast<double>(i) / (s_encodeSize - 1);
+				const double s = v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+				encode[i] = static_cast<uint8_t>(s * 255.0 + 0.5);
+			}
+
+			for (int i(0); i < 256; ++i)
+			{
+				const double s = i / 255.0;
+				const double v = s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4);
+				decode[i] = static_cast<float>(v);
+			}
+		}
+	};
+
+	const SrgbTables& tables()
+	{
+		static const SrgbTables s_tables;
+		return s_tables;
+	}
+
+	inline float saturate(const float v)
+	{
+		// 比较写法同时把 NaN 变为 0
+		return v > 0.f ? (v < 1.f ? v : 1.f) : 0.f;
+	}
+
+	inline uint8_t quantize(const float v)
+	{
+		return static_cast<uint8_t>(saturate(v) * 255.f + 0.5f);
+	}
+
+	inline uint8_t encodeSrgb(const SrgbTables& lut, const float v)
+	{
+		return lut.encode[static_cast<int>(saturate(v) * s_encodeScale + 0.5f)];
+	}
+}
+
+uint8_t math::ColorTool::linearToSrgb8(const float v)
+{
+	return encodeSrgb(tables(), v);
+}
+
+float math::ColorTool::srgb8ToLinear(const uint8_t v)
+{
+	return tables().decode[v];
+}
+
+void math::ColorTool::packColors(const float* rgba, const size_t count, uint8_t* pixels,
+	const PixelFormat format, const ColorSpace space)
+{
+	const bool bgra = (PixelFormat::BGRA8 == format);
+	const int r = bgra ? 2 : 0;
+	const int b = bgra ? 0 : 2;
+	size_t i(0);
+
+	if (ColorSpace::Linear == space)
+	{
+#ifdef MATH_SIMD_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 scale = _mm_set1_ps(255.f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i q[4];
+			for (int k(0); k < 4; ++k)
+			{
+				__m128 v = _mm_loadu_ps(rgba + 4 * (i + k));
+				if (bgra)
+				{
+					v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2));
+				}
+				v = _mm_min_ps(_mm_max_ps(v, zero), one);
+				// 与标量路径相同的 +0.5 截断（四舍五入），不用 _mm_cvtps_epi32 的银行家舍入
+				q[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+			}
+
+			const __m128i lo = _mm_packs_epi32(q[0], q[1]);
+			const __m128i hi = _mm_packs_epi32(q[2], q[3]);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 4 * i), _mm_packus_epi16(lo, hi));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			const float* src = rgba + 4 * i;
+			uint8_t* dst = pixels + 4 * i;
+			dst[r] = quantize(src[0]);
+			dst[1] = quantize(src[1]);
+			dst[b] = quantize(src[2]);
+			dst[3] = quantize(src[3]);
+		}
+		return;
+	}
+
+	const SrgbTables& lut = tables();
+#ifdef MATH_SIMD_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 scale = _mm_set_ps(255.f, s_encodeScale, s_encodeScale, s_encodeScale);
+	const __m128 half = _mm_set1_ps(0.5f);
+	alignas(16) int32_t index[4];
+	for (; i < count; ++i)
+	{
+		// 截断与定点化走 SIMD，RGB 查表，alpha 直接量化
+		const __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba + 4 * i), zero), one);
+		_mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half)));
+
+		uint8_t* dst = pixels + 4 * i;
+		dst[r] = lut.encode[index[0]];
+		dst[1] = lut.encode[index[1]];
+		dst[b] = lut.encode[index[2]];
+		dst[3] = static_cast<uint8_t>(index[3]);
+	}
+#else
+	for (; i < count; ++i)
+	{
+		const float* src = rgba + 4 * i;
+		uint8_t* dst = pixels + 4 * i;
+		dst[r] = encodeSrgb(lut, src[0]);
+		dst[1] = encodeSrgb(lut, src[1]);
+		dst[b] = encodeSrgb(lut, src[2]);
+		dst[3] = quantize(src[3]);
+	}
+#endif
+}
+
+void math::ColorTool::unpackColors(const uint8_t* pixels, const size_t count, float* rgba,
+	const PixelFormat format, const ColorSpace space)
+{
+	const bool bgra = (PixelFormat::BGRA8 == format);
+	const int r = bgra ? 2 : 0;
+	const int b = bgra ? 0 : 2;
+	size_t i(0);
+
+	if (ColorSpace::Linear == space)
+	{
+#ifdef MATH_SIMD_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 scale = _mm_set1_ps(1.f / 255.f);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 4 * i));
+			const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+			const __m128i q[4] = {
+				_mm_unpacklo_epi16(lo, zero),
+				_mm_unpackhi_epi16(lo, zero),
+				_mm_unpacklo_epi16(hi, zero),
+				_mm_unpackhi_epi16(hi, zero)
+			};
+
+			for (int k(0); k < 4; ++k)
+			{
+				__m128 v = _mm_mul_ps(_mm_cvtepi32_ps(q[k]), scale);
+				if (bgra)
+				{
+					v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2));
+				}
+				_mm_storeu_ps(rgba + 4 * (i + k), v);
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			const uint8_t* src = pixels + 4 * i;
+			float* dst = rgba + 4 * i;
+			dst[0] = src[r] * (1.f / 255.f);
+			dst[1] = src[1] * (1.f / 255.f);
+			dst[2] = src[b] * (1.f / 255.f);
+			dst[3] = src[3] * (1.f / 255.f);
+		}
+		return;
+	}
+
+	const SrgbTables& lut = tables();
+	for (; i < count; ++i)
+	{
+		const uint8_t* src = pixels + 4 * i;
+		float* dst = rgba + 4 * i;
+		dst[0] = lut.decode[src[r]];
+		dst[1] = lut.decode[src[1]];
+		dst[2] = lut.decode[src[b]];
+		dst[3] = src[3] * (1.f / 255.f);
+	}
+}
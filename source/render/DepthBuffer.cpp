@@ -0,0 +1,458 @@
+#include "render/DepthBuffer.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr size_t s_hierarchyGrain = 256;
+
+#ifdef MATH_SIMD_SSE2
+	/*!
+	 * 4 位掩码展开为 4 路比较掩码
+	 */
+	inline __m128 laneMask(const uint32_t bits)
+	{
+		const __m128i select = _mm_setr_epi32(1, 2, 4, 8);
+		const __m128i lanes = _mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), select);
+		return _mm_castsi128_ps(_mm_cmpeq_epi32(lanes, select));
+	}
+#endif
+}
+
+bool math::DepthBuffer::create(const size_t width, const size_t height)
+{
+	if (0 == width || 0 == height)
+	{
+		return false;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_tilesX = (width + s_tileSize - 1) / s_tileSize;
+	m_tilesY = (height + s_tileSize - 1) / s_tileSize;
+	m_depths.assign(m_tilesX * m_tilesY * s_tilePixels, 1.f);
+	m_dirty.assign(m_tilesX * m_tilesY, 0);
+
+	// 第 0 级每个节点对应一个 tile，之后每级 2x2 合并（向上取整）直到 1x1
+	m_levels.clear();
+	size_t w = m_tilesX;
+	size_t h = m_tilesY;
+	size_t offset(0);
+	while (true)
+	{
+		m_levels.push_back(Level{ w, h, offset });
+		offset += w * h;
+		if (1 == w && 1 == h)
+		{
+			break;
+		}
+		w = (w + 1) / 2;
+		h = (h + 1) / 2;
+	}
+	m_minDepths.assign(offset, 1.f);
+	m_maxDepths.assign(offset, 1.f);
+	return true;
+}
+
+void math::DepthBuffer::clear(const float depth)
+{
+	std::fill(m_depths.begin(), m_depths.end(), depth);
+	std::fill(m_dirty.begin(), m_dirty.end(), uint8_t(0));
+	std::fill(m_minDepths.begin(), m_minDepths.end(), depth);
+	std::fill(m_maxDepths.begin(), m_maxDepths.end(), depth);
+}
+
+size_t math::DepthBuffer::width() const
+{
+	return m_width;
+}
+
+size_t math::DepthBuffer::height() const
+{
+	return m_height;
+}
+
+size_t math::DepthBuffer::tilesX() const
+{
+	return m_tilesX;
+}
+
+size_t math::DepthBuffer::tilesY() const
+{
+	return m_tilesY;
+}
+
+float math::DepthBuffer::depth(const size_t x, const size_t y) const
+{
+	return tile(x / s_tileSize, y / s_tileSize)[(y % s_tileSize) * s_tileSize + x % s_tileSize];
+}
+
+size_t math::DepthBuffer::testSpan(const size_t x, const size_t y, const size_t count, const float* depths,
+	uint8_t* pass, const bool write)
+{
+	const size_t n = (y < m_height && x < m_width) ? std::min(count, m_width - x) : 0;
+	if (nullptr != pass && n < count)
+	{
+		std::fill(pass + n, pass + count, uint8_t(0));
+	}
+
+	const size_t tileY = y / s_tileSize;
+	const size_t row = y % s_tileSize;
+	size_t passed(0);
+	for (size_t i(0); i < n;)
+	{
+		// 每次处理落在同一 tile 行内的一段
+		const size_t column = (x + i) % s_tileSize;
+		const size_t tileX = (x + i) / s_tileSize;
+		const size_t run = std::min(s_tileSize - column, n - i);
+		float* stored = tile(tileX, tileY) + row * s_tileSize + column;
+		const float* incoming = depths + i;
+		size_t hits(0);
+
+#ifdef MATH_SIMD_SSE2
+		if (s_tileSize == run)
+		{
+			for (size_t h(0); h < s_tileSize; h += 4)
+			{
+				const __m128 d = _mm_loadu_ps(incoming + h);
+				const __m128 old = _mm_loadu_ps(stored + h);
+				const __m128 less = _mm_cmplt_ps(d, old);
+				const uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(less));
+				if (write)
+				{
+					_mm_storeu_ps(stored + h, _mm_or_ps(_mm_and_ps(less, d), _mm_andnot_ps(less, old)));
+				}
+				if (nullptr != pass)
+				{
+					for (size_t k(0); k < 4; ++k)
+					{
+						pass[i + h + k] = static_cast<uint8_t>((bits >> k) & 1u);
+					}
+				}
+				hits += std::popcount(bits);
+			}
+		}
+		else
+#endif
+		{
+			for (size_t k(0); k < run; ++k)
+			{
+				const bool less = incoming[k] < stored[k];
+				if (less && write)
+				{
+					stored[k] = incoming[k];
+				}
+				if (nullptr != pass)
+				{
+					pass[i + k] = less ? 1 : 0;
+				}
+				hits += less ? 1 : 0;
+			}
+		}
+
+		if (write && 0 != hits)
+		{
+			m_dirty[tileY * m_tilesX + tileX] = 1;
+		}
+		passed += hits;
+		i += run;
+	}
+	return passed;
+}
+
+uint64_t math::DepthBuffer::testTile(const size_t tileX, const size_t tileY, const float* depths,
+	const uint64_t coverage, const bool write)
+{
+	if (tileX >= m_tilesX || tileY >= m_tilesY)
+	{
+		return 0;
+	}
+
+	const uint64_t active = coverage & validMask(tileX, tileY);
+	float* stored = tile(tileX, tileY);
+	uint64_t result(0);
+	for (size_t r(0); r < s_tileSize; ++r)
+	{
+		const uint32_t rowBits = static_cast<uint32_t>(active >> (s_tileSize * r)) & 0xffu;
+		if (0 == rowBits)
+		{
+			continue;
+		}
+
+		const float* incoming = depths + r * s_tileSize;
+		float* target = stored + r * s_tileSize;
+#ifdef MATH_SIMD_SSE2
+		for (size_t h(0); h < s_tileSize; h += 4)
+		{
+			const __m128 d = _mm_loadu_ps(incoming + h);
+			const __m128 old = _mm_loadu_ps(target + h);
+			const __m128 less = _mm_and_ps(_mm_cmplt_ps(d, old), laneMask(rowBits >> h));
+			if (write)
+			{
+				_mm_storeu_ps(target + h, _mm_or_ps(_mm_and_ps(less, d), _mm_andnot_ps(less, old)));
+			}
+			result |= static_cast<uint64_t>(_mm_movemask_ps(less)) << (s_tileSize * r + h);
+		}
+#else
+		for (size_t k(0); k < s_tileSize; ++k)
+		{
+			if (0 != (rowBits & (1u << k)) && incoming[k] < target[k])
+			{
+				if (write)
+				{
+					target[k] = incoming[k];
+				}
+				result |= uint64_t(1) << (s_tileSize * r + k);
+			}
+		}
+#endif
+	}
+
+	if (write && 0 != result)
+	{
+		m_dirty[tileY * m_tilesX + tileX] = 1;
+	}
+	return result;
+}
+
+size_t math::DepthBuffer::updateHierarchy(ThreadPool& pool)
+{
+	std::vector<size_t> nodes;
+	for (size_t i(0); i < m_dirty.size(); ++i)
+	{
+		if (0 != m_dirty[i])
+		{
+			m_dirty[i] = 0;
+			nodes.push_back(i);
+		}
+	}
+	if (nodes.empty())
+	{
+		return 0;
+	}
+
+	const size_t updated = nodes.size();
+	if (updated <= s_hierarchyGrain)
+	{
+		for (const size_t index : nodes)
+		{
+			updateTile(index);
+		}
+	}
+	else
+	{
+		pool.parallelFor(0, updated, s_hierarchyGrain, [this, &nodes](size_t begin, size_t end)
+		{
+			for (size_t i(begin); i < end; ++i)
+			{
+				updateTile(nodes[i]);
+			}
+		});
+	}
+
+	// 逐级只重算脏节点的父节点
+	std::vector<size_t> parents;
+	std::vector<uint8_t> marked;
+	for (size_t l(1); l < m_levels.size(); ++l)
+	{
+		const Level& child = m_levels[l - 1];
+		const Level& level = m_levels[l];
+		marked.assign(level.width * level.height, 0);
+		parents.clear();
+		for (const size_t node : nodes)
+		{
+			const size_t parent = (node / child.width / 2) * level.width + (node % child.width) / 2;
+			if (0 == marked[parent])
+			{
+				marked[parent] = 1;
+				parents.push_back(parent);
+			}
+		}
+
+		for (const size_t parent : parents)
+		{
+			const size_t px = parent % level.width;
+			const size_t py = parent / level.width;
+			float low = m_minDepths[child.offset + 2 * py * child.width + 2 * px];
+			float high = m_maxDepths[child.offset + 2 * py * child.width + 2 * px];
+			for (size_t cy(2 * py); cy < std::min(2 * py + 2, child.height); ++cy)
+			{
+				for (size_t cx(2 * px); cx < std::min(2 * px + 2, child.width); ++cx)
+				{
+					low = std::min(low, m_minDepths[child.offset + cy * child.width + cx]);
+					high = std::max(high, m_maxDepths[child.offset + cy * child.width + cx]);
+				}
+			}
+			m_minDepths[level.offset + parent] = low;
+			m_maxDepths[level.offset + parent] = high;
+		}
+		nodes.swap(parents);
+	}
+	return updated;
+}
+
+bool math::DepthBuffer::isOccluded(const float minX, const float minY, const float maxX, const float maxY,
+	const float minDepth) const
+{
+	// NaN 或空矩形保守地视为可见
+	if (m_levels.empty() || !(minX <= maxX && minY <= maxY))
+	{
+		return false;
+	}
+
+	const float w = static_cast<float>(m_width);
+	const float h = static_cast<float>(m_height);
+	if (maxX < 0.f || maxY < 0.f || minX >= w || minY >= h)
+	{
+		return true;
+	}
+
+	const size_t x0 = minX > 0.f ? static_cast<size_t>(minX) : 0;
+	const size_t y0 = minY > 0.f ? static_cast<size_t>(minY) : 0;
+	const size_t x1 = maxX < w ? static_cast<size_t>(maxX) : m_width - 1;
+	const size_t y1 = maxY < h ? static_cast<size_t>(maxY) : m_height - 1;
+	return isOccluded(m_levels.size() - 1, 0, 0, x0 / s_tileSize, y0 / s_tileSize, x1 / s_tileSize, y1 / s_tileSize,
+		minDepth);
+}
+
+float* math::DepthBuffer::tile(const size_t tileX, const size_t tileY)
+{
+	return m_depths.data() + (tileY * m_tilesX + tileX) * s_tilePixels;
+}
+
+const float* math::DepthBuffer::tile(const size_t tileX, const size_t tileY) const
+{
+	return m_depths.data() + (tileY * m_tilesX + tileX) * s_tilePixels;
+}
+
+uint64_t math::DepthBuffer::validMask(const size_t tileX, const size_t tileY) const
+{
+	const size_t columns = std::min(s_tileSize, m_width - tileX * s_tileSize);
+	const size_t rows = std::min(s_tileSize, m_height - tileY * s_tileSize);
+	const uint64_t rowMask = (uint64_t(1) << columns) - 1;
+	uint64_t mask(0);
+	for (size_t r(0); r < rows; ++r)
+	{
+		mask |= rowMask << (s_tileSize * r);
+	}
+	return mask;
+}
+
+void math::DepthBuffer::updateTile(const size_t index)
+{
+	const size_t tileX = index % m_tilesX;
+	const size_t tileY = index / m_tilesX;
+	const float* depths = tile(tileX, tileY);
+	const size_t columns = std::min(s_tileSize, m_width - tileX * s_tileSize);
+	const size_t rows = std::min(s_tileSize, m_height - tileY * s_tileSize);
+
+	float low = depths[0];
+	float high = depths[0];
+#ifdef MATH_SIMD_SSE2
+	if (s_tileSize == columns && s_tileSize == rows)
+	{
+		__m128 lowLanes = _mm_loadu_ps(depths);
+		__m128 highLanes = lowLanes;
+		for (size_t i(4); i < s_tilePixels; i += 4)
+		{
+			const __m128 d = _mm_loadu_ps(depths + i);
+			lowLanes = _mm_min_ps(lowLanes, d);
+			highLanes = _mm_max_ps(highLanes, d);
+		}
+		alignas(16) float lanes[8];
+		_mm_store_ps(lanes, lowLanes);
+		_mm_store_ps(lanes + 4, highLanes);
+		low = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+		high = std::max(std::max(lanes[4], lanes[5]), std::max(lanes[6], lanes[7]));
+	}
+	else
+#endif
+	{
+		for (size_t r(0); r < rows; ++r)
+		{
+			for (size_t c(0); c < columns; ++c)
+			{
+				low = std::min(low, depths[r * s_tileSize + c]);
+				high = std::max(high, depths[r * s_tileSize + c]);
+			}
+		}
+	}
+	m_minDepths[index] = low;
+	m_maxDepths[index] = high;
+}
+
+bool math::DepthBuffer::isOccluded(const float* corners, const size_t count, const ClipDepth clipDepth) const
+{
+	float minX = std::numeric_limits<float>::infinity();
+	float maxX = -minX;
+	float minY = minX;
+	float maxY = maxX;
+	float minZ = minX;
+	for (size_t i(0); i < count; ++i)
+	{
+		const float* c = corners + 4 * i;
+		if (!(c[3] > 0.f))
+		{
+			return false;
+		}
+		const float inv = 1.f / c[3];
+		const float x = c[0] * inv;
+		const float y = c[1] * inv;
+		const float z = c[2] * inv;
+		// std::min/max 会跳过 NaN，必须显式检查，否则该顶点被忽略、包围矩形偏小
+		if (std::isnan(x) || std::isnan(y) || std::isnan(z))
+		{
+			return false;
+		}
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, z);
+	}
+
+	const float depth = ClipDepth::ZeroToOne == clipDepth ? minZ : minZ * 0.5f + 0.5f;
+	const float w = static_cast<float>(m_width);
+	const float h = static_cast<float>(m_height);
+	return isOccluded((minX * 0.5f + 0.5f) * w, (0.5f - maxY * 0.5f) * h, (maxX * 0.5f + 0.5f) * w,
+		(0.5f - minY * 0.5f) * h, depth);
+}
+
+bool math::DepthBuffer::isOccluded(const size_t level, const size_t nodeX, const size_t nodeY, const size_t tileX0,
+	const size_t tileY0, const size_t tileX1, const size_t tileY1, const float minDepth) const
+{
+	const Level& info = m_levels[level];
+	if (m_maxDepths[info.offset + nodeY * info.width + nodeX] <= minDepth)
+	{
+		return true;
+	}
+	if (0 == level)
+	{
+		return false;
+	}
+
+	// 只下探与矩形相交的子节点，子节点 (cx, cy) 覆盖第 0 级 tile [cx << shift, (cx + 1) << shift)
+	const size_t shift = level - 1;
+	const Level& child = m_levels[shift];
+	const size_t cx0 = std::max(2 * nodeX, tileX0 >> shift);
+	const size_t cx1 = std::min({ 2 * nodeX + 1, tileX1 >> shift, child.width - 1 });
+	const size_t cy0 = std::max(2 * nodeY, tileY0 >> shift);
+	const size_t cy1 = std::min({ 2 * nodeY + 1, tileY1 >> shift, child.height - 1 });
+	for (size_t cy(cy0); cy <= cy1; ++cy)
+	{
+		for (size_t cx(cx0); cx <= cx1; ++cx)
+		{
+			if (!isOccluded(shift, cx, cy, tileX0, tileY0, tileX1, tileY1, minDepth))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,689 @@
+#include "render/Texture.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// 寻址前把纹理坐标限制在 ±2^23 内：超出后 float 已没有小数部分，同时保证取整不溢出 int
+	constexpr float s_coordLimit = 8388608.f;
+	constexpr size_t s_rowGrain = 16;
+	constexpr size_t s_kaiserTaps = 8;
+
+	struct Axis
+	{
+		size_t i0;
+		size_t i1;
+		float f;
+	};
+
+	struct Mip
+	{
+		size_t level0;
+		size_t level1;
+		float t;
+	};
+
+	/*!
+	 * 单个坐标轴的寻址：返回相邻两个纹素的下标与插值权重，比较写法同时把 NaN 映射到边界
+	 */
+	inline Axis axis(float u, const float size, const math::WrapMode mode)
+	{
+		u = u > -s_coordLimit ? (u < s_coordLimit ? u : s_coordLimit) : -s_coordLimit;
+		if (math::WrapMode::Repeat == mode)
+		{
+			u = u - std::floor(u);
+		}
+		else if (math::WrapMode::Mirror == mode)
+		{
+			const float m = u - 2.f * std::floor(u * 0.5f);
+			u = m > 1.f ? 2.f - m : m;
+		}
+
+		float x = u * size - 0.5f;
+		x = x > -1.f ? (x < size ? x : size) : -1.f;
+		const float x0 = std::floor(x);
+		float lo = x0;
+		float hi = x0 + 1.f;
+		if (math::WrapMode::Repeat == mode)
+		{
+			lo = lo < 0.f ? size - 1.f : (lo < size ? lo : lo - size);
+			hi = hi < size ? hi : 0.f;
+		}
+		else
+		{
+			lo = lo > 0.f ? (lo < size - 1.f ? lo : size - 1.f) : 0.f;
+			hi = hi > 0.f ? (hi < size - 1.f ? hi : size - 1.f) : 0.f;
+		}
+		return { static_cast<size_t>(lo), static_cast<size_t>(hi), x - x0 };
+	}
+
+	inline Mip selectMip(const float lod, const size_t levelCount, const math::TextureFilter filter)
+	{
+		const float top = static_cast<float>(levelCount - 1);
+		const float l = lod > 0.f ? (lod < top ? lod : top) : 0.f;
+		if (math::TextureFilter::Bilinear == filter)
+		{
+			const size_t level = static_cast<size_t>(l + 0.5f);
+			return { level, level, 0.f };
+		}
+
+		const size_t level = static_cast<size_t>(l);
+		return { level, std::min(level + 1, levelCount - 1), l - static_cast<float>(level) };
+	}
+
+	inline void bilinear(const float* c00, const float* c10, const float* c01, const float* c11,
+		const float fx, const float fy, float* out)
+	{
+		for (size_t c(0); c < 4; ++c)
+		{
+			const float top = c00[c] + (c10[c] - c00[c]) * fx;
+			const float bottom = c01[c] + (c11[c] - c01[c]) * fx;
+			out[c] = top + (bottom - top) * fy;
+		}
+	}
+
+	/*!
+	 * 8 抽头 Kaiser 窗 sinc：目标纹素中心位于源纹素 2x 与 2x + 1 之间，
+	 * 抽头 k 取源纹素 2x + k - 3，到中心的距离以目标纹素为单位为 (k - 3.5) / 2
+	 */
+	std::array<float, s_kaiserTaps> kaiserKernel()
+	{
+		constexpr double beta = 4.0;
+		constexpr double radius = 2.0;
+		auto bessel0 = [](const double x)
+		{
+			double sum = 1.0;
+			double term = 1.0;
+			for (int k(1); k < 24; ++k)
+			{
+				const double h = x / (2.0 * k);
+				term *= h * h;
+				sum += term;
+			}
+			return sum;
+		};
+
+		double weights[s_kaiserTaps];
+		double total = 0.0;
+		for (size_t k(0); k < s_kaiserTaps; ++k)
+		{
+			const double d = (static_cast<double>(k) - 3.5) / 2.0;
+			const double sinc = std::sin(std::numbers::pi * d) / (std::numbers::pi * d);
+			const double r = d / radius;
+			weights[k] = sinc * bessel0(beta * std::sqrt(1.0 - r * r)) / bessel0(beta);
+			total += weights[k];
+		}
+
+		std::array<float, s_kaiserTaps> kernel;
+		for (size_t k(0); k < s_kaiserTaps; ++k)
+		{
+			kernel[k] = static_cast<float>(weights[k] / total);
+		}
+		return kernel;
+	}
+
+	inline size_t tap(const size_t center, const size_t k, const size_t size)
+	{
+		// center + k - 3，截断到 [0, size - 1]
+		return center + k < 3 ? 0 : std::min(center + k - 3, size - 1);
+	}
+
+#ifdef MATH_SIMD_SSE2
+	inline __m128 floorPs(const __m128 x)
+	{
+		// 调用方保证 |x| < 2^31
+		const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+		return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.f)));
+	}
+
+	inline __m128 selectPs(const __m128 mask, const __m128 a, const __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	/*!
+	 * axis 的 4 路版本，逐条运算与标量版本相同，结果逐位一致
+	 */
+	inline void axis(__m128 u, const __m128 size, const math::WrapMode mode, __m128i& i0, __m128i& i1, __m128& f)
+	{
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 zero = _mm_setzero_ps();
+		u = _mm_min_ps(_mm_max_ps(u, _mm_set1_ps(-s_coordLimit)), _mm_set1_ps(s_coordLimit));
+		if (math::WrapMode::Repeat == mode)
+		{
+			u = _mm_sub_ps(u, floorPs(u));
+		}
+		else if (math::WrapMode::Mirror == mode)
+		{
+			const __m128 m = _mm_sub_ps(u, _mm_mul_ps(_mm_set1_ps(2.f), floorPs(_mm_mul_ps(u, _mm_set1_ps(0.5f)))));
+			u = selectPs(_mm_cmpgt_ps(m, one), _mm_sub_ps(_mm_set1_ps(2.f), m), m);
+		}
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(u, size), _mm_set1_ps(0.5f));
+		x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.f)), size);
+		const __m128 x0 = floorPs(x);
+		__m128 lo = x0;
+		__m128 hi = _mm_add_ps(x0, one);
+		if (math::WrapMode::Repeat == mode)
+		{
+			lo = selectPs(_mm_cmplt_ps(lo, zero), _mm_sub_ps(size, one),
+				selectPs(_mm_cmplt_ps(lo, size), lo, _mm_sub_ps(lo, size)));
+			hi = _mm_and_ps(_mm_cmplt_ps(hi, size), hi);
+		}
+		else
+		{
+			const __m128 last = _mm_sub_ps(size, one);
+			lo = _mm_min_ps(_mm_max_ps(lo, zero), last);
+			hi = _mm_min_ps(_mm_max_ps(hi, zero), last);
+		}
+		i0 = _mm_cvttps_epi32(lo);
+		i1 = _mm_cvttps_epi32(hi);
+		f = _mm_sub_ps(x, x0);
+	}
+
+	inline __m128i mulLo(const __m128i a, const __m128i b)
+	{
+		// SSE2 没有 32 位低位乘法，奇偶两组分别用 _mm_mul_epu32
+		const __m128i even = _mm_mul_epu32(a, b);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+			_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	}
+
+	/*!
+	 * tile 内的列偏移 (x / 4) * 16 + x % 4 与行偏移 (y / 4) * pitch + (y % 4) * 4，与 Texture::texelIndex 一致
+	 */
+	inline __m128i columnOffset(const __m128i x)
+	{
+		return _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(x, 2), 4), _mm_and_si128(x, _mm_set1_epi32(3)));
+	}
+
+	inline __m128i rowOffset(const __m128i y, const __m128i pitch)
+	{
+		return _mm_add_epi32(mulLo(_mm_srli_epi32(y, 2), pitch), _mm_slli_epi32(_mm_and_si128(y, _mm_set1_epi32(3)), 2));
+	}
+#endif
+}
+
+bool math::Texture::create(const uint8_t* pixels, const size_t width, const size_t height, const PixelFormat format)
+{
+	if (nullptr == pixels || 0 == width || 0 == height || width > s_maxSize || height > s_maxSize)
+	{
+		return false;
+	}
+
+	m_format = TextureFormat::RGBA8;
+	m_levels.clear();
+	m_bytes.clear();
+	m_floats.clear();
+	appendLevel(width, height);
+
+	const int r = PixelFormat::BGRA8 == format ? 2 : 0;
+	const int b = PixelFormat::BGRA8 == format ? 0 : 2;
+	for (size_t y(0); y < height; ++y)
+	{
+		for (size_t x(0); x < width; ++x)
+		{
+			const uint8_t* src = pixels + 4 * (y * width + x);
+			uint8_t* dst = m_bytes.data() + 4 * texelIndex(m_levels[0], x, y);
+			dst[0] = src[r];
+			dst[1] = src[1];
+			dst[2] = src[b];
+			dst[3] = src[3];
+		}
+	}
+	return true;
+}
+
+bool math::Texture::create(const float* rgba, const size_t width, const size_t height)
+{
+	if (nullptr == rgba || 0 == width || 0 == height || width > s_maxSize || height > s_maxSize)
+	{
+		return false;
+	}
+
+	m_format = TextureFormat::RGBA32F;
+	m_levels.clear();
+	m_bytes.clear();
+	m_floats.clear();
+	appendLevel(width, height);
+	for (size_t y(0); y < height; ++y)
+	{
+		storeRow(0, y, rgba + 4 * y * width);
+	}
+	return true;
+}
+
+void math::Texture::generateMips(const MipFilter filter, ThreadPool& pool)
+{
+	if (m_levels.empty())
+	{
+		return;
+	}
+
+	// 丢弃旧的 mip，各级都由上一级未量化的浮点结果生成，RGBA8 不会逐级累积量化误差
+	size_t w = m_levels[0].width;
+	size_t h = m_levels[0].height;
+	const size_t baseTexels = m_levels.size() > 1 ? m_levels[1].offset : 0;
+	m_levels.resize(1);
+	if (0 != baseTexels)
+	{
+		m_bytes.resize(TextureFormat::RGBA8 == m_format ? 4 * baseTexels : 0);
+		m_floats.resize(TextureFormat::RGBA32F == m_format ? 4 * baseTexels : 0);
+	}
+
+	std::vector<float> src(4 * w * h);
+	readLevel(0, src.data());
+	std::vector<float> dst;
+	std::vector<float> tmp;
+	const std::array<float, s_kaiserTaps> kernel = kaiserKernel();
+
+	while (w > 1 || h > 1)
+	{
+		const size_t dw = std::max<size_t>(1, w / 2);
+		const size_t dh = std::max<size_t>(1, h / 2);
+		appendLevel(dw, dh);
+		const size_t level = m_levels.size() - 1;
+		dst.resize(4 * dw * dh);
+
+		if (MipFilter::Box == filter)
+		{
+			pool.parallelFor(0, dh, s_rowGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t y(begin); y < end; ++y)
+				{
+					const float* row0 = src.data() + 4 * w * std::min(2 * y, h - 1);
+					const float* row1 = src.data() + 4 * w * std::min(2 * y + 1, h - 1);
+					float* out = dst.data() + 4 * dw * y;
+					for (size_t x(0); x < dw; ++x)
+					{
+						const size_t x0 = 4 * std::min(2 * x, w - 1);
+						const size_t x1 = 4 * std::min(2 * x + 1, w - 1);
+						for (size_t c(0); c < 4; ++c)
+						{
+							out[4 * x + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+						}
+					}
+					storeRow(level, y, out);
+				}
+			});
+		}
+		else
+		{
+			// 先水平降采样到 tmp（dw x h），再竖直降采样
+			tmp.resize(4 * dw * h);
+			pool.parallelFor(0, h, s_rowGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t y(begin); y < end; ++y)
+				{
+					const float* row = src.data() + 4 * w * y;
+					float* out = tmp.data() + 4 * dw * y;
+					for (size_t x(0); x < dw; ++x)
+					{
+						float sum[4] = {};
+						for (size_t k(0); k < s_kaiserTaps; ++k)
+						{
+							const float* texel = row + 4 * (w > 1 ? tap(2 * x, k, w) : 0);
+							for (size_t c(0); c < 4; ++c)
+							{
+								sum[c] += kernel[k] * texel[c];
+							}
+						}
+						std::copy(sum, sum + 4, out + 4 * x);
+					}
+				}
+			});
+			pool.parallelFor(0, dh, s_rowGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t y(begin); y < end; ++y)
+				{
+					float* out = dst.data() + 4 * dw * y;
+					std::fill(out, out + 4 * dw, 0.f);
+					for (size_t k(0); k < s_kaiserTaps; ++k)
+					{
+						const float* row = tmp.data() + 4 * dw * (h > 1 ? tap(2 * y, k, h) : 0);
+						for (size_t i(0); i < 4 * dw; ++i)
+						{
+							out[i] += kernel[k] * row[i];
+						}
+					}
+					storeRow(level, y, out);
+				}
+			});
+		}
+
+		src.swap(dst);
+		w = dw;
+		h = dh;
+	}
+}
+
+math::TextureFormat math::Texture::format() const
+{
+	return m_format;
+}
+
+size_t math::Texture::levelCount() const
+{
+	return m_levels.size();
+}
+
+size_t math::Texture::width(const size_t level) const
+{
+	return level < m_levels.size() ? m_levels[level].width : 0;
+}
+
+size_t math::Texture::height(const size_t level) const
+{
+	return level < m_levels.size() ? m_levels[level].height : 0;
+}
+
+math::TVector4<float> math::Texture::texel(const size_t level, const size_t x, const size_t y) const
+{
+	const size_t index = texelIndex(m_levels[level], x, y);
+	if (TextureFormat::RGBA8 == m_format)
+	{
+		const uint8_t* p = m_bytes.data() + 4 * index;
+		return TVector4<float>(p[0] * (1.f / 255.f), p[1] * (1.f / 255.f), p[2] * (1.f / 255.f), p[3] * (1.f / 255.f));
+	}
+	const float* p = m_floats.data() + 4 * index;
+	return TVector4<float>(p[0], p[1], p[2], p[3]);
+}
+
+void math::Texture::readLevel(const size_t level, float* rgba) const
+{
+	const Level& info = m_levels[level];
+	for (size_t y(0); y < info.height; ++y)
+	{
+		for (size_t x(0); x < info.width; x += s_tile)
+		{
+			// tile 内同一行的 4 个纹素连续存放
+			const size_t run = std::min(s_tile, info.width - x);
+			const size_t index = texelIndex(info, x, y);
+			float* out = rgba + 4 * (y * info.width + x);
+			if (TextureFormat::RGBA8 == m_format)
+			{
+				ColorTool::unpackColors(m_bytes.data() + 4 * index, run, out);
+			}
+			else
+			{
+				std::memcpy(out, m_floats.data() + 4 * index, 4 * run * sizeof(float));
+			}
+		}
+	}
+}
+
+void math::Texture::sample(const float* u, const float* v, const float* lod, const size_t count,
+	const TextureSampler& sampler, float* rgba) const
+{
+	if (m_levels.empty())
+	{
+		std::fill(rgba, rgba + 4 * count, 0.f);
+		return;
+	}
+
+	if (TextureFormat::RGBA8 == m_format)
+	{
+		sampleBatch<TextureFormat::RGBA8>(u, v, lod, count, sampler, rgba);
+	}
+	else
+	{
+		sampleBatch<TextureFormat::RGBA32F>(u, v, lod, count, sampler, rgba);
+	}
+}
+
+void math::Texture::sampleQuads(const float* u, const float* v, const size_t quadCount, const TextureSampler& sampler,
+	float* rgba, const float lodBias) const
+{
+	if (m_levels.empty())
+	{
+		std::fill(rgba, rgba + 16 * quadCount, 0.f);
+		return;
+	}
+
+	const float w = static_cast<float>(m_levels[0].width);
+	const float h = static_cast<float>(m_levels[0].height);
+	for (size_t q(0); q < quadCount; ++q)
+	{
+		// 以第 0 级纹素为单位的屏幕空间导数，lod = log2(max(|d/dx|, |d/dy|))
+		const float* qu = u + 4 * q;
+		const float* qv = v + 4 * q;
+		const float dux = (qu[1] - qu[0]) * w, dvx = (qv[1] - qv[0]) * h;
+		const float duy = (qu[2] - qu[0]) * w, dvy = (qv[2] - qv[0]) * h;
+		const float rho2 = std::max(dux * dux + dvx * dvx, duy * duy + dvy * dvy);
+		const float lod = 0.5f * std::log2(rho2) + lodBias;
+		const float lods[4] = { lod, lod, lod, lod };
+
+		if (TextureFormat::RGBA8 == m_format)
+		{
+			sampleBatch<TextureFormat::RGBA8>(qu, qv, lods, 4, sampler, rgba + 16 * q);
+		}
+		else
+		{
+			sampleBatch<TextureFormat::RGBA32F>(qu, qv, lods, 4, sampler, rgba + 16 * q);
+		}
+	}
+}
+
+size_t math::Texture::texelIndex(const Level& level, const size_t x, const size_t y) const
+{
+	const size_t tile = (y / s_tile) * level.tilesX + x / s_tile;
+	return level.offset + tile * s_tile * s_tile + (y % s_tile) * s_tile + x % s_tile;
+}
+
+void math::Texture::appendLevel(const size_t width, const size_t height)
+{
+	const size_t tilesX = (width + s_tile - 1) / s_tile;
+	const size_t tilesY = (height + s_tile - 1) / s_tile;
+	const size_t texels = tilesX * tilesY * s_tile * s_tile;
+	if (TextureFormat::RGBA8 == m_format)
+	{
+		m_levels.push_back(Level{ width, height, tilesX, m_bytes.size() / 4 });
+		m_bytes.resize(m_bytes.size() + 4 * texels);
+	}
+	else
+	{
+		m_levels.push_back(Level{ width, height, tilesX, m_floats.size() / 4 });
+		m_floats.resize(m_floats.size() + 4 * texels);
+	}
+}
+
+void math::Texture::storeRow(const size_t level, const size_t y, const float* rgba)
+{
+	const Level& info = m_levels[level];
+	for (size_t x(0); x < info.width; x += s_tile)
+	{
+		const size_t run = std::min(s_tile, info.width - x);
+		const size_t index = texelIndex(info, x, y);
+		if (TextureFormat::RGBA8 == m_format)
+		{
+			ColorTool::packColors(rgba + 4 * x, run, m_bytes.data() + 4 * index);
+		}
+		else
+		{
+			std::memcpy(m_floats.data() + 4 * index, rgba + 4 * x, 4 * run * sizeof(float));
+		}
+	}
+}
+
+template <math::TextureFormat F>
+void math::Texture::samplePixel(const float u, const float v, const float lod, const TextureSampler& sampler,
+	float* rgba) const
+{
+	auto fetch = [this](const size_t index, float* texel)
+	{
+		if constexpr (TextureFormat::RGBA8 == F)
+		{
+			const uint8_t* p = m_bytes.data() + 4 * index;
+			for (size_t c(0); c < 4; ++c)
+			{
+				texel[c] = static_cast<float>(p[c]);
+			}
+		}
+		else
+		{
+			std::memcpy(texel, m_floats.data() + 4 * index, 4 * sizeof(float));
+		}
+	};
+	auto filter = [&](const size_t level, float* out)
+	{
+		const Level& info = m_levels[level];
+		const Axis ax = axis(u, static_cast<float>(info.width), sampler.wrapU);
+		const Axis ay = axis(v, static_cast<float>(info.height), sampler.wrapV);
+		const size_t pitch = info.tilesX * s_tile * s_tile;
+		const size_t col0 = ax.i0 / s_tile * s_tile * s_tile + ax.i0 % s_tile;
+		const size_t col1 = ax.i1 / s_tile * s_tile * s_tile + ax.i1 % s_tile;
+		const size_t row0 = info.offset + ay.i0 / s_tile * pitch + ay.i0 % s_tile * s_tile;
+		const size_t row1 = info.offset + ay.i1 / s_tile * pitch + ay.i1 % s_tile * s_tile;
+		float c00[4], c10[4], c01[4], c11[4];
+		fetch(row0 + col0, c00);
+		fetch(row0 + col1, c10);
+		fetch(row1 + col0, c01);
+		fetch(row1 + col1, c11);
+		bilinear(c00, c10, c01, c11, ax.f, ay.f, out);
+	};
+
+	const Mip mip = selectMip(lod, m_levels.size(), sampler.filter);
+	filter(mip.level0, rgba);
+	if (TextureFilter::Trilinear == sampler.filter)
+	{
+		float next[4];
+		filter(mip.level1, next);
+		for (size_t c(0); c < 4; ++c)
+		{
+			rgba[c] = rgba[c] + (next[c] - rgba[c]) * mip.t;
+		}
+	}
+	if constexpr (TextureFormat::RGBA8 == F)
+	{
+		for (size_t c(0); c < 4; ++c)
+		{
+			rgba[c] *= 1.f / 255.f;
+		}
+	}
+}
+
+template <math::TextureFormat F>
+void math::Texture::sampleGroup(const float* u, const float* v, const float* lod, const TextureSampler& sampler,
+	float* rgba) const
+{
+#ifdef MATH_SIMD_SSE2
+	const __m128 us = _mm_loadu_ps(u);
+	const __m128 vs = _mm_loadu_ps(v);
+	Mip mips[4];
+	for (size_t k(0); k < 4; ++k)
+	{
+		mips[k] = selectMip(nullptr != lod ? lod[k] : 0.f, m_levels.size(), sampler.filter);
+	}
+
+	auto fetch = [this](const size_t index) -> __m128
+	{
+		if constexpr (TextureFormat::RGBA8 == F)
+		{
+			int32_t packed;
+			std::memcpy(&packed, m_bytes.data() + 4 * index, sizeof(packed));
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+			return _mm_cvtepi32_ps(wide);
+		}
+		else
+		{
+			return _mm_loadu_ps(m_floats.data() + 4 * index);
+		}
+	};
+
+	// 4 个像素的寻址跨像素计算，每个像素的 2x2 纹素以 RGBA 向量插值
+	auto filter = [&](const bool second, __m128* out)
+	{
+		const Level* levels[4];
+		for (size_t k(0); k < 4; ++k)
+		{
+			levels[k] = &m_levels[second ? mips[k].level1 : mips[k].level0];
+		}
+		const __m128 widths = _mm_setr_ps(static_cast<float>(levels[0]->width), static_cast<float>(levels[1]->width),
+			static_cast<float>(levels[2]->width), static_cast<float>(levels[3]->width));
+		const __m128 heights = _mm_setr_ps(static_cast<float>(levels[0]->height), static_cast<float>(levels[1]->height),
+			static_cast<float>(levels[2]->height), static_cast<float>(levels[3]->height));
+		const __m128i pitches = _mm_setr_epi32(static_cast<int>(levels[0]->tilesX * s_tile * s_tile),
+			static_cast<int>(levels[1]->tilesX * s_tile * s_tile), static_cast<int>(levels[2]->tilesX * s_tile * s_tile),
+			static_cast<int>(levels[3]->tilesX * s_tile * s_tile));
+
+		__m128i x0, x1, y0, y1;
+		__m128 wx, wy;
+		axis(us, widths, sampler.wrapU, x0, x1, wx);
+		axis(vs, heights, sampler.wrapV, y0, y1, wy);
+		const __m128i col0 = columnOffset(x0);
+		const __m128i col1 = columnOffset(x1);
+		const __m128i row0 = rowOffset(y0, pitches);
+		const __m128i row1 = rowOffset(y1, pitches);
+
+		alignas(16) uint32_t i00[4], i10[4], i01[4], i11[4];
+		alignas(16) float fx[4], fy[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(i00), _mm_add_epi32(col0, row0));
+		_mm_store_si128(reinterpret_cast<__m128i*>(i10), _mm_add_epi32(col1, row0));
+		_mm_store_si128(reinterpret_cast<__m128i*>(i01), _mm_add_epi32(col0, row1));
+		_mm_store_si128(reinterpret_cast<__m128i*>(i11), _mm_add_epi32(col1, row1));
+		_mm_store_ps(fx, wx);
+		_mm_store_ps(fy, wy);
+		for (size_t k(0); k < 4; ++k)
+		{
+			const size_t offset = levels[k]->offset;
+			const __m128 c00 = fetch(offset + i00[k]);
+			const __m128 c10 = fetch(offset + i10[k]);
+			const __m128 c01 = fetch(offset + i01[k]);
+			const __m128 c11 = fetch(offset + i11[k]);
+			const __m128 sx = _mm_set1_ps(fx[k]);
+			const __m128 top = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), sx));
+			const __m128 bottom = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), sx));
+			out[k] = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(fy[k])));
+		}
+	};
+
+	__m128 colors[4];
+	filter(false, colors);
+	if (TextureFilter::Trilinear == sampler.filter)
+	{
+		__m128 next[4];
+		filter(true, next);
+		for (size_t k(0); k < 4; ++k)
+		{
+			colors[k] = _mm_add_ps(colors[k], _mm_mul_ps(_mm_sub_ps(next[k], colors[k]), _mm_set1_ps(mips[k].t)));
+		}
+	}
+	for (size_t k(0); k < 4; ++k)
+	{
+		if constexpr (TextureFormat::RGBA8 == F)
+		{
+			colors[k] = _mm_mul_ps(colors[k], _mm_set1_ps(1.f / 255.f));
+		}
+		_mm_storeu_ps(rgba + 4 * k, colors[k]);
+	}
+#else
+	for (size_t k(0); k < 4; ++k)
+	{
+		samplePixel<F>(u[k], v[k], nullptr != lod ? lod[k] : 0.f, sampler, rgba + 4 * k);
+	}
+#endif
+}
+
+template <math::TextureFormat F>
+void math::Texture::sampleBatch(const float* u, const float* v, const float* lod, const size_t count,
+	const TextureSampler& sampler, float* rgba) const
+{
+	size_t i(0);
+	for (; i + 4 <= count; i += 4)
+	{
+		sampleGroup<F>(u + i, v + i, nullptr != lod ? lod + i : nullptr, sampler, rgba + 4 * i);
+	}
+	for (; i < count; ++i)
+	{
+		samplePixel<F>(u[i], v[i], nullptr != lod ? lod[i] : 0.f, sampler, rgba + 4 * i);
+	}
+}
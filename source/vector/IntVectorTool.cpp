@@ -0,0 +1,336 @@
+#include "vector/IntVectorTool.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr uint64_t s_exactLimit = 1ull << 52;
+
+	inline uint32_t absDifference(const int a, const int b)
+	{
+		return a < b ? static_cast<uint32_t>(b) - static_cast<uint32_t>(a)
+			: static_cast<uint32_t>(a) - static_cast<uint32_t>(b);
+	}
+
+#ifdef MATH_SIMD_SSE2
+	inline __m128i load(const int* p)
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+
+	// 4 个 32 位通道按偶/奇分别零扩展到 64 位
+	inline void widen(const __m128i v, __m128i& even, __m128i& odd)
+	{
+		even = _mm_and_si128(v, _mm_set_epi32(0, -1, 0, -1));
+		odd = _mm_srli_epi64(v, 32);
+	}
+
+	// 有符号 32 位乘积：无符号乘积减去符号修正项 2^32 * (sa * b + sb * a)
+	inline void signedProducts(const __m128i a, const __m128i b, __m128i& even, __m128i& odd)
+	{
+		const __m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+			_mm_and_si128(_mm_srai_epi32(b, 31), a));
+		even = _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(correction, 32));
+		odd = _mm_sub_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)),
+			_mm_and_si128(correction, _mm_set_epi32(-1, 0, -1, 0)));
+	}
+
+	inline __m128i absolute(const __m128i v)
+	{
+		const __m128i sign = _mm_srai_epi32(v, 31);
+		return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+	}
+
+	// |a - b|，按无符号 32 位解释时精确
+	inline __m128i absDifference(const __m128i a, const __m128i b)
+	{
+		const __m128i less = _mm_cmplt_epi32(a, b);
+		return _mm_sub_epi32(_mm_xor_si128(_mm_sub_epi32(a, b), less), less);
+	}
+
+	inline __m128i maxUnsigned(const __m128i a, const __m128i b)
+	{
+		const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+		const __m128i greater = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+		return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+	}
+
+	inline void store2(uint64_t* out, const __m128i v)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+	}
+
+	/*
+	 * 按维数把 64 位通道归约为每个向量一个和
+	 * terms(offset, even, odd) 给出从第 offset 个分量开始 4 个分量对应的 64 位项
+	 * 维数 3 时 4 个向量占 3 个寄存器：(x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+	 * 返回已处理的向量数
+	 */
+	template <typename Terms>
+	size_t reduce(const size_t dimension, const size_t count, uint64_t* out, Terms terms)
+	{
+		size_t i(0);
+		__m128i e0, o0, e1, o1, e2, o2;
+		if (2 == dimension)
+		{
+			for (; i + 2 <= count; i += 2)
+			{
+				terms(2 * i, e0, o0);
+				store2(out + i, _mm_add_epi64(e0, o0));
+			}
+		}
+		else if (4 == dimension)
+		{
+			for (; i + 2 <= count; i += 2)
+			{
+				terms(4 * i, e0, o0);
+				terms(4 * i + 4, e1, o1);
+				const __m128i s0 = _mm_add_epi64(e0, o0);
+				const __m128i s1 = _mm_add_epi64(e1, o1);
+				store2(out + i, _mm_add_epi64(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1)));
+			}
+		}
+		else if (3 == dimension)
+		{
+			for (; i + 4 <= count; i += 4)
+			{
+				terms(3 * i, e0, o0);
+				terms(3 * i + 4, e1, o1);
+				terms(3 * i + 8, e2, o2);
+				const __m128i v01 = _mm_add_epi64(_mm_add_epi64(
+					_mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(e0), _mm_castsi128_pd(o0), 2)),
+					_mm_unpacklo_epi64(o0, e1)),
+					_mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(e0), _mm_castsi128_pd(o1), 1)));
+				const __m128i v23 = _mm_add_epi64(_mm_add_epi64(
+					_mm_unpackhi_epi64(e1, e2),
+					_mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(o1), _mm_castsi128_pd(o2), 1))),
+					_mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(e2), _mm_castsi128_pd(o2), 2)));
+				store2(out + i, v01);
+				store2(out + i + 2, v23);
+			}
+		}
+		return i;
+	}
+#endif
+}
+
+void math::IntVectorTool::add(const int* a, const int* b, int* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(load(a + i), load(b + i)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = static_cast<int>(static_cast<uint32_t>(a[i]) + static_cast<uint32_t>(b[i]));
+	}
+}
+
+void math::IntVectorTool::subtract(const int* a, const int* b, int* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi32(load(a + i), load(b + i)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = static_cast<int>(static_cast<uint32_t>(a[i]) - static_cast<uint32_t>(b[i]));
+	}
+}
+
+void math::IntVectorTool::scale(const int* a, const int s, int* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	// SSE2 没有 32 位低位乘法，用两次 64 位无符号乘法取低 32 位再交错
+	const __m128i factor = _mm_set1_epi32(s);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i v = load(a + i);
+		const __m128i even = _mm_mul_epu32(v, factor);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(v, 32), factor);
+		const __m128i result = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+			_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), result);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = static_cast<int>(static_cast<uint32_t>(a[i]) * static_cast<uint32_t>(s));
+	}
+}
+
+void math::IntVectorTool::dot(const int* a, const int* b, const size_t dimension, int64_t* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	i = reduce(dimension, count, reinterpret_cast<uint64_t*>(out),
+		[a, b](const size_t offset, __m128i& even, __m128i& odd)
+	{
+		signedProducts(load(a + offset), load(b + offset), even, odd);
+	});
+#endif
+	for (; i < count; ++i)
+	{
+		int64_t sum(0);
+		for (size_t k(0); k < dimension; ++k)
+		{
+			sum += static_cast<int64_t>(a[i * dimension + k]) * b[i * dimension + k];
+		}
+		out[i] = sum;
+	}
+}
+
+void math::IntVectorTool::squaredLength(const int* a, const size_t dimension, uint64_t* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	i = reduce(dimension, count, out, [a](const size_t offset, __m128i& even, __m128i& odd)
+	{
+		const __m128i v = absolute(load(a + offset));
+		even = _mm_mul_epu32(v, v);
+		odd = _mm_mul_epu32(_mm_srli_epi64(v, 32), _mm_srli_epi64(v, 32));
+	});
+#endif
+	for (; i < count; ++i)
+	{
+		uint64_t sum(0);
+		for (size_t k(0); k < dimension; ++k)
+		{
+			const int64_t c = a[i * dimension + k];
+			sum += static_cast<uint64_t>(c * c);
+		}
+		out[i] = sum;
+	}
+}
+
+void math::IntVectorTool::length(const int* a, const size_t dimension, uint32_t* out, const size_t count)
+{
+	constexpr size_t block = 256;
+	uint64_t squared[block];
+	for (size_t first(0); first < count; first += block)
+	{
+		const size_t n = std::min(block, count - first);
+		squaredLength(a + first * dimension, dimension, squared, n);
+		isqrt(squared, out + first, n);
+	}
+}
+
+void math::IntVectorTool::manhattanDistance(const int* a, const int* b, const size_t dimension, uint64_t* out,
+	const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	i = reduce(dimension, count, out, [a, b](const size_t offset, __m128i& even, __m128i& odd)
+	{
+		widen(absDifference(load(a + offset), load(b + offset)), even, odd);
+	});
+#endif
+	for (; i < count; ++i)
+	{
+		uint64_t sum(0);
+		for (size_t k(0); k < dimension; ++k)
+		{
+			sum += absDifference(a[i * dimension + k], b[i * dimension + k]);
+		}
+		out[i] = sum;
+	}
+}
+
+void math::IntVectorTool::chebyshevDistance(const int* a, const int* b, const size_t dimension, uint32_t* out,
+	const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	alignas(16) uint32_t lanes[4];
+	if (2 == dimension)
+	{
+		for (; i + 2 <= count; i += 2)
+		{
+			const __m128i d = absDifference(load(a + 2 * i), load(b + 2 * i));
+			const __m128i m = maxUnsigned(d, _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 3, 0, 1)));
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), m);
+			out[i] = lanes[0];
+			out[i + 1] = lanes[2];
+		}
+	}
+	else if (4 == dimension)
+	{
+		for (; i < count; ++i)
+		{
+			const __m128i d = absDifference(load(a + 4 * i), load(b + 4 * i));
+			const __m128i m = maxUnsigned(d, _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+			out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(maxUnsigned(m,
+				_mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)))));
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		uint32_t result(0);
+		for (size_t k(0); k < dimension; ++k)
+		{
+			result = std::max(result, absDifference(a[i * dimension + k], b[i * dimension + k]));
+		}
+		out[i] = result;
+	}
+}
+
+uint32_t math::IntVectorTool::isqrt(const uint64_t v)
+{
+	// v < 2^52 时 double 精确表示 v，正确舍入的平方根截断即为 floor(sqrt(v))
+	if (v < s_exactLimit)
+	{
+		return static_cast<uint32_t>(std::sqrt(static_cast<double>(v)));
+	}
+
+	// 否则浮点平方根给出初值（误差至多 1），再用整数运算修正
+	uint64_t r = std::min<uint64_t>(static_cast<uint64_t>(std::sqrt(static_cast<double>(v))), 0xffffffffull);
+	while (r * r > v)
+	{
+		--r;
+	}
+	while (r < 0xffffffffull && (r + 1) * (r + 1) <= v)
+	{
+		++r;
+	}
+	return static_cast<uint32_t>(r);
+}
+
+void math::IntVectorTool::isqrt(const uint64_t* in, uint32_t* out, const size_t count)
+{
+	size_t i(0);
+#ifdef MATH_SIMD_SSE2
+	// SSE2 没有 64 位整数转 double：把 v 写入 2^52 的尾数再减去 2^52，要求 v < 2^52
+	const __m128i exponent = _mm_set1_epi64x(0x4330000000000000ll);
+	const __m128d offset = _mm_set1_pd(4503599627370496.0);
+	for (; i + 2 <= count; i += 2)
+	{
+		if (in[i] >= s_exactLimit || in[i + 1] >= s_exactLimit)
+		{
+			out[i] = isqrt(in[i]);
+			out[i + 1] = isqrt(in[i + 1]);
+			continue;
+		}
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		const __m128d d = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(v, exponent)), offset);
+		const __m128i r = _mm_cvttpd_epi32(_mm_sqrt_pd(d));
+		out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(r));
+		out[i + 1] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(r, 4)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = isqrt(in[i]);
+	}
+}
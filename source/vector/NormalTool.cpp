@@ -0,0 +1,419 @@
+#include "vector/NormalTool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#ifdef MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	/*!
+	 * 八面体编码参数：每轴 bits 位，码值取 [0, 2 * half]，解码值为 (code - half) / half
+	 */
+	struct Octahedral
+	{
+		int bits;
+		float half;
+		float inverseHalf;
+		float lastFloor;
+	};
+
+	bool isOctahedral(const math::NormalEncoding encoding)
+	{
+		return math::NormalEncoding::Octahedral16 == encoding || math::NormalEncoding::Octahedral24 == encoding
+			|| math::NormalEncoding::Octahedral32 == encoding;
+	}
+
+	Octahedral octahedral(const math::NormalEncoding encoding)
+	{
+		const int bits = math::NormalEncoding::Octahedral16 == encoding ? 8
+			: (math::NormalEncoding::Octahedral24 == encoding ? 12 : 16);
+		const float half = static_cast<float>((1 << (bits - 1)) - 1);
+		return { bits, half, 1.f / half, 2.f * half - 1.f };
+	}
+
+	inline void store(uint8_t* out, const uint32_t value, const size_t size)
+	{
+		for (size_t k(0); k < size; ++k)
+		{
+			out[k] = static_cast<uint8_t>(value >> (8 * k));
+		}
+	}
+
+	inline uint32_t load(const uint8_t* in, const size_t size)
+	{
+		uint32_t value(0);
+		for (size_t k(0); k < size; ++k)
+		{
+			value |= static_cast<uint32_t>(in[k]) << (8 * k);
+		}
+		return value;
+	}
+
+	// 以下标量函数的运算顺序与 SSE 路径逐条对应，两条路径结果逐位相同
+
+	inline void octahedralUnfold(const float a, const float b, float& x, float& y, float& z)
+	{
+		x = a;
+		y = b;
+		z = (1.f - std::fabs(a)) - std::fabs(b);
+		if (z < 0.f)
+		{
+			x = (1.f - std::fabs(b)) * std::copysign(1.f, a);
+			y = (1.f - std::fabs(a)) * std::copysign(1.f, b);
+		}
+	}
+
+	uint32_t encodeOctahedral(const float* n, const Octahedral& oct)
+	{
+		const float l1 = (std::fabs(n[0]) + std::fabs(n[1])) + std::fabs(n[2]);
+		const float inverse = 1.f / l1;
+		float u = n[0] * inverse;
+		float v = n[1] * inverse;
+		if (n[2] < 0.f)
+		{
+			const float au = std::fabs(u);
+			u = (1.f - std::fabs(v)) * std::copysign(1.f, u);
+			v = (1.f - au) * std::copysign(1.f, v);
+		}
+		// 零向量、含无穷大或 NaN 的向量投影到中心 (0, 0)，即 +z；无穷大时 u、v 为 NaN，转整数前必须替换
+		if (!(std::isfinite(l1) && l1 > 0.f))
+		{
+			u = 0.f;
+			v = 0.f;
+		}
+
+		const float fu = std::trunc(std::min(std::max(u * oct.half + oct.half, 0.f), oct.lastFloor));
+		const float fv = std::trunc(std::min(std::max(v * oct.half + oct.half, 0.f), oct.lastFloor));
+
+		// 在相邻 4 个量化点中取解码方向与输入夹角最小的一个；用 |n x d|^2 / |d|^2 比较，
+		// 小角度下余弦在 float 中已无法区分相邻量化点，正弦平方仍有足够的相对精度
+		float bestU = fu, bestV = fv, bestError = 0.f;
+		for (int k(0); k < 4; ++k)
+		{
+			const float cu = fu + static_cast<float>(k & 1);
+			const float cv = fv + static_cast<float>(k >> 1);
+			float x, y, z;
+			octahedralUnfold((cu - oct.half) * oct.inverseHalf, (cv - oct.half) * oct.inverseHalf, x, y, z);
+			const float cx = n[1] * z - n[2] * y;
+			const float cy = n[2] * x - n[0] * z;
+			const float cz = n[0] * y - n[1] * x;
+			const float error = ((cx * cx + cy * cy) + cz * cz) / ((x * x + y * y) + z * z);
+			if (0 == k || error < bestError)
+			{
+				bestU = cu;
+				bestV = cv;
+				bestError = error;
+			}
+		}
+		return static_cast<uint32_t>(bestU) | (static_cast<uint32_t>(bestV) << oct.bits);
+	}
+
+	void decodeOctahedral(const uint32_t code, const Octahedral& oct, float* n)
+	{
+		const uint32_t mask = (1u << oct.bits) - 1;
+		const float cu = static_cast<float>(static_cast<int32_t>(code & mask));
+		const float cv = static_cast<float>(static_cast<int32_t>((code >> oct.bits) & mask));
+		float x, y, z;
+		octahedralUnfold((cu - oct.half) * oct.inverseHalf, (cv - oct.half) * oct.inverseHalf, x, y, z);
+		const float inverse = 1.f / std::sqrt((x * x + y * y) + z * z);
+		n[0] = x * inverse;
+		n[1] = y * inverse;
+		n[2] = z * inverse;
+	}
+
+#ifdef MATH_SIMD_SSE2
+	inline __m128 absolute(const __m128 v)
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), v);
+	}
+
+	inline __m128 signOf(const __m128 v)
+	{
+		return _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.f)), _mm_set1_ps(1.f));
+	}
+
+	inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	inline void octahedralUnfold(const __m128 a, const __m128 b, __m128& x, __m128& y, __m128& z)
+	{
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 absA = absolute(a);
+		const __m128 absB = absolute(b);
+		z = _mm_sub_ps(_mm_sub_ps(one, absA), absB);
+		const __m128 folded = _mm_cmplt_ps(z, _mm_setzero_ps());
+		x = select(folded, _mm_mul_ps(_mm_sub_ps(one, absB), signOf(a)), a);
+		y = select(folded, _mm_mul_ps(_mm_sub_ps(one, absA), signOf(b)), b);
+	}
+
+	// 4 个交错存储的 xyz 转为 x、y、z 三组
+	inline void loadNormals(const float* xyz, __m128& x, __m128& y, __m128& z)
+	{
+		const __m128 m0 = _mm_loadu_ps(xyz);
+		const __m128 m1 = _mm_loadu_ps(xyz + 4);
+		const __m128 m2 = _mm_loadu_ps(xyz + 8);
+		x = _mm_shuffle_ps(m0, _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 0, 1, 1)),
+			_mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 1, 2, 2)), m2, _MM_SHUFFLE(3, 0, 2, 0));
+	}
+
+	inline void storeNormals(const __m128 x, const __m128 y, const __m128 z, float* xyz)
+	{
+		const __m128 xyLow = _mm_unpacklo_ps(x, y);
+		const __m128 xyHigh = _mm_unpackhi_ps(x, y);
+		const __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+		const __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 zxy = _mm_shuffle_ps(z, xyHigh, _MM_SHUFFLE(3, 2, 3, 2));
+		_mm_storeu_ps(xyz, _mm_shuffle_ps(xyLow, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+		_mm_storeu_ps(xyz + 4, _mm_shuffle_ps(yz, xyHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+		_mm_storeu_ps(xyz + 8, _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(1, 3, 2, 0)));
+	}
+
+	__m128i encodeOctahedral4(const float* xyz, const Octahedral& oct)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 half = _mm_set1_ps(oct.half);
+		const __m128 inverseHalf = _mm_set1_ps(oct.inverseHalf);
+		const __m128 lastFloor = _mm_set1_ps(oct.lastFloor);
+
+		__m128 nx, ny, nz;
+		loadNormals(xyz, nx, ny, nz);
+		const __m128 l1 = _mm_add_ps(_mm_add_ps(absolute(nx), absolute(ny)), absolute(nz));
+		const __m128 inverse = _mm_div_ps(one, l1);
+		__m128 u = _mm_mul_ps(nx, inverse);
+		__m128 v = _mm_mul_ps(ny, inverse);
+		const __m128 lower = _mm_cmplt_ps(nz, zero);
+		const __m128 foldedU = _mm_mul_ps(_mm_sub_ps(one, absolute(v)), signOf(u));
+		const __m128 foldedV = _mm_mul_ps(_mm_sub_ps(one, absolute(u)), signOf(v));
+		u = select(lower, foldedU, u);
+		v = select(lower, foldedV, v);
+		const __m128 valid = _mm_and_ps(_mm_cmpgt_ps(l1, zero),
+			_mm_cmplt_ps(l1, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+		u = _mm_and_ps(valid, u);
+		v = _mm_and_ps(valid, v);
+
+		const __m128 fu = _mm_cvtepi32_ps(_mm_cvttps_epi32(
+			_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(u, half), half), zero), lastFloor)));
+		const __m128 fv = _mm_cvtepi32_ps(_mm_cvttps_epi32(
+			_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(v, half), half), zero), lastFloor)));
+
+		__m128 bestU = fu, bestV = fv, bestError = zero;
+		for (int k(0); k < 4; ++k)
+		{
+			const __m128 cu = _mm_add_ps(fu, _mm_set1_ps(static_cast<float>(k & 1)));
+			const __m128 cv = _mm_add_ps(fv, _mm_set1_ps(static_cast<float>(k >> 1)));
+			__m128 x, y, z;
+			octahedralUnfold(_mm_mul_ps(_mm_sub_ps(cu, half), inverseHalf), _mm_mul_ps(_mm_sub_ps(cv, half), inverseHalf),
+				x, y, z);
+			const __m128 cx = _mm_sub_ps(_mm_mul_ps(ny, z), _mm_mul_ps(nz, y));
+			const __m128 cy = _mm_sub_ps(_mm_mul_ps(nz, x), _mm_mul_ps(nx, z));
+			const __m128 cz = _mm_sub_ps(_mm_mul_ps(nx, y), _mm_mul_ps(ny, x));
+			const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			const __m128 error = _mm_div_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz)), len2);
+			const __m128 better = 0 == k ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_cmplt_ps(error, bestError);
+			bestU = select(better, cu, bestU);
+			bestV = select(better, cv, bestV);
+			bestError = select(better, error, bestError);
+		}
+		return _mm_or_si128(_mm_cvttps_epi32(bestU), _mm_slli_epi32(_mm_cvttps_epi32(bestV), oct.bits));
+	}
+
+	void decodeOctahedral4(const __m128i code, const Octahedral& oct, float* xyz)
+	{
+		const __m128 half = _mm_set1_ps(oct.half);
+		const __m128 inverseHalf = _mm_set1_ps(oct.inverseHalf);
+		const __m128i mask = _mm_set1_epi32(static_cast<int>((1u << oct.bits) - 1));
+		const __m128 cu = _mm_cvtepi32_ps(_mm_and_si128(code, mask));
+		const __m128 cv = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(code, oct.bits), mask));
+		__m128 x, y, z;
+		octahedralUnfold(_mm_mul_ps(_mm_sub_ps(cu, half), inverseHalf), _mm_mul_ps(_mm_sub_ps(cv, half), inverseHalf),
+			x, y, z);
+		const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(len2));
+		storeNormals(_mm_mul_ps(x, inverse), _mm_mul_ps(y, inverse), _mm_mul_ps(z, inverse), xyz);
+	}
+#endif
+
+	// 球面 Fibonacci 点集（Keinert 等，Spherical Fibonacci Mapping）
+	// 第 i 个点：z = 1 - (2i + 1) / n，方位角 2 * pi * frac(i / phi)；frac 用 64 位定点整数乘法精确求出
+	constexpr uint64_t s_inverseGolden = 0x9E3779B97F4A7C15ull;
+	constexpr double s_twoPi = 2.0 * std::numbers::pi;
+
+	inline double goldenAngle(const uint64_t i)
+	{
+		return s_twoPi * std::ldexp(static_cast<double>(i * s_inverseGolden), -64);
+	}
+
+	void fibonacciPoint(const uint64_t i, const double n, double* p)
+	{
+		const double z = 1.0 - (2.0 * static_cast<double>(i) + 1.0) / n;
+		const double sinTheta = std::sqrt(std::max(0.0, 1.0 - z * z));
+		const double angle = goldenAngle(i);
+		p[0] = std::cos(angle) * sinTheta;
+		p[1] = std::sin(angle) * sinTheta;
+		p[2] = z;
+	}
+
+	uint32_t encodeFibonacci(const float* n, const double count)
+	{
+		const double x = n[0], y = n[1], z = n[2];
+		const double length = std::sqrt(x * x + y * y + z * z);
+		if (!(length > 0.0) || !std::isfinite(length))
+		{
+			return 0;
+		}
+		const double p[3] = { x / length, y / length, z / length };
+
+		// 在 (方位角, z) 平面上，点集是以 F(k)、F(k+1) 为基的格，k 由所在纬度的点密度决定
+		const double golden = std::numbers::phi;
+		const double sqrt5 = std::sqrt(5.0);
+		const double cosTheta = p[2];
+		const double k = std::max(2.0, std::floor(std::log(count * std::numbers::pi * sqrt5 * (1.0 - cosTheta * cosTheta))
+			/ std::log(golden * golden)));
+		const double fk = std::pow(golden, k) / sqrt5;
+		const double f0 = std::round(fk);
+		const double f1 = std::round(fk * golden);
+		const double offset = s_twoPi * (golden - 1.0);
+		const double b00 = goldenAngle(static_cast<uint64_t>(f0) + 1) - offset;
+		const double b01 = goldenAngle(static_cast<uint64_t>(f1) + 1) - offset;
+		const double b10 = -2.0 * f0 / count;
+		const double b11 = -2.0 * f1 / count;
+		const double determinant = b00 * b11 - b01 * b10;
+		const double rx = std::atan2(p[1], p[0]);
+		const double ry = cosTheta - (1.0 - 1.0 / count);
+		const double c0 = std::floor((b11 * rx - b01 * ry) / determinant);
+		const double c1 = std::floor((b00 * ry - b10 * rx) / determinant);
+
+		// 格单元的 4 个角中取最近的点
+		double best = std::numeric_limits<double>::infinity();
+		uint32_t index(0);
+		for (int s(0); s < 4; ++s)
+		{
+			const double i = std::clamp(f0 * (c0 + (s & 1)) + f1 * (c1 + (s >> 1)), 0.0, count - 1.0);
+			double q[3];
+			fibonacciPoint(static_cast<uint64_t>(i), count, q);
+			const double d = (q[0] - p[0]) * (q[0] - p[0]) + (q[1] - p[1]) * (q[1] - p[1]) + (q[2] - p[2]) * (q[2] - p[2]);
+			if (d < best)
+			{
+				best = d;
+				index = static_cast<uint32_t>(i);
+			}
+		}
+		return index;
+	}
+
+	double fibonacciCount(const math::NormalEncoding encoding)
+	{
+		return math::NormalEncoding::Fibonacci16 == encoding ? 65536.0
+			: (math::NormalEncoding::Fibonacci24 == encoding ? 16777216.0 : 4294967296.0);
+	}
+}
+
+size_t math::NormalTool::encodedSize(const NormalEncoding encoding)
+{
+	switch (encoding)
+	{
+	case NormalEncoding::Octahedral16:
+	case NormalEncoding::Fibonacci16:
+		return 2;
+	case NormalEncoding::Octahedral24:
+	case NormalEncoding::Fibonacci24:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+double math::NormalTool::maxAngularError(const NormalEncoding encoding)
+{
+	switch (encoding)
+	{
+	case NormalEncoding::Octahedral16:
+		return 1.15e-2;
+	case NormalEncoding::Octahedral24:
+		return 7.0e-4;
+	case NormalEncoding::Octahedral32:
+		return 4.5e-5;
+	case NormalEncoding::Fibonacci16:
+		return 1.05e-2;
+	case NormalEncoding::Fibonacci24:
+		return 6.3e-4;
+	default:
+		return 4.3e-5;
+	}
+}
+
+void math::NormalTool::encode(const float* xyz, const size_t count, uint8_t* out, const NormalEncoding encoding)
+{
+	const size_t size = encodedSize(encoding);
+	size_t i(0);
+	if (!isOctahedral(encoding))
+	{
+		const double points = fibonacciCount(encoding);
+		for (; i < count; ++i)
+		{
+			store(out + size * i, encodeFibonacci(xyz + 3 * i, points), size);
+		}
+		return;
+	}
+
+	const Octahedral oct = octahedral(encoding);
+#ifdef MATH_SIMD_SSE2
+	alignas(16) uint32_t codes[4];
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_store_si128(reinterpret_cast<__m128i*>(codes), encodeOctahedral4(xyz + 3 * i, oct));
+		for (size_t k(0); k < 4; ++k)
+		{
+			store(out + size * (i + k), codes[k], size);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		store(out + size * i, encodeOctahedral(xyz + 3 * i, oct), size);
+	}
+}
+
+void math::NormalTool::decode(const uint8_t* in, const size_t count, float* xyz, const NormalEncoding encoding)
+{
+	const size_t size = encodedSize(encoding);
+	size_t i(0);
+	if (!isOctahedral(encoding))
+	{
+		const double points = fibonacciCount(encoding);
+		for (; i < count; ++i)
+		{
+			double p[3];
+			fibonacciPoint(load(in + size * i, size), points, p);
+			xyz[3 * i] = static_cast<float>(p[0]);
+			xyz[3 * i + 1] = static_cast<float>(p[1]);
+			xyz[3 * i + 2] = static_cast<float>(p[2]);
+		}
+		return;
+	}
+
+	const Octahedral oct = octahedral(encoding);
+#ifdef MATH_SIMD_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i code = _mm_setr_epi32(static_cast<int>(load(in + size * i, size)),
+			static_cast<int>(load(in + size * (i + 1), size)), static_cast<int>(load(in + size * (i + 2), size)),
+			static_cast<int>(load(in + size * (i + 3), size)));
+		decodeOctahedral4(code, oct, xyz + 3 * i);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		decodeOctahedral(load(in + size * i, size), oct, xyz + 3 * i);
+	}
+}
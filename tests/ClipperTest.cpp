@@ -0,0 +1,170 @@
+#include "TestCommon.h"
+#include "render/TClipper.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	using Clipper = TClipper<float>;
+	using Vector4 = TVector4<float>;
+	using Vector3 = TVector3<float>;
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	// 输出顶点数不超过上界，w >= 0，重心坐标有限且和约为 1
+	bool validPolygon(const Vector4* positions, const Vector3* barycentrics, const size_t count)
+	{
+		if (count > Clipper::s_maxVertices || (0 != count && count < 3))
+		{
+			return false;
+		}
+		for (size_t i(0); i < count; ++i)
+		{
+			const float sum = barycentrics[i].x() + barycentrics[i].y() + barycentrics[i].z();
+			if (!(positions[i].w() >= 0.f) || !(std::abs(sum - 1.f) < 1e-3f))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 所有平面在 w = 0 处交于原点，原点附近的近退化三角形上内外符号会因舍入交替，输出超过 3 + 6 个顶点
+	void testNearDegenerateOverflow()
+	{
+		const Clipper clipper;
+		const Vector4 a(-0x1.5e9524p-5f, -0x1.c7599ap-5f, 0x1.0801c8p-5f, 0x1.a5fap-8f);
+		const Vector4 b(0x1.703784p-13f, 0x1.dfc50cp-13f, -0x1.145baap-13f, 0x1.f4c4fcp-13f);
+		const Vector4 c(-0x1.53540cp-37f, -0x1.361c2p-38f, 0x1.613d0cp-36f, -0x1.e7215cp-36f);
+
+		Vector4 positions[Clipper::s_maxVertices];
+		Vector3 barycentrics[Clipper::s_maxVertices];
+		const size_t count = clipper.clipTriangle(a, b, c, positions, barycentrics);
+		CHECK(count > 9);
+		CHECK(validPolygon(positions, barycentrics, count));
+	}
+
+	void testRandomNearDegenerate()
+	{
+		const Clipper clipper;
+		Vector4 positions[Clipper::s_maxVertices];
+		Vector3 barycentrics[Clipper::s_maxVertices];
+		uint32_t state = 2024;
+		size_t invalid(0);
+		for (int t(0); t < 200000; ++t)
+		{
+			Vector4 v[3];
+			for (Vector4& p : v)
+			{
+				const float scale = std::ldexp(1.f, -static_cast<int>(nextRandom(state) % 40));
+				float c[4];
+				for (float& value : c)
+				{
+					value = (nextRandom(state) / 8388608.f - 1.f) * scale;
+				}
+				p.set(c[0], c[1], c[2], c[3]);
+			}
+			invalid += !validPolygon(positions, barycentrics, clipper.clipTriangle(v[0], v[1], v[2], positions, barycentrics));
+		}
+		CHECK(0 == invalid);
+	}
+
+	// 批量接口（float 下 SSE2 计算 outcode）与逐个 clipTriangle（标量 outcode）逐位一致
+	void testBatchMatchesSingle()
+	{
+		uint32_t state = 7;
+		std::vector<Vector4> vertices;
+		for (int i(0); i < 1001; ++i)
+		{
+			float c[4];
+			for (float& value : c)
+			{
+				value = (nextRandom(state) / 8388608.f - 1.f) * 3.f;
+			}
+			vertices.emplace_back(c[0], c[1], c[2], std::abs(c[3]) + (0 == i % 7 ? -1.f : 0.25f));
+		}
+		std::vector<uint32_t> indices;
+		for (uint32_t i(0); i + 2 < vertices.size(); ++i)
+		{
+			indices.insert(indices.end(), { i, i + 1, i + 2 });
+		}
+
+		for (const ClipDepth depth : { ClipDepth::NegativeOneToOne, ClipDepth::ZeroToOne })
+		{
+			for (const float guardBand : { 1.f, 2.5f })
+			{
+				Clipper clipper(depth, guardBand);
+				TClipResult<float> result;
+				clipper.clip(vertices.data(), vertices.size(), indices.data(), indices.size() / 3, result);
+
+				size_t output(0), mismatches(0);
+				for (size_t t(0); t < indices.size() / 3; ++t)
+				{
+					Vector4 positions[Clipper::s_maxVertices];
+					Vector3 barycentrics[Clipper::s_maxVertices];
+					const size_t count = clipper.clipTriangle(vertices[indices[3 * t]], vertices[indices[3 * t + 1]],
+						vertices[indices[3 * t + 2]], positions, barycentrics);
+					for (size_t k(1); k + 1 < count; ++k, ++output)
+					{
+						if (output >= result.triangles.size())
+						{
+							++mismatches;
+							continue;
+						}
+						const size_t order[3] = { 0, k, k + 1 };
+						for (size_t j(0); j < 3; ++j)
+						{
+							const Vector4& p = result.positions[3 * output + j];
+							const Vector4& q = positions[order[j]];
+							mismatches += !(p.x() == q.x() && p.y() == q.y() && p.z() == q.z() && p.w() == q.w());
+						}
+						mismatches += t != result.triangles[output];
+					}
+				}
+				CHECK(output == result.triangles.size());
+				CHECK(0 == mismatches);
+			}
+		}
+	}
+
+	void testTrivialCases()
+	{
+		const Clipper clipper;
+		Vector4 positions[Clipper::s_maxVertices];
+		Vector3 barycentrics[Clipper::s_maxVertices];
+
+		// 全在视锥内：原样输出
+		CHECK(3 == clipper.clipTriangle(Vector4(0.f, 0.f, 0.f, 1.f), Vector4(0.5f, 0.f, 0.f, 1.f),
+			Vector4(0.f, 0.5f, 0.f, 1.f), positions, barycentrics));
+		CHECK(1.f == barycentrics[0].x() && 1.f == barycentrics[1].y() && 1.f == barycentrics[2].z());
+
+		// 全在同一平面外侧：剔除
+		CHECK(0 == clipper.clipTriangle(Vector4(2.f, 0.f, 0.f, 1.f), Vector4(3.f, 0.f, 0.f, 1.f),
+			Vector4(2.f, 1.f, 0.f, 1.f), positions, barycentrics));
+
+		// 跨近平面：裁成四边形，全部 z >= -w
+		const size_t count = clipper.clipTriangle(Vector4(0.f, 0.f, -2.f, 1.f), Vector4(0.5f, 0.f, 0.f, 1.f),
+			Vector4(0.f, 0.5f, 0.f, 1.f), positions, barycentrics);
+		CHECK(4 == count);
+		for (size_t i(0); i < count; ++i)
+		{
+			CHECK(positions[i].z() >= -positions[i].w());
+		}
+	}
+}
+
+int main()
+{
+	testNearDegenerateOverflow();
+	testRandomNearDegenerate();
+	testBatchMatchesSingle();
+	testTrivialCases();
+	return test::report("ClipperTest");
+}
@@ -0,0 +1,110 @@
+#include "TestCommon.h"
+#include "render/ColorTool.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 批量接口的前 4k 个元素走 SSE2，其余走标量尾部；逐个调用（count = 1）总走标量
+	void testBatchMatchesScalar()
+	{
+		std::vector<float> rgba;
+		for (int i(0); i < 1024; ++i)
+		{
+			rgba.push_back((i % 511) / 510.f);
+		}
+		// 恰好落在 .5 上的值：四舍五入应向上，与位置无关
+		for (const float v : { 0.5f / 255.f, 2.5f / 255.f, 128.5f / 255.f, -1.f, 2.f,
+			std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -0.f })
+		{
+			rgba.push_back(v);
+		}
+		while (0 != rgba.size() % 4)
+		{
+			rgba.push_back(0.25f);
+		}
+		const size_t count = rgba.size() / 4;
+
+		for (const ColorSpace space : { ColorSpace::Linear, ColorSpace::SRGB })
+		{
+			for (const PixelFormat format : { PixelFormat::RGBA8, PixelFormat::BGRA8 })
+			{
+				std::vector<uint8_t> batch(4 * count);
+				ColorTool::packColors(rgba.data(), count, batch.data(), format, space);
+				for (size_t i(0); i < count; ++i)
+				{
+					uint8_t single[4];
+					ColorTool::packColors(rgba.data() + 4 * i, 1, single, format, space);
+					for (int k(0); k < 4; ++k)
+					{
+						CHECK(single[k] == batch[4 * i + k]);
+					}
+				}
+			}
+		}
+	}
+
+	void testRoundHalfUp()
+	{
+		const float rgba[8] = { 0.5f / 255.f, 2.5f / 255.f, 128.5f / 255.f, 1.f,
+			0.5f / 255.f, 2.5f / 255.f, 128.5f / 255.f, 1.f };
+		uint8_t pixels[8];
+		ColorTool::packColors(rgba, 2, pixels, PixelFormat::RGBA8, ColorSpace::Linear);
+		for (int i(0); i < 2; ++i)
+		{
+			CHECK(1 == pixels[4 * i]);
+			CHECK(3 == pixels[4 * i + 1]);
+			CHECK(129 == pixels[4 * i + 2]);
+			CHECK(255 == pixels[4 * i + 3]);
+		}
+	}
+
+	void testNonFinite()
+	{
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		const float inf = std::numeric_limits<float>::infinity();
+		const float rgba[16] = { nan, inf, -inf, nan, nan, inf, -inf, nan, nan, inf, -inf, nan, nan, inf, -inf, nan };
+		uint8_t pixels[16];
+		ColorTool::packColors(rgba, 4, pixels, PixelFormat::RGBA8, ColorSpace::Linear);
+		for (int i(0); i < 4; ++i)
+		{
+			CHECK(0 == pixels[4 * i]);
+			CHECK(255 == pixels[4 * i + 1]);
+			CHECK(0 == pixels[4 * i + 2]);
+			CHECK(0 == pixels[4 * i + 3]);
+		}
+	}
+
+	void testRoundTrip()
+	{
+		std::vector<uint8_t> pixels(4 * 256);
+		for (int i(0); i < 256; ++i)
+		{
+			for (int k(0); k < 4; ++k)
+			{
+				pixels[4 * i + k] = static_cast<uint8_t>(i);
+			}
+		}
+		for (const ColorSpace space : { ColorSpace::Linear, ColorSpace::SRGB })
+		{
+			std::vector<float> rgba(4 * 256);
+			std::vector<uint8_t> back(4 * 256);
+			ColorTool::unpackColors(pixels.data(), 256, rgba.data(), PixelFormat::BGRA8, space);
+			ColorTool::packColors(rgba.data(), 256, back.data(), PixelFormat::BGRA8, space);
+			CHECK(back == pixels);
+		}
+	}
+}
+
+int main()
+{
+	testBatchMatchesScalar();
+	testRoundHalfUp();
+	testNonFinite();
+	testRoundTrip();
+	return test::report("ColorToolTest");
+}
@@ -0,0 +1,199 @@
+#include "TestCommon.h"
+#include "geometry/TConvexHull.hpp"
+#include "geometry/Predicates.h"
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	using Hull = TConvexHull<double>;
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	// 每个三角形从外侧看逆时针：所有点都不在任何面的外侧（orient3d < 0），且每条有向边恰好有一条反向边
+	void checkClosedHull(const std::vector<TVector3<double>>& points, const std::vector<uint32_t>& triangles)
+	{
+		CHECK(!triangles.empty() && 0 == triangles.size() % 3);
+
+		std::map<std::pair<uint32_t, uint32_t>, int> edges;
+		std::set<uint32_t> vertices;
+		size_t outsidePoints(0);
+		for (size_t t(0); t < triangles.size(); t += 3)
+		{
+			const uint32_t v[3] = { triangles[t], triangles[t + 1], triangles[t + 2] };
+			for (int k(0); k < 3; ++k)
+			{
+				++edges[{ v[k], v[(k + 1) % 3] }];
+				vertices.insert(v[k]);
+			}
+			for (const TVector3<double>& q : points)
+			{
+				outsidePoints += Predicates::orient3d(points[v[0]], points[v[1]], points[v[2]], q) < 0.0;
+			}
+		}
+		CHECK(0 == outsidePoints);
+
+		size_t badEdges(0);
+		for (const auto& [edge, uses] : edges)
+		{
+			const auto twin = edges.find({ edge.second, edge.first });
+			badEdges += !(1 == uses && edges.end() != twin && 1 == twin->second);
+		}
+		CHECK(0 == badEdges);
+
+		// 欧拉公式 V - E + F = 2
+		const long faces = static_cast<long>(triangles.size() / 3);
+		CHECK(2 == static_cast<long>(vertices.size()) - static_cast<long>(edges.size() / 2) + faces);
+	}
+
+	// 立方体：角点、棱上、面上与内部的整数格点大量共面共线，只应输出 8 个角点、12 个三角形
+	void testCubeWithCoplanarPoints()
+	{
+		std::vector<TVector3<double>> points;
+		for (int x(0); x <= 4; ++x)
+		{
+			for (int y(0); y <= 4; ++y)
+			{
+				for (int z(0); z <= 4; ++z)
+				{
+					points.emplace_back(x, y, z);
+				}
+			}
+		}
+
+		std::vector<uint32_t> triangles;
+		CHECK(Hull::hull3d(points.data(), points.size(), triangles));
+		CHECK(36 == triangles.size());
+		for (const uint32_t index : triangles)
+		{
+			const TVector3<double>& p = points[index];
+			CHECK((0.0 == p.x() || 4.0 == p.x()) && (0.0 == p.y() || 4.0 == p.y()) && (0.0 == p.z() || 4.0 == p.z()));
+		}
+		checkClosedHull(points, triangles);
+	}
+
+	// 整数点精确落在同一球面上，quickhull 会反复遇到共面与共球的情形
+	void testCospherical()
+	{
+		std::vector<TVector3<double>> points;
+		for (int x(-5); x <= 5; ++x)
+		{
+			for (int y(-5); y <= 5; ++y)
+			{
+				for (int z(-5); z <= 5; ++z)
+				{
+					if (25 == x * x + y * y + z * z)
+					{
+						points.emplace_back(1e3 + x, -1e3 + y, z);
+					}
+				}
+			}
+		}
+
+		std::vector<uint32_t> triangles;
+		CHECK(Hull::hull3d(points.data(), points.size(), triangles));
+		checkClosedHull(points, triangles);
+	}
+
+	// 点数超过分块粒度时走极值点预剔除路径
+	void testLargeBall()
+	{
+		uint32_t state = 12345;
+		std::vector<TVector3<double>> points;
+		while (points.size() < 70000)
+		{
+			const double x = nextRandom(state) / 8388608.0 - 1.0;
+			const double y = nextRandom(state) / 8388608.0 - 1.0;
+			const double z = nextRandom(state) / 8388608.0 - 1.0;
+			if (x * x + y * y + z * z <= 1.0)
+			{
+				points.emplace_back(x, y, z);
+			}
+		}
+
+		std::vector<uint32_t> triangles;
+		CHECK(Hull::hull3d(points.data(), points.size(), triangles));
+
+		// 全量的外侧检查开销过大，只检查抽样点与拓扑
+		std::vector<TVector3<double>> hullPoints;
+		std::vector<uint32_t> remapped;
+		std::map<uint32_t, uint32_t> index;
+		for (const uint32_t v : triangles)
+		{
+			const auto [it, inserted] = index.emplace(v, static_cast<uint32_t>(hullPoints.size()));
+			if (inserted)
+			{
+				hullPoints.push_back(points[v]);
+			}
+			remapped.push_back(it->second);
+		}
+		for (size_t i(0); i < points.size(); i += 997)
+		{
+			hullPoints.push_back(points[i]);
+		}
+		checkClosedHull(hullPoints, remapped);
+	}
+
+	void testDegenerate()
+	{
+		std::vector<uint32_t> triangles;
+		const std::vector<TVector3<double>> planar = { { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 }, { 0.5, 0.25, 1 } };
+		CHECK(!Hull::hull3d(planar.data(), planar.size(), triangles));
+		CHECK(triangles.empty());
+
+		const std::vector<TVector3<double>> line = { { 0, 0, 0 }, { 1, 1, 1 }, { 2, 2, 2 }, { 3, 3, 3 } };
+		CHECK(!Hull::hull3d(line.data(), line.size(), triangles));
+
+		const std::vector<TVector3<double>> same(6, TVector3<double>(1, 2, 3));
+		CHECK(!Hull::hull3d(same.data(), same.size(), triangles));
+		CHECK(!Hull::hull3d(same.data(), 3, triangles));
+	}
+
+	// 正方形边上的共线点不输出，结果逆时针、从最左下点开始
+	void testHull2dCollinear()
+	{
+		std::vector<TVector2<double>> points;
+		for (int x(0); x <= 8; ++x)
+		{
+			for (int y(0); y <= 8; ++y)
+			{
+				points.emplace_back(x, y);
+			}
+		}
+
+		std::vector<uint32_t> hull;
+		Hull::hull2d(points.data(), points.size(), hull);
+		CHECK(4 == hull.size());
+		if (4 == hull.size())
+		{
+			CHECK(0.0 == points[hull[0]].x() && 0.0 == points[hull[0]].y());
+			for (size_t i(0); i < hull.size(); ++i)
+			{
+				const TVector2<double>& a = points[hull[i]];
+				const TVector2<double>& b = points[hull[(i + 1) % 4]];
+				const TVector2<double>& c = points[hull[(i + 2) % 4]];
+				CHECK(Predicates::orient2d(a, b, c) > 0.0);
+			}
+		}
+	}
+}
+
+int main()
+{
+	testCubeWithCoplanarPoints();
+	testCospherical();
+	testLargeBall();
+	testDegenerate();
+	testHull2dCollinear();
+	return test::report("ConvexHullTest");
+}
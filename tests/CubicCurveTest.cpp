@@ -0,0 +1,253 @@
+#include "TestCommon.h"
+#include "geometry/TCubicCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	const CurveBasis s_bases[] = { CurveBasis::Bezier, CurveBasis::CatmullRom, CurveBasis::BSpline };
+
+	struct Random
+	{
+		uint64_t state;
+
+		double next(const double low, const double high)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return low + (high - low) * static_cast<double>(state >> 11) * 0x1.0p-53;
+		}
+	};
+
+	// 直接写出的基函数及其导数，不经过幂基系数
+	void basisWeights(const CurveBasis basis, const double u, double w[4], double dw[4])
+	{
+		const double s = 1.0 - u;
+		switch (basis)
+		{
+		case CurveBasis::Bezier:
+			w[0] = s * s * s; w[1] = 3 * u * s * s; w[2] = 3 * u * u * s; w[3] = u * u * u;
+			dw[0] = -3 * s * s; dw[1] = 3 * s * s - 6 * u * s; dw[2] = 6 * u * s - 3 * u * u; dw[3] = 3 * u * u;
+			break;
+		case CurveBasis::CatmullRom:
+			w[0] = 0.5 * (-u * u * u + 2 * u * u - u);
+			w[1] = 0.5 * (3 * u * u * u - 5 * u * u + 2);
+			w[2] = 0.5 * (-3 * u * u * u + 4 * u * u + u);
+			w[3] = 0.5 * (u * u * u - u * u);
+			dw[0] = 0.5 * (-3 * u * u + 4 * u - 1);
+			dw[1] = 0.5 * (9 * u * u - 10 * u);
+			dw[2] = 0.5 * (-9 * u * u + 8 * u + 1);
+			dw[3] = 0.5 * (3 * u * u - 2 * u);
+			break;
+		default:
+			w[0] = s * s * s / 6; w[1] = (3 * u * u * u - 6 * u * u + 4) / 6;
+			w[2] = (-3 * u * u * u + 3 * u * u + 3 * u + 1) / 6; w[3] = u * u * u / 6;
+			dw[0] = -s * s / 2; dw[1] = (9 * u * u - 12 * u) / 6; dw[2] = (-9 * u * u + 6 * u + 3) / 6; dw[3] = u * u / 2;
+			break;
+		}
+	}
+
+	template <typename Vector>
+	std::vector<Vector> randomPoints(Random& random, const size_t count)
+	{
+		std::vector<Vector> points(count);
+		for (Vector& point : points)
+		{
+			for (size_t c(0); c < TVectorTraits<Vector>::s_size; ++c)
+			{
+				point.data()[c] = static_cast<typename TVectorTraits<Vector>::Scalar>(random.next(-10, 10));
+			}
+		}
+		return points;
+	}
+
+	// 段 segment 在 u 处的双精度参照值
+	template <typename Vector>
+	double curveReference(const CurveBasis basis, const std::vector<Vector>& points, const size_t segment,
+		const double u, const size_t component)
+	{
+		double w[4], dw[4];
+		basisWeights(basis, u, w, dw);
+		const size_t first = segment * (CurveBasis::Bezier == basis ? 3 : 1);
+		double value(0.0);
+		for (size_t k(0); k < 4; ++k)
+		{
+			value += w[k] * static_cast<double>(points[first + k].data()[component]);
+		}
+		return value;
+	}
+
+	// 前向差分细分、单点求值与批量求值都与双精度基函数参照一致
+	template <typename Vector>
+	void testCurve(const double tolerance)
+	{
+		using Scalar = typename TVectorTraits<Vector>::Scalar;
+		constexpr size_t dimension = TVectorTraits<Vector>::s_size;
+		Random random{ 3u + dimension };
+		for (const CurveBasis basis : s_bases)
+		{
+			const std::vector<Vector> points = randomPoints<Vector>(random, 13);
+			TCubicCurve<Vector> curve;
+			CHECK(curve.set(basis, points.data(), points.size()));
+			const size_t segments = CurveBasis::Bezier == basis ? 4 : 10;
+			CHECK(segments == curve.segmentCount());
+
+			for (const size_t steps : { size_t(1), size_t(7), size_t(64) })
+			{
+				std::vector<Vector> tessellated(segments * steps + 1);
+				CHECK(tessellated.size() == curve.tessellate(steps, tessellated.data()));
+
+				std::vector<Scalar> parameters(tessellated.size());
+				for (size_t i(0); i < parameters.size(); ++i)
+				{
+					parameters[i] = static_cast<Scalar>(static_cast<double>(i) / static_cast<double>(steps));
+				}
+				std::vector<Vector> batch(parameters.size());
+				curve.evaluate(parameters.data(), parameters.size(), batch.data());
+
+				double error(0.0);
+				for (size_t i(0); i < tessellated.size(); ++i)
+				{
+					// 每段末点属于下一段的起点，最后一个点为末段 u = 1
+					const size_t segment = std::min(i / steps, segments - 1);
+					const double u = static_cast<double>(i - segment * steps) / static_cast<double>(steps);
+					const Vector single = curve.evaluate(parameters[i]);
+					for (size_t c(0); c < dimension; ++c)
+					{
+						const double expected = curveReference(basis, points, segment, u, c);
+						error = std::max(error, std::abs(static_cast<double>(tessellated[i].data()[c]) - expected));
+						error = std::max(error, std::abs(static_cast<double>(single.data()[c]) - expected));
+						error = std::max(error, std::abs(static_cast<double>(batch[i].data()[c]) - expected));
+					}
+				}
+				CHECK(error < tolerance);
+			}
+		}
+	}
+
+	// 控制点数不合法时曲线置空
+	void testInvalidCurve()
+	{
+		Random random{ 5u };
+		const std::vector<TVector3<float>> points = randomPoints<TVector3<float>>(random, 6);
+		TCubicCurve<TVector3<float>> curve;
+		CHECK(!curve.set(CurveBasis::Bezier, points.data(), 6));
+		CHECK(curve.empty());
+		CHECK(!curve.set(CurveBasis::BSpline, points.data(), 3));
+		CHECK(0 == curve.tessellate(8, nullptr));
+		CHECK(curve.set(CurveBasis::Bezier, points.data(), 4));
+		CHECK(0 == curve.tessellate(0, nullptr));
+	}
+
+	// 共线等距的 Bezier 控制点为匀速直线：弧长精确，等弧长采样等距
+	void testArcLength()
+	{
+		std::vector<TVector2<double>> points;
+		for (size_t i(0); i < 7; ++i)
+		{
+			points.emplace_back(3.0 * static_cast<double>(i), 4.0 * static_cast<double>(i));
+		}
+		TCubicCurve<TVector2<double>> curve;
+		CHECK(curve.set(CurveBasis::Bezier, points.data(), points.size()));
+		CHECK(0.0 == curve.length());
+		curve.buildArcLengthTable(16);
+		CHECK(std::abs(curve.length() - 30.0) < 1e-12);
+		CHECK(std::abs(curve.parameterAtLength(7.5) - 0.5) < 1e-12);
+
+		std::vector<TVector2<double>> samples(11);
+		curve.sampleUniform(samples.size(), samples.data());
+		double error(0.0);
+		for (size_t i(0); i < samples.size(); ++i)
+		{
+			error = std::max(error, std::abs(samples[i].x() - 1.8 * static_cast<double>(i)));
+			error = std::max(error, std::abs(samples[i].y() - 2.4 * static_cast<double>(i)));
+		}
+		CHECK(error < 1e-12);
+	}
+
+	// 网格顶点与法线和逐点求值、双精度张量积参照一致
+	template <typename Scalar>
+	void testPatch(const double tolerance)
+	{
+		using Vector = TVector3<Scalar>;
+		Random random{ 23u };
+		for (const CurveBasis basis : s_bases)
+		{
+			const std::vector<Vector> points = randomPoints<Vector>(random, 16);
+			TBicubicPatch<Vector> patch;
+			patch.set(basis, points.data());
+
+			const size_t uSteps = 17, vSteps = 9;
+			std::vector<Vector> positions((uSteps + 1) * (vSteps + 1));
+			std::vector<Vector> normals(positions.size());
+			CHECK(positions.size() == patch.tessellate(uSteps, vSteps, positions.data(), normals.data()));
+
+			double error(0.0);
+			for (size_t j(0); j <= vSteps; ++j)
+			{
+				const double v = static_cast<double>(j) / static_cast<double>(vSteps);
+				double wv[4], dwv[4];
+				basisWeights(basis, v, wv, dwv);
+				for (size_t i(0); i <= uSteps; ++i)
+				{
+					const double u = static_cast<double>(i) / static_cast<double>(uSteps);
+					double wu[4], dwu[4];
+					basisWeights(basis, u, wu, dwu);
+					double p[3] = {}, pu[3] = {}, pv[3] = {};
+					for (size_t row(0); row < 4; ++row)
+					{
+						for (size_t col(0); col < 4; ++col)
+						{
+							for (size_t c(0); c < 3; ++c)
+							{
+								const double g = static_cast<double>(points[4 * row + col].data()[c]);
+								p[c] += wv[row] * wu[col] * g;
+								pu[c] += wv[row] * dwu[col] * g;
+								pv[c] += dwv[row] * wu[col] * g;
+							}
+						}
+					}
+					double n[3] = { pu[1] * pv[2] - pu[2] * pv[1], pu[2] * pv[0] - pu[0] * pv[2],
+						pu[0] * pv[1] - pu[1] * pv[0] };
+					const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+					const Vector& position = positions[j * (uSteps + 1) + i];
+					const Vector& normal = normals[j * (uSteps + 1) + i];
+					const Vector single = patch.evaluate(static_cast<Scalar>(u), static_cast<Scalar>(v));
+					for (size_t c(0); c < 3; ++c)
+					{
+						error = std::max(error, std::abs(static_cast<double>(position.data()[c]) - p[c]));
+						error = std::max(error, std::abs(static_cast<double>(single.data()[c]) - p[c]));
+						error = std::max(error, std::abs(static_cast<double>(normal.data()[c]) - n[c] / length));
+					}
+				}
+			}
+			CHECK(error < tolerance);
+		}
+
+		// 所有控制点重合时切向量为零，法线为零向量
+		const std::vector<Vector> flat(16, Vector(Scalar(1), Scalar(2), Scalar(3)));
+		TBicubicPatch<Vector> patch;
+		patch.set(CurveBasis::Bezier, flat.data());
+		std::vector<Vector> positions(9), normals(9);
+		CHECK(9 == patch.tessellate(2, 2, positions.data(), normals.data()));
+		CHECK(Vector(Scalar(0), Scalar(0), Scalar(0)) == normals[4]);
+		CHECK(0 == patch.tessellate(0, 2, positions.data()));
+	}
+}
+
+int main()
+{
+	testCurve<TVector3<float>>(1e-4);
+	testCurve<TVector2<float>>(1e-4);
+	testCurve<TVector<5, float>>(1e-4);
+	testCurve<TVector3<double>>(1e-11);
+	testInvalidCurve();
+	testArcLength();
+	testPatch<float>(1e-4);
+	testPatch<double>(1e-11);
+	return test::report("CubicCurveTest");
+}
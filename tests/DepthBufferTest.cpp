@@ -0,0 +1,323 @@
+#include "TestCommon.h"
+#include "render/DepthBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 宽高不是 tile（8）的整数倍；tile 数超过 updateHierarchy 的并行粒度（256）
+	constexpr size_t s_width = 203;
+	constexpr size_t s_height = 117;
+	constexpr size_t s_tile = DepthBuffer::s_tileSize;
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	float randomUnit(uint32_t& state)
+	{
+		return static_cast<float>(nextRandom(state)) * (1.f / 16777216.f);
+	}
+
+	/*!
+	 * 逐像素的参照深度缓冲，按行存放
+	 */
+	struct Reference
+	{
+		std::vector<float> depths = std::vector<float>(s_width * s_height, 1.f);
+
+		float& at(const size_t x, const size_t y)
+		{
+			return depths[y * s_width + x];
+		}
+
+		float at(const size_t x, const size_t y) const
+		{
+			return depths[y * s_width + x];
+		}
+
+		// 像素矩形 [x0, x1] x [y0, y1] 内的最大深度
+		float maxDepth(const size_t x0, const size_t y0, const size_t x1, const size_t y1) const
+		{
+			float result(0.f);
+			for (size_t y(y0); y <= y1; ++y)
+			{
+				for (size_t x(x0); x <= x1; ++x)
+				{
+					result = std::max(result, at(x, y));
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * @brief 按接口约定逐像素求遮挡：矩形所覆盖的 tile 内所有屏幕内像素都不大于 minDepth
+		 */
+		bool isOccluded(const float minX, const float minY, const float maxX, const float maxY, const float minDepth) const
+		{
+			if (!(minX <= maxX && minY <= maxY))
+			{
+				return false;
+			}
+			if (maxX < 0.f || maxY < 0.f || minX >= s_width || minY >= s_height)
+			{
+				return true;
+			}
+			const size_t x0 = minX > 0.f ? static_cast<size_t>(minX) : 0;
+			const size_t y0 = minY > 0.f ? static_cast<size_t>(minY) : 0;
+			const size_t x1 = maxX < s_width ? static_cast<size_t>(maxX) : s_width - 1;
+			const size_t y1 = maxY < s_height ? static_cast<size_t>(maxY) : s_height - 1;
+			return maxDepth(x0 / s_tile * s_tile, y0 / s_tile * s_tile, std::min(x1 / s_tile * s_tile + s_tile - 1,
+				s_width - 1), std::min(y1 / s_tile * s_tile + s_tile - 1, s_height - 1)) <= minDepth;
+		}
+	};
+
+	// 随机写入行段与 tile，逐像素比较通过结果与存储的深度
+	void randomWrites(DepthBuffer& buffer, Reference& reference, uint32_t& state, const size_t operations,
+		size_t& mismatches)
+	{
+		std::vector<float> depths(s_width + 16);
+		std::vector<uint8_t> pass(depths.size());
+		for (size_t op(0); op < operations; ++op)
+		{
+			const bool write = 0 != nextRandom(state) % 4;
+			const float base = 0.2f + 0.8f * randomUnit(state);
+			if (nextRandom(state) % 2)
+			{
+				const size_t x = nextRandom(state) % (s_width + 4);
+				const size_t y = nextRandom(state) % (s_height + 2);
+				const size_t count = 1 + nextRandom(state) % 40;
+				for (size_t i(0); i < count; ++i)
+				{
+					depths[i] = base + 0.05f * randomUnit(state);
+				}
+				size_t expected(0);
+				const size_t passed = buffer.testSpan(x, y, count, depths.data(), pass.data(), write);
+				for (size_t i(0); i < count; ++i)
+				{
+					const bool inside = y < s_height && x + i < s_width;
+					const bool less = inside && depths[i] < reference.at(x + i, y);
+					mismatches += (less ? 1 : 0) != pass[i];
+					expected += less ? 1 : 0;
+					if (less && write)
+					{
+						reference.at(x + i, y) = depths[i];
+					}
+				}
+				mismatches += expected != passed;
+			}
+			else
+			{
+				const size_t tileX = nextRandom(state) % (buffer.tilesX() + 1);
+				const size_t tileY = nextRandom(state) % (buffer.tilesY() + 1);
+				const uint64_t coverage = (static_cast<uint64_t>(nextRandom(state)) << 40)
+					^ (static_cast<uint64_t>(nextRandom(state)) << 20) ^ nextRandom(state);
+				for (size_t i(0); i < 64; ++i)
+				{
+					depths[i] = base + 0.05f * randomUnit(state);
+				}
+				uint64_t expected(0);
+				for (size_t i(0); i < 64 && tileX < buffer.tilesX() && tileY < buffer.tilesY(); ++i)
+				{
+					const size_t x = tileX * s_tile + i % s_tile;
+					const size_t y = tileY * s_tile + i / s_tile;
+					if (0 != (coverage >> i & 1u) && x < s_width && y < s_height && depths[i] < reference.at(x, y))
+					{
+						expected |= uint64_t(1) << i;
+						if (write)
+						{
+							reference.at(x, y) = depths[i];
+						}
+					}
+				}
+				mismatches += expected != buffer.testTile(tileX, tileY, depths.data(), coverage, write);
+			}
+		}
+
+		for (size_t y(0); y < s_height; ++y)
+		{
+			for (size_t x(0); x < s_width; ++x)
+			{
+				mismatches += reference.at(x, y) != buffer.depth(x, y);
+			}
+		}
+	}
+
+	// 写入与逐像素参照一致；更新金字塔后矩形查询与逐像素求得的结果完全相同，未更新时只会偏向可见
+	void testWritesAndQueries()
+	{
+		DepthBuffer buffer;
+		CHECK(buffer.create(s_width, s_height));
+		CHECK(26 == buffer.tilesX() && 15 == buffer.tilesY());
+		Reference reference;
+		uint32_t state = 9u;
+		size_t writeMismatches(0), queryMismatches(0), unsound(0);
+
+		// 先把每个 tile 都写脏一次，走并行路径
+		std::vector<float> tileDepths(64);
+		for (size_t ty(0); ty < buffer.tilesY(); ++ty)
+		{
+			for (size_t tx(0); tx < buffer.tilesX(); ++tx)
+			{
+				for (size_t i(0); i < 64; ++i)
+				{
+					tileDepths[i] = 0.6f + 0.4f * randomUnit(state);
+					const size_t x = tx * s_tile + i % s_tile, y = ty * s_tile + i / s_tile;
+					if (x < s_width && y < s_height)
+					{
+						reference.at(x, y) = std::min(reference.at(x, y), tileDepths[i]);
+					}
+				}
+				buffer.testTile(tx, ty, tileDepths.data());
+			}
+		}
+		CHECK(buffer.tilesX() * buffer.tilesY() == buffer.updateHierarchy());
+		CHECK(0 == buffer.updateHierarchy());
+
+		for (size_t round(0); round < 8; ++round)
+		{
+			randomWrites(buffer, reference, state, 300, writeMismatches);
+			// 过时的金字塔仍是保守的
+			for (size_t q(0); q < 200; ++q)
+			{
+				const float x0 = randomUnit(state) * (s_width + 40.f) - 20.f;
+				const float y0 = randomUnit(state) * (s_height + 40.f) - 20.f;
+				const float x1 = x0 + randomUnit(state) * 60.f;
+				const float y1 = y0 + randomUnit(state) * 40.f;
+				const float minDepth = 0.3f + 0.8f * randomUnit(state);
+				unsound += buffer.isOccluded(x0, y0, x1, y1, minDepth)
+					&& !reference.isOccluded(x0, y0, x1, y1, minDepth);
+			}
+
+			buffer.updateHierarchy();
+			for (size_t q(0); q < 500; ++q)
+			{
+				const float x0 = randomUnit(state) * (s_width + 40.f) - 20.f;
+				const float y0 = randomUnit(state) * (s_height + 40.f) - 20.f;
+				const float x1 = x0 + randomUnit(state) * 80.f - 5.f;
+				const float y1 = y0 + randomUnit(state) * 50.f - 5.f;
+				const float minDepth = 0.3f + 0.8f * randomUnit(state);
+				queryMismatches += buffer.isOccluded(x0, y0, x1, y1, minDepth)
+					!= reference.isOccluded(x0, y0, x1, y1, minDepth);
+			}
+		}
+		CHECK(0 == writeMismatches);
+		CHECK(0 == queryMismatches);
+		CHECK(0 == unsound);
+
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		CHECK(!buffer.isOccluded(nan, 0.f, 10.f, 10.f, 1.f));
+		CHECK(buffer.isOccluded(-10.f, -10.f, -1.f, -1.f, 0.f));
+
+		buffer.clear(0.5f);
+		CHECK(buffer.isOccluded(0.f, 0.f, s_width, s_height, 0.5f));
+		CHECK(!buffer.isOccluded(0.f, 0.f, s_width, s_height, 0.49f));
+	}
+
+	// 裁剪空间包围盒：被判为遮挡时，投影矩形内每个像素都不比盒子的最近深度远
+	void testCorners()
+	{
+		DepthBuffer buffer;
+		CHECK(buffer.create(s_width, s_height));
+		Reference reference;
+		uint32_t state = 21u;
+		size_t mismatches(0);
+		randomWrites(buffer, reference, state, 3000, mismatches);
+		buffer.updateHierarchy();
+		CHECK(0 == mismatches);
+
+		size_t occluded(0), unsound(0);
+		for (size_t box(0); box < 2000; ++box)
+		{
+			const double cx = randomUnit(state) * 2.4 - 1.2, cy = randomUnit(state) * 2.4 - 1.2;
+			const double ex = randomUnit(state) * 0.2, ey = randomUnit(state) * 0.2;
+			const double z = randomUnit(state);
+			TVector4<float> corners[8];
+			double minX(1e9), maxX(-1e9), minY(1e9), maxY(-1e9), minZ(1e9);
+			for (size_t k(0); k < 8; ++k)
+			{
+				const double x = cx + (k & 1 ? ex : -ex), y = cy + (k & 2 ? ey : -ey), d = z + (k & 4 ? 0.05 : 0.0);
+				const float w = 1.f + 2.f * randomUnit(state);
+				corners[k] = TVector4<float>(static_cast<float>(x * w), static_cast<float>(y * w),
+					static_cast<float>(d * w), w);
+				minX = std::min(minX, x); maxX = std::max(maxX, x);
+				minY = std::min(minY, y); maxY = std::max(maxY, y);
+				minZ = std::min(minZ, d);
+			}
+			if (!buffer.isOccluded(corners, 8))
+			{
+				continue;
+			}
+			++occluded;
+
+			// 略微收缩矩形以容忍投影的舍入
+			const double px0 = (minX * 0.5 + 0.5) * s_width + 0.01, px1 = (maxX * 0.5 + 0.5) * s_width - 0.01;
+			const double py0 = (0.5 - maxY * 0.5) * s_height + 0.01, py1 = (0.5 - minY * 0.5) * s_height - 0.01;
+			if (px1 < 0.0 || py1 < 0.0 || px0 >= s_width || py0 >= s_height)
+			{
+				continue;
+			}
+			const size_t x0 = static_cast<size_t>(std::max(px0, 0.0));
+			const size_t y0 = static_cast<size_t>(std::max(py0, 0.0));
+			const size_t x1 = std::min(static_cast<size_t>(px1), s_width - 1);
+			const size_t y1 = std::min(static_cast<size_t>(py1), s_height - 1);
+			unsound += reference.maxDepth(x0, y0, x1, y1) > minZ + 1e-6;
+		}
+		CHECK(occluded > 100);
+		CHECK(0 == unsound);
+	}
+
+	// 任一顶点投影后 x、y 或 z 为 NaN 时保守地视为可见（std::min/max 会静默跳过 NaN）
+	void testNaNCorners()
+	{
+		DepthBuffer buffer;
+		CHECK(buffer.create(s_width, s_height));
+		buffer.clear(0.1f);
+
+		TVector4<float> corners[16];
+		for (size_t k(0); k < 8; ++k)
+		{
+			const float x = k & 1 ? 0.1f : -0.1f, y = k & 2 ? 0.1f : -0.1f, z = k & 4 ? 0.6f : 0.5f;
+			corners[k] = TVector4<float>(2.f * x, 2.f * y, 2.f * z, 2.f);
+		}
+		CHECK(buffer.isOccluded(corners, 8));
+		CHECK(buffer.isOccluded(corners, 8, ClipDepth::NegativeOneToOne));
+
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		const float inf = std::numeric_limits<float>::infinity();
+		for (size_t c(0); c < 4; ++c)
+		{
+			TVector4<float> broken[8];
+			std::copy(corners, corners + 8, broken);
+			broken[5].data()[c] = nan;
+			CHECK(!buffer.isOccluded(broken, 8));
+		}
+
+		// 有限正 w 下的 inf / inf 同样是 NaN
+		TVector4<float> infinite[8];
+		std::copy(corners, corners + 8, infinite);
+		infinite[3] = TVector4<float>(inf, inf, inf, inf);
+		CHECK(!buffer.isOccluded(infinite, 8));
+
+		std::copy(corners, corners + 8, corners + 8);
+		corners[12].data()[1] = nan;
+		uint8_t visible[2] = { 7, 7 };
+		CHECK(1 == buffer.cullBoxes(corners, 2, visible));
+		CHECK(0 == visible[0] && 1 == visible[1]);
+	}
+}
+
+int main()
+{
+	testWritesAndQueries();
+	testCorners();
+	testNaNCorners();
+	return test::report("DepthBufferTest");
+}
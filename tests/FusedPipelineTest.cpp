@@ -0,0 +1,212 @@
+#include "TestCommon.h"
+#include "parallel/TFusedPipeline.hpp"
+#include "parallel/TNumaArray.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 默认构造函数非平凡，但可平凡复制、平凡析构
+	struct Particle
+	{
+		float position[3] = { 1.f, 2.f, 3.f };
+		uint32_t id = 7u;
+	};
+
+	TFusedPipeline<double> makePipeline()
+	{
+		TFusedPipeline<double> pipeline;
+		pipeline.then([](double* data, size_t size)
+		{
+			for (size_t i(0); i < size; ++i)
+			{
+				data[i] = data[i] * 2.0;
+			}
+		}).then([](double* data, size_t size)
+		{
+			for (size_t i(0); i < size; ++i)
+			{
+				data[i] = data[i] + 1.0;
+			}
+		});
+		return pipeline;
+	}
+
+	std::vector<double> makeInput(const size_t count)
+	{
+		std::vector<double> input(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			input[i] = static_cast<double>(i % 1000) - 500.0;
+		}
+		return input;
+	}
+
+	// 元素数不是块大小的整数倍，普通存储与非临时存储、原地与异地结果都与顺序循环一致
+	void testRun(BlockedExecutor& executor)
+	{
+		const size_t count = executor.blockElements(sizeof(double)) * 7 + 13;
+		const std::vector<double> input = makeInput(count);
+		std::vector<double> expected(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			expected[i] = input[i] * 2.0 + 1.0;
+		}
+
+		TFusedPipeline<double> pipeline = makePipeline();
+		CHECK(2 == pipeline.stageCount());
+		for (const bool streaming : { true, false })
+		{
+			pipeline.streamingStores(streaming);
+			std::vector<double> out(count, 0.0);
+			CHECK(pipeline.run(executor, input.data(), out.data(), count));
+			CHECK(expected == out);
+
+			std::vector<double> inPlace = input;
+			CHECK(pipeline.run(executor, inPlace.data(), inPlace.data(), count));
+			CHECK(expected == inPlace);
+		}
+
+		CHECK(pipeline.run(executor, nullptr, nullptr, 0));
+		CHECK(!pipeline.run(executor, input.data(), nullptr, count));
+	}
+
+	// 归约按块序合并：与顺序累加的结果一致（整数值求和精确），块数与线程数无关
+	void testReduce(BlockedExecutor& executor)
+	{
+		const size_t count = executor.blockElements(sizeof(double)) * 5 + 1;
+		const std::vector<double> input = makeInput(count);
+		double expectedSum(0.0);
+		std::vector<double> expected(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			expected[i] = input[i] * 2.0 + 1.0;
+			expectedSum += expected[i];
+		}
+
+		const TFusedPipeline<double> pipeline = makePipeline();
+		const auto blockSum = [](const double* data, size_t size)
+		{
+			double total(0.0);
+			for (size_t i(0); i < size; ++i)
+			{
+				total += data[i];
+			}
+			return total;
+		};
+		const auto add = [](const double a, const double b) { return a + b; };
+
+		double total(-1.0);
+		std::vector<double> out(count, 0.0);
+		CHECK(pipeline.reduce(executor, input.data(), out.data(), count, 0.0, blockSum, add, total));
+		CHECK(expectedSum == total);
+		CHECK(expected == out);
+
+		total = -1.0;
+		CHECK(pipeline.reduce(executor, input.data(), static_cast<double*>(nullptr), count, 0.0, blockSum, add, total));
+		CHECK(expectedSum == total);
+
+		// 最大值归约，单位元不为 0
+		double largest(0.0);
+		CHECK(pipeline.reduce(executor, input.data(), static_cast<double*>(nullptr), count, -1e300,
+			[](const double* data, size_t size)
+			{
+				double value(-1e300);
+				for (size_t i(0); i < size; ++i)
+				{
+					value = std::max(value, data[i]);
+				}
+				return value;
+			},
+			[](const double a, const double b) { return std::max(a, b); }, largest));
+		CHECK(999.0 == largest);
+
+		total = -1.0;
+		CHECK(pipeline.reduce(executor, static_cast<const double*>(nullptr), static_cast<double*>(nullptr), 0, 0.0,
+			blockSum, add, total));
+		CHECK(0.0 == total);
+	}
+
+	// 阶段抛出的异常在调用线程重新抛出，执行器之后仍可使用
+	void testThrowingStage(BlockedExecutor& executor)
+	{
+		const size_t count = executor.blockElements(sizeof(double)) * 4;
+		std::vector<double> data = makeInput(count);
+		TFusedPipeline<double> pipeline;
+		pipeline.then([](double* block, size_t)
+		{
+			if (block[0] == -500.0)
+			{
+				throw std::runtime_error("stage failed");
+			}
+		});
+
+		bool caught(false);
+		try
+		{
+			pipeline.run(executor, data.data(), data.data(), count);
+		}
+		catch (const std::runtime_error& error)
+		{
+			caught = std::string("stage failed") == error.what();
+		}
+		CHECK(caught);
+
+		size_t calls(0);
+		executor.run([&calls](size_t index)
+		{
+			if (0 == index)
+			{
+				++calls;
+			}
+		});
+		CHECK(1 == calls);
+		testRun(executor);
+	}
+
+	// 各工作线程完成首次写入后，每个元素都是 T()
+	void testNumaArray(BlockedExecutor& executor)
+	{
+		const size_t count = executor.blockElements(sizeof(Particle)) * 3 + 5;
+		TNumaArray<Particle> particles(executor, count);
+		CHECK(count == particles.size());
+		CHECK(!particles.empty());
+		CHECK(0 == reinterpret_cast<uintptr_t>(particles.data()) % BlockedExecutor::s_pageSize);
+
+		size_t wrong(0);
+		for (const Particle& particle : particles)
+		{
+			wrong += !(1.f == particle.position[0] && 2.f == particle.position[1] && 3.f == particle.position[2]
+				&& 7u == particle.id);
+		}
+		CHECK(0 == wrong);
+
+		particles[count - 1].id = 9u;
+		TNumaArray<Particle> moved(std::move(particles));
+		CHECK(particles.empty());
+		CHECK(count == moved.size());
+		CHECK(9u == moved[count - 1].id);
+
+		TNumaArray<Particle> empty(executor, 0);
+		CHECK(empty.empty());
+		CHECK(empty.begin() == empty.end());
+	}
+}
+
+int main()
+{
+	// 小块、不绑定 CPU，使每个线程都分到多个块
+	BlockedExecutor executor(3, 4096, false);
+	CHECK(3 == executor.threadCount());
+	testRun(executor);
+	testReduce(executor);
+	testThrowingStage(executor);
+	testNumaArray(executor);
+	return test::report("FusedPipelineTest");
+}
@@ -0,0 +1,208 @@
+#include "TestCommon.h"
+#include "vector/IntVectorTool.h"
+#include "vector/TVector3.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	constexpr int s_min = std::numeric_limits<int>::min();
+	constexpr int s_max = std::numeric_limits<int>::max();
+
+	uint64_t nextRandom(uint64_t& state)
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return state >> 16;
+	}
+
+	// 约四分之一的分量取 INT32_MIN / INT32_MAX / -1 / 0 等极端值
+	int randomComponent(uint64_t& state)
+	{
+		const int special[] = { s_min, s_max, s_min + 1, -1, 0, 1 };
+		const uint64_t r = nextRandom(state);
+		return 0 == (r & 3) ? special[(r >> 2) % 6] : static_cast<int>(static_cast<uint32_t>(r >> 8));
+	}
+
+	__int128 dotReference(const int* a, const int* b, const size_t dimension)
+	{
+		__int128 sum(0);
+		for (size_t k(0); k < dimension; ++k)
+		{
+			sum += static_cast<__int128>(a[k]) * b[k];
+		}
+		return sum;
+	}
+
+	bool reference(const int* a, const int* b, const size_t dimension, __int128& dot, __int128& squared,
+		__int128& manhattan, __int128& chebyshev)
+	{
+		dot = dotReference(a, b, dimension);
+		squared = dotReference(a, a, dimension);
+		manhattan = 0;
+		chebyshev = 0;
+		for (size_t k(0); k < dimension; ++k)
+		{
+			const __int128 d = static_cast<__int128>(a[k]) - b[k];
+			manhattan += d < 0 ? -d : d;
+			chebyshev = std::max(chebyshev, d < 0 ? -d : d);
+		}
+		// 只保留结果在输出类型范围内的向量，超出时 64 位累加按约定不保证
+		return dot >= std::numeric_limits<int64_t>::min() && dot <= std::numeric_limits<int64_t>::max()
+			&& squared <= static_cast<__int128>(std::numeric_limits<uint64_t>::max());
+	}
+
+	uint32_t isqrtReference(const uint64_t v)
+	{
+		uint64_t low(0), high(0x100000000ull);
+		while (high - low > 1)
+		{
+			const uint64_t mid = (low + high) / 2;
+			if (static_cast<unsigned __int128>(mid) * mid <= v)
+			{
+				low = mid;
+			}
+			else
+			{
+				high = mid;
+			}
+		}
+		return static_cast<uint32_t>(low);
+	}
+
+	// 维数 1 到 7、向量数 0 到 13（覆盖 SSE2 归约的整组与标量尾部，维数 3 的 4 个一组）与 128 位标量参照逐一比较
+	void testReductions()
+	{
+		uint64_t state = 12345u;
+		size_t mismatches(0);
+		for (size_t dimension(1); dimension <= 7; ++dimension)
+		{
+			for (size_t count(0); count <= 13; ++count)
+			{
+				std::vector<int> a(dimension * count + 1), b(dimension * count + 1);
+				std::vector<__int128> dots(count), squares(count), manhattans(count), chebyshevs(count);
+				for (size_t i(0); i < count; ++i)
+				{
+					do
+					{
+						for (size_t k(0); k < dimension; ++k)
+						{
+							a[i * dimension + k] = randomComponent(state);
+							b[i * dimension + k] = randomComponent(state);
+						}
+					} while (!reference(&a[i * dimension], &b[i * dimension], dimension, dots[i], squares[i],
+						manhattans[i], chebyshevs[i]));
+				}
+
+				std::vector<int64_t> dot(count + 1, -7);
+				std::vector<uint64_t> squared(count + 1, 7u), manhattan(count + 1, 7u);
+				std::vector<uint32_t> chebyshev(count + 1, 7u), length(count + 1, 7u);
+				IntVectorTool::dot(a.data(), b.data(), dimension, dot.data(), count);
+				IntVectorTool::squaredLength(a.data(), dimension, squared.data(), count);
+				IntVectorTool::manhattanDistance(a.data(), b.data(), dimension, manhattan.data(), count);
+				IntVectorTool::chebyshevDistance(a.data(), b.data(), dimension, chebyshev.data(), count);
+				IntVectorTool::length(a.data(), dimension, length.data(), count);
+
+				for (size_t i(0); i < count; ++i)
+				{
+					mismatches += dot[i] != static_cast<int64_t>(dots[i]);
+					mismatches += squared[i] != static_cast<uint64_t>(squares[i]);
+					mismatches += manhattan[i] != static_cast<uint64_t>(manhattans[i]);
+					mismatches += chebyshev[i] != static_cast<uint32_t>(chebyshevs[i]);
+					mismatches += length[i] != isqrtReference(static_cast<uint64_t>(squares[i]));
+				}
+				// 不写出 count 之后的元素
+				mismatches += -7 != dot[count] || 7u != squared[count] || 7u != manhattan[count]
+					|| 7u != chebyshev[count] || 7u != length[count];
+			}
+		}
+		CHECK(0 == mismatches);
+	}
+
+	// 逐分量运算按补码回绕
+	void testWrapping()
+	{
+		const int a[] = { s_max, s_min, -1, 5, 7, s_min, 0 };
+		const int b[] = { 1, -1, s_min, -5, s_max, s_min, s_max };
+		int sum[7], difference[7], scaled[7];
+		IntVectorTool::add(a, b, sum, 7);
+		IntVectorTool::subtract(a, b, difference, 7);
+		IntVectorTool::scale(a, -3, scaled, 7);
+		size_t mismatches(0);
+		for (size_t i(0); i < 7; ++i)
+		{
+			mismatches += sum[i] != static_cast<int>(static_cast<uint32_t>(a[i]) + static_cast<uint32_t>(b[i]));
+			mismatches += difference[i] != static_cast<int>(static_cast<uint32_t>(a[i]) - static_cast<uint32_t>(b[i]));
+			mismatches += scaled[i] != static_cast<int>(static_cast<uint32_t>(a[i]) * static_cast<uint32_t>(-3));
+		}
+		CHECK(0 == mismatches);
+	}
+
+	// 2^52 两侧（批量路径在此切换到整数修正）、完全平方数附近与 2^64 - 1
+	void testIsqrt()
+	{
+		std::vector<uint64_t> values;
+		const uint64_t roots[] = { 0u, 1u, 2u, 3u, 46340u, 67108863u, 67108864u, 67108865u, 94906265u, 2147483648u,
+			4294967295u };
+		for (const uint64_t r : roots)
+		{
+			const uint64_t square = r * r;
+			values.push_back(square);
+			values.push_back(square + 1);
+			if (square > 0)
+			{
+				values.push_back(square - 1);
+			}
+		}
+		const uint64_t limit = 1ull << 52;
+		for (uint64_t d(0); d < 8; ++d)
+		{
+			values.push_back(limit - d);
+			values.push_back(limit + d);
+		}
+		values.push_back(std::numeric_limits<uint64_t>::max());
+		values.push_back(std::numeric_limits<uint64_t>::max() - 1);
+		values.push_back(0xfffffffe00000001ull);
+		values.push_back(0xfffffffe00000000ull);
+
+		std::vector<uint32_t> batch(values.size());
+		IntVectorTool::isqrt(values.data(), batch.data(), values.size());
+		size_t mismatches(0);
+		for (size_t i(0); i < values.size(); ++i)
+		{
+			const uint32_t expected = isqrtReference(values[i]);
+			mismatches += expected != IntVectorTool::isqrt(values[i]);
+			mismatches += expected != batch[i];
+		}
+		CHECK(0 == mismatches);
+	}
+
+	// 向量数组版本转发到分量版本
+	void testVectorOverloads()
+	{
+		const TVector3<int> a[] = { { 1, 2, 3 }, { -4, 5, -6 }, { s_max, 0, s_min }, { 7, -8, 9 }, { 0, 0, 0 } };
+		const TVector3<int> b[] = { { 3, 2, 1 }, { 6, 5, 4 }, { 1, 1, 1 }, { -1, -1, -1 }, { 0, 0, 0 } };
+		int64_t dot[5];
+		uint32_t length[5];
+		IntVectorTool::dot(a, b, dot, 5);
+		IntVectorTool::length(a, length, 5);
+		CHECK(10 == dot[0]);
+		CHECK(-23 == dot[1]);
+		CHECK(static_cast<int64_t>(s_max) + s_min == dot[2]);
+		CHECK(-8 == dot[3]);
+		CHECK(3 == length[0] && 8 == length[1] && 0 == length[4]);
+		CHECK(isqrtReference((1ull << 63) - (1ull << 32) + 1ull) == length[2]);
+	}
+}
+
+int main()
+{
+	testReductions();
+	testWrapping();
+	testIsqrt();
+	testVectorOverloads();
+	return test::report("IntVectorToolTest");
+}
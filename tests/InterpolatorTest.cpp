@@ -0,0 +1,260 @@
+#include "TestCommon.h"
+#include "render/TInterpolator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	double randomUnit(uint32_t& state)
+	{
+		return static_cast<double>(nextRandom(state)) * (1.0 / 16777216.0);
+	}
+
+	/*!
+	 * 随机屏幕空间重心坐标，三者之和为 1
+	 */
+	template <floattype T>
+	void randomBarycentrics(uint32_t& state, const size_t count, std::vector<T>& b0, std::vector<T>& b1,
+		std::vector<T>& b2)
+	{
+		b0.resize(count);
+		b1.resize(count);
+		b2.resize(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			double u = randomUnit(state);
+			double v = randomUnit(state);
+			if (u + v > 1.0)
+			{
+				u = 1.0 - u;
+				v = 1.0 - v;
+			}
+			b0[i] = static_cast<T>(1.0 - u - v);
+			b1[i] = static_cast<T>(u);
+			b2[i] = static_cast<T>(v);
+		}
+	}
+
+	/*!
+	 * 依次追加标量、TVector2/3/4，共 10 个分量
+	 */
+	template <floattype T>
+	void appendMixed(uint32_t& state, TTriangleAttributes<T>& attributes)
+	{
+		auto r = [&state]() { return static_cast<T>(randomUnit(state) * 4.0 - 2.0); };
+		CHECK(0 == attributes.append(r(), r(), r()));
+		CHECK(1 == attributes.append(TVector2<T>(r(), r()), TVector2<T>(r(), r()), TVector2<T>(r(), r())));
+		CHECK(3 == attributes.append(TVector3<T>(r(), r(), r()), TVector3<T>(r(), r(), r()),
+			TVector3<T>(r(), r(), r())));
+		CHECK(6 == attributes.append(TVector4<T>(r(), r(), r(), r()), TVector4<T>(r(), r(), r(), r()),
+			TVector4<T>(r(), r(), r(), r())));
+		CHECK(10 == attributes.componentCount());
+	}
+
+	// 4 像素一组与标量尾部都与双精度 sum(bi * Ai / wi) / sum(bi / wi) 一致，插值后的 w 同样
+	template <floattype T>
+	void testPerspectiveCorrect(const double tolerance)
+	{
+		uint32_t state = 1u;
+		TTriangleAttributes<T> attributes;
+		appendMixed(state, attributes);
+		const size_t components = attributes.componentCount();
+
+		// 顶点深度相差较大时透视校正与屏幕空间线性插值差别明显
+		const double w[3] = { 0.5, 4.0, 20.0 };
+		const T invW[3] = { static_cast<T>(1.0 / w[0]), static_cast<T>(1.0 / w[1]), static_cast<T>(1.0 / w[2]) };
+
+		for (const size_t count : { size_t(0), size_t(1), size_t(3), size_t(4), size_t(1027) })
+		{
+			std::vector<T> b0, b1, b2;
+			randomBarycentrics(state, count, b0, b1, b2);
+			std::vector<std::vector<T>> streams(components, std::vector<T>(count + 1, T(-7)));
+			std::vector<T*> out(components);
+			for (size_t c(0); c < components; ++c)
+			{
+				out[c] = streams[c].data();
+			}
+			std::vector<T> outW(count + 1, T(-7));
+			TInterpolator<T>::perspectiveCorrect(attributes, invW, b0.data(), b1.data(), b2.data(), count, out.data(),
+				outW.data());
+
+			double error(0.0), errorW(0.0), linearGap(0.0);
+			for (size_t p(0); p < count; ++p)
+			{
+				const double q0 = static_cast<double>(b0[p]) / w[0];
+				const double q1 = static_cast<double>(b1[p]) / w[1];
+				const double q2 = static_cast<double>(b2[p]) / w[2];
+				const double sum = q0 + q1 + q2;
+				errorW = std::max(errorW, std::abs(outW[p] - 1.0 / sum) * sum);
+				for (size_t c(0); c < components; ++c)
+				{
+					const double a0 = attributes.value(0, c), a1 = attributes.value(1, c), a2 = attributes.value(2, c);
+					const double expected = (q0 * a0 + q1 * a1 + q2 * a2) / sum;
+					const double linear = b0[p] * a0 + b1[p] * a1 + b2[p] * a2;
+					error = std::max(error, std::abs(out[c][p] - expected));
+					linearGap = std::max(linearGap, std::abs(linear - expected));
+				}
+			}
+			CHECK(error < tolerance);
+			CHECK(errorW < tolerance);
+			CHECK(count < 4 || linearGap > 0.1);
+
+			// 不越界写入
+			bool untouched = T(-7) == outW[count];
+			for (size_t c(0); c < components; ++c)
+			{
+				untouched = untouched && T(-7) == streams[c][count];
+			}
+			CHECK(untouched);
+		}
+
+		// outW 可以省略，结果不变
+		const size_t count = 6;
+		std::vector<T> b0, b1, b2;
+		randomBarycentrics(state, count, b0, b1, b2);
+		std::vector<std::vector<T>> withW(components, std::vector<T>(count)), withoutW(components, std::vector<T>(count));
+		std::vector<T*> outA(components), outB(components);
+		for (size_t c(0); c < components; ++c)
+		{
+			outA[c] = withW[c].data();
+			outB[c] = withoutW[c].data();
+		}
+		std::vector<T> outW(count);
+		TInterpolator<T>::perspectiveCorrect(attributes, invW, b0.data(), b1.data(), b2.data(), count, outA.data(),
+			outW.data());
+		TInterpolator<T>::perspectiveCorrect(attributes, invW, b0.data(), b1.data(), b2.data(), count, outB.data());
+		CHECK(withW == withoutW);
+	}
+
+	// 三个顶点 w 相同时透视校正退化为屏幕空间重心插值
+	template <floattype T>
+	void testBarycentric(const double tolerance)
+	{
+		uint32_t state = 2u;
+		TTriangleAttributes<T> attributes;
+		appendMixed(state, attributes);
+		const size_t components = attributes.componentCount();
+
+		const size_t count = 1029;
+		std::vector<T> b0, b1, b2;
+		randomBarycentrics(state, count, b0, b1, b2);
+		std::vector<std::vector<T>> linear(components, std::vector<T>(count)), perspective(components,
+			std::vector<T>(count));
+		std::vector<T*> outL(components), outP(components);
+		for (size_t c(0); c < components; ++c)
+		{
+			outL[c] = linear[c].data();
+			outP[c] = perspective[c].data();
+		}
+		TInterpolator<T>::barycentric(attributes, b0.data(), b1.data(), b2.data(), count, outL.data());
+		const T invW[3] = { T(0.25), T(0.25), T(0.25) };
+		TInterpolator<T>::perspectiveCorrect(attributes, invW, b0.data(), b1.data(), b2.data(), count, outP.data());
+
+		double error(0.0), gap(0.0);
+		for (size_t p(0); p < count; ++p)
+		{
+			for (size_t c(0); c < components; ++c)
+			{
+				const double expected = static_cast<double>(b0[p]) * attributes.value(0, c)
+					+ static_cast<double>(b1[p]) * attributes.value(1, c)
+					+ static_cast<double>(b2[p]) * attributes.value(2, c);
+				error = std::max(error, std::abs(linear[c][p] - expected));
+				gap = std::max(gap, std::abs(perspective[c][p] - expected));
+			}
+		}
+		CHECK(error < tolerance);
+		CHECK(gap < tolerance);
+	}
+
+	// 标量与向量 lerp 与双精度结果一致
+	void testLerp()
+	{
+		uint32_t state = 3u;
+		const size_t count = 37;
+		std::vector<float> a(count), b(count), t(count), out(count);
+		std::vector<TVector3<float>> va(count), vb(count), vout(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			a[i] = static_cast<float>(randomUnit(state) * 2.0 - 1.0);
+			b[i] = static_cast<float>(randomUnit(state) * 2.0 - 1.0);
+			t[i] = static_cast<float>(randomUnit(state));
+			va[i].set(a[i], b[i], t[i]);
+			vb[i].set(b[i], t[i], a[i]);
+		}
+		TInterpolator<float>::lerp(a.data(), b.data(), t.data(), out.data(), count);
+		TInterpolator<float>::lerp(va.data(), vb.data(), t.data(), vout.data(), count);
+
+		double error(0.0);
+		for (size_t i(0); i < count; ++i)
+		{
+			const double s = t[i];
+			error = std::max(error, std::abs(out[i] - (a[i] + (static_cast<double>(b[i]) - a[i]) * s)));
+			for (size_t k(0); k < 3; ++k)
+			{
+				const double expected = va[i][k] + (static_cast<double>(vb[i][k]) - va[i][k]) * s;
+				error = std::max(error, std::abs(vout[i][k] - expected));
+			}
+		}
+		CHECK(error < 1e-6);
+	}
+
+	// 最多 32 个分量：第 33 个分量追加失败，返回 s_maxComponents 且已有分量不变
+	void testCapacity()
+	{
+		using Attributes = TTriangleAttributes<float>;
+		Attributes attributes;
+		for (size_t i(0); i < 10; ++i)
+		{
+			const float v = static_cast<float>(i);
+			CHECK(3 * i == attributes.append(TVector3<float>(v, v, v), TVector3<float>(v, v, v),
+				TVector3<float>(v, v, v)));
+		}
+
+		// 剩 2 个分量时放不下 TVector4，也不会只写入一部分
+		CHECK(Attributes::s_maxComponents == attributes.append(TVector4<float>(1.f), TVector4<float>(1.f),
+			TVector4<float>(1.f)));
+		CHECK(30 == attributes.componentCount());
+
+		CHECK(30 == attributes.append(TVector2<float>(30.f, 31.f), TVector2<float>(30.f, 31.f),
+			TVector2<float>(30.f, 31.f)));
+		CHECK(Attributes::s_maxComponents == attributes.componentCount());
+
+		CHECK(Attributes::s_maxComponents == attributes.append(99.f, 99.f, 99.f));
+		CHECK(Attributes::s_maxComponents == attributes.componentCount());
+		bool intact = true;
+		for (size_t c(0); c < Attributes::s_maxComponents; ++c)
+		{
+			const float expected = c < 30 ? static_cast<float>(c / 3) : static_cast<float>(c);
+			for (size_t v(0); v < 3; ++v)
+			{
+				intact = intact && expected == attributes.value(v, c);
+			}
+		}
+		CHECK(intact);
+
+		attributes.clear();
+		CHECK(0 == attributes.componentCount());
+		CHECK(0 == attributes.append(1.f, 2.f, 3.f));
+	}
+}
+
+int main()
+{
+	testPerspectiveCorrect<float>(1e-5);
+	testPerspectiveCorrect<double>(1e-12);
+	testBarycentric<float>(1e-5);
+	testBarycentric<double>(1e-12);
+	testLerp();
+	testCapacity();
+	return test::report("InterpolatorTest");
+}
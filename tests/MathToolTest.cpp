@@ -0,0 +1,100 @@
+#include "TestCommon.h"
+#include "algorithm/MathTool.h"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	void testFractionRange()
+	{
+		for (const float v : { -1e-8f, -1e-30f, -std::numeric_limits<float>::denorm_min(), -0.f, 0.f, 0.5f, -0.5f,
+			3.75f, -3.75f, 1e9f, -1e9f })
+		{
+			const float f = MathTool::fraction(v);
+			CHECK(f >= 0.f && f < 1.f);
+		}
+		CHECK(MathTool::fraction(-1e-8f) == std::nextafter(1.f, 0.f));
+		CHECK(MathTool::fraction(-0.25f) == 0.75f);
+		CHECK(std::isnan(MathTool::fraction(std::numeric_limits<float>::quiet_NaN())));
+	}
+
+	// 批量接口的前 4k 个元素走 SSE2，与逐个调用（标量）逐位相同
+	void testBatchMatchesScalar()
+	{
+		std::vector<float> in = { -1e-8f, -1e-30f, -0.f, 0.f, 0.5f, -0.5f, 3.75f, -3.75f, 8388607.5f, -8388607.5f,
+			1e20f, -1e20f, std::numeric_limits<float>::infinity(), 2.f, -2.f, -7e-9f, 123.456f };
+		for (int i(0); i < 200; ++i)
+		{
+			in.push_back((i - 100) * 0.173f);
+		}
+		std::vector<float> floors(in.size()), fractions(in.size());
+		MathTool::floor(in.data(), floors.data(), in.size());
+		MathTool::fraction(in.data(), fractions.data(), in.size());
+		for (size_t i(0); i < in.size(); ++i)
+		{
+			float single;
+			MathTool::floor(&in[i], &single, 1);
+			CHECK(single == floors[i]);
+			CHECK(std::floor(in[i]) == floors[i]);
+			MathTool::fraction(&in[i], &single, 1);
+			CHECK(single == fractions[i] || (std::isnan(single) && std::isnan(fractions[i])));
+			if (std::isfinite(in[i]))
+			{
+				CHECK(fractions[i] >= 0.f && fractions[i] < 1.f);
+			}
+		}
+	}
+
+	// 病态点积：朴素求和完全抵消，Dot2 给出精确结果；与 MathCore 的定长版本结果相同
+	void testCompensatedDot()
+	{
+		const std::array<double, 6> a = { 1e16, 1.0, -1e16, 3.0, 1e-3, 0.1 };
+		const std::array<double, 6> b = { 1.0, 1.0, 1.0, 1.0 / 3.0, 1e3, 10.0 };
+		const double exact = 1.0 + 3.0 * (1.0 / 3.0) + 1e-3 * 1e3 + 0.1 * 10.0;
+
+		const double compensated = MathTool::dot<PrecisionPolicy::Compensated>(a.data(), b.data(), a.size());
+		CHECK(std::abs(compensated - exact) <= 4.0 * std::numeric_limits<double>::epsilon() * exact);
+		CHECK(compensated == (dotProduct<PrecisionPolicy::Compensated>(a, b)));
+		CHECK(compensated == compensatedDot(a.data(), b.data(), a.size()));
+		CHECK(std::abs(MathTool::dot(a.data(), b.data(), a.size()) - exact) > 0.5);
+
+		// 零长度与 NaN
+		CHECK(0.0 == MathTool::dot<PrecisionPolicy::Compensated>(a.data(), b.data(), 0));
+		const double nan[] = { std::numeric_limits<double>::quiet_NaN() };
+		CHECK(std::isnan(MathTool::dot<PrecisionPolicy::Compensated>(nan, b.data(), 1)));
+	}
+
+	// float 的各精度策略与 double 参照一致（Native 有单精度舍入误差）
+	void testFloatDotPolicies()
+	{
+		std::vector<float> a, b;
+		double reference(0.0);
+		for (int i(0); i < 1003; ++i)
+		{
+			a.push_back(std::sin(0.37f * i));
+			b.push_back(std::cos(0.11f * i) * 3.f);
+			reference += static_cast<double>(a.back()) * static_cast<double>(b.back());
+		}
+		const double promoted = MathTool::dot<PrecisionPolicy::Promoted>(a.data(), b.data(), a.size());
+		const float compensated = MathTool::dot<PrecisionPolicy::Compensated>(a.data(), b.data(), a.size());
+		const float native = MathTool::dot(a.data(), b.data(), a.size());
+		CHECK(std::abs(promoted - reference) < 1e-9);
+		CHECK(compensated == static_cast<float>(promoted));
+		CHECK(std::abs(native - reference) < 1e-3);
+		CHECK(std::abs(MathTool::norm<PrecisionPolicy::Promoted>(a.data(), a.size())
+			- std::sqrt(MathTool::dot<PrecisionPolicy::Promoted>(a.data(), a.data(), a.size()))) < 1e-12);
+	}
+}
+
+int main()
+{
+	testFractionRange();
+	testBatchMatchesScalar();
+	testCompensatedDot();
+	testFloatDotPolicies();
+	return test::report("MathToolTest");
+}
@@ -0,0 +1,316 @@
+#include "TestCommon.h"
+#include "mesh/TMeshTool.hpp"
+#include "mesh/VertexAdjacency.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 以原点为中心、边长 2 的立方体：8 个共享顶点，12 个逆时针（从外侧看）三角形
+	const uint32_t s_cubeIndices[] = {
+		0, 2, 1, 0, 3, 2,	// z = -1
+		4, 5, 6, 4, 6, 7,	// z = 1
+		0, 1, 5, 0, 5, 4,	// y = -1
+		3, 7, 6, 3, 6, 2,	// y = 1
+		0, 4, 7, 0, 7, 3,	// x = -1
+		1, 2, 6, 1, 6, 5	// x = 1
+	};
+
+	template <typename T>
+	std::vector<TVector3<T>> cubePositions()
+	{
+		return { { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+			{ -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 } };
+	}
+
+	template <typename T>
+	double distance(const TVector3<T>& a, const double x, const double y, const double z)
+	{
+		return std::max({ std::abs(a.x() - x), std::abs(a.y() - y), std::abs(a.z() - z) });
+	}
+
+	// 面法线为坐标轴方向；角度加权时每个面在角上的夹角之和都是 90°，与三角化无关，顶点法线为对角线方向
+	template <typename T>
+	void testCube(const double tolerance)
+	{
+		const std::vector<TVector3<T>> positions = cubePositions<T>();
+		VertexAdjacency adjacency;
+		adjacency.build(s_cubeIndices, 12, 8);
+
+		std::vector<TVector3<T>> faceNormals(12);
+		TMeshTool<T>::computeFaceNormals(positions.data(), s_cubeIndices, 12, faceNormals.data());
+		const double axes[6][3] = { { 0, 0, -1 }, { 0, 0, 1 }, { 0, -1, 0 }, { 0, 1, 0 }, { -1, 0, 0 }, { 1, 0, 0 } };
+		double error(0.0);
+		for (size_t f(0); f < 12; ++f)
+		{
+			error = std::max(error, distance(faceNormals[f], axes[f / 2][0], axes[f / 2][1], axes[f / 2][2]));
+		}
+		CHECK(error < tolerance);
+
+		std::vector<TVector3<T>> normals(8);
+		TMeshTool<T>::computeVertexNormals(positions.data(), s_cubeIndices, 12, adjacency, NormalWeight::Angle,
+			normals.data());
+		error = 0.0;
+		const double d = 1.0 / std::sqrt(3.0);
+		for (size_t v(0); v < 8; ++v)
+		{
+			error = std::max(error, distance(normals[v], positions[v].x() * d, positions[v].y() * d,
+				positions[v].z() * d));
+		}
+		CHECK(error < tolerance);
+
+		// 均匀与面积加权受三角化影响：顶点 0 在 z = -1、y = -1、x = -1 面上各有 2 个三角形，
+		// 顶点 1 在 z = -1、y = -1 面上各 1 个，在 x = 1 面上 2 个
+		TMeshTool<T>::computeVertexNormals(positions.data(), s_cubeIndices, 12, adjacency, NormalWeight::Uniform,
+			normals.data());
+		CHECK(distance(normals[0], -d, -d, -d) < tolerance);
+		CHECK(distance(normals[1], d, -d, -d) > 0.1);
+		CHECK(distance(normals[1], 2.0 / std::sqrt(6.0), -1.0 / std::sqrt(6.0), -1.0 / std::sqrt(6.0)) < tolerance);
+		TMeshTool<T>::computeVertexNormals(positions.data(), s_cubeIndices, 12, adjacency, NormalWeight::Area,
+			normals.data());
+		CHECK(distance(normals[1], 2.0 / std::sqrt(6.0), -1.0 / std::sqrt(6.0), -1.0 / std::sqrt(6.0)) < tolerance);
+	}
+
+	// 三种加权都与双精度逐面散射（scatter）参照一致；顶点数超过并行粒度 4096
+	template <typename T>
+	void testRandomMesh(const double tolerance)
+	{
+		const uint32_t side = 80;
+		std::vector<TVector3<T>> positions(side * side);
+		uint32_t state = 5u;
+		for (size_t y(0); y < side; ++y)
+		{
+			for (size_t x(0); x < side; ++x)
+			{
+				state = state * 1664525u + 1013904223u;
+				const double h = static_cast<double>(state >> 8) / 16777216.0;
+				positions[y * side + x] = TVector3<T>(T(x + 0.3 * h), T(y - 0.2 * h), T(2.0 * h));
+			}
+		}
+		std::vector<uint32_t> indices;
+		for (uint32_t y(0); y + 1 < side; ++y)
+		{
+			for (uint32_t x(0); x + 1 < side; ++x)
+			{
+				const uint32_t v = y * side + x;
+				indices.insert(indices.end(), { v, v + 1, v + side + 1, v, v + side + 1, v + side });
+			}
+		}
+		const size_t faceCount = indices.size() / 3;
+		VertexAdjacency adjacency;
+		adjacency.build(indices.data(), faceCount, positions.size());
+
+		for (const NormalWeight weight : { NormalWeight::Uniform, NormalWeight::Area, NormalWeight::Angle })
+		{
+			std::vector<double> sum(3 * positions.size(), 0.0);
+			for (size_t f(0); f < faceCount; ++f)
+			{
+				double p[3][3];
+				for (size_t k(0); k < 3; ++k)
+				{
+					const TVector3<T>& q = positions[indices[3 * f + k]];
+					p[k][0] = q.x(); p[k][1] = q.y(); p[k][2] = q.z();
+				}
+				const double e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+				const double e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+				const double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+					e1[0] * e2[1] - e1[1] * e2[0] };
+				const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				for (size_t k(0); k < 3; ++k)
+				{
+					double w = NormalWeight::Area == weight ? 1.0 : 1.0 / length;
+					if (NormalWeight::Angle == weight)
+					{
+						const double* a = p[(k + 1) % 3];
+						const double* b = p[(k + 2) % 3];
+						const double u[3] = { a[0] - p[k][0], a[1] - p[k][1], a[2] - p[k][2] };
+						const double v[3] = { b[0] - p[k][0], b[1] - p[k][1], b[2] - p[k][2] };
+						const double c[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2],
+							u[0] * v[1] - u[1] * v[0] };
+						w *= std::atan2(std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]),
+							u[0] * v[0] + u[1] * v[1] + u[2] * v[2]);
+					}
+					for (size_t c(0); c < 3; ++c)
+					{
+						sum[3 * indices[3 * f + k] + c] += w * n[c];
+					}
+				}
+			}
+
+			std::vector<TVector3<T>> normals(positions.size());
+			TMeshTool<T>::computeVertexNormals(positions.data(), indices.data(), faceCount, adjacency, weight,
+				normals.data());
+			double error(0.0);
+			for (size_t v(0); v < positions.size(); ++v)
+			{
+				const double* s = &sum[3 * v];
+				const double length = std::sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+				error = std::max(error, distance(normals[v], s[0] / length, s[1] / length, s[2] / length));
+			}
+			CHECK(error < tolerance);
+		}
+	}
+
+	// 不共享顶点的立方体：每个顶点只属于一个面，顶点法线等于面法线；退化三角形输出零向量
+	void testFlatAndDegenerate()
+	{
+		const std::vector<TVector3<float>> shared = cubePositions<float>();
+		std::vector<TVector3<float>> positions(36);
+		std::vector<uint32_t> indices(36);
+		for (uint32_t i(0); i < 36; ++i)
+		{
+			positions[i] = shared[s_cubeIndices[i]];
+			indices[i] = i;
+		}
+		VertexAdjacency adjacency;
+		adjacency.build(indices.data(), 12, 36);
+		std::vector<TVector3<float>> faceNormals(12), normals(36);
+		TMeshTool<float>::computeFaceNormals(positions.data(), indices.data(), 12, faceNormals.data());
+		TMeshTool<float>::computeVertexNormals(positions.data(), indices.data(), 12, adjacency, NormalWeight::Uniform,
+			normals.data());
+		size_t mismatches(0);
+		for (size_t i(0); i < 36; ++i)
+		{
+			mismatches += !(faceNormals[i / 3] == normals[i]);
+		}
+		CHECK(0 == mismatches);
+
+		const TVector3<float> line[3] = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 2.f, 2.f, 2.f } };
+		const uint32_t triangle[3] = { 0, 1, 2 };
+		TVector3<float> degenerate(5.f, 5.f, 5.f);
+		TMeshTool<float>::computeFaceNormals(line, triangle, 1, &degenerate);
+		CHECK(TVector3<float>(0.f, 0.f, 0.f) == degenerate);
+	}
+
+	// 由两个三角形组成、UV 与 xy 对齐的矩形：切线为 dP/du，w 表示副切线是否与 cross(n, t) 同向
+	void testQuadTangents()
+	{
+		using Tool = TMeshTool<double>;
+		const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+		VertexAdjacency adjacency;
+		adjacency.build(indices, 2, 4);
+
+		// 绕任意轴旋转后结果随之旋转
+		const double angle = 0.7;
+		const double axis[3] = { 1.0 / std::sqrt(3.0), -1.0 / std::sqrt(3.0), 1.0 / std::sqrt(3.0) };
+		auto rotate = [&](const double x, const double y, const double z, double out[3])
+		{
+			const double c = std::cos(angle), s = std::sin(angle);
+			const double dot = axis[0] * x + axis[1] * y + axis[2] * z;
+			const double cross[3] = { axis[1] * z - axis[2] * y, axis[2] * x - axis[0] * z, axis[0] * y - axis[1] * x };
+			out[0] = x * c + cross[0] * s + axis[0] * dot * (1 - c);
+			out[1] = y * c + cross[1] * s + axis[1] * dot * (1 - c);
+			out[2] = z * c + cross[2] * s + axis[2] * dot * (1 - c);
+		};
+
+		const double corners[4][2] = { { 0, 0 }, { 2, 0 }, { 2, 1 }, { 0, 1 } };
+		TVector3<double> positions[4];
+		TVector3<double> normals[4];
+		double n[3], t[3];
+		rotate(0, 0, 1, n);
+		rotate(1, 0, 0, t);
+		for (size_t i(0); i < 4; ++i)
+		{
+			double p[3];
+			rotate(corners[i][0], corners[i][1], 0.0, p);
+			positions[i] = TVector3<double>(p[0], p[1], p[2]);
+			normals[i] = TVector3<double>(n[0], n[1], n[2]);
+		}
+
+		// 镜像 u 时切线反向，副切线不变，w 变为 -1
+		for (const bool mirrored : { false, true })
+		{
+			TVector2<double> uvs[4];
+			for (size_t i(0); i < 4; ++i)
+			{
+				const double u = corners[i][0] * 0.5;
+				uvs[i] = TVector2<double>(mirrored ? 1.0 - u : u, corners[i][1]);
+			}
+			TVector4<double> tangents[4];
+			Tool::computeTangents(positions, normals, uvs, indices, 2, adjacency, tangents);
+			const double sign = mirrored ? -1.0 : 1.0;
+			double error(0.0);
+			for (size_t i(0); i < 4; ++i)
+			{
+				error = std::max({ error, std::abs(tangents[i].x() - sign * t[0]),
+					std::abs(tangents[i].y() - sign * t[1]), std::abs(tangents[i].z() - sign * t[2]),
+					std::abs(tangents[i].w() - sign) });
+			}
+			CHECK(error < 1e-12);
+		}
+
+		// 法线与面不垂直时 Gram-Schmidt 使切线与法线正交且为单位长度
+		TVector2<double> uvs[4];
+		for (size_t i(0); i < 4; ++i)
+		{
+			uvs[i] = TVector2<double>(corners[i][0] * 0.5, corners[i][1]);
+			const double tilt = 0.3 * static_cast<double>(i + 1);
+			const double length = std::sqrt(1.0 + tilt * tilt);
+			double m[3];
+			rotate(tilt / length, 0.0, 1.0 / length, m);
+			normals[i] = TVector3<double>(m[0], m[1], m[2]);
+		}
+		TVector4<double> tangents[4];
+		Tool::computeTangents(positions, normals, uvs, indices, 2, adjacency, tangents);
+		double error(0.0);
+		for (size_t i(0); i < 4; ++i)
+		{
+			const TVector4<double>& s = tangents[i];
+			error = std::max(error, std::abs(s.x() * normals[i].x() + s.y() * normals[i].y() + s.z() * normals[i].z()));
+			error = std::max(error, std::abs(s.x() * s.x() + s.y() * s.y() + s.z() * s.z() - 1.0));
+			error = std::max(error, std::abs(s.w() - 1.0));
+		}
+		CHECK(error < 1e-12);
+	}
+
+	// 已知一环的小网格：中心顶点 0 周围 4 个三角形，顶点 6 不被引用
+	void testAdjacency()
+	{
+		const uint32_t indices[] = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 4, 1, 0, 1, 5, 2 };
+		VertexAdjacency adjacency;
+		adjacency.build(indices, 5, 7);
+		CHECK(7 == adjacency.vertexCount());
+
+		const std::vector<uint32_t> offsets = { 0, 4, 7, 10, 12, 14, 15, 15 };
+		CHECK(offsets == adjacency.offsets());
+
+		// 每个顶点的角点按面索引递增
+		const std::vector<uint32_t> corners = { 0, 3, 6, 11, 1, 10, 12, 2, 4, 14, 5, 7, 8, 9, 13 };
+		CHECK(corners == adjacency.corners());
+
+		size_t wrong(0);
+		for (size_t v(0); v < adjacency.vertexCount(); ++v)
+		{
+			for (uint32_t i(offsets[v]); i < offsets[v + 1]; ++i)
+			{
+				wrong += indices[adjacency.corners()[i]] != v;
+			}
+		}
+		CHECK(0 == wrong);
+
+		// 重新构建时覆盖旧数据
+		adjacency.build(indices, 1, 3);
+		CHECK(3 == adjacency.vertexCount());
+		CHECK((std::vector<uint32_t>{ 0, 1, 2, 3 }) == adjacency.offsets());
+		CHECK((std::vector<uint32_t>{ 0, 1, 2 }) == adjacency.corners());
+
+		VertexAdjacency empty;
+		CHECK(0 == empty.vertexCount());
+	}
+}
+
+int main()
+{
+	testCube<float>(1e-6);
+	testCube<double>(1e-14);
+	testRandomMesh<float>(1e-5);
+	testRandomMesh<double>(1e-12);
+	testFlatAndDegenerate();
+	testQuadTangents();
+	testAdjacency();
+	return test::report("MeshToolTest");
+}
@@ -0,0 +1,135 @@
+#include "TestCommon.h"
+#include "noise/TNoise.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 批量坐标：随机点、格点附近、整数点与绝对值极小的负数（小数部分会舍入为 1）
+	std::vector<float> makeCoords(const size_t count, uint32_t state)
+	{
+		std::vector<float> coords(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			const float r = static_cast<float>(state >> 8) / 16777216.f;
+			switch (i % 5)
+			{
+			case 0:
+				coords[i] = -1e-8f * (1.f + r);
+				break;
+			case 1:
+				coords[i] = std::floor((r - 0.5f) * 600.f);
+				break;
+			case 2:
+				coords[i] = std::nextafter(std::floor((r - 0.5f) * 600.f), 0.f);
+				break;
+			default:
+				coords[i] = (r - 0.5f) * 600.f;
+				break;
+			}
+		}
+		return coords;
+	}
+
+	template <size_t D>
+	float samplePoint(const TNoise<float>& noise, const NoiseType type, const std::vector<float>* coords, const size_t i,
+		const TFbmParams<float>* params)
+	{
+		if constexpr (2 == D)
+		{
+			const TVector2<float> p(coords[0][i], coords[1][i]);
+			return nullptr == params ? noise.evaluate(type, p) : noise.fbm(type, p, *params);
+		}
+		else if constexpr (3 == D)
+		{
+			const TVector3<float> p(coords[0][i], coords[1][i], coords[2][i]);
+			return nullptr == params ? noise.evaluate(type, p) : noise.fbm(type, p, *params);
+		}
+		else
+		{
+			const TVector4<float> p(coords[0][i], coords[1][i], coords[2][i], coords[3][i]);
+			return nullptr == params ? noise.evaluate(type, p) : noise.fbm(type, p, *params);
+		}
+	}
+
+	// 批量接口按 4 点一组走 SSE2，单点接口走标量，两者应逐点相等
+	template <size_t D>
+	void testBatchMatchesScalar(const TFbmParams<float>* params)
+	{
+		const size_t count = 1003;
+		std::vector<float> coords[D];
+		const float* rows[D];
+		for (size_t d(0); d < D; ++d)
+		{
+			coords[d] = makeCoords(count, static_cast<uint32_t>(17 + 31 * d));
+			rows[d] = coords[d].data();
+		}
+
+		const TNoise<float> noise(7);
+		for (const NoiseType type : { NoiseType::Value, NoiseType::Perlin, NoiseType::Simplex })
+		{
+			std::vector<float> batch(count);
+			noise.evaluate(type, rows, D, count, batch.data(), params);
+			for (size_t i(0); i < count; ++i)
+			{
+				const float single = samplePoint<D>(noise, type, coords, i, params);
+				CHECK(single == batch[i]);
+				CHECK(std::isfinite(batch[i]) && std::abs(batch[i]) <= 1.5f);
+			}
+		}
+	}
+
+	// 绝对值极小的负数与 0 落在同一格点边界两侧，噪声应连续（而不是跳到下一个格点的值）
+	void testTinyNegativeContinuity()
+	{
+		const TNoise<float> noise(3);
+		for (const NoiseType type : { NoiseType::Value, NoiseType::Perlin })
+		{
+			const float atZero = noise.evaluate(type, TVector2<float>(0.f, 0.25f));
+			const float below = noise.evaluate(type, TVector2<float>(-1e-8f, 0.25f));
+			CHECK(std::abs(atZero - below) < 1e-4f);
+		}
+	}
+
+	void testDoubleBatch()
+	{
+		const size_t count = 77;
+		std::vector<double> x(count), y(count), z(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			x[i] = 0.37 * i - 11.0;
+			y[i] = -0.21 * i;
+			z[i] = 1e-17 * i - 1e-16;
+		}
+		const double* rows[] = { x.data(), y.data(), z.data() };
+		const TNoise<double> noise(11);
+		std::vector<double> batch(count);
+		noise.evaluate(NoiseType::Simplex, rows, 3, count, batch.data());
+		for (size_t i(0); i < count; ++i)
+		{
+			CHECK(noise.evaluate(NoiseType::Simplex, TVector3<double>(x[i], y[i], z[i])) == batch[i]);
+		}
+	}
+}
+
+int main()
+{
+	testBatchMatchesScalar<2>(nullptr);
+	testBatchMatchesScalar<3>(nullptr);
+	testBatchMatchesScalar<4>(nullptr);
+
+	TFbmParams<float> params;
+	params.octaves = 4;
+	params.frequency = 0.37f;
+	testBatchMatchesScalar<2>(&params);
+	testBatchMatchesScalar<3>(&params);
+	testBatchMatchesScalar<4>(&params);
+
+	testTinyNegativeContinuity();
+	testDoubleBatch();
+	return test::report("NoiseTest");
+}
@@ -0,0 +1,163 @@
+#include "TestCommon.h"
+#include "vector/NormalTool.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	const NormalEncoding s_encodings[] = { NormalEncoding::Octahedral16, NormalEncoding::Octahedral24,
+		NormalEncoding::Octahedral32, NormalEncoding::Fibonacci16, NormalEncoding::Fibonacci24,
+		NormalEncoding::Fibonacci32 };
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	float randomSigned(uint32_t& state)
+	{
+		return static_cast<float>(nextRandom(state)) / 8388608.f - 1.f;
+	}
+
+	std::vector<float> randomNormals(const size_t count, uint32_t seed)
+	{
+		std::vector<float> xyz(3 * count);
+		for (size_t i(0); i < count; ++i)
+		{
+			float x, y, z, length;
+			do
+			{
+				x = randomSigned(seed);
+				y = randomSigned(seed);
+				z = randomSigned(seed);
+				length = std::sqrt(x * x + y * y + z * z);
+			} while (!(length > 1e-3f) || length > 1.f);
+			xyz[3 * i] = x / length;
+			xyz[3 * i + 1] = y / length;
+			xyz[3 * i + 2] = z / length;
+		}
+		return xyz;
+	}
+
+	double angleBetween(const float* a, const float* b)
+	{
+		const double cx = double(a[1]) * b[2] - double(a[2]) * b[1];
+		const double cy = double(a[2]) * b[0] - double(a[0]) * b[2];
+		const double cz = double(a[0]) * b[1] - double(a[1]) * b[0];
+		const double dot = double(a[0]) * b[0] + double(a[1]) * b[1] + double(a[2]) * b[2];
+		return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot);
+	}
+
+	// 编码再解码的夹角不超过 maxAngularError，坐标轴方向八面体编码精确还原
+	void testRoundTrip()
+	{
+		const size_t count = 4099;
+		std::vector<float> xyz = randomNormals(count, 7u);
+		const float axes[18] = { 1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1 };
+		xyz.insert(xyz.end(), axes, axes + 18);
+		const size_t total = xyz.size() / 3;
+
+		for (const NormalEncoding encoding : s_encodings)
+		{
+			std::vector<uint8_t> code(NormalTool::encodedSize(encoding) * total);
+			std::vector<float> decoded(3 * total);
+			NormalTool::encode(xyz.data(), total, code.data(), encoding);
+			NormalTool::decode(code.data(), total, decoded.data(), encoding);
+
+			bool within = true;
+			for (size_t i(0); i < total; ++i)
+			{
+				within = within && angleBetween(&xyz[3 * i], &decoded[3 * i]) <= NormalTool::maxAngularError(encoding);
+			}
+			CHECK(within);
+		}
+
+		std::vector<uint8_t> code(4 * 6);
+		std::vector<float> decoded(18);
+		NormalTool::encode(axes, 6, code.data(), NormalEncoding::Octahedral32);
+		NormalTool::decode(code.data(), 6, decoded.data(), NormalEncoding::Octahedral32);
+		bool exact = true;
+		for (size_t i(0); i < 18; ++i)
+		{
+			exact = exact && axes[i] == decoded[i];
+		}
+		CHECK(exact);
+	}
+
+	// SIMD 批量路径与逐个编解码（走标量路径）逐字节、逐位相同，非单位长度的输入也一样
+	void testBatchMatchesScalar()
+	{
+		const size_t count = 1027;
+		std::vector<float> xyz = randomNormals(count, 11u);
+		uint32_t seed = 13u;
+		for (size_t i(0); i < xyz.size(); ++i)
+		{
+			xyz[i] *= 0.25f + static_cast<float>(nextRandom(seed) % 64);
+		}
+
+		for (const NormalEncoding encoding : s_encodings)
+		{
+			const size_t size = NormalTool::encodedSize(encoding);
+			std::vector<uint8_t> batch(size * count), single(size * count);
+			NormalTool::encode(xyz.data(), count, batch.data(), encoding);
+			for (size_t i(0); i < count; ++i)
+			{
+				NormalTool::encode(&xyz[3 * i], 1, &single[size * i], encoding);
+			}
+			CHECK(batch == single);
+
+			std::vector<float> batchDecoded(3 * count), singleDecoded(3 * count);
+			NormalTool::decode(batch.data(), count, batchDecoded.data(), encoding);
+			for (size_t i(0); i < count; ++i)
+			{
+				NormalTool::decode(&batch[size * i], 1, &singleDecoded[3 * i], encoding);
+			}
+			CHECK(batchDecoded == singleDecoded);
+		}
+	}
+
+	// 零向量、含无穷大或 NaN 的向量在批量与标量路径上都编码为 +z
+	void testNonFinite()
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		const float xyz[24] = { inf, 0, 0, 0, -inf, 0, 0, 0, -inf, inf, inf, inf,
+			nan, 0, 0, 0, 0, nan, 0, 0, 0, -0.f, -0.f, -0.f };
+		const size_t count = 8;
+
+		for (const NormalEncoding encoding : s_encodings)
+		{
+			const size_t size = NormalTool::encodedSize(encoding);
+			std::vector<uint8_t> batch(size * count), single(size * count);
+			NormalTool::encode(xyz, count, batch.data(), encoding);
+			for (size_t i(0); i < count; ++i)
+			{
+				NormalTool::encode(&xyz[3 * i], 1, &single[size * i], encoding);
+			}
+			CHECK(batch == single);
+
+			std::vector<float> decoded(3 * count);
+			NormalTool::decode(batch.data(), count, decoded.data(), encoding);
+			const float up[3] = { 0.f, 0.f, 1.f };
+			bool towardsZ = true;
+			for (size_t i(0); i < count; ++i)
+			{
+				towardsZ = towardsZ && angleBetween(&decoded[3 * i], up) <= NormalTool::maxAngularError(encoding);
+			}
+			CHECK(towardsZ);
+		}
+	}
+}
+
+int main()
+{
+	testRoundTrip();
+	testBatchMatchesScalar();
+	testNonFinite();
+	return test::report("NormalToolTest");
+}
@@ -0,0 +1,205 @@
+#include "TestCommon.h"
+#include "geometry/Predicates.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	int sign(const double v)
+	{
+		return (v > 0.0) - (v < 0.0);
+	}
+
+	int sign(const __int128 v)
+	{
+		return (v > 0) - (v < 0);
+	}
+
+	// Kettner 等人的经典反例：p 在 0.5 附近按 ulp 扰动，q、r 与之近似共线
+	// 坐标都是 2^-53 的整数倍，用 128 位整数算出精确符号作参照
+	void testOrient2dNearCollinear()
+	{
+		const double q[] = { 12.0, 12.0 };
+		const double r[] = { 24.0, 24.0 };
+		const double ulp = std::ldexp(1.0, -53);
+		const auto fixed = [](const double v) { return static_cast<__int128>(std::ldexp(v, 53)); };
+
+		std::vector<TVector2<double>> points;
+		size_t naiveWrong(0), mismatches(0);
+		for (int i(0); i < 64; ++i)
+		{
+			for (int j(0); j < 64; ++j)
+			{
+				const double p[] = { 0.5 + i * ulp, 0.5 + j * ulp };
+				points.emplace_back(p[0], p[1]);
+
+				const __int128 exact = (fixed(q[0]) - fixed(p[0])) * (fixed(r[1]) - fixed(p[1]))
+					- (fixed(q[1]) - fixed(p[1])) * (fixed(r[0]) - fixed(p[0]));
+				const double naive = (q[0] - p[0]) * (r[1] - p[1]) - (q[1] - p[1]) * (r[0] - p[0]);
+				naiveWrong += sign(naive) != sign(exact);
+				mismatches += sign(Predicates::orient2d(q, r, p)) != sign(exact);
+			}
+		}
+		CHECK(naiveWrong > 0);
+		CHECK(0 == mismatches);
+
+		// 批量版本与单点版本符号与数值都一致
+		std::vector<double> batch(points.size());
+		const TVector2<double> vq(q[0], q[1]), vr(r[0], r[1]);
+		Predicates::orient2d(vq, vr, points.data(), points.size(), batch.data());
+		size_t batchMismatches(0);
+		for (size_t i(0); i < points.size(); ++i)
+		{
+			batchMismatches += batch[i] != Predicates::orient2d(vq, vr, points[i]);
+		}
+		CHECK(0 == batchMismatches);
+	}
+
+	// d 精确落在平面 x + y + z = 3 上为 0，沿法线微小扰动后的符号与大扰动一致
+	void testOrient3dCoplanar()
+	{
+		const double a[] = { 1.0, 1.0, 1.0 };
+		const double b[] = { 2.75, 0.125, 0.125 };
+		const double c[] = { 0.25, 2.5, 0.25 };
+		const double far[] = { 1.0, 1.0, 2.0 };
+		const int reference = sign(Predicates::orient3d(a, b, c, far));
+		CHECK(0 != reference);
+
+		const double step = std::ldexp(1.0, -30);
+		size_t mismatches(0);
+		for (int i(0); i < 40; ++i)
+		{
+			const double u = (i * 7919 % 1000) * step * 1e6, v = (i * 104729 % 1000) * step * 1e6;
+			const double on[] = { u, v, 3.0 - u - v };
+			const double above[] = { u, v, std::nextafter(on[2], 10.0) };
+			const double below[] = { u, v, std::nextafter(on[2], -10.0) };
+			mismatches += 0 != sign(Predicates::orient3d(a, b, c, on));
+			mismatches += reference != sign(Predicates::orient3d(a, b, c, above));
+			mismatches += -reference != sign(Predicates::orient3d(a, b, c, below));
+		}
+		CHECK(0 == mismatches);
+	}
+
+	// 圆心 (1024.375, -511.25)、半径 5 的整数勾股点精确共圆
+	void testIncircleCocircular()
+	{
+		const double cx = 1024.375, cy = -511.25;
+		const double a[] = { cx + 5.0, cy };
+		const double b[] = { cx + 3.0, cy + 4.0 };
+		const double c[] = { cx - 4.0, cy + 3.0 };
+		const double d[] = { cx - 3.0, cy - 4.0 };
+		CHECK(0.0 == Predicates::incircle(a, b, c, d));
+
+		const double inside[] = { std::nextafter(d[0], cx), d[1] };
+		const double outside[] = { std::nextafter(d[0], -1e9), d[1] };
+		CHECK(Predicates::incircle(a, b, c, inside) > 0.0);
+		CHECK(Predicates::incircle(a, b, c, outside) < 0.0);
+	}
+
+	// 大坐标上的近退化输入直接调用精确路径：坐标为绝对值小于 2^48 (2D) / 2^36 (3D) 的整数，
+	// 128 位整数行列式即精确值；精确路径的返回值必须与之同号，共线、共面时恰为 0
+	void testExactNearDegenerate()
+	{
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		const auto next = [&state](const int bits)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64_t>(state >> (64 - bits)) - (int64_t(1) << (bits - 1));
+		};
+
+		size_t mismatches2(0), mismatches3(0);
+		for (int i(0); i < 20000; ++i)
+		{
+			// c = a + t (b - a) + 微小扰动，t 取整数使 c 仍是整数点
+			const int64_t a[] = { next(48), next(48) };
+			const int64_t dir[] = { next(20), next(20) };
+			const int64_t t = next(8);
+			const int64_t b[] = { a[0] + dir[0], a[1] + dir[1] };
+			const int64_t c[] = { a[0] + t * dir[0] + next(2), a[1] + t * dir[1] + next(2) };
+			const __int128 exact = static_cast<__int128>(b[0] - a[0]) * (c[1] - a[1])
+				- static_cast<__int128>(b[1] - a[1]) * (c[0] - a[0]);
+			const double pa[] = { double(a[0]), double(a[1]) }, pb[] = { double(b[0]), double(b[1]) };
+			const double pc[] = { double(c[0]), double(c[1]) };
+			mismatches2 += sign(Predicates::orient2dExact(pa, pb, pc)) != sign(exact);
+			mismatches2 += sign(Predicates::orient2d(pa, pb, pc)) != sign(exact);
+
+			const int64_t p[4][3] = { { next(36), next(36), next(36) }, { next(16), next(16), next(16) },
+				{ next(16), next(16), next(16) }, { next(2), next(2), next(2) } };
+			int64_t q[4][3];
+			for (size_t k(0); k < 3; ++k)
+			{
+				q[0][k] = p[0][k];
+				q[1][k] = p[0][k] + p[1][k];
+				q[2][k] = p[0][k] + p[2][k];
+				q[3][k] = p[0][k] + 3 * p[1][k] - 2 * p[2][k] + p[3][k];
+			}
+			__int128 m[3][3];
+			for (size_t r(0); r < 3; ++r)
+			{
+				for (size_t k(0); k < 3; ++k)
+				{
+					m[r][k] = q[r][k] - q[3][k];
+				}
+			}
+			const __int128 det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+				- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+			double d[4][3];
+			for (size_t r(0); r < 4; ++r)
+			{
+				for (size_t k(0); k < 3; ++k)
+				{
+					d[r][k] = static_cast<double>(q[r][k]);
+				}
+			}
+			mismatches3 += sign(Predicates::orient3dExact(d[0], d[1], d[2], d[3])) != sign(det);
+			mismatches3 += sign(Predicates::orient3d(d[0], d[1], d[2], d[3])) != sign(det);
+		}
+		CHECK(0 == mismatches2);
+		CHECK(0 == mismatches3);
+	}
+
+	// 球心 (1000, 1000, 1000)、半径 3 的球面上取整数点
+	void testInsphereCospherical()
+	{
+		const double o = 1000.0;
+		double a[] = { o + 3.0, o, o };
+		double b[] = { o, o + 3.0, o };
+		double c[] = { o, o, o + 3.0 };
+		double d[] = { o - 3.0, o, o };
+		if (Predicates::orient3d(a, b, c, d) < 0.0)
+		{
+			std::swap(a, b);
+		}
+		CHECK(Predicates::orient3d(a, b, c, d) > 0.0);
+
+		const double e[] = { o + 2.0, o + 2.0, o + 1.0 };
+		CHECK(0.0 == Predicates::insphere(a, b, c, d, e));
+
+		const double inside[] = { std::nextafter(e[0], o), e[1], e[2] };
+		const double outside[] = { std::nextafter(e[0], 1e9), e[1], e[2] };
+		CHECK(Predicates::insphere(a, b, c, d, inside) > 0.0);
+		CHECK(Predicates::insphere(a, b, c, d, outside) < 0.0);
+
+		const TVector3<double> va(a[0], a[1], a[2]), vb(b[0], b[1], b[2]), vc(c[0], c[1], c[2]), vd(d[0], d[1], d[2]);
+		const TVector3<double> points[] = { { e[0], e[1], e[2] }, { inside[0], inside[1], inside[2] },
+			{ outside[0], outside[1], outside[2] } };
+		double batch[3];
+		Predicates::insphere(va, vb, vc, vd, points, 3, batch);
+		CHECK(0.0 == batch[0]);
+		CHECK(batch[1] > 0.0);
+		CHECK(batch[2] < 0.0);
+	}
+}
+
+int main()
+{
+	testOrient2dNearCollinear();
+	testOrient3dCoplanar();
+	testIncircleCocircular();
+	testInsphereCospherical();
+	testExactNearDegenerate();
+	return test::report("PredicatesTest");
+}
@@ -0,0 +1,170 @@
+#include "TestCommon.h"
+#include "random/Random.h"
+#include "random/TSampler.hpp"
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// Random123 的 Philox4x32-10 已知答案（计数器与密钥全 0）
+	void testPhiloxKnownAnswer()
+	{
+		uint32_t r[4];
+		Random::philox(0, 0, r);
+		CHECK(0x6627e8d5u == r[0]);
+		CHECK(0xe169c58du == r[1]);
+		CHECK(0xbc57ac4cu == r[2]);
+		CHECK(0x9b00dbd8u == r[3]);
+	}
+
+	// 批量填充（SSE2 下 4 个计数器一组）与逐个计数器的标量 Philox 逐元素相同，包括计数器低 32 位进位处
+	template <typename T>
+	void testFillMatchesScalar()
+	{
+		constexpr size_t lanes = 16 / sizeof(T);
+		const uint64_t carry = (uint64_t(1) << 32) * lanes;
+		for (const uint64_t seed : { uint64_t(0), uint64_t(0x123456789abcdef0ull) })
+		{
+			for (const uint64_t offset : { uint64_t(0), uint64_t(3), carry - 9 * lanes - 1, ~uint64_t(0) - 200 })
+			{
+				for (const size_t count : { size_t(1), size_t(5), size_t(16), size_t(37), size_t(181) })
+				{
+					std::vector<T> out(count);
+					Random::fillUniform(seed, offset, out.data(), count);
+					size_t mismatches(0);
+					for (size_t j(0); j < count; ++j)
+					{
+						const uint64_t index = offset + j;
+						uint32_t r[4];
+						Random::philox(seed, index / lanes, r);
+						const size_t lane = index % lanes;
+						T expected;
+						if constexpr (std::is_same_v<T, float>)
+						{
+							expected = Random::toFloat(r[lane]);
+						}
+						else
+						{
+							expected = Random::toDouble(r[2 * lane], r[2 * lane + 1]);
+						}
+						mismatches += expected != out[j];
+					}
+					CHECK(0 == mismatches);
+				}
+			}
+		}
+
+		// 已知答案经批量路径输出
+		std::vector<T> out(4 * lanes);
+		Random::fillUniform(0, 0, out.data(), out.size());
+		if constexpr (std::is_same_v<T, float>)
+		{
+			CHECK(Random::toFloat(0x6627e8d5u) == out[0] && Random::toFloat(0x9b00dbd8u) == out[3]);
+		}
+		else
+		{
+			CHECK(Random::toDouble(0x6627e8d5u, 0xe169c58du) == out[0]);
+			CHECK(Random::toDouble(0xbc57ac4cu, 0x9b00dbd8u) == out[1]);
+		}
+	}
+
+	// 随机流分段填充（任意偏移、跨计数器边界、跨并行分块）与一次填充逐元素相同
+	template <typename T>
+	void testStreamSegments()
+	{
+		const size_t count = 200003;
+		std::vector<T> whole(count);
+		Random::fillUniform(42, 5, whole.data(), count);
+
+		std::vector<T> pieces(count);
+		size_t begin(0);
+		for (const size_t length : { size_t(1), size_t(2), size_t(3), size_t(70001), size_t(7) })
+		{
+			Random::fillUniform(42, 5 + begin, pieces.data() + begin, length);
+			begin += length;
+		}
+		Random::fillUniform(42, 5 + begin, pieces.data() + begin, count - begin);
+
+		size_t mismatches(0), outOfRange(0);
+		double mean(0.0);
+		for (size_t i(0); i < count; ++i)
+		{
+			mismatches += whole[i] != pieces[i];
+			outOfRange += !(whole[i] >= T(0) && whole[i] < T(1));
+			mean += whole[i];
+		}
+		CHECK(0 == mismatches);
+		CHECK(0 == outOfRange);
+		CHECK(std::abs(mean / count - 0.5) < 0.01);
+	}
+
+	// 不同种子、相邻偏移给出不同的流
+	void testStreamsIndependent()
+	{
+		const size_t count = 1024;
+		std::vector<float> a(count), b(count), c(count);
+		Random::fillUniform(1, 0, a.data(), count);
+		Random::fillUniform(2, 0, b.data(), count);
+		Random::fillUniform(1, 1, c.data(), count);
+
+		size_t sameSeed(0), sameOffset(0);
+		for (size_t i(0); i < count; ++i)
+		{
+			sameSeed += a[i] == b[i];
+			sameOffset += a[i] == c[i];
+			if (i + 1 < count)
+			{
+				CHECK(a[i + 1] == c[i]);
+			}
+		}
+		CHECK(sameSeed < 4);
+		CHECK(sameOffset < 4);
+	}
+
+	void testToFloatBounds()
+	{
+		CHECK(0.f == Random::toFloat(0));
+		CHECK(Random::toFloat(0xffffffffu) < 1.f);
+		CHECK(0.0 == Random::toDouble(0, 0));
+		CHECK(Random::toDouble(0xffffffffu, 0xffffffffu) < 1.0);
+	}
+
+	// 采样器按序号分段生成与一次生成相同，方向为单位长度
+	void testSamplerSegments()
+	{
+		using Sampler = TSampler<float>;
+		const size_t count = 40000;
+		std::vector<TVector3<float>> whole(count), pieces(count);
+		Sampler::cosineHemisphere(9, 100, count, whole.data());
+		Sampler::cosineHemisphere(9, 100, 12345, pieces.data());
+		Sampler::cosineHemisphere(9, 100 + 12345, count - 12345, pieces.data() + 12345);
+
+		size_t mismatches(0), invalid(0);
+		for (size_t i(0); i < count; ++i)
+		{
+			mismatches += !(whole[i].x() == pieces[i].x() && whole[i].y() == pieces[i].y() && whole[i].z() == pieces[i].z());
+			const float length = std::sqrt(whole[i].x() * whole[i].x() + whole[i].y() * whole[i].y() +
+				whole[i].z() * whole[i].z());
+			invalid += !(std::abs(length - 1.f) < 1e-5f && whole[i].z() >= 0.f);
+		}
+		CHECK(0 == mismatches);
+		CHECK(0 == invalid);
+	}
+}
+
+int main()
+{
+	testPhiloxKnownAnswer();
+	testFillMatchesScalar<float>();
+	testFillMatchesScalar<double>();
+	testStreamSegments<float>();
+	testStreamSegments<double>();
+	testStreamsIndependent();
+	testToFloatBounds();
+	testSamplerSegments();
+	return test::report("RandomTest");
+}
@@ -0,0 +1,452 @@
+#include "TestCommon.h"
+#include "scene/TSkinning.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 超过一个并行块（4096），且不是 4 的整数倍，覆盖 SSE2 分组与标量尾部
+	constexpr size_t s_vertexCount = 4096 + 1027;
+	constexpr size_t s_boneCount = 7;
+
+	struct Random
+	{
+		uint64_t state;
+
+		double next(const double low, const double high)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return low + (high - low) * static_cast<double>(state >> 11) * 0x1.0p-53;
+		}
+	};
+
+	struct Mesh
+	{
+		std::vector<double> position[3];
+		std::vector<double> normal[3];
+		std::vector<int> indices;
+		std::vector<double> weights;
+	};
+
+	// 法线为单位向量，权重和为 1，部分顶点只有一根或两根骨骼
+	Mesh randomMesh(Random& random)
+	{
+		Mesh mesh;
+		for (size_t c(0); c < 3; ++c)
+		{
+			mesh.position[c].resize(s_vertexCount);
+			mesh.normal[c].resize(s_vertexCount);
+		}
+		mesh.indices.resize(4 * s_vertexCount);
+		mesh.weights.resize(4 * s_vertexCount);
+		for (size_t i(0); i < s_vertexCount; ++i)
+		{
+			double n[3], len2(0.0);
+			for (size_t c(0); c < 3; ++c)
+			{
+				mesh.position[c][i] = random.next(-10, 10);
+				n[c] = random.next(-1, 1);
+				len2 += n[c] * n[c];
+			}
+			for (size_t c(0); c < 3; ++c)
+			{
+				mesh.normal[c][i] = n[c] / std::sqrt(len2);
+			}
+
+			const size_t used = 1 + i % 4;
+			double sum(0.0);
+			for (size_t k(0); k < 4; ++k)
+			{
+				mesh.indices[4 * i + k] = static_cast<int>(random.next(0, s_boneCount));
+				mesh.weights[4 * i + k] = k < used ? random.next(0.1, 1) : 0.0;
+				sum += mesh.weights[4 * i + k];
+			}
+			for (size_t k(0); k < 4; ++k)
+			{
+				mesh.weights[4 * i + k] /= sum;
+			}
+		}
+		return mesh;
+	}
+
+	void randomQuaternion(Random& random, double q[4])
+	{
+		double len2(0.0);
+		for (size_t c(0); c < 4; ++c)
+		{
+			q[c] = random.next(-1, 1);
+			len2 += q[c] * q[c];
+		}
+		for (size_t c(0); c < 4; ++c)
+		{
+			q[c] /= std::sqrt(len2);
+		}
+	}
+
+	void rotationMatrix(const double q[4], double r[3][3])
+	{
+		const double x = q[0], y = q[1], z = q[2], w = q[3];
+		r[0][0] = 1 - 2 * (y * y + z * z); r[0][1] = 2 * (x * y - w * z); r[0][2] = 2 * (x * z + w * y);
+		r[1][0] = 2 * (x * y + w * z); r[1][1] = 1 - 2 * (x * x + z * z); r[1][2] = 2 * (y * z - w * x);
+		r[2][0] = 2 * (x * z - w * y); r[2][1] = 2 * (y * z + w * x); r[2][2] = 1 - 2 * (x * x + y * y);
+	}
+
+	// Hamilton 积，分量顺序 (x, y, z, w)
+	void multiply(const double a[4], const double b[4], double r[4])
+	{
+		r[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+		r[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+		r[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+		r[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+	}
+
+	template <typename T>
+	struct Buffers
+	{
+		std::vector<T> position[3];
+		std::vector<T> normal[3];
+		std::vector<T> outPosition[3];
+		std::vector<T> outNormal[3];
+		std::vector<TVector4<int>> indices;
+		std::vector<TVector4<T>> weights;
+
+		explicit Buffers(const Mesh& mesh)
+			: indices(s_vertexCount), weights(s_vertexCount)
+		{
+			for (size_t c(0); c < 3; ++c)
+			{
+				position[c].assign(mesh.position[c].begin(), mesh.position[c].end());
+				normal[c].assign(mesh.normal[c].begin(), mesh.normal[c].end());
+				outPosition[c].assign(s_vertexCount, T(0));
+				outNormal[c].assign(s_vertexCount, T(0));
+			}
+			for (size_t i(0); i < s_vertexCount; ++i)
+			{
+				const int* idx = &mesh.indices[4 * i];
+				const double* w = &mesh.weights[4 * i];
+				indices[i] = TVector4<int>(idx[0], idx[1], idx[2], idx[3]);
+				weights[i] = TVector4<T>(T(w[0]), T(w[1]), T(w[2]), T(w[3]));
+			}
+		}
+
+		typename TSkinning<T>::ConstStreams in(const bool normals) const
+		{
+			const std::vector<T>* s = normals ? normal : position;
+			return { s[0].data(), s[1].data(), s[2].data() };
+		}
+
+		typename TSkinning<T>::Streams out(const bool normals)
+		{
+			std::vector<T>* s = normals ? outNormal : outPosition;
+			return { s[0].data(), s[1].data(), s[2].data() };
+		}
+	};
+
+	// 输出与参照的最大误差，按 1 + |参照| 归一
+	template <typename T>
+	double maxError(const std::vector<T> (&actual)[3], const std::vector<double> (&expected)[3])
+	{
+		double error(0.0);
+		for (size_t c(0); c < 3; ++c)
+		{
+			for (size_t i(0); i < s_vertexCount; ++i)
+			{
+				const double e = std::abs(static_cast<double>(actual[c][i]) - expected[c][i])
+					/ (1.0 + std::abs(expected[c][i]));
+				error = std::isnan(e) ? 1e300 : std::max(error, e);
+			}
+		}
+		return error;
+	}
+
+	void normalize(std::vector<double> (&v)[3], const size_t i)
+	{
+		const double len = std::sqrt(v[0][i] * v[0][i] + v[1][i] * v[1][i] + v[2][i] * v[2][i]);
+		for (size_t c(0); c < 3; ++c)
+		{
+			v[c][i] /= len;
+		}
+	}
+
+	// 带缩放与切变的一般仿射骨骼，与双精度逐顶点混合矩阵比较
+	template <typename T>
+	void testLinearBlend(const double tolerance)
+	{
+		Random random{ 7u };
+		const Mesh mesh = randomMesh(random);
+		double bones[s_boneCount][3][4];
+		std::vector<typename TSkinning<T>::Matrix> palette(s_boneCount);
+		for (size_t b(0); b < s_boneCount; ++b)
+		{
+			for (size_t r(0); r < 3; ++r)
+			{
+				for (size_t c(0); c < 4; ++c)
+				{
+					const double value = c < 3 ? random.next(-1.5, 1.5) : random.next(-5, 5);
+					bones[b][r][c] = static_cast<double>(static_cast<T>(value));
+				}
+				palette[b][r] = TVector4<T>(T(bones[b][r][0]), T(bones[b][r][1]), T(bones[b][r][2]), T(bones[b][r][3]));
+			}
+		}
+
+		Buffers<T> buffers(mesh);
+		std::vector<double> position[3], normal[3];
+		for (size_t c(0); c < 3; ++c)
+		{
+			position[c].resize(s_vertexCount);
+			normal[c].resize(s_vertexCount);
+		}
+		for (size_t i(0); i < s_vertexCount; ++i)
+		{
+			double m[3][4] = {};
+			for (size_t k(0); k < 4; ++k)
+			{
+				const double w = static_cast<double>(buffers.weights[i].data()[k]);
+				for (size_t r(0); r < 3; ++r)
+				{
+					for (size_t c(0); c < 4; ++c)
+					{
+						m[r][c] += w * bones[mesh.indices[4 * i + k]][r][c];
+					}
+				}
+			}
+			const double p[3] = { static_cast<double>(buffers.position[0][i]), static_cast<double>(buffers.position[1][i]),
+				static_cast<double>(buffers.position[2][i]) };
+			const double n[3] = { static_cast<double>(buffers.normal[0][i]), static_cast<double>(buffers.normal[1][i]),
+				static_cast<double>(buffers.normal[2][i]) };
+			for (size_t r(0); r < 3; ++r)
+			{
+				position[r][i] = m[r][0] * p[0] + m[r][1] * p[1] + m[r][2] * p[2] + m[r][3];
+				normal[r][i] = m[r][0] * n[0] + m[r][1] * n[1] + m[r][2] * n[2];
+			}
+			normalize(normal, i);
+		}
+
+		CHECK(TSkinning<T>::linearBlend(palette.data(), s_boneCount, buffers.indices.data(), buffers.weights.data(),
+			s_vertexCount, buffers.in(false), buffers.out(false), buffers.in(true), buffers.out(true)));
+		CHECK(maxError(buffers.outPosition, position) < tolerance);
+		CHECK(maxError(buffers.outNormal, normal) < tolerance);
+
+		// 输出与输入为同一数组
+		CHECK(TSkinning<T>::linearBlend(palette.data(), s_boneCount, buffers.indices.data(), buffers.weights.data(),
+			s_vertexCount, buffers.in(false), { buffers.position[0].data(), buffers.position[1].data(),
+			buffers.position[2].data() }));
+		CHECK(maxError(buffers.position, position) < tolerance);
+	}
+
+	// 刚体骨骼（部分旋转取反半球），与双精度的半球对齐、混合、归一化后转为矩阵的结果比较
+	template <typename T>
+	void testDualQuaternion(const double tolerance)
+	{
+		Random random{ 11u };
+		const Mesh mesh = randomMesh(random);
+		double real[s_boneCount][4], dual[s_boneCount][4];
+		std::vector<typename TSkinning<T>::DualQuaternion> palette(s_boneCount);
+		for (size_t b(0); b < s_boneCount; ++b)
+		{
+			double q[4];
+			randomQuaternion(random, q);
+			const TVector3<T> t(T(random.next(-5, 5)), T(random.next(-5, 5)), T(random.next(-5, 5)));
+			palette[b] = TSkinning<T>::toDualQuaternion(TVector4<T>(T(q[0]), T(q[1]), T(q[2]), T(q[3])), t);
+			for (size_t c(0); c < 4; ++c)
+			{
+				real[b][c] = static_cast<double>(palette[b].real.data()[c]);
+				dual[b][c] = static_cast<double>(palette[b].dual.data()[c]);
+			}
+		}
+
+		Buffers<T> buffers(mesh);
+		std::vector<double> position[3], normal[3];
+		for (size_t c(0); c < 3; ++c)
+		{
+			position[c].resize(s_vertexCount);
+			normal[c].resize(s_vertexCount);
+		}
+		for (size_t i(0); i < s_vertexCount; ++i)
+		{
+			const double* q0 = real[mesh.indices[4 * i]];
+			double r[4] = {}, d[4] = {};
+			for (size_t k(0); k < 4; ++k)
+			{
+				const size_t b = mesh.indices[4 * i + k];
+				const double dot = real[b][0] * q0[0] + real[b][1] * q0[1] + real[b][2] * q0[2] + real[b][3] * q0[3];
+				const double w = (dot < 0.0 ? -1.0 : 1.0) * static_cast<double>(buffers.weights[i].data()[k]);
+				for (size_t c(0); c < 4; ++c)
+				{
+					r[c] += w * real[b][c];
+					d[c] += w * dual[b][c];
+				}
+			}
+			const double len = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+			for (size_t c(0); c < 4; ++c)
+			{
+				r[c] /= len;
+				d[c] /= len;
+			}
+
+			// t = 2 * d * conj(r)
+			const double conjugate[4] = { -r[0], -r[1], -r[2], r[3] };
+			double t[4];
+			multiply(d, conjugate, t);
+			double m[3][3];
+			rotationMatrix(r, m);
+			const double p[3] = { static_cast<double>(buffers.position[0][i]), static_cast<double>(buffers.position[1][i]),
+				static_cast<double>(buffers.position[2][i]) };
+			const double n[3] = { static_cast<double>(buffers.normal[0][i]), static_cast<double>(buffers.normal[1][i]),
+				static_cast<double>(buffers.normal[2][i]) };
+			for (size_t row(0); row < 3; ++row)
+			{
+				position[row][i] = m[row][0] * p[0] + m[row][1] * p[1] + m[row][2] * p[2] + 2.0 * t[row];
+				normal[row][i] = m[row][0] * n[0] + m[row][1] * n[1] + m[row][2] * n[2];
+			}
+		}
+
+		CHECK(TSkinning<T>::dualQuaternion(palette.data(), s_boneCount, buffers.indices.data(), buffers.weights.data(),
+			s_vertexCount, buffers.in(false), buffers.out(false), buffers.in(true), buffers.out(true)));
+		CHECK(maxError(buffers.outPosition, position) < tolerance);
+		CHECK(maxError(buffers.outNormal, normal) < tolerance);
+	}
+
+	// 单位骨骼：权重和精确为 1 时位置逐位不变，法线在舍入误差内不变
+	template <typename T>
+	void testIdentity()
+	{
+		Random random{ 13u };
+		const Mesh mesh = randomMesh(random);
+		Buffers<T> buffers(mesh);
+		for (TVector4<T>& w : buffers.weights)
+		{
+			w = TVector4<T>(T(0.5), T(0.25), T(0.125), T(0.125));
+		}
+
+		const T one(1), zero(0);
+		std::vector<typename TSkinning<T>::Matrix> matrices(s_boneCount, typename TSkinning<T>::Matrix{
+			TVector4<T>(one, zero, zero, zero), TVector4<T>(zero, one, zero, zero), TVector4<T>(zero, zero, one, zero) });
+		std::vector<typename TSkinning<T>::DualQuaternion> dualQuaternions(s_boneCount,
+			TSkinning<T>::toDualQuaternion(TVector4<T>(zero, zero, zero, one), TVector3<T>(zero, zero, zero)));
+
+		std::vector<double> normal[3];
+		for (size_t c(0); c < 3; ++c)
+		{
+			normal[c].assign(buffers.normal[c].begin(), buffers.normal[c].end());
+		}
+		for (size_t i(0); i < s_vertexCount; ++i)
+		{
+			normalize(normal, i);
+		}
+
+		for (const bool dq : { false, true })
+		{
+			const bool valid = dq
+				? TSkinning<T>::dualQuaternion(dualQuaternions.data(), s_boneCount, buffers.indices.data(),
+					buffers.weights.data(), s_vertexCount, buffers.in(false), buffers.out(false), buffers.in(true),
+					buffers.out(true))
+				: TSkinning<T>::linearBlend(matrices.data(), s_boneCount, buffers.indices.data(), buffers.weights.data(),
+					s_vertexCount, buffers.in(false), buffers.out(false), buffers.in(true), buffers.out(true));
+			CHECK(valid);
+			for (size_t c(0); c < 3; ++c)
+			{
+				CHECK(buffers.position[c] == buffers.outPosition[c]);
+			}
+			CHECK(maxError(buffers.outNormal, normal) < (sizeof(T) == sizeof(float) ? 1e-6 : 1e-14));
+		}
+	}
+
+	// 单根刚体骨骼：由矩阵构造的对偶四元数蒙皮与直接乘矩阵一致；旋转覆盖 toDualQuaternion 的四个分支
+	template <typename T>
+	void testSingleRigidBone(const double tolerance)
+	{
+		Random random{ 17u };
+		const Mesh mesh = randomMesh(random);
+		const double h = std::sqrt(0.5);
+		const double rotations[][4] = { { 0.1, -0.2, 0.3, 0.9 }, { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 },
+			{ h, 0.0, h, 0.0 }, { 0.2, 0.9, -0.3, 0.1 } };
+		for (const double (&rotation)[4] : rotations)
+		{
+			double q[4], len2(0.0);
+			for (size_t c(0); c < 4; ++c)
+			{
+				len2 += rotation[c] * rotation[c];
+			}
+			for (size_t c(0); c < 4; ++c)
+			{
+				q[c] = rotation[c] / std::sqrt(len2);
+			}
+			double m[3][3];
+			rotationMatrix(q, m);
+			const double t[3] = { random.next(-5, 5), random.next(-5, 5), random.next(-5, 5) };
+			typename TSkinning<T>::Matrix matrix;
+			for (size_t r(0); r < 3; ++r)
+			{
+				matrix[r] = TVector4<T>(T(m[r][0]), T(m[r][1]), T(m[r][2]), T(t[r]));
+			}
+			const typename TSkinning<T>::DualQuaternion bone = TSkinning<T>::toDualQuaternion(matrix);
+
+			Buffers<T> buffers(mesh);
+			for (size_t i(0); i < s_vertexCount; ++i)
+			{
+				buffers.indices[i] = TVector4<int>(0, 0, 0, 0);
+				buffers.weights[i] = TVector4<T>(T(1), T(0), T(0), T(0));
+			}
+			std::vector<double> position[3], normal[3];
+			for (size_t r(0); r < 3; ++r)
+			{
+				position[r].resize(s_vertexCount);
+				normal[r].resize(s_vertexCount);
+				for (size_t i(0); i < s_vertexCount; ++i)
+				{
+					const double p[3] = { mesh.position[0][i], mesh.position[1][i], mesh.position[2][i] };
+					const double n[3] = { mesh.normal[0][i], mesh.normal[1][i], mesh.normal[2][i] };
+					position[r][i] = m[r][0] * p[0] + m[r][1] * p[1] + m[r][2] * p[2] + t[r];
+					normal[r][i] = m[r][0] * n[0] + m[r][1] * n[1] + m[r][2] * n[2];
+				}
+			}
+
+			CHECK(TSkinning<T>::dualQuaternion(&bone, 1, buffers.indices.data(), buffers.weights.data(), s_vertexCount,
+				buffers.in(false), buffers.out(false), buffers.in(true), buffers.out(true)));
+			CHECK(maxError(buffers.outPosition, position) < tolerance);
+			CHECK(maxError(buffers.outNormal, normal) < tolerance);
+		}
+	}
+
+	// 骨骼下标越界或缺少输出流时返回 false，不写入输出
+	void testInvalid()
+	{
+		Random random{ 19u };
+		const Mesh mesh = randomMesh(random);
+		Buffers<float> buffers(mesh);
+		const TSkinning<float>::Matrix bone{ TVector4<float>(1.f, 0.f, 0.f, 1.f), TVector4<float>(0.f, 1.f, 0.f, 0.f),
+			TVector4<float>(0.f, 0.f, 1.f, 0.f) };
+		buffers.indices[s_vertexCount - 1] = TVector4<int>(0, 0, 1, 0);
+		CHECK(!TSkinning<float>::linearBlend(&bone, 1, buffers.indices.data(), buffers.weights.data(), s_vertexCount,
+			buffers.in(false), buffers.out(false)));
+		buffers.indices[s_vertexCount - 1] = TVector4<int>(0, -1, 0, 0);
+		const TSkinning<float>::DualQuaternion dq = TSkinning<float>::toDualQuaternion(bone);
+		CHECK(!TSkinning<float>::dualQuaternion(&dq, 1, buffers.indices.data(), buffers.weights.data(), s_vertexCount,
+			buffers.in(false), buffers.out(false)));
+		buffers.indices[s_vertexCount - 1] = TVector4<int>(0, 0, 0, 0);
+		CHECK(!TSkinning<float>::linearBlend(&bone, 1, buffers.indices.data(), buffers.weights.data(), s_vertexCount,
+			buffers.in(false), buffers.out(false), buffers.in(true), {}));
+		for (size_t c(0); c < 3; ++c)
+		{
+			CHECK(std::vector<float>(s_vertexCount, 0.f) == buffers.outPosition[c]);
+		}
+	}
+}
+
+int main()
+{
+	testLinearBlend<float>(1e-5);
+	testLinearBlend<double>(1e-13);
+	testDualQuaternion<float>(1e-5);
+	testDualQuaternion<double>(1e-13);
+	testIdentity<float>();
+	testIdentity<double>();
+	testSingleRigidBone<float>(1e-5);
+	testSingleRigidBone<double>(1e-13);
+	testInvalid();
+	return test::report("SkinningTest");
+}
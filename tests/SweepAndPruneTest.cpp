@@ -0,0 +1,161 @@
+#include "TestCommon.h"
+#include "geometry/TSweepAndPrune.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	template <typename T>
+	using Boxes = std::vector<TVector3<T>>;
+
+	template <typename T>
+	std::vector<std::pair<uint32_t, uint32_t>> bruteForce(const Boxes<T>& minimum, const Boxes<T>& maximum)
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		for (uint32_t i(0); i < minimum.size(); ++i)
+		{
+			for (uint32_t j(i + 1); j < minimum.size(); ++j)
+			{
+				bool overlap(true);
+				for (size_t a(0); a < 3; ++a)
+				{
+					overlap = overlap && minimum[i].data()[a] <= maximum[j].data()[a]
+						&& minimum[j].data()[a] <= maximum[i].data()[a];
+				}
+				if (overlap)
+				{
+					pairs.emplace_back(i, j);
+				}
+			}
+		}
+		return pairs;
+	}
+
+	template <typename T>
+	std::vector<std::pair<uint32_t, uint32_t>> broadphase(TSweepAndPrune<T>& sap, const Boxes<T>& minimum,
+		const Boxes<T>& maximum, bool& updated)
+	{
+		updated = sap.update(minimum.data(), maximum.data(), minimum.size());
+		std::vector<BroadphasePair> found;
+		sap.findPairs(found);
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		for (const BroadphasePair& pair : found)
+		{
+			pairs.emplace_back(pair.first, pair.second);
+		}
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	template <typename T>
+	void makeBoxes(const size_t count, const T spread, const T size, uint32_t seed, Boxes<T>& minimum, Boxes<T>& maximum)
+	{
+		minimum.clear();
+		maximum.clear();
+		for (size_t i(0); i < count; ++i)
+		{
+			T lo[3], hi[3];
+			for (size_t a(0); a < 3; ++a)
+			{
+				lo[a] = static_cast<T>(nextRandom(seed) % 4096) / T(4096) * spread * (a == 0 ? T(4) : T(1));
+				hi[a] = lo[a] + static_cast<T>(nextRandom(seed) % 64) / T(64) * size;
+			}
+			minimum.emplace_back(lo[0], lo[1], lo[2]);
+			maximum.emplace_back(hi[0], hi[1], hi[2]);
+		}
+	}
+
+	// float 下次轴测试走 SSE2，double 走标量；两者与暴力枚举一致，并在帧间移动后保持一致
+	void testMatchesBruteForce()
+	{
+		Boxes<float> minF, maxF;
+		makeBoxes<float>(3000, 100.f, 3.f, 5, minF, maxF);
+		Boxes<double> minD, maxD;
+		for (size_t i(0); i < minF.size(); ++i)
+		{
+			minD.emplace_back(minF[i].x(), minF[i].y(), minF[i].z());
+			maxD.emplace_back(maxF[i].x(), maxF[i].y(), maxF[i].z());
+		}
+
+		TSweepAndPrune<float> sapF;
+		TSweepAndPrune<double> sapD;
+		for (int frame(0); frame < 3; ++frame)
+		{
+			bool updatedF(false), updatedD(false);
+			const auto expected = bruteForce(minD, maxD);
+			CHECK(!expected.empty());
+			CHECK(broadphase(sapF, minF, maxF, updatedF) == expected);
+			CHECK(broadphase(sapD, minD, maxD, updatedD) == expected);
+			CHECK(updatedF && updatedD);
+			CHECK(sapF.cellCount() > 1);
+
+			for (size_t i(0); i < minF.size(); i += 3)
+			{
+				const float shift = 0.25f * static_cast<float>(frame + 1);
+				minF[i].set(minF[i].x() + shift, minF[i].y(), minF[i].z());
+				maxF[i].set(maxF[i].x() + shift, maxF[i].y(), maxF[i].z());
+				minD[i].set(minF[i].x(), minF[i].y(), minF[i].z());
+				maxD[i].set(maxF[i].x(), maxF[i].y(), maxF[i].z());
+			}
+		}
+	}
+
+	// 次轴范围为非规格化数或小到 cells / range 溢出：只用一个格子，不得把 NaN 转换为整数
+	template <typename T>
+	void testTinyRange(const T tiny)
+	{
+		Boxes<T> minimum, maximum;
+		for (size_t i(0); i < 256; ++i)
+		{
+			const T x = static_cast<T>(i % 32);
+			const T offset = (0 == i % 2) ? T(0) : tiny;
+			minimum.emplace_back(x, offset, offset);
+			maximum.emplace_back(x + T(0.5), offset, offset);
+		}
+
+		TSweepAndPrune<T> sap;
+		bool updated(false);
+		const auto pairs = broadphase(sap, minimum, maximum, updated);
+		CHECK(updated);
+		CHECK(pairs == bruteForce(minimum, maximum));
+	}
+
+	void testInvalidInput()
+	{
+		Boxes<float> minimum = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f } };
+		Boxes<float> maximum = { { 1.f, 1.f, 1.f }, { 2.f, 2.f, 2.f } };
+		TSweepAndPrune<float> sap;
+		bool updated(false);
+		CHECK(1 == broadphase(sap, minimum, maximum, updated).size());
+
+		maximum[1].set(std::numeric_limits<float>::infinity(), 2.f, 2.f);
+		CHECK(!sap.update(minimum.data(), maximum.data(), minimum.size()));
+		CHECK(0 == sap.size());
+
+		maximum[1].set(std::numeric_limits<float>::quiet_NaN(), 2.f, 2.f);
+		CHECK(!sap.update(minimum.data(), maximum.data(), minimum.size()));
+		CHECK(sap.update(minimum.data(), maximum.data(), 0));
+	}
+}
+
+int main()
+{
+	testMatchesBruteForce();
+	testTinyRange<float>(std::numeric_limits<float>::denorm_min());
+	testTinyRange<float>(1e-38f);
+	testTinyRange<double>(std::numeric_limits<double>::denorm_min());
+	testTinyRange<double>(1e-306);
+	testInvalidInput();
+	return test::report("SweepAndPruneTest");
+}
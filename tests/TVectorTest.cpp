@@ -0,0 +1,240 @@
+#include "TestCommon.h"
+#include "vector/TVector.hpp"
+#include "vector/TVectorTraits.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+using namespace math;
+
+namespace
+{
+	// 维数、分量类型与内存布局：N 为 5（SSE 下走标量展开）、8 与 16（按 128 位通道成组）
+	template <size_t N, typename T>
+	constexpr bool checkTraits()
+	{
+		using Vector = TVector<N, T>;
+		static_assert(N == TVectorTraits<Vector>::s_size);
+		static_assert(std::is_same_v<T, typename TVectorTraits<Vector>::Scalar>);
+		static_assert(N == Vector::s_size);
+		static_assert(std::is_same_v<T, typename Vector::Scalar>);
+		static_assert(vectortype<Vector>);
+		static_assert(sizeof(Vector) == N * sizeof(T));
+		static_assert(std::is_trivially_copyable_v<Vector>);
+		static_assert(std::is_same_v<std::array<T, N>, decltype(TVectorTraits<Vector>::components(Vector()))>);
+		return true;
+	}
+
+	static_assert(checkTraits<5, float>() && checkTraits<5, double>() && checkTraits<5, int>());
+	static_assert(checkTraits<8, float>() && checkTraits<8, double>());
+	static_assert(checkTraits<16, float>() && checkTraits<16, double>());
+	static_assert(!vectortype<std::array<float, 8>>);
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	template <size_t N, typename T>
+	std::array<T, N> randomArray(uint32_t& state)
+	{
+		std::array<T, N> values;
+		for (size_t i(0); i < N; ++i)
+		{
+			values[i] = static_cast<T>(static_cast<double>(nextRandom(state)) * (8.0 / 16777216.0) - 4.0);
+		}
+		return values;
+	}
+
+	template <size_t N, typename T, typename Op>
+	std::array<T, N> scalarLoop(const std::array<T, N>& a, const std::array<T, N>& b, Op op)
+	{
+		std::array<T, N> result;
+		for (size_t i(0); i < N; ++i)
+		{
+			result[i] = op(a[i], b[i]);
+		}
+		return result;
+	}
+
+	template <size_t N, typename T>
+	std::array<T, N> scalarLoop(const std::array<T, N>& a, const T s, T (*op)(T, T))
+	{
+		std::array<T, N> result;
+		for (size_t i(0); i < N; ++i)
+		{
+			result[i] = op(a[i], s);
+		}
+		return result;
+	}
+
+	template <typename T>
+	T mul(const T a, const T b)
+	{
+		return a * b;
+	}
+
+	template <typename T>
+	T div(const T a, const T b)
+	{
+		return a / b;
+	}
+
+	// 逐分量运算在 IEEE 下与标量循环逐位相同，SIMD 通道与标量展开都不能改变结果
+	template <size_t N, typename T>
+	void testArithmetic()
+	{
+		using Vector = TVector<N, T>;
+		uint32_t state = static_cast<uint32_t>(N * 31 + sizeof(T));
+		for (size_t round(0); round < 50; ++round)
+		{
+			const std::array<T, N> a = randomArray<N, T>(state);
+			const std::array<T, N> b = randomArray<N, T>(state);
+			const T s = static_cast<T>(static_cast<double>(nextRandom(state)) / 16777216.0 * 3.0 + 0.25);
+			const Vector va(a), vb(b);
+
+			CHECK((va + vb).components() == scalarLoop(a, b, std::plus<T>()));
+			CHECK((va - vb).components() == scalarLoop(a, b, std::minus<T>()));
+			CHECK(va.multiply(vb).components() == scalarLoop(a, b, std::multiplies<T>()));
+			CHECK(((va * s).components() == scalarLoop<N, T>(a, s, mul<T>)));
+			CHECK(((s * va).components() == scalarLoop<N, T>(a, s, mul<T>)));
+			CHECK(((va / s).components() == scalarLoop<N, T>(a, s, div<T>)));
+			CHECK(((-va).components() == scalarLoop<N, T>(a, T(-1), mul<T>)));
+
+			Vector vc(va);
+			vc += vb;
+			CHECK(vc == va + vb);
+			vc -= vb;
+			CHECK(vc.components() == scalarLoop(scalarLoop(a, b, std::plus<T>()), b, std::minus<T>()));
+			vc = va;
+			vc *= s;
+			CHECK(vc == va * s);
+			vc = va;
+			vc /= s;
+			CHECK(vc == va / s);
+		}
+	}
+
+	// 点乘、长度与距离：SIMD 通道改变求和顺序，与双精度标量循环比较相对误差
+	template <size_t N, typename T>
+	void testDotLength(const double tolerance)
+	{
+		using Vector = TVector<N, T>;
+		uint32_t state = static_cast<uint32_t>(N * 17 + sizeof(T));
+		double dotError(0.0), lengthError(0.0), distanceError(0.0), unitError(0.0);
+		for (size_t round(0); round < 200; ++round)
+		{
+			const std::array<T, N> a = randomArray<N, T>(state);
+			const std::array<T, N> b = randomArray<N, T>(state);
+			const Vector va(a), vb(b);
+
+			double dot(0.0), aa(0.0), scale(0.0), dd(0.0);
+			for (size_t i(0); i < N; ++i)
+			{
+				dot += static_cast<double>(a[i]) * b[i];
+				aa += static_cast<double>(a[i]) * a[i];
+				scale += std::abs(static_cast<double>(a[i]) * b[i]);
+				const double d = static_cast<double>(b[i]) - a[i];
+				dd += d * d;
+			}
+			dotError = std::max(dotError, std::abs(va.dot(vb) - dot) / scale);
+			dotError = std::max(dotError, std::abs(va * vb - dot) / scale);
+			lengthError = std::max(lengthError, std::abs(va.squaredLength() - aa) / aa);
+			lengthError = std::max(lengthError, std::abs(va.length() - std::sqrt(aa)) / std::sqrt(aa));
+			lengthError = std::max(lengthError, std::abs(va.template length<PrecisionPolicy::Promoted>()
+				- std::sqrt(aa)) / std::sqrt(aa));
+			distanceError = std::max(distanceError, std::abs(va.distanceTo(vb) - std::sqrt(dd)) / std::sqrt(dd));
+
+			const Vector unit = va.makeNormalize();
+			for (size_t i(0); i < N; ++i)
+			{
+				unitError = std::max(unitError, std::abs(unit[static_cast<int>(i)] - a[i] / std::sqrt(aa)));
+			}
+		}
+		CHECK(dotError < tolerance);
+		CHECK(lengthError < tolerance);
+		CHECK(distanceError < tolerance);
+		CHECK(unitError < tolerance);
+
+		// 零向量归一化保持为零
+		Vector zero;
+		zero.normalized();
+		CHECK(zero == Vector(T(0)));
+	}
+
+	// 构造、下标与除零：Checked 策略下越界读取与除零得到 NaN
+	template <size_t N, typename T>
+	void testAccess()
+	{
+		using Vector = TVector<N, T>;
+		std::array<T, N> values;
+		for (size_t i(0); i < N; ++i)
+		{
+			values[i] = static_cast<T>(i + 1);
+		}
+		Vector v(values);
+		bool indexed = true;
+		for (size_t i(0); i < N; ++i)
+		{
+			indexed = indexed && static_cast<T>(i + 1) == v[static_cast<int>(i)] && v.data()[i] == values[i];
+		}
+		CHECK(indexed);
+		CHECK(std::isnan(static_cast<const Vector&>(v)[static_cast<int>(N)]));
+		CHECK(std::isnan(static_cast<const Vector&>(v)[-1]));
+
+		const Vector invalid = v / T(0);
+		bool allNaN = true;
+		for (size_t i(0); i < N; ++i)
+		{
+			allNaN = allNaN && std::isnan(invalid[static_cast<int>(i)]);
+		}
+		CHECK(allNaN);
+
+		v.fill(T(2));
+		CHECK(v == Vector(T(2)));
+		v.makeZero();
+		CHECK(v == Vector());
+
+		// +0 与 -0 相等，哈希也相同
+		const Vector negativeZero = -Vector();
+		CHECK(negativeZero == Vector());
+		CHECK(std::hash<Vector>()(negativeZero) == std::hash<Vector>()(Vector()));
+	}
+
+	void testVariadic()
+	{
+		const TVector<5, float> v(1.f, 2, 3.0, 4.f, 5u);
+		CHECK((v == TVector<5, float>(std::array<float, 5>{ 1.f, 2.f, 3.f, 4.f, 5.f })));
+
+		// 整数分量的长度先精确求和，按 double 返回
+		const TVector<5, int> w(1, 2, 3, 4, 5);
+		CHECK(55 == w.squaredLength());
+		CHECK(std::sqrt(55.0) == w.length());
+		CHECK((TVector<5, int>(2, 4, 6, 8, 10) == w * 2));
+	}
+}
+
+int main()
+{
+	testArithmetic<5, float>();
+	testArithmetic<5, double>();
+	testArithmetic<8, float>();
+	testArithmetic<8, double>();
+	testArithmetic<16, float>();
+	testArithmetic<16, double>();
+	testDotLength<5, float>(2e-6);
+	testDotLength<5, double>(1e-14);
+	testDotLength<8, float>(2e-6);
+	testDotLength<8, double>(1e-14);
+	testDotLength<16, float>(2e-6);
+	testDotLength<16, double>(1e-14);
+	testAccess<5, float>();
+	testAccess<8, double>();
+	testAccess<16, float>();
+	testVariadic();
+	return test::report("TVectorTest");
+}
@@ -0,0 +1,150 @@
+#include "TestCommon.h"
+#include "parallel/TaskGraph.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 逐块依赖：后继第 c 块执行时前驱第 c 块已完成
+	void testChunkDependency(ThreadPool& pool)
+	{
+		const size_t count = 10000;
+		std::vector<int> a(count, 0), b(count, 0);
+		TaskGraph graph;
+		const TaskGraph::TaskId first = graph.addParallelTask(0, count, 64, [&](size_t begin, size_t end)
+		{
+			for (size_t i(begin); i < end; ++i)
+			{
+				a[i] = static_cast<int>(i);
+			}
+		});
+		const TaskGraph::TaskId second = graph.addParallelTask(0, count, 64, [&](size_t begin, size_t end)
+		{
+			for (size_t i(begin); i < end; ++i)
+			{
+				b[i] = a[i] * 2;
+			}
+		});
+		CHECK(graph.addChunkDependency(first, second));
+
+		std::atomic<int> total{ 0 };
+		const TaskGraph::TaskId last = graph.addTask([&]()
+		{
+			int sum(0);
+			for (size_t i(0); i < count; i += 1000)
+			{
+				sum += b[i];
+			}
+			total = sum;
+		});
+		CHECK(graph.addDependency(second, last));
+
+		for (int round(0); round < 3; ++round)
+		{
+			total = -1;
+			CHECK(graph.run(pool));
+			CHECK(90000 == total.load());
+		}
+	}
+
+	// 空区间的分块任务不调用 func，但仍释放整体与逐块后继
+	void testEmptyRange(ThreadPool& pool)
+	{
+		TaskGraph graph;
+		std::atomic<int> calls{ 0 };
+		std::atomic<bool> tailRan{ false };
+		const TaskGraph::TaskId empty = graph.addParallelTask(0, 0, 64, [&](size_t, size_t) { ++calls; });
+		const TaskGraph::TaskId reversed = graph.addParallelTask(10, 5, 64, [&](size_t, size_t) { ++calls; });
+		const TaskGraph::TaskId chained = graph.addParallelTask(7, 7, 1, [&](size_t, size_t) { ++calls; });
+		const TaskGraph::TaskId tail = graph.addTask([&]() { tailRan = true; });
+		CHECK(graph.addDependency(empty, reversed));
+		CHECK(graph.addChunkDependency(reversed, chained));
+		CHECK(graph.addDependency(chained, tail));
+
+		CHECK(graph.run(pool));
+		CHECK(0 == calls.load());
+		CHECK(tailRan.load());
+	}
+
+	void testCycle(ThreadPool& pool)
+	{
+		TaskGraph graph;
+		int runs(0);
+		const TaskGraph::TaskId a = graph.addTask([&]() { ++runs; });
+		const TaskGraph::TaskId b = graph.addTask([&]() { ++runs; });
+		CHECK(graph.addDependency(a, b));
+		CHECK(graph.addDependency(b, a));
+		CHECK(!graph.addDependency(a, a));
+		CHECK(!graph.run(pool));
+		CHECK(0 == runs);
+	}
+
+	// 抛出异常的任务不会让 run 永久阻塞：图排空后在调用线程重新抛出，之后的运行不受影响
+	void testThrowingTask(ThreadPool& pool)
+	{
+		TaskGraph graph;
+		std::atomic<bool> fail{ true };
+		std::atomic<size_t> executed{ 0 };
+		const TaskGraph::TaskId producer = graph.addParallelTask(0, 4096, 16, [&](size_t begin, size_t)
+		{
+			++executed;
+			if (fail && 1024 == begin)
+			{
+				throw std::runtime_error("chunk failed");
+			}
+		});
+		const TaskGraph::TaskId consumer = graph.addParallelTask(0, 4096, 16, [&](size_t, size_t) { ++executed; });
+		const TaskGraph::TaskId tail = graph.addTask([&]() { ++executed; });
+		CHECK(graph.addChunkDependency(producer, consumer));
+		CHECK(graph.addDependency(consumer, tail));
+
+		bool caught(false);
+		try
+		{
+			graph.run(pool);
+		}
+		catch (const std::runtime_error& error)
+		{
+			caught = std::string("chunk failed") == error.what();
+		}
+		CHECK(caught);
+		CHECK(executed.load() < 2 * 256 + 1);
+
+		fail = false;
+		executed = 0;
+		CHECK(graph.run(pool));
+		CHECK(2 * 256 + 1 == executed.load());
+	}
+
+	void testThrowingSingleTask(ThreadPool& pool)
+	{
+		TaskGraph graph;
+		graph.addTask([]() { throw 42; });
+		int value(0);
+		try
+		{
+			graph.run(pool);
+		}
+		catch (const int thrown)
+		{
+			value = thrown;
+		}
+		CHECK(42 == value);
+	}
+}
+
+int main()
+{
+	ThreadPool pool(4);
+	testChunkDependency(pool);
+	testEmptyRange(pool);
+	testCycle(pool);
+	testThrowingTask(pool);
+	testThrowingSingleTask(pool);
+	testThrowingTask(ThreadPool::instance());
+	return test::report("TaskGraphTest");
+}
@@ -0,0 +1,41 @@
+#ifndef __TEST_COMMON_H__
+#define __TEST_COMMON_H__
+
+#include <cstdio>
+
+/*!
+ * 单元测试的最小断言工具：失败时打印位置并计数，main 返回失败数，由 ctest 判定
+ */
+namespace test
+{
+	inline int& failures()
+	{
+		static int s_failures = 0;
+		return s_failures;
+	}
+
+	inline int report(const char* name)
+	{
+		if (0 == failures())
+		{
+			std::printf("%s: all checks passed\n", name);
+		}
+		else
+		{
+			std::printf("%s: %d check(s) failed\n", name, failures());
+		}
+		return 0 == failures() ? 0 : 1;
+	}
+}
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			++test::failures(); \
+		} \
+	} while (0)
+
+#endif
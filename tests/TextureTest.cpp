@@ -0,0 +1,331 @@
+#include "TestCommon.h"
+#include "render/Texture.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	// 宽高都不是 tile（4）的整数倍，也都是奇数
+	constexpr size_t s_width = 13;
+	constexpr size_t s_height = 7;
+
+	const WrapMode s_modes[] = { WrapMode::Repeat, WrapMode::Clamp, WrapMode::Mirror };
+
+	uint32_t nextRandom(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	float randomUnit(uint32_t& state)
+	{
+		return static_cast<float>(nextRandom(state)) * (1.f / 16777216.f);
+	}
+
+	/*!
+	 * 按行存放的双精度 RGBA 图像
+	 */
+	struct Image
+	{
+		size_t width;
+		size_t height;
+		std::vector<double> rgba;
+
+		const double* at(const size_t x, const size_t y) const
+		{
+			return rgba.data() + 4 * (y * width + x);
+		}
+	};
+
+	Image toImage(const float* rgba, const size_t width, const size_t height)
+	{
+		return Image{ width, height, std::vector<double>(rgba, rgba + 4 * width * height) };
+	}
+
+	// 单轴寻址的双精度参照：相邻两个纹素与权重
+	void referenceAxis(const double coord, const size_t size, const WrapMode mode, size_t& i0, size_t& i1, double& f)
+	{
+		const double n = static_cast<double>(size);
+		double u = coord;
+		if (WrapMode::Repeat == mode)
+		{
+			u -= std::floor(u);
+		}
+		else if (WrapMode::Mirror == mode)
+		{
+			const double m = u - 2.0 * std::floor(u * 0.5);
+			u = m > 1.0 ? 2.0 - m : m;
+		}
+
+		const double x = std::clamp(u * n - 0.5, -1.0, n);
+		const double x0 = std::floor(x);
+		f = x - x0;
+		const long long lo = static_cast<long long>(x0);
+		const long long count = static_cast<long long>(size);
+		if (WrapMode::Repeat == mode)
+		{
+			i0 = static_cast<size_t>((lo % count + count) % count);
+			i1 = static_cast<size_t>(((lo + 1) % count + count) % count);
+		}
+		else
+		{
+			i0 = static_cast<size_t>(std::clamp(lo, 0ll, count - 1));
+			i1 = static_cast<size_t>(std::clamp(lo + 1, 0ll, count - 1));
+		}
+	}
+
+	void referenceBilinear(const Image& image, const float u, const float v, const TextureSampler& sampler,
+		double* out)
+	{
+		size_t x0, x1, y0, y1;
+		double fx, fy;
+		referenceAxis(u, image.width, sampler.wrapU, x0, x1, fx);
+		referenceAxis(v, image.height, sampler.wrapV, y0, y1, fy);
+		for (size_t c(0); c < 4; ++c)
+		{
+			const double top = image.at(x0, y0)[c] * (1.0 - fx) + image.at(x1, y0)[c] * fx;
+			const double bottom = image.at(x0, y1)[c] * (1.0 - fx) + image.at(x1, y1)[c] * fx;
+			out[c] = top * (1.0 - fy) + bottom * fy;
+		}
+	}
+
+	// 2x2 平均，奇数尺寸时末行末列不参与，尺寸为 1 的方向重复使用唯一的行或列
+	Image referenceBox(const Image& src)
+	{
+		Image dst{ std::max<size_t>(1, src.width / 2), std::max<size_t>(1, src.height / 2), {} };
+		dst.rgba.resize(4 * dst.width * dst.height);
+		for (size_t y(0); y < dst.height; ++y)
+		{
+			const size_t y0 = std::min(2 * y, src.height - 1), y1 = std::min(2 * y + 1, src.height - 1);
+			for (size_t x(0); x < dst.width; ++x)
+			{
+				const size_t x0 = std::min(2 * x, src.width - 1), x1 = std::min(2 * x + 1, src.width - 1);
+				for (size_t c(0); c < 4; ++c)
+				{
+					dst.rgba[4 * (y * dst.width + x) + c] = 0.25 * (src.at(x0, y0)[c] + src.at(x1, y0)[c]
+						+ src.at(x0, y1)[c] + src.at(x1, y1)[c]);
+				}
+			}
+		}
+		return dst;
+	}
+
+	std::vector<float> randomFloats(uint32_t& state, const size_t count)
+	{
+		std::vector<float> values(count);
+		for (float& value : values)
+		{
+			value = randomUnit(state);
+		}
+		return values;
+	}
+
+	Image levelImage(const Texture& texture, const size_t level)
+	{
+		std::vector<float> rgba(4 * texture.width(level) * texture.height(level));
+		texture.readLevel(level, rgba.data());
+		return toImage(rgba.data(), texture.width(level), texture.height(level));
+	}
+
+	// 三种寻址、两种格式：SSE 的 4 像素一组与标量尾部都与双精度参照一致，且与单个采样逐位相同
+	void testBilinear()
+	{
+		uint32_t state = 1u;
+		const std::vector<float> texels = randomFloats(state, 4 * s_width * s_height);
+		std::vector<uint8_t> bytes(texels.size());
+		for (size_t i(0); i < bytes.size(); ++i)
+		{
+			bytes[i] = static_cast<uint8_t>(nextRandom(state));
+		}
+		std::vector<float> unpacked(bytes.size());
+		for (size_t i(0); i < bytes.size(); ++i)
+		{
+			unpacked[i] = static_cast<float>(bytes[i]) / 255.f;
+		}
+
+		Texture floatTexture, byteTexture;
+		CHECK(floatTexture.create(texels.data(), s_width, s_height));
+		CHECK(byteTexture.create(bytes.data(), s_width, s_height));
+		const Image floatImage = toImage(texels.data(), s_width, s_height);
+		const Image byteImage = toImage(unpacked.data(), s_width, s_height);
+
+		// 覆盖纹理外的坐标、纹素中心与边界
+		const size_t count = 1003;
+		std::vector<float> u(count), v(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			u[i] = i % 7 ? randomUnit(state) * 5.f - 2.f : (static_cast<float>(i % s_width) + 0.5f) / s_width;
+			v[i] = i % 5 ? randomUnit(state) * 5.f - 2.f : static_cast<float>(i % (s_height + 1)) / s_height;
+		}
+
+		for (const Texture* texture : { &floatTexture, &byteTexture })
+		{
+			const Image& image = texture == &floatTexture ? floatImage : byteImage;
+			for (const WrapMode wrapU : s_modes)
+			{
+				for (const WrapMode wrapV : s_modes)
+				{
+					TextureSampler sampler;
+					sampler.wrapU = wrapU;
+					sampler.wrapV = wrapV;
+					std::vector<float> batch(4 * count);
+					texture->sample(u.data(), v.data(), nullptr, count, sampler, batch.data());
+
+					double error(0.0);
+					size_t differences(0);
+					for (size_t i(0); i < count; ++i)
+					{
+						double expected[4];
+						referenceBilinear(image, u[i], v[i], sampler, expected);
+						float single[4];
+						texture->sample(&u[i], &v[i], nullptr, 1, sampler, single);
+						differences += 0 != std::memcmp(single, &batch[4 * i], sizeof(single));
+						for (size_t c(0); c < 4; ++c)
+						{
+							error = std::max(error, std::abs(batch[4 * i + c] - expected[c]));
+						}
+					}
+					CHECK(error < 1e-5);
+					CHECK(0 == differences);
+				}
+			}
+		}
+	}
+
+	// 奇数尺寸逐级与双精度 2x2 平均一致；RGBA8 各级由未量化的结果生成，误差不超过半个量化步长
+	void testBoxMips()
+	{
+		uint32_t state = 2u;
+		const std::vector<float> texels = randomFloats(state, 4 * s_width * s_height);
+		std::vector<uint8_t> bytes(texels.size());
+		for (size_t i(0); i < bytes.size(); ++i)
+		{
+			bytes[i] = static_cast<uint8_t>(nextRandom(state));
+		}
+
+		Texture floatTexture, byteTexture;
+		CHECK(floatTexture.create(texels.data(), s_width, s_height));
+		CHECK(byteTexture.create(bytes.data(), s_width, s_height));
+		floatTexture.generateMips();
+		byteTexture.generateMips();
+
+		const size_t widths[] = { 13, 6, 3, 1 };
+		const size_t heights[] = { 7, 3, 1, 1 };
+		for (const Texture* texture : { &floatTexture, &byteTexture })
+		{
+			CHECK(4 == texture->levelCount());
+			Image expected = levelImage(*texture, 0);
+			for (size_t level(1); level < texture->levelCount() && level < 4; ++level)
+			{
+				CHECK(widths[level] == texture->width(level) && heights[level] == texture->height(level));
+				expected = referenceBox(expected);
+				const Image actual = levelImage(*texture, level);
+				double error(0.0);
+				for (size_t i(0); i < expected.rgba.size() && expected.rgba.size() == actual.rgba.size(); ++i)
+				{
+					error = std::max(error, std::abs(actual.rgba[i] - expected.rgba[i]));
+				}
+				CHECK(expected.rgba.size() == actual.rgba.size());
+				CHECK(error < (texture == &floatTexture ? 1e-6 : 0.51 / 255.0));
+			}
+		}
+
+		// 重复生成时丢弃旧的 mip
+		floatTexture.generateMips();
+		CHECK(4 == floatTexture.levelCount());
+	}
+
+	// lod 选级：Bilinear 取最近一级，Trilinear 在相邻两级间插值
+	void testMipSelection()
+	{
+		uint32_t state = 3u;
+		const std::vector<float> texels = randomFloats(state, 4 * s_width * s_height);
+		Texture texture;
+		CHECK(texture.create(texels.data(), s_width, s_height));
+		texture.generateMips();
+		const Image level1 = levelImage(texture, 1);
+		const Image level2 = levelImage(texture, 2);
+
+		const size_t count = 9;
+		std::vector<float> u(count), v(count), lod(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			u[i] = randomUnit(state);
+			v[i] = randomUnit(state);
+			lod[i] = 1.25f;
+		}
+
+		TextureSampler sampler;
+		std::vector<float> bilinear(4 * count), trilinear(4 * count);
+		texture.sample(u.data(), v.data(), lod.data(), count, sampler, bilinear.data());
+		sampler.filter = TextureFilter::Trilinear;
+		texture.sample(u.data(), v.data(), lod.data(), count, sampler, trilinear.data());
+
+		double error(0.0);
+		for (size_t i(0); i < count; ++i)
+		{
+			double a[4], b[4];
+			referenceBilinear(level1, u[i], v[i], sampler, a);
+			referenceBilinear(level2, u[i], v[i], sampler, b);
+			for (size_t c(0); c < 4; ++c)
+			{
+				error = std::max(error, std::abs(bilinear[4 * i + c] - a[c]));
+				error = std::max(error, std::abs(trilinear[4 * i + c] - (0.75 * a[c] + 0.25 * b[c])));
+			}
+		}
+		CHECK(error < 1e-5);
+	}
+
+	// Kaiser 核归一化：常量纹理各级仍为该常量
+	void testKaiserConstant()
+	{
+		std::vector<float> texels(4 * s_width * s_height);
+		for (size_t i(0); i < texels.size(); ++i)
+		{
+			texels[i] = 0.25f * static_cast<float>(i % 4 + 1);
+		}
+		Texture texture;
+		CHECK(texture.create(texels.data(), s_width, s_height));
+		texture.generateMips(MipFilter::Kaiser);
+		double error(0.0);
+		for (size_t level(1); level < texture.levelCount(); ++level)
+		{
+			const Image image = levelImage(texture, level);
+			for (size_t i(0); i < image.rgba.size(); ++i)
+			{
+				error = std::max(error, std::abs(image.rgba[i] - 0.25 * static_cast<double>(i % 4 + 1)));
+			}
+		}
+		CHECK(error < 1e-5);
+	}
+
+	void testInvalid()
+	{
+		const float rgba[4] = { 1.f, 0.f, 0.f, 1.f };
+		Texture texture;
+		CHECK(!texture.create(rgba, 0, 1));
+		CHECK(!texture.create(static_cast<const float*>(nullptr), 1, 1));
+		CHECK(!texture.create(rgba, Texture::s_maxSize + 1, 1));
+		CHECK(0 == texture.levelCount());
+
+		const float u = 0.5f, v = 0.5f;
+		float out[4] = { 1.f, 1.f, 1.f, 1.f };
+		texture.sample(&u, &v, nullptr, 1, TextureSampler(), out);
+		CHECK(0.f == out[0] && 0.f == out[3]);
+	}
+}
+
+int main()
+{
+	testBilinear();
+	testBoxMips();
+	testMipSelection();
+	testKaiserConstant();
+	testInvalid();
+	return test::report("TextureTest");
+}
@@ -0,0 +1,253 @@
+#include "TestCommon.h"
+#include "scene/TTransformHierarchy.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	using Hierarchy = TTransformHierarchy<double>;
+	using Vector3 = Hierarchy::Vector3;
+	using Quaternion = Hierarchy::Quaternion;
+
+	// 3x4 仿射矩阵，按行存放
+	struct Affine
+	{
+		double m[3][4];
+	};
+
+	struct Random
+	{
+		uint64_t state;
+
+		double next(const double low, const double high)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return low + (high - low) * static_cast<double>(state >> 11) * 0x1.0p-53;
+		}
+
+		size_t index(const size_t count)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<size_t>((state >> 33) % count);
+		}
+	};
+
+	// 直接由四元数、缩放、平移写出局部矩阵，零四元数不旋转
+	Affine localReference(const Hierarchy& hierarchy, const size_t node)
+	{
+		const Quaternion& q = hierarchy.rotation(node);
+		const Vector3& s = hierarchy.scale(node);
+		const Vector3& t = hierarchy.translation(node);
+		const double n = q.x() * q.x() + q.y() * q.y() + q.z() * q.z() + q.w() * q.w();
+		double r[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		if (n > 0.0)
+		{
+			const double x = q.x(), y = q.y(), z = q.z(), w = q.w();
+			r[0][0] = 1 - 2 * (y * y + z * z) / n;
+			r[0][1] = 2 * (x * y - w * z) / n;
+			r[0][2] = 2 * (x * z + w * y) / n;
+			r[1][0] = 2 * (x * y + w * z) / n;
+			r[1][1] = 1 - 2 * (x * x + z * z) / n;
+			r[1][2] = 2 * (y * z - w * x) / n;
+			r[2][0] = 2 * (x * z - w * y) / n;
+			r[2][1] = 2 * (y * z + w * x) / n;
+			r[2][2] = 1 - 2 * (x * x + y * y) / n;
+		}
+		const double scale[3] = { s.x(), s.y(), s.z() };
+		const double translation[3] = { t.x(), t.y(), t.z() };
+		Affine a;
+		for (int i(0); i < 3; ++i)
+		{
+			for (int j(0); j < 3; ++j)
+			{
+				a.m[i][j] = r[i][j] * scale[j];
+			}
+			a.m[i][3] = translation[i];
+		}
+		return a;
+	}
+
+	Affine multiply(const Affine& p, const Affine& l)
+	{
+		Affine a;
+		for (int i(0); i < 3; ++i)
+		{
+			for (int j(0); j < 4; ++j)
+			{
+				a.m[i][j] = p.m[i][0] * l.m[0][j] + p.m[i][1] * l.m[1][j] + p.m[i][2] * l.m[2][j];
+			}
+			a.m[i][3] += p.m[i][3];
+		}
+		return a;
+	}
+
+	// 沿父链从根开始逐级相乘
+	Affine worldReference(const Hierarchy& hierarchy, size_t node)
+	{
+		std::vector<size_t> chain;
+		for (; Hierarchy::s_noParent != node; node = hierarchy.parent(node))
+		{
+			chain.push_back(node);
+		}
+		Affine world = localReference(hierarchy, chain.back());
+		for (size_t i(chain.size() - 1); i > 0; --i)
+		{
+			world = multiply(world, localReference(hierarchy, chain[i - 1]));
+		}
+		return world;
+	}
+
+	size_t mismatches(const Hierarchy& hierarchy)
+	{
+		size_t count(0);
+		for (size_t node(0); node < hierarchy.size(); ++node)
+		{
+			const Affine expected = worldReference(hierarchy, node);
+			const Hierarchy::Matrix& world = hierarchy.worldMatrix(node);
+			for (int i(0); i < 3; ++i)
+			{
+				const double row[4] = { world[i].x(), world[i].y(), world[i].z(), world[i].w() };
+				for (int j(0); j < 4; ++j)
+				{
+					count += !(std::abs(row[j] - expected.m[i][j]) <= 1e-9 * (1.0 + std::abs(expected.m[i][j])));
+				}
+			}
+		}
+		return count;
+	}
+
+	Quaternion randomRotation(Random& random)
+	{
+		return Quaternion(random.next(-1, 1), random.next(-1, 1), random.next(-1, 1), random.next(-1, 1));
+	}
+
+	Vector3 randomVector(Random& random, const double low, const double high)
+	{
+		return Vector3(random.next(low, high), random.next(low, high), random.next(low, high));
+	}
+
+	size_t addRandomNode(Hierarchy& hierarchy, Random& random, const size_t parent)
+	{
+		return hierarchy.addNode(parent, randomVector(random, -5, 5), randomRotation(random),
+			randomVector(random, 0.5, 1.5));
+	}
+
+	// 节点或其祖先被修改时需要重算
+	size_t affectedCount(const Hierarchy& hierarchy, const std::vector<uint8_t>& edited)
+	{
+		size_t count(0);
+		for (size_t node(0); node < hierarchy.size(); ++node)
+		{
+			for (size_t n(node); Hierarchy::s_noParent != n; n = hierarchy.parent(n))
+			{
+				if (edited[n])
+				{
+					++count;
+					break;
+				}
+			}
+		}
+		return count;
+	}
+
+	// 第 1 层超过 s_grain（1024）个节点，走 parallelFor 路径；随机修改局部变换与追加节点后与逐链重算一致
+	void testRandomEdits()
+	{
+		ThreadPool pool(4);
+		Random random{ 2024u };
+		Hierarchy hierarchy;
+		const size_t root = addRandomNode(hierarchy, random, Hierarchy::s_noParent);
+		const size_t second = hierarchy.addNode(Hierarchy::s_noParent, Vector3(1, 2, 3), Quaternion(0, 0, 0, 0),
+			Vector3(1, 1, 1));
+		for (size_t i(0); i < 3000; ++i)
+		{
+			addRandomNode(hierarchy, random, root);
+		}
+		for (size_t i(0); i < 3000; ++i)
+		{
+			addRandomNode(hierarchy, random, 2 + random.index(3000));
+		}
+		for (size_t i(0); i < 200; ++i)
+		{
+			addRandomNode(hierarchy, random, 3002 + random.index(3000));
+		}
+		addRandomNode(hierarchy, random, second);
+
+		CHECK(hierarchy.dirty());
+		CHECK(hierarchy.size() == hierarchy.update(pool));
+		CHECK(!hierarchy.dirty());
+		CHECK(0 == hierarchy.update(pool));
+		CHECK(0 == mismatches(hierarchy));
+		CHECK(1 == hierarchy.depth(2) && 2 == hierarchy.depth(3002) && 3 == hierarchy.depth(6002));
+
+		for (int round(0); round < 6; ++round)
+		{
+			std::vector<uint8_t> edited(hierarchy.size(), 0);
+			const size_t edits = 0 == round ? 1 : 1 + random.index(400);
+			for (size_t e(0); e < edits; ++e)
+			{
+				// 第 0 轮只改根节点，整棵树重算
+				const size_t node = 0 == round ? root : random.index(hierarchy.size());
+				edited[node] = 1;
+				switch (random.index(4))
+				{
+				case 0:
+					CHECK(hierarchy.setTranslation(node, randomVector(random, -5, 5)));
+					break;
+				case 1:
+					CHECK(hierarchy.setRotation(node, randomRotation(random)));
+					break;
+				case 2:
+					CHECK(hierarchy.setScale(node, randomVector(random, 0.5, 1.5)));
+					break;
+				default:
+					CHECK(hierarchy.setLocal(node, randomVector(random, -5, 5), randomRotation(random),
+						randomVector(random, 0.5, 1.5)));
+					break;
+				}
+			}
+
+			// 新节点挂在已有节点下，子节点表在 update 时重建
+			if (round % 2)
+			{
+				const size_t added = addRandomNode(hierarchy, random, random.index(hierarchy.size()));
+				edited.push_back(1);
+				CHECK(added + 1 == hierarchy.size());
+			}
+
+			CHECK(affectedCount(hierarchy, edited) == hierarchy.update(pool));
+			CHECK(0 == mismatches(hierarchy));
+		}
+
+		const Vector3 point(0.5, -1.0, 2.0);
+		const Affine world = worldReference(hierarchy, 6002);
+		const Vector3 moved = hierarchy.transformPoint(6002, point);
+		CHECK(std::abs(moved.x() - (world.m[0][0] * 0.5 - world.m[0][1] + world.m[0][2] * 2 + world.m[0][3])) < 1e-9);
+	}
+
+	// Checked 策略下无效下标被拒绝
+	void testInvalidNodes()
+	{
+		Hierarchy hierarchy;
+		CHECK(Hierarchy::s_noParent == hierarchy.addNode(3, Vector3(), Quaternion(), Vector3(1, 1, 1)));
+		CHECK(0 == hierarchy.size());
+		CHECK(!hierarchy.setTranslation(0, Vector3()));
+		CHECK(0 == hierarchy.update());
+
+		const size_t root = hierarchy.addNode(Hierarchy::s_noParent, Vector3(1, 0, 0), Quaternion(0, 0, 0, 2),
+			Vector3(2, 2, 2));
+		CHECK(1 == hierarchy.update());
+		CHECK(Vector3(3, 2, 2) == hierarchy.transformPoint(root, Vector3(1, 1, 1)));
+		CHECK(!hierarchy.setLocal(1, Vector3(), Quaternion(), Vector3()));
+	}
+}
+
+int main()
+{
+	testRandomEdits();
+	testInvalidNodes();
+	return test::report("TransformHierarchyTest");
+}
@@ -0,0 +1,87 @@
+#include "TestCommon.h"
+#include "vector/TUnitVector2.hpp"
+#include "vector/TUnitVector3.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace math;
+
+namespace
+{
+	using Unit3 = TUnitVector3<float>;
+	using Unit2 = TUnitVector2<float>;
+	using Vector3 = TVector3<float>;
+	using Vector2 = TVector2<float>;
+
+	// 分量平方会上溢或下溢的向量仍能归一化
+	void testExtremeMagnitudes()
+	{
+		Unit3 unit3;
+		CHECK(Unit3::normalize(Vector3(1e20f, 0.f, 0.f), unit3));
+		CHECK(Vector3(1.f, 0.f, 0.f) == unit3.vector());
+		CHECK(Unit3::normalize(Vector3(0.f, -1e-25f, 0.f), unit3));
+		CHECK(Vector3(0.f, -1.f, 0.f) == unit3.vector());
+		CHECK(Unit3::normalize(Vector3(1e-45f, 0.f, 1e-45f), unit3));
+		CHECK(Unit3::isUnitLength(unit3.vector()));
+		CHECK(Unit3::normalize(Vector3(3e38f, -3e38f, 3e38f), unit3));
+		CHECK(Unit3::isUnitLength(unit3.vector()));
+
+		Unit2 unit2;
+		CHECK(Unit2::normalize(Vector2(0.f, 1e20f), unit2));
+		CHECK(Vector2(0.f, 1.f) == unit2.vector());
+		CHECK(Unit2::normalize(Vector2(-1e-25f, 0.f), unit2));
+		CHECK(Vector2(-1.f, 0.f) == unit2.vector());
+		CHECK(Unit2::normalize(Vector2(3e-39f, 4e-39f), unit2));
+		CHECK(std::fabs(unit2.x() - 0.6f) < 1e-6f && std::fabs(unit2.y() - 0.8f) < 1e-6f);
+	}
+
+	// 普通量级的结果与直接除以长度逐位相同
+	void testMatchesDirect()
+	{
+		const Vector3 vec(0.3f, -1.7f, 2.9f);
+		Unit3 unit;
+		CHECK(Unit3::normalize(vec, unit));
+		CHECK(vec * (1.f / vec.length()) == unit.vector());
+	}
+
+	// 零向量、NaN 与无穷分量失败且不修改输出
+	void testDegenerate()
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		Unit3 unit = Unit3::xAxisVector;
+		CHECK(!Unit3::normalize(Vector3(0.f, 0.f, 0.f), unit));
+		CHECK(!Unit3::normalize(Vector3(nan, 1.f, 0.f), unit));
+		CHECK(!Unit3::normalize(Vector3(1.f, 0.f, nan), unit));
+		CHECK(!Unit3::normalize(Vector3(inf, 0.f, 0.f), unit));
+		CHECK(!Unit3::normalize(Vector3(1e-30f, -inf, 0.f), unit));
+		CHECK(Unit3::xAxisVector == unit);
+
+		Unit2 unit2 = Unit2::yAxisVector;
+		CHECK(!Unit2::normalize(Vector2(0.f, -0.f), unit2));
+		CHECK(!Unit2::normalize(Vector2(nan, 0.f), unit2));
+		CHECK(!Unit2::normalize(Vector2(0.f, inf), unit2));
+		CHECK(Unit2::yAxisVector == unit2);
+	}
+
+	// Checked 策略下 trusted 在运行时校验，非单位长度的输入被归一化
+	void testTrustedChecked()
+	{
+		CHECK(Vector3(0.f, 1.f, 0.f) == Unit3::trusted(Vector3(0.f, 1.f, 0.f)).vector());
+		CHECK(Vector3(0.f, 0.f, -1.f) == Unit3::trusted(Vector3(0.f, 0.f, -5.f)).vector());
+		CHECK(Unit3() == Unit3::trusted(Vector3(0.f, 0.f, 0.f)));
+		CHECK(Unit3::isUnitLength(Unit3::trusted(Vector3(1.f, 1.f, 1.f)).vector()));
+
+		CHECK(Vector2(-1.f, 0.f) == Unit2::trusted(Vector2(-2.f, 0.f)).vector());
+		CHECK(Unit2() == Unit2::trusted(Vector2(std::numeric_limits<float>::quiet_NaN(), 0.f)));
+	}
+}
+
+int main()
+{
+	testExtremeMagnitudes();
+	testMatchesDirect();
+	testDegenerate();
+	testTrustedChecked();
+	return test::report("UnitVectorTest");
+}
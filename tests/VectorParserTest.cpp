@@ -0,0 +1,185 @@
+#include "TestCommon.h"
+#include "io/VectorParser.h"
+#include "io/VectorWriter.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include "vector/TVector4.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	template <typename Vector>
+	bool parseObj(const std::string& text, const ObjElement element, std::vector<Vector>& out)
+	{
+		return VectorParser::parseObj(text.data(), text.size(), element, out);
+	}
+
+	template <typename Vector>
+	bool sameBits(const std::vector<Vector>& a, const std::vector<Vector>& b)
+	{
+		return a.size() == b.size() && (a.empty() || 0 == std::memcmp(a.data(), b.data(), a.size() * sizeof(Vector)));
+	}
+
+	// 超过 1MB、跨越多个按行对齐的块：写出再读回逐位相同，其余种类的行不计入
+	void testRoundTrip()
+	{
+		uint64_t state = 42u;
+		std::vector<TVector3<double>> vectors(40000);
+		for (TVector3<double>& vec : vectors)
+		{
+			double c[3];
+			for (double& v : c)
+			{
+				state = state * 6364136223846793005ull + 1442695040888963407ull;
+				uint64_t bits = state >> 2;
+				std::memcpy(&v, &bits, sizeof(v));
+				if (!std::isfinite(v))
+				{
+					v = static_cast<double>(state >> 40) * 1e-7;
+				}
+			}
+			vec = TVector3<double>(c[0], c[1], c[2]);
+		}
+
+		std::string text(VectorWriter::maxLength<TVector3<double>>(vectors.size(), "v "), '\0');
+		const std::to_chars_result result = VectorWriter::write(text.data(), text.data() + text.size(), vectors.data(),
+			vectors.size(), "v ");
+		CHECK(std::errc() == result.ec);
+		text.resize(result.ptr - text.data());
+		CHECK(text.size() > (size_t(1) << 20));
+
+		// 在中间插入其他种类的行与注释
+		text.insert(text.find('\n', text.size() / 2) + 1, "vn 0 0 1\n# comment\nvt 0.5 0.5\n\n");
+
+		std::vector<TVector3<double>> parsed;
+		CHECK(parseObj(text, ObjElement::Position, parsed));
+		CHECK(sameBits(vectors, parsed));
+
+		std::vector<TVector3<double>> normals;
+		CHECK(parseObj(text, ObjElement::Normal, normals));
+		CHECK(1 == normals.size() && TVector3<double>(0.0, 0.0, 1.0) == normals[0]);
+	}
+
+	// \r\n 行尾、制表符、逗号与分号分隔、行首空白与多余字段
+	void testSeparators()
+	{
+		const std::string text = "v 1 2 3\r\nv 4,5,6\r\n  v\t7;8;9 \r\nv +1.5e1, -2 ,3e-1 99\r\n# v 0 0 0\r\nvn 0 0 1\r\n";
+		std::vector<TVector3<float>> out;
+		CHECK(parseObj(text, ObjElement::Position, out));
+		CHECK(4 == out.size());
+		if (4 == out.size())
+		{
+			CHECK(TVector3<float>(1.f, 2.f, 3.f) == out[0]);
+			CHECK(TVector3<float>(4.f, 5.f, 6.f) == out[1]);
+			CHECK(TVector3<float>(7.f, 8.f, 9.f) == out[2]);
+			CHECK(TVector3<float>(15.f, -2.f, 0.3f) == out[3]);
+		}
+	}
+
+	// 位置的 w 缺省为 1，纹理坐标缺少的分量为 0
+	void testDefaults()
+	{
+		std::vector<TVector4<double>> positions;
+		CHECK(parseObj(std::string("v 1 2 3\nv 1 2 3 0.5\n"), ObjElement::Position, positions));
+		CHECK(2 == positions.size());
+		if (2 == positions.size())
+		{
+			CHECK(TVector4<double>(1.0, 2.0, 3.0, 1.0) == positions[0]);
+			CHECK(TVector4<double>(1.0, 2.0, 3.0, 0.5) == positions[1]);
+		}
+
+		std::vector<TVector3<float>> texCoords;
+		CHECK(parseObj(std::string("vt 0.25\nvt 0.25 0.5\nvt 0.25 0.5 0.75\n"), ObjElement::TexCoord, texCoords));
+		CHECK(3 == texCoords.size());
+		if (3 == texCoords.size())
+		{
+			CHECK(TVector3<float>(0.25f, 0.f, 0.f) == texCoords[0]);
+			CHECK(TVector3<float>(0.25f, 0.5f, 0.f) == texCoords[1]);
+			CHECK(TVector3<float>(0.25f, 0.5f, 0.75f) == texCoords[2]);
+		}
+
+		std::vector<TVector2<float>> uv;
+		CHECK(parseObj(std::string("vt 0.25 0.5 0.75\n"), ObjElement::TexCoord, uv));
+		CHECK(1 == uv.size() && TVector2<float>(0.25f, 0.5f) == uv[0]);
+	}
+
+	// 格式错误返回 false 且输出为空，即使之前已有内容
+	void testMalformed()
+	{
+		const char* const texts[] = { "v 1 2 3\nv 1 2 x\n", "v 1 2\n", "v 1 2 3x\n", "v 1e999 0 0\n", "v 1 2 3\nv \n" };
+		for (const char* text : texts)
+		{
+			std::vector<TVector3<float>> out(5);
+			CHECK(!parseObj(std::string(text), ObjElement::Position, out));
+			CHECK(out.empty());
+		}
+
+		// 错误行位于第二个 1MB 块之后
+		std::string large;
+		while (large.size() < (size_t(3) << 20))
+		{
+			large += "v 0.125 -0.25 0.5\n";
+		}
+		large += "v 1 2 ?\n";
+		std::vector<TVector3<double>> out;
+		CHECK(!parseObj(large, ObjElement::Position, out));
+		CHECK(out.empty());
+	}
+
+	// 每行一个向量：跳过表头，空行与注释忽略
+	void testRows()
+	{
+		const std::string text = "x,y,z\n1,2,3\n\n# note\n4;5;6\r\n7 8 9\n";
+		std::vector<TVector3<float>> out;
+		CHECK(VectorParser::parseRows(text.data(), text.size(), 1, out));
+		CHECK(3 == out.size() && TVector3<float>(7.f, 8.f, 9.f) == out[2]);
+
+		CHECK(!VectorParser::parseRows(text.data(), text.size(), 0, out));
+		CHECK(out.empty());
+	}
+
+	// ASCII PLY：按属性名取列，vertex 之前的元素行跳过，之后的元素不读
+	void testPly()
+	{
+		const std::string text = "ply\r\nformat ascii 1.0\ncomment test\nelement camera 1\nproperty float fov\n"
+			"element vertex 2\nproperty float x\nproperty float y\nproperty float z\nproperty float nx\n"
+			"element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+			"60\n0 1 2 9\n3 4 5 9\n3 0 1 2\n";
+		const std::vector<std::string> properties = { "z", "x" };
+		std::vector<TVector2<float>> out;
+		CHECK(VectorParser::parsePly(text.data(), text.size(), properties, out));
+		CHECK(2 == out.size());
+		if (2 == out.size())
+		{
+			CHECK(TVector2<float>(2.f, 0.f) == out[0]);
+			CHECK(TVector2<float>(5.f, 3.f) == out[1]);
+		}
+
+		// 顶点行不足、属性缺失、二进制格式
+		const std::string truncated = text.substr(0, text.find("3 4 5 9"));
+		CHECK(!VectorParser::parsePly(truncated.data(), truncated.size(), properties, out));
+		CHECK(out.empty());
+		const std::vector<std::string> missing = { "z", "w" };
+		CHECK(!VectorParser::parsePly(text.data(), text.size(), missing, out));
+		std::string binary = text;
+		binary.replace(binary.find("ascii"), 5, "binary_little_endian");
+		CHECK(!VectorParser::parsePly(binary.data(), binary.size(), properties, out));
+	}
+}
+
+int main()
+{
+	testRoundTrip();
+	testSeparators();
+	testDefaults();
+	testMalformed();
+	testRows();
+	testPly();
+	return test::report("VectorParserTest");
+}
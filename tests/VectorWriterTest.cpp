@@ -0,0 +1,137 @@
+#include "TestCommon.h"
+#include "io/VectorParser.h"
+#include "io/VectorWriter.h"
+#include "parallel/ThreadPool.h"
+#include "vector/TVector2.hpp"
+#include "vector/TVector3.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	template <typename Vector>
+	std::string writeString(const std::vector<Vector>& vectors, const std::string_view prefix, const char separator)
+	{
+		std::string text(VectorWriter::maxLength<Vector>(vectors.size(), prefix), '\0');
+		const std::to_chars_result result = VectorWriter::write(text.data(), text.data() + text.size(), vectors.data(),
+			vectors.size(), prefix, separator);
+		CHECK(std::errc() == result.ec);
+		text.resize(result.ptr - text.data());
+		return text;
+	}
+
+	// 单个向量：最短往返表示，空间不足时报告 value_too_large
+	void testToChars()
+	{
+		char buffer[64];
+		const TVector3<float> vec(1.5f, -0.f, 1e-38f);
+		std::to_chars_result result = VectorWriter::toChars(buffer, buffer + sizeof(buffer), vec, ',');
+		CHECK(std::errc() == result.ec);
+		CHECK(std::string("1.5,-0,1e-38") == std::string(buffer, result.ptr));
+
+		result = VectorWriter::toChars(buffer, buffer + 5, vec, ',');
+		CHECK(std::errc::value_too_large == result.ec);
+		result = VectorWriter::toChars(buffer, buffer + 3, vec, ',');
+		CHECK(std::errc::value_too_large == result.ec);
+	}
+
+	// maxLength 是输出长度的上界，int 与 double 的最长分量恰好达到 maxChars
+	void testMaxLength()
+	{
+		const std::vector<TVector2<int>> ints = { { std::numeric_limits<int>::min(), std::numeric_limits<int>::min() } };
+		const std::vector<TVector2<float>> floats = { { -1.17549435e-38f, -1.17549435e-38f } };
+		const std::vector<TVector2<double>> doubles = { { -2.2250738585072014e-308, -2.2250738585072014e-308 } };
+		CHECK(VectorWriter::maxLength<TVector2<int>>(1, "v ") == writeString(ints, "v ", ' ').size());
+		CHECK(VectorWriter::maxLength<TVector2<float>>(1, "v ") >= writeString(floats, "v ", ' ').size());
+		CHECK(VectorWriter::maxLength<TVector2<double>>(1, "v ") == writeString(doubles, "v ", ' ').size());
+	}
+
+	// 多个格式化窗口的输出与逐个 toChars 拼接的结果相同；缓冲区不足时报告 value_too_large
+	void testWindows()
+	{
+		const size_t count = ThreadPool::instance().threadCount() * 4 * 8192 + 4099;
+		std::vector<TVector2<int>> vectors(count);
+		for (size_t i(0); i < count; ++i)
+		{
+			vectors[i] = TVector2<int>(static_cast<int>(i * 2654435761u), -static_cast<int>(i));
+		}
+
+		std::string expected;
+		char buffer[64];
+		for (const TVector2<int>& vec : vectors)
+		{
+			expected += "p ";
+			expected.append(buffer, VectorWriter::toChars(buffer, buffer + sizeof(buffer), vec, ';').ptr);
+			expected += '\n';
+		}
+		CHECK(expected == writeString(vectors, "p ", ';'));
+
+		std::string small(expected.size() - 1, '\0');
+		const std::to_chars_result result = VectorWriter::write(small.data(), small.data() + small.size(),
+			vectors.data(), count, "p ", ';');
+		CHECK(std::errc::value_too_large == result.ec);
+
+		char empty[1];
+		CHECK(empty == VectorWriter::write(empty, empty + 1, vectors.data(), 0, "p ").ptr);
+	}
+
+	// 写文件再用 VectorParser 读回，逐位相同
+	void testFileRoundTrip()
+	{
+		std::vector<TVector3<float>> vectors(50000);
+		uint32_t state(1u);
+		for (TVector3<float>& vec : vectors)
+		{
+			float c[3];
+			for (float& v : c)
+			{
+				state = state * 1664525u + 1013904223u;
+				v = std::ldexp(static_cast<float>(static_cast<int32_t>(state)), -static_cast<int>(state % 61));
+			}
+			vec = TVector3<float>(c[0], c[1], c[2]);
+		}
+
+		const std::string path = (std::filesystem::temp_directory_path() / "VectorWriterTest.obj").string();
+		CHECK(VectorWriter::writeFile(path, vectors.data(), vectors.size(), "v "));
+		std::vector<TVector3<float>> parsed;
+		CHECK(VectorParser::parseObjFile(path, ObjElement::Position, parsed));
+		CHECK(parsed.size() == vectors.size()
+			&& 0 == std::memcmp(parsed.data(), vectors.data(), vectors.size() * sizeof(TVector3<float>)));
+
+		CHECK(VectorWriter::writeFile(path, vectors.data(), vectors.size(), {}, ','));
+		CHECK(VectorParser::parseRowsFile(path, 0, parsed));
+		CHECK(parsed.size() == vectors.size()
+			&& 0 == std::memcmp(parsed.data(), vectors.data(), vectors.size() * sizeof(TVector3<float>)));
+		std::filesystem::remove(path);
+
+		const std::string missing = (std::filesystem::temp_directory_path() / "no-such-dir" / "out.obj").string();
+		CHECK(!VectorWriter::writeFile(missing, vectors.data(), vectors.size(), "v "));
+	}
+
+	// std::format 输出 "(x, y, z)"，格式说明作用于每个分量
+	void testFormatter()
+	{
+#ifdef __cpp_lib_format
+		CHECK(std::string("(1, -2.5, 3)") == std::format("{}", TVector3<float>(1.f, -2.5f, 3.f)));
+		CHECK(std::string("(0.33, 2.00)") == std::format("{:.2f}", TVector2<double>(1.0 / 3.0, 2.0)));
+		CHECK(std::string("(   7,   -8)") == std::format("{:4}", TVector2<int>(7, -8)));
+#endif
+	}
+}
+
+int main()
+{
+	testToChars();
+	testMaxLength();
+	testWindows();
+	testFileRoundTrip();
+	testFormatter();
+	return test::report("VectorWriterTest");
+}
@@ -0,0 +1,126 @@
+#include "TestCommon.h"
+#include "mesh/TVertexWelder.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace math;
+
+namespace
+{
+	using Vector = TVector3<float>;
+	using Welder = TVertexWelder<float>;
+
+	// 串行参照：按首次出现的顺序编号
+	template <typename KeyFunc>
+	void referenceWeld(const std::vector<Vector>& vertices, KeyFunc keyFunc, std::vector<uint32_t>& firsts,
+		std::vector<uint32_t>& remap)
+	{
+		std::map<std::tuple<uint64_t, uint64_t, uint64_t>, uint32_t> ids;
+		firsts.clear();
+		remap.clear();
+		for (size_t i(0); i < vertices.size(); ++i)
+		{
+			const auto [it, inserted] = ids.emplace(keyFunc(vertices[i]), static_cast<uint32_t>(firsts.size()));
+			if (inserted)
+			{
+				firsts.push_back(static_cast<uint32_t>(i));
+			}
+			remap.push_back(it->second);
+		}
+	}
+
+	bool sameBits(const Vector& a, const Vector& b)
+	{
+		return hashBits(a.x()) == hashBits(b.x()) && hashBits(a.y()) == hashBits(b.y()) && hashBits(a.z()) == hashBits(b.z());
+	}
+
+	// 顶点数跨越多个并行分块，大量重复顶点同时竞争同一槽位（CAS 取最小下标）
+	std::vector<Vector> makeSoup(const size_t count)
+	{
+		std::vector<Vector> vertices;
+		uint32_t state = 99;
+		for (size_t i(0); i < count; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			const uint32_t id = (state >> 8) % 5000;
+			vertices.emplace_back(static_cast<float>(id % 17) * 0.25f, static_cast<float>(id / 17) * 0.5f, -1.f);
+		}
+		return vertices;
+	}
+
+	void testExactWeld()
+	{
+		std::vector<Vector> vertices = makeSoup(200000);
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		vertices.emplace_back(0.f, 1.f, 2.f);
+		vertices.emplace_back(-0.f, 1.f, 2.f);
+		vertices.emplace_back(nan, 0.f, 0.f);
+		vertices.emplace_back(nan, 0.f, 0.f);
+
+		std::vector<Vector> unique;
+		std::vector<uint32_t> remap;
+		CHECK(Welder::weld(vertices.data(), vertices.size(), unique, remap));
+
+		std::vector<uint32_t> firsts, expected;
+		referenceWeld(vertices, [](const Vector& v)
+		{
+			return std::make_tuple(hashBits(v.x()), hashBits(v.y()), hashBits(v.z()));
+		}, firsts, expected);
+
+		CHECK(unique.size() == firsts.size());
+		CHECK(remap == expected);
+		size_t wrong(0);
+		for (size_t i(0); i < unique.size() && i < firsts.size(); ++i)
+		{
+			wrong += !sameBits(unique[i], vertices[firsts[i]]);
+		}
+		CHECK(0 == wrong);
+
+		// +0 与 -0 合并，位模式相同的 NaN 合并
+		const size_t n = vertices.size();
+		CHECK(remap[n - 4] == remap[n - 3]);
+		CHECK(remap[n - 2] == remap[n - 1]);
+
+		// 重复运行结果相同（与线程调度无关）
+		std::vector<Vector> again;
+		std::vector<uint32_t> remapAgain;
+		Welder::weld(vertices.data(), vertices.size(), again, remapAgain);
+		CHECK(remapAgain == remap);
+	}
+
+	void testQuantizedWeld()
+	{
+		const std::vector<Vector> vertices = { { 0.01f, 0.01f, 0.01f }, { 0.09f, 0.05f, 0.02f }, { 0.11f, 0.01f, 0.01f },
+			{ -0.01f, 0.01f, 0.01f }, { 0.05f, 0.05f, 0.05f } };
+		std::vector<Vector> unique;
+		std::vector<uint32_t> remap;
+		CHECK(Welder::weld(vertices.data(), vertices.size(), 0.1, unique, remap));
+		CHECK(3 == unique.size());
+		CHECK((std::vector<uint32_t>{ 0, 0, 1, 2, 0 } == remap));
+		CHECK(sameBits(unique[0], vertices[0]));
+
+		std::vector<uint32_t> indices = { 4, 3, 2, 1, 0 };
+		Welder::remapIndices(indices.data(), indices.size(), remap);
+		CHECK((std::vector<uint32_t>{ 0, 2, 1, 0, 0 } == indices));
+	}
+
+	void testEmpty()
+	{
+		std::vector<Vector> unique(3);
+		std::vector<uint32_t> remap(3);
+		CHECK(Welder::weld(nullptr, 0, unique, remap));
+		CHECK(unique.empty() && remap.empty());
+	}
+}
+
+int main()
+{
+	testExactWeld();
+	testQuantizedWeld();
+	testEmpty();
+	return test::report("VertexWelderTest");
+}